@@ -83,6 +83,8 @@ SOURCES += \
         core/AppGuard.cpp \
         core/CallbookManager.cpp \
         core/CredentialStore.cpp \
+        core/DBTaskExecutor.cpp \
+        core/DatabaseBackup.cpp \
         core/FileCompressor.cpp \
         core/FldigiTCPServer.cpp \
         core/FldigiUDPReceiver.cpp \
@@ -101,6 +103,8 @@ SOURCES += \
         core/QSLPrintLabelRenderer.cpp \
         core/QSLStorage.cpp \
         core/QSOFilterManager.cpp \
+        core/SQLBulkLoad.cpp \
+        core/SQLTuning.cpp \
         core/WsjtxUDPReceiver.cpp \
         core/debug.cpp \
         core/EmergencyFrequency.cpp \
@@ -122,11 +126,20 @@ SOURCES += \
         data/CWKeyProfile.cpp \
         data/CWShortcutProfile.cpp \
         data/Callsign.cpp \
+        data/ContestDupeIndex.cpp \
         data/Data.cpp \
+        data/DXCCCreditIndex.cpp \
+        data/DxccAD1CIndex.cpp \
+        data/DxccClublogIndex.cpp \
+        data/DxccPrefixTrie.cpp \
+        data/DxccSnapshot.cpp \
+        data/DxccStatusMatrix.cpp \
         data/DxServerString.cpp \
         data/Gridsquare.cpp \
         data/HostsPortString.cpp \
+        data/ImportDupeIndex.cpp \
         data/MainLayoutProfile.cpp \
+        data/RefStringTable.cpp \
         data/RigProfile.cpp \
         data/RotProfile.cpp \
         data/RotUsrButtonsProfile.cpp \
@@ -134,6 +147,7 @@ SOURCES += \
         data/StationProfile.cpp \
         data/UpdatableSQLRecord.cpp \
         logformat/AdiFormat.cpp \
+        logformat/AdiTokenizer.cpp \
         logformat/AdxFormat.cpp \
         logformat/CabrilloFormat.cpp \
         logformat/CSVFormat.cpp \
@@ -142,8 +156,10 @@ SOURCES += \
         logformat/PotaAdiFormat.cpp \
         models/AlertTableModel.cpp \
         models/AwardsTableModel.cpp \
+        models/DBQueryResultModel.cpp \
         models/DxccTableModel.cpp \
         models/LogbookModel.cpp \
+        models/RefStringTableModel.cpp \
         models/RigTypeModel.cpp \
         models/RotTypeModel.cpp \
         models/SearchFilterProxyModel.cpp \
@@ -275,6 +291,8 @@ HEADERS += \
         core/AppGuard.h \
         core/CallbookManager.h \
         core/CredentialStore.h \
+        core/DBTaskExecutor.h \
+        core/DatabaseBackup.h \
         core/FileCompressor.h \
         core/FldigiTCPServer.h \
         core/FldigiUDPReceiver.h \
@@ -286,6 +304,7 @@ HEADERS += \
         core/Migration.h \
         core/MqttClient.h \
         core/NetworkNotification.h \
+        core/OrderedWorkQueue.h \
         core/PasswordCipher.h \
         core/PlatformParameterManager.h \
         core/PotaQE.h \
@@ -293,7 +312,8 @@ HEADERS += \
         core/QSLPrintLabelRenderer.h \
         core/QSLStorage.h \
         core/QSOFilterManager.h \
-        core/QuadKeyCache.h \
+        core/SQLBulkLoad.h \
+        core/SQLTuning.h \
         core/WsjtxUDPReceiver.h \
         core/csv.hpp \
         core/debug.h \
@@ -315,18 +335,27 @@ HEADERS += \
         data/CWKeyProfile.h \
         data/CWShortcutProfile.h \
         data/Callsign.h \
+        data/ContestDupeIndex.h \
         data/Data.h \
         data/DxServerString.h \
         data/DxSpot.h \
+        data/DXCCCreditIndex.h \
         data/Dxcc.h \
+        data/DxccAD1CIndex.h \
+        data/DxccClublogIndex.h \
+        data/DxccPrefixTrie.h \
+        data/DxccSnapshot.h \
+        data/DxccStatusMatrix.h \
         data/Gridsquare.h \
         data/HeardMeSpot.h \
         data/HostsPortString.h \
+        data/ImportDupeIndex.h \
         data/MainLayoutProfile.h \
         data/POTAEntity.h \
         data/POTASpot.h \
         data/PskDecode.h \
         data/ProfileManager.h \
+        data/RefStringTable.h \
         data/RigProfile.h \
         data/RotProfile.h \
         data/RotUsrButtonsProfile.h \
@@ -345,6 +374,7 @@ HEADERS += \
         data/WsjtxLogADIF.h \
         data/WsjtxStatus.h \
         logformat/AdiFormat.h \
+        logformat/AdiTokenizer.h \
         logformat/AdxFormat.h \
         logformat/CabrilloFormat.h \
         logformat/CSVFormat.h \
@@ -353,8 +383,10 @@ HEADERS += \
         logformat/PotaAdiFormat.h \
         models/AlertTableModel.h \
         models/AwardsTableModel.h \
+        models/DBQueryResultModel.h \
         models/DxccTableModel.h \
         models/LogbookModel.h \
+        models/RefStringTableModel.h \
         models/RigTypeModel.h \
         models/RotTypeModel.h \
         models/SearchFilterProxyModel.h \
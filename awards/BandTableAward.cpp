@@ -3,9 +3,20 @@
 #include "core/debug.h"
 #include "data/Band.h"
 #include "data/BandPlan.h"
+#include "core/DBTaskExecutor.h"
 
 MODULE_IDENTIFICATION("qlog.awards.bandtableaward");
 
+// all awards share one request - only the shown award is refreshed
+const QString BandTableAward::TASK_KEY = QStringLiteral("awards_band_table");
+
+BandTableAward::~BandTableAward()
+{
+    FCT_IDENTIFICATION;
+
+    DBTaskExecutor::instance()->cancel(TASK_KEY);
+}
+
 QWidget* BandTableAward::createWidget(QWidget *parent)
 {
     FCT_IDENTIFICATION;
@@ -26,6 +37,7 @@ QWidget* BandTableAward::createWidget(QWidget *parent)
     m_tableView->verticalHeader()->setMinimumSectionSize(20);
     m_tableView->verticalHeader()->setDefaultSectionSize(20);
     m_tableView->verticalHeader()->setHighlightSections(false);
+    m_tableView->setModel(m_model);
 
     m_widget = m_tableView;
     return m_widget;
@@ -185,11 +197,15 @@ void BandTableAward::updateData(const AwardFilterParams &params)
                                                            );
     qCDebug(runtime) << finalSQL;
 
-    m_model->setQuery(finalSQL);
-    m_model->setHeaderData(1, Qt::Horizontal, "");
-    m_model->setHeaderData(2, Qt::Horizontal, "");
-    m_tableView->setModel(m_model);
-    m_tableView->setColumnHidden(0, true);
+    // the pivot reads the whole log - the table is filled when the result arrives
+    DBTaskExecutor::instance()->submit(TASK_KEY, finalSQL, QVariantList(),
+                                       m_tableView, [this](const DBQueryResult &result)
+    {
+        m_model->setResult(result);
+        m_model->setHeaderData(1, Qt::Horizontal, "");
+        m_model->setHeaderData(2, Qt::Horizontal, "");
+        m_tableView->setColumnHidden(0, true);
+    });
 }
 
 BandTableAward::ConditionResult BandTableAward::getConditionSelected(const QModelIndex &clickedIndex) const
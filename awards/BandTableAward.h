@@ -63,6 +63,8 @@
 class BandTableAward : public AwardDefinition
 {
 public:
+    ~BandTableAward() override;
+
     QWidget* createWidget(QWidget *parent) override;
     void updateData(const AwardFilterParams &params) override;
     ConditionResult getConditionSelected(const QModelIndex &clickedIndex) const override;
@@ -232,6 +234,8 @@ protected:
     static QString generateSplitSourceContacts(const QString &outputColumn);
 
 private:
+    static const QString TASK_KEY;
+
     QTableView *m_tableView = nullptr;
     AwardsTableModel *m_model = nullptr;
     QString m_currentEntity;
@@ -0,0 +1,308 @@
+#include <QThread>
+#include <QFutureWatcher>
+#include <QSqlDatabase>
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <sqlite3.h>
+
+#include "DBTaskExecutor.h"
+#include "core/debug.h"
+#include "core/LogDatabase.h"
+
+MODULE_IDENTIFICATION("qlog.core.dbtaskexecutor");
+
+DBTaskExecutor::DBTaskExecutor(QObject *parent) :
+    QObject(parent)
+{
+    FCT_IDENTIFICATION;
+}
+
+DBTaskExecutor::~DBTaskExecutor()
+{
+    FCT_IDENTIFICATION;
+
+    stop();
+}
+
+QFuture<DBQueryResult> DBTaskExecutor::submit(const QString &key,
+                                              const QString &statement,
+                                              const QVariantList &bindValues)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << key << statement << bindValues;
+
+    QSharedPointer<Task> task(new Task);
+    task->key = key;
+    task->statement = statement;
+    task->bindValues = bindValues;
+    task->interface.reportStarted();
+
+    QMutexLocker locker(&mutex);
+
+    if ( stopping )
+    {
+        qCDebug(runtime) << "Executor is stopped - request canceled" << key;
+        task->interface.cancel();
+        task->interface.reportFinished();
+        return task->interface.future();
+    }
+
+    if ( workers.isEmpty() )
+        startWorkers();
+
+    cancelLocked(key);
+    tasks.enqueue(task);
+    taskAvailable.wakeOne();
+
+    return task->interface.future();
+}
+
+QFuture<DBQueryResult> DBTaskExecutor::submit(const QString &key,
+                                              const QString &statement,
+                                              const QVariantList &bindValues,
+                                              QObject *context,
+                                              const std::function<void (const DBQueryResult &)> &callback)
+{
+    FCT_IDENTIFICATION;
+
+    QFutureWatcher<DBQueryResult> *watcher = new QFutureWatcher<DBQueryResult>(context);
+
+    connect(watcher, &QFutureWatcher<DBQueryResult>::finished, context, [watcher, callback]()
+    {
+        if ( !watcher->isCanceled() )
+            callback(watcher->result());
+
+        watcher->deleteLater();
+    });
+
+    const QFuture<DBQueryResult> future = submit(key, statement, bindValues);
+    watcher->setFuture(future);
+    return future;
+}
+
+void DBTaskExecutor::cancel(const QString &key)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << key;
+
+    QMutexLocker locker(&mutex);
+    cancelLocked(key);
+}
+
+void DBTaskExecutor::stop()
+{
+    FCT_IDENTIFICATION;
+
+    QVector<Worker> stoppedWorkers;
+
+    {
+        QMutexLocker locker(&mutex);
+
+        stopping = true;
+
+        while ( !tasks.isEmpty() )
+        {
+            QSharedPointer<Task> task = tasks.dequeue();
+            task->interface.cancel();
+            task->interface.reportFinished();
+        }
+
+        for ( const Worker &worker : static_cast<const QVector<Worker>&>(workers) )
+        {
+            if ( worker.current )
+                worker.current->interface.cancel();
+        }
+
+        stoppedWorkers = workers;
+        taskAvailable.wakeAll();
+    }
+
+    for ( const Worker &worker : static_cast<const QVector<Worker>&>(stoppedWorkers) )
+    {
+        worker.thread->wait();
+        delete worker.thread;
+    }
+
+    QMutexLocker locker(&mutex);
+    workers.clear();
+}
+
+// mutex must be locked
+void DBTaskExecutor::startWorkers()
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(runtime) << "Starting" << WORKER_COUNT << "workers";
+
+    workers.resize(WORKER_COUNT);
+
+    for ( int i = 0; i < WORKER_COUNT; i++ )
+    {
+        workers[i].thread = QThread::create([this, i]()
+        {
+            workerLoop(i);
+        });
+        workers[i].thread->start();
+    }
+}
+
+void DBTaskExecutor::workerLoop(int index)
+{
+    FCT_IDENTIFICATION;
+
+    // the connection of the thread is removed by the pool when the thread exits
+    QSqlDatabase db = LogDatabase::instance()->readOnlyConnection();
+    sqlite3 *handle = nullptr;
+
+    QVariant v = db.driver()->handle();
+    if ( v.isValid() && qstrcmp(v.typeName(), "sqlite3*") == 0 )
+        handle = *static_cast<sqlite3 **>(v.data());
+    else
+        qCWarning(runtime) << "Cannot get SQLite driver handle - running requests cannot be canceled";
+
+    QMutexLocker locker(&mutex);
+
+    while ( true )
+    {
+        while ( !stopping && tasks.isEmpty() )
+            taskAvailable.wait(&mutex);
+
+        if ( stopping )
+            break;
+
+        QSharedPointer<Task> task = tasks.dequeue();
+        workers[index].current = task;
+
+        locker.unlock();
+
+        DBQueryResult result;
+
+        if ( !task->interface.isCanceled() )
+        {
+            // the handler stops the statement of a canceled request
+            if ( handle )
+                sqlite3_progress_handler(handle, PROGRESS_HANDLER_OPS, &DBTaskExecutor::progressHandler, task.data());
+
+            result = execute(db, *task);
+
+            if ( handle )
+                sqlite3_progress_handler(handle, 0, nullptr, nullptr);
+        }
+
+        locker.relock();
+
+        workers[index].current.clear();
+
+        if ( task->interface.isCanceled() )
+            qCDebug(runtime) << "Request canceled" << task->key;
+        else
+            task->interface.reportResult(result);
+
+        task->interface.reportFinished();
+    }
+}
+
+// mutex must be locked
+void DBTaskExecutor::cancelLocked(const QString &key)
+{
+    FCT_IDENTIFICATION;
+
+    for ( int i = tasks.size() - 1; i >= 0; i-- )
+    {
+        if ( tasks.at(i)->key != key )
+            continue;
+
+        qCDebug(runtime) << "Canceling a pending request" << key;
+
+        QSharedPointer<Task> task = tasks.takeAt(i);
+        task->interface.cancel();
+        task->interface.reportFinished();
+    }
+
+    for ( const Worker &worker : static_cast<const QVector<Worker>&>(workers) )
+    {
+        if ( !worker.current
+             || worker.current->key != key
+             || worker.current->interface.isCanceled() )
+            continue;
+
+        qCDebug(runtime) << "Canceling a running request" << key;
+
+        worker.current->interface.cancel();
+    }
+}
+
+// Hot path - no FCT_IDENTIFICATION here
+int DBTaskExecutor::progressHandler(void *task)
+{
+    // non-zero value interrupts the running statement
+    return static_cast<Task *>(task)->interface.isCanceled() ? 1 : 0;
+}
+
+DBQueryResult DBTaskExecutor::execute(const QSqlDatabase &db, const Task &task)
+{
+    FCT_IDENTIFICATION;
+
+    DBQueryResult result;
+
+    if ( !db.isOpen() )
+    {
+        result.error = QStringLiteral("Database connection is not open");
+        return result;
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+
+    if ( !query.prepare(task.statement) )
+    {
+        result.error = query.lastError().text();
+        qCWarning(runtime) << "Cannot prepare" << task.statement << result.error;
+        return result;
+    }
+
+    for ( int i = 0; i < task.bindValues.size(); i++ )
+        query.bindValue(i, task.bindValues.at(i));
+
+    if ( !query.exec() )
+    {
+        result.error = query.lastError().text();
+        if ( !task.interface.isCanceled() )
+            qCWarning(runtime) << "Cannot execute" << task.statement << result.error;
+        return result;
+    }
+
+    const QSqlRecord record = query.record();
+
+    for ( int i = 0; i < record.count(); i++ )
+        result.columns << record.fieldName(i);
+
+    while ( query.next() )
+    {
+        if ( result.rows.size() % CANCEL_CHECK_ROWS == 0
+             && task.interface.isCanceled() )
+            return result;
+
+        QVariantList row;
+        row.reserve(record.count());
+
+        for ( int i = 0; i < record.count(); i++ )
+            row << query.value(i);
+
+        result.rows << row;
+    }
+
+    // an interrupted step ends the loop as the end of data
+    if ( query.lastError().isValid() )
+    {
+        result.error = query.lastError().text();
+        return result;
+    }
+
+    result.ok = true;
+    return result;
+}
@@ -0,0 +1,96 @@
+#ifndef QLOG_CORE_DBTASKEXECUTOR_H
+#define QLOG_CORE_DBTASKEXECUTOR_H
+
+#include <QObject>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVariant>
+#include <functional>
+
+class QThread;
+class QSqlDatabase;
+
+struct DBQueryResult
+{
+    bool ok = false;
+    QString error;
+    QStringList columns;
+    QList<QVariantList> rows;
+};
+
+// Runs read statements for the UI on worker threads, over the read-only
+// connections of LogDatabase::readOnlyConnection, and returns the rows as QFuture.
+//
+// Every request has a key (usually the name of the widget). A new request
+// cancels the pending or running request with the same key - a running statement
+// is stopped by the SQLite progress handler - so a stale result never delays the fresh one.
+class DBTaskExecutor : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DBTaskExecutor *instance()
+    {
+        static DBTaskExecutor instance;
+        return &instance;
+    };
+
+    QFuture<DBQueryResult> submit(const QString &key,
+                                  const QString &statement,
+                                  const QVariantList &bindValues = QVariantList());
+
+    // the same as submit; the callback is called in the thread of the context
+    // when the result is ready. A canceled request does not call it.
+    QFuture<DBQueryResult> submit(const QString &key,
+                                  const QString &statement,
+                                  const QVariantList &bindValues,
+                                  QObject *context,
+                                  const std::function<void(const DBQueryResult &)> &callback);
+
+    void cancel(const QString &key);
+
+    // cancels all requests and stops the worker threads; must be called
+    // before the main connection is closed
+    void stop();
+
+private:
+    struct Task
+    {
+        QString key;
+        QString statement;
+        QVariantList bindValues;
+        QFutureInterface<DBQueryResult> interface;
+    };
+
+    struct Worker
+    {
+        QThread *thread = nullptr;
+        QSharedPointer<Task> current;
+    };
+
+    explicit DBTaskExecutor(QObject *parent = nullptr);
+    ~DBTaskExecutor();
+
+    void startWorkers();
+    void workerLoop(int index);
+    void cancelLocked(const QString &key);
+    static DBQueryResult execute(const QSqlDatabase &db, const Task &task);
+    static int progressHandler(void *task);
+
+    QMutex mutex;
+    QWaitCondition taskAvailable;
+    QQueue<QSharedPointer<Task>> tasks;
+    QVector<Worker> workers;
+    bool stopping = false;
+
+    const int WORKER_COUNT = 2;
+    const int CANCEL_CHECK_ROWS = 256;
+    const int PROGRESS_HANDLER_OPS = 1000;
+};
+
+#endif // QLOG_CORE_DBTASKEXECUTOR_H
@@ -0,0 +1,372 @@
+#include <QThread>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QElapsedTimer>
+#include <sqlite3.h>
+
+#include "DatabaseBackup.h"
+#include "core/debug.h"
+#include "core/FileCompressor.h"
+#include "core/LogDatabase.h"
+#include "core/LogParam.h"
+#include "core/Migration.h"
+
+MODULE_IDENTIFICATION("qlog.core.databasebackup");
+
+QString DatabaseBackup::FORMAT_DATABASE = "database";
+QString DatabaseBackup::FORMAT_ADX = "adx";
+
+#define BACKUP_STEP_PAUSE_MS 10
+
+DatabaseBackup::DatabaseBackup(QObject *parent) :
+    QObject(parent)
+{
+    FCT_IDENTIFICATION;
+
+    periodicTimer.setInterval(PERIODIC_CHECK_MS);
+    connect(&periodicTimer, &QTimer::timeout, this, &DatabaseBackup::startPeriodicBackup);
+}
+
+DatabaseBackup::~DatabaseBackup()
+{
+    FCT_IDENTIFICATION;
+
+    stop();
+}
+
+void DatabaseBackup::startPeriodicBackup()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !periodicTimer.isActive() )
+        periodicTimer.start();
+
+    if ( isRunning() )
+    {
+        qCDebug(runtime) << "Backup is already running";
+        return;
+    }
+
+    const QDate &lastBackupDate = LogParam::getLastBackupDate();
+    const QDate &now = QDate::currentDate();
+
+    qCDebug(runtime) << "The last backup date" << lastBackupDate;
+
+    if ( lastBackupDate.isValid()
+         && lastBackupDate.addDays(BACKUP_INTERVAL_DAYS) > now )
+    {
+        qCDebug(runtime) << "Backup skipped";
+        return;
+    }
+
+    if ( LogParam::getBackupFormat() == FORMAT_ADX )
+    {
+        // the export reads the main connection - it cannot run in the background
+        const bool result = DBSchemaMigration::backupAllQSOsToADX();
+        emit backupFinished(result, QString());
+        return;
+    }
+
+    const bool compress = LogParam::getBackupCompressed();
+    const QString sourceFile = LogDatabase::dbFilename();
+
+    backupThreadDate = now;
+    backupThreadFile = backupDirectory().filePath(backupFileName(now, compress));
+    backupThreadResult = false;
+    abortRequested.storeRelease(0);
+
+    qCDebug(runtime) << "Starting a background backup to" << backupThreadFile;
+
+    const QString destFile = backupThreadFile;
+
+    backupThread = QThread::create([this, sourceFile, destFile, compress]()
+    {
+        backupThreadResult = backupDatabase(sourceFile, destFile, compress,
+                                            DEFAULT_PAGES_PER_STEP, &abortRequested);
+    });
+
+    connect(backupThread, &QThread::finished, this, &DatabaseBackup::backupThreadFinished);
+    backupThread->setPriority(QThread::LowPriority);
+    backupThread->start();
+}
+
+bool DatabaseBackup::backupNow(int schemaVersion)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << schemaVersion;
+
+    // a running backup is finished first - the files must not be rotated under it
+    if ( backupThread )
+    {
+        backupThread->wait();
+        backupThreadFinished();
+    }
+
+    if ( LogParam::getBackupFormat() == FORMAT_ADX )
+        return DBSchemaMigration::backupAllQSOsToADX(true);
+
+    const QDate &now = QDate::currentDate();
+    const bool compress = LogParam::getBackupCompressed();
+    const QString destFile = backupDirectory().filePath(backupFileName(now, compress, schemaVersion));
+
+    qCDebug(runtime) << "Backup to" << destFile;
+
+    if ( !backupDatabase(LogDatabase::dbFilename(), destFile, compress) )
+        return false;
+
+    LogParam::setLastBackupDate(now);
+    removeOldBackups(backupDirectory(), BACKUP_COUNT);
+
+    return true;
+}
+
+void DatabaseBackup::stop()
+{
+    FCT_IDENTIFICATION;
+
+    periodicTimer.stop();
+
+    if ( !backupThread )
+        return;
+
+    qCDebug(runtime) << "Aborting the running backup";
+
+    abortRequested.storeRelease(1);
+    backupThread->wait();
+    delete backupThread;
+    backupThread = nullptr;
+}
+
+bool DatabaseBackup::isRunning() const
+{
+    return backupThread != nullptr;
+}
+
+void DatabaseBackup::backupThreadFinished()
+{
+    FCT_IDENTIFICATION;
+
+    // called by the signal and by backupNow - the second call does nothing
+    if ( !backupThread )
+        return;
+
+    backupThread->deleteLater();
+    backupThread = nullptr;
+
+    qCDebug(runtime) << "Background backup finished" << backupThreadResult;
+
+    if ( backupThreadResult )
+    {
+        LogParam::setLastBackupDate(backupThreadDate);
+        removeOldBackups(backupDirectory(), BACKUP_COUNT);
+    }
+
+    emit backupFinished(backupThreadResult, backupThreadFile);
+}
+
+bool DatabaseBackup::backupDatabase(const QString &sourceFile,
+                                    const QString &destFile,
+                                    bool compress,
+                                    int pagesPerStep,
+                                    const QAtomicInt *abort)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << sourceFile << destFile << compress << pagesPerStep;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // the destination is created under a temporary name - an unfinished backup never replaces a complete one
+    const QString copyFile = destFile + ".part";
+    sqlite3 *srcHandle = nullptr;
+    sqlite3 *dstHandle = nullptr;
+    sqlite3_backup *backup = nullptr;
+    bool ok = false;
+    bool inTransaction = false;
+
+    QFile::remove(copyFile);
+
+    if ( sqlite3_open_v2(sourceFile.toUtf8().constData(), &srcHandle,
+                         SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK )
+    {
+        qWarning() << "Cannot open the database file:" << sqlite3_errmsg(srcHandle);
+        goto cleanup;
+    }
+
+    sqlite3_busy_timeout(srcHandle, 5000);
+
+    // one read transaction for all slices - the backup is a snapshot and it is not
+    // restarted when the main connection writes; WAL readers do not block the writer
+    if ( sqlite3_exec(srcHandle, "BEGIN; SELECT COUNT(*) FROM sqlite_master;",
+                      nullptr, nullptr, nullptr) != SQLITE_OK )
+    {
+        qWarning() << "Cannot start a read transaction:" << sqlite3_errmsg(srcHandle);
+        goto cleanup;
+    }
+    inTransaction = true;
+
+    if ( sqlite3_open_v2(copyFile.toUtf8().constData(), &dstHandle,
+                         SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK )
+    {
+        qWarning() << "Cannot open a backup file:" << sqlite3_errmsg(dstHandle);
+        goto cleanup;
+    }
+
+    backup = sqlite3_backup_init(dstHandle, "main", srcHandle, "main");
+    if ( !backup )
+    {
+        qWarning() << "Cannot Init a backup" << sqlite3_errmsg(dstHandle);
+        goto cleanup;
+    }
+
+    while ( true )
+    {
+        if ( abort && abort->loadAcquire() )
+        {
+            qCDebug(runtime) << "Backup aborted";
+            break;
+        }
+
+        int rc = sqlite3_backup_step(backup, pagesPerStep);
+
+        if ( rc == SQLITE_DONE )
+        {
+            ok = true;
+            break;
+        }
+        else if ( rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED )
+        {
+            // a short pause between the slices leaves the disk to the application
+            sqlite3_sleep(BACKUP_STEP_PAUSE_MS);
+            continue;
+        }
+        else
+        {
+            qWarning() << "Backup Error" << sqlite3_errmsg(dstHandle);
+            break;
+        }
+    }
+
+    // sqlite3_backup_finish always releases the backup handle,
+    // even on error — never call it twice
+    if ( sqlite3_backup_finish(backup) != SQLITE_OK )
+    {
+        qWarning() << "Cannot finalize the database backup" << sqlite3_errmsg(dstHandle);
+        ok = false;
+    }
+    backup = nullptr;
+
+cleanup:
+    if ( backup )
+        sqlite3_backup_finish(backup);
+
+    if ( dstHandle )
+        sqlite3_close(dstHandle);
+
+    if ( inTransaction )
+        sqlite3_exec(srcHandle, "COMMIT;", nullptr, nullptr, nullptr);
+
+    if ( srcHandle )
+        sqlite3_close(srcHandle);
+
+    QString finishedFile = copyFile;
+
+    if ( ok && compress )
+    {
+        finishedFile = destFile + ".tmp";
+
+        FileCompressor::ProgressCallback progressCallback = [abort](qint64, qint64)
+        {
+            return !( abort && abort->loadAcquire() );
+        };
+
+        ok = FileCompressor::gzipFile(copyFile, finishedFile, progressCallback);
+        QFile::remove(copyFile);
+    }
+
+    if ( ok )
+    {
+        QFile::remove(destFile);
+        ok = QFile::rename(finishedFile, destFile);
+
+        if ( !ok )
+            qWarning() << "Cannot rename the backup file to" << destFile;
+    }
+
+    if ( !ok )
+    {
+        QFile::remove(copyFile);
+        QFile::remove(finishedFile);
+    }
+    else
+        qCDebug(runtime) << "Database backup finished in" << timer.elapsed() << "ms";
+
+    return ok;
+}
+
+void DatabaseBackup::removeOldBackups(const QDir &dir, int keepCount)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << dir.path() << keepCount;
+
+    // old ADX backup files had a timestamp YYYYMMDDHHmmSS, newer have only YYYYMMDD;
+    // all formats are rotated together so the old ADX backups are phased out
+    const QRegularExpression backupRegex("^qlog_backup_\\d{8}(\\d{6})?\\.(adx|db|db\\.gz)$");
+    const QRegularExpression premigrationRegex("^qlog_backup_\\d{8}_premigration_v\\d+\\.(db|db\\.gz)$");
+    const QRegularExpression unfinishedRegex("^qlog_backup_\\d{8}(_premigration_v\\d+)?\\.(db|db\\.gz)\\.(part|tmp)$");
+
+    const QFileInfoList &fileList = dir.entryInfoList(QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
+    QFileInfoList backupList;
+    QFileInfoList premigrationList;
+
+    for ( const QFileInfo &fileInfo : fileList )
+    {
+        const QString &fileName = fileInfo.fileName();
+
+        if ( backupRegex.match(fileName).hasMatch() )
+            backupList.append(fileInfo);
+        else if ( premigrationRegex.match(fileName).hasMatch() )
+            premigrationList.append(fileInfo);
+        else if ( unfinishedRegex.match(fileName).hasMatch() )
+        {
+            qCDebug(runtime) << "Removing unfinished backup file: " << fileName;
+            QFile::remove(fileInfo.absoluteFilePath());
+        }
+    }
+
+    // the names start with the date - the name order is the age order
+    while ( backupList.size() > keepCount )
+        removeBackupFile(backupList.takeFirst().absoluteFilePath());
+
+    // the pre-migration backups are rotated separately - the periodic backups
+    // must not push out the last copy of the old schema
+    while ( premigrationList.size() > PREMIGRATION_BACKUP_COUNT )
+        removeBackupFile(premigrationList.takeFirst().absoluteFilePath());
+}
+
+void DatabaseBackup::removeBackupFile(const QString &filepath)
+{
+    FCT_IDENTIFICATION;
+
+    if ( QFile::remove(filepath) )
+        qCDebug(runtime) << "Removing old backup file: " << filepath;
+    else
+        qWarning() << "Failed to remove old backup file: " << filepath;
+}
+
+QString DatabaseBackup::backupFileName(const QDate &date, bool compress, int premigrationVersion)
+{
+    const QString premigration = ( premigrationVersion > 0 ) ? QString("_premigration_v%1").arg(premigrationVersion)
+                                                             : QString();
+
+    return "qlog_backup_" + date.toString("yyyyMMdd") + premigration + ( ( compress ) ? ".db.gz" : ".db" );
+}
+
+QDir DatabaseBackup::backupDirectory()
+{
+    return LogDatabase::dbDirectory();
+}
@@ -0,0 +1,90 @@
+#ifndef QLOG_CORE_DATABASEBACKUP_H
+#define QLOG_CORE_DATABASEBACKUP_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QDate>
+#include <QDir>
+#include <QTimer>
+
+class QThread;
+
+// Backup of the log database.
+// The database file is copied by the SQLite online backup API from a separate
+// read-only connection in a background thread. The copy runs in slices inside
+// one read transaction, so it is a consistent snapshot and the main connection
+// can write during the backup (WAL mode). The copy is optionally gzipped.
+// The ADX export is still available as an explicitly selected backup format;
+// it runs on the main connection and therefore blocks.
+class DatabaseBackup : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DatabaseBackup *instance()
+    {
+        static DatabaseBackup instance;
+        return &instance;
+    };
+
+    static const int BACKUP_COUNT = 10;
+    static const int PREMIGRATION_BACKUP_COUNT = 3;
+    static const int BACKUP_INTERVAL_DAYS = 7;
+    static const int DEFAULT_PAGES_PER_STEP = 1024;
+
+    static QString FORMAT_DATABASE;
+    static QString FORMAT_ADX;
+
+    // starts a background backup when the last one is older than BACKUP_INTERVAL_DAYS;
+    // the check is repeated periodically while QLog is running
+    void startPeriodicBackup();
+
+    // synchronous backup before the migration of the schemaVersion database;
+    // the file name contains the version so it does not replace the periodic backup
+    bool backupNow(int schemaVersion);
+
+    // stops the periodic backups and waits for a running one (application exit)
+    void stop();
+
+    bool isRunning() const;
+
+    // copies sourceFile by the online backup API in slices of pagesPerStep pages;
+    // destFile is replaced only when the backup is complete.
+    // abort is checked between the slices
+    static bool backupDatabase(const QString &sourceFile,
+                               const QString &destFile,
+                               bool compress,
+                               int pagesPerStep = DEFAULT_PAGES_PER_STEP,
+                               const QAtomicInt *abort = nullptr);
+
+    // keeps keepCount newest periodic backups (ADX and database) and PREMIGRATION_BACKUP_COUNT
+    // newest pre-migration backups, and removes unfinished backup files
+    static void removeOldBackups(const QDir &dir, int keepCount);
+
+    // premigrationVersion 0 is the name of a periodic backup
+    static QString backupFileName(const QDate &date, bool compress, int premigrationVersion = 0);
+
+signals:
+    void backupFinished(bool success, const QString &filename);
+
+private slots:
+    void backupThreadFinished();
+
+private:
+    explicit DatabaseBackup(QObject *parent = nullptr);
+    ~DatabaseBackup();
+
+    static QDir backupDirectory();
+    static void removeBackupFile(const QString &filepath);
+
+    QTimer periodicTimer;
+    QThread *backupThread = nullptr;
+    QAtomicInt abortRequested;
+    QString backupThreadFile;
+    QDate backupThreadDate;
+    bool backupThreadResult = false;
+
+    const int PERIODIC_CHECK_MS = 6 * 60 * 60 * 1000;
+};
+
+#endif // QLOG_CORE_DATABASEBACKUP_H
@@ -2,12 +2,86 @@
 #include <QFileInfo>
 #include <QProgressDialog>
 #include <QCoreApplication>
+#include <QThread>
+#include <QAtomicInt>
+#include <cstring>
 #include <zlib.h>
 #include "FileCompressor.h"
+#include "core/OrderedWorkQueue.h"
 #include "core/debug.h"
 
 MODULE_IDENTIFICATION("qlog.core.filecompressor");
 
+#define GZIP_BLOCK_SIZE (128 * 1024)
+#define GZIP_DICTIONARY_SIZE (32 * 1024)
+
+// one block of the parallel compression
+struct GzipBlock
+{
+    QByteArray data;
+    QByteArray dictionary;      // the end of the previous block
+    QByteArray output;          // raw deflate data
+    qint64 length = 0;          // uncompressed size
+    uLong crc = 0;
+    bool last = false;
+    bool failed = false;
+};
+
+// Deflates one block to a raw deflate stream. A block which is not the last one
+// ends with a sync flush, so the blocks can be simply concatenated.
+static bool deflateBlock(z_stream &strm, GzipBlock &block)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( deflateReset(&strm) != Z_OK )
+        return false;
+
+    if ( !block.dictionary.isEmpty()
+         && deflateSetDictionary(&strm,
+                                 reinterpret_cast<const Bytef*>(block.dictionary.constData()),
+                                 static_cast<uInt>(block.dictionary.size())) != Z_OK )
+        return false;
+
+    block.crc = crc32(0L, reinterpret_cast<const Bytef*>(block.data.constData()),
+                      static_cast<uInt>(block.data.size()));
+
+    strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(block.data.constData()));
+    strm.avail_in = static_cast<uInt>(block.data.size());
+
+    // deflateBound does not count the sync flush marker
+    block.output.resize(static_cast<int>(deflateBound(&strm, static_cast<uLong>(block.data.size()))) + 64);
+
+    int produced = 0;
+    const int flush = ( block.last ) ? Z_FINISH : Z_SYNC_FLUSH;
+    int ret;
+
+    while ( true )
+    {
+        strm.next_out = reinterpret_cast<Bytef*>(block.output.data() + produced);
+        strm.avail_out = static_cast<uInt>(block.output.size() - produced);
+
+        ret = deflate(&strm, flush);
+
+        produced = block.output.size() - static_cast<int>(strm.avail_out);
+
+        if ( ret == Z_STREAM_ERROR )
+            return false;
+
+        if ( strm.avail_out > 0 )
+            break;
+
+        block.output.resize(block.output.size() * 2);
+    }
+
+    block.output.resize(produced);
+    block.data.clear();
+    block.dictionary.clear();
+
+    // Z_BUF_ERROR - the flush was already complete when the output buffer was full
+    return ( block.last ) ? ret == Z_STREAM_END
+                          : strm.avail_in == 0 && ( ret == Z_OK || ret == Z_BUF_ERROR );
+}
+
 QByteArray FileCompressor::gzip(const QByteArray &in)
 {
     FCT_IDENTIFICATION;
@@ -89,6 +163,11 @@ bool FileCompressor::gzipFile(const QString &sourceFile, const QString &destFile
 
     qCDebug(function_parameters) << sourceFile << "->" << destFile;
 
+    // not worth starting the threads for a few blocks
+    if ( QThread::idealThreadCount() > 1
+         && QFileInfo(sourceFile).size() > 4 * GZIP_BLOCK_SIZE )
+        return gzipFileParallel(sourceFile, destFile, progress);
+
     QFile source(sourceFile);
     if ( !source.open(QIODevice::ReadOnly) )
     {
@@ -185,6 +264,197 @@ bool FileCompressor::gzipFile(const QString &sourceFile, const QString &destFile
     return true;
 }
 
+// The calling thread writes the gzip header, the deflated blocks in the file order
+// and the trailer; the CRC of the whole file is combined from the block CRCs.
+// A reader thread splits the file to blocks and the worker threads deflate them.
+bool FileCompressor::gzipFileParallel(const QString &sourceFile, const QString &destFile,
+                                      const ProgressCallback &progress,
+                                      int threads)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << sourceFile << "->" << destFile << threads;
+
+    QFile source(sourceFile);
+    if ( !source.open(QIODevice::ReadOnly) )
+    {
+        qWarning() << "Cannot open source file:" << sourceFile;
+        return false;
+    }
+
+    QFile dest(destFile);
+    if ( !dest.open(QIODevice::WriteOnly) )
+    {
+        qWarning() << "Cannot create dest file:" << destFile;
+        return false;
+    }
+
+    const qint64 totalSize = source.size();
+    const int workerCount = ( threads > 0 ) ? threads : qMax(1, QThread::idealThreadCount());
+
+    qCDebug(runtime) << "Parallel compression of" << totalSize << "bytes;" << workerCount << "workers";
+
+    OrderedWorkQueue<GzipBlock> queue(workerCount * 2);
+    QAtomicInt cancelled(0);
+
+    QThread *readerThread = QThread::create([&source, &queue, &cancelled]()
+    {
+        QByteArray dictionary;
+        bool last = false;
+
+        while ( !last && !cancelled.loadAcquire() )
+        {
+            GzipBlock block;
+            block.data.resize(GZIP_BLOCK_SIZE);
+
+            const qint64 bytesRead = source.read(block.data.data(), GZIP_BLOCK_SIZE);
+
+            if ( bytesRead < 0 )
+            {
+                qWarning() << "Read error";
+                block.data.clear();
+                block.failed = true;
+                last = true;
+            }
+            else
+            {
+                block.data.resize(static_cast<int>(bytesRead));
+                block.length = bytesRead;
+                last = ( bytesRead < GZIP_BLOCK_SIZE || source.atEnd() );
+            }
+
+            block.last = last;
+            block.dictionary = dictionary;
+            dictionary = block.data.right(GZIP_DICTIONARY_SIZE);
+            queue.pushInput(block);
+        }
+        queue.finishInput();
+    });
+
+    QList<QThread *> workerThreads;
+
+    for ( int i = 0; i < workerCount; i++ )
+    {
+        workerThreads << QThread::create([&queue, &cancelled]()
+        {
+            z_stream strm{};
+
+            // raw deflate - the gzip header and trailer are written by the writer
+            const bool initialized = ( deflateInit2(&strm, Z_BEST_SPEED, Z_DEFLATED,
+                                                    -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK );
+
+            if ( !initialized )
+                qWarning() << "deflateInit2 failed";
+
+            quint64 seq;
+            GzipBlock block;
+
+            while ( queue.takeInput(seq, block) )
+            {
+                // the blocks of a cancelled compression are only passed to the writer
+                if ( !block.failed && !cancelled.loadAcquire() )
+                    block.failed = !initialized || !deflateBlock(strm, block);
+
+                queue.pushResult(seq, block);
+            }
+
+            if ( initialized )
+                deflateEnd(&strm);
+        });
+    }
+
+    readerThread->start();
+
+    for ( QThread *thread : static_cast<const QList<QThread *>&>(workerThreads) )
+        thread->start();
+
+    // gzip header: deflate, no flags, no mtime, fastest compression, unknown OS
+    static const char header[] = { '\x1f', '\x8b', '\x08', '\x00',
+                                   '\x00', '\x00', '\x00', '\x00',
+                                   '\x04', '\xff' };
+
+    bool success = ( dest.write(header, sizeof(header)) == static_cast<qint64>(sizeof(header)) );
+    bool finished = false;
+    uLong crc = crc32(0L, Z_NULL, 0);
+    qint64 bytesProcessed = 0;
+    GzipBlock block;
+
+    if ( !success )
+        qWarning() << "Write error";
+
+    // the queue is always drained, so the reader is never blocked on a cancelled compression
+    while ( queue.takeResult(block) )
+    {
+        if ( !success )
+            continue;
+
+        if ( block.failed )
+        {
+            qWarning() << "Block compression failed";
+            success = false;
+            cancelled.storeRelease(1);
+            continue;
+        }
+
+        if ( dest.write(block.output) != block.output.size() )
+        {
+            qWarning() << "Write error";
+            success = false;
+            cancelled.storeRelease(1);
+            continue;
+        }
+
+        crc = crc32_combine(crc, block.crc, static_cast<z_off_t>(block.length));
+        bytesProcessed += block.length;
+        finished = block.last;
+
+        if ( progress && !progress(bytesProcessed, totalSize) )
+        {
+            qCDebug(runtime) << "Compression cancelled by user";
+            success = false;
+            cancelled.storeRelease(1);
+        }
+    }
+
+    readerThread->wait();
+    delete readerThread;
+
+    for ( QThread *thread : static_cast<const QList<QThread *>&>(workerThreads) )
+    {
+        thread->wait();
+        delete thread;
+    }
+
+    if ( success && finished )
+    {
+        // trailer: CRC32 and the input size modulo 2^32, little endian
+        const quint32 size = static_cast<quint32>(bytesProcessed);
+        char trailer[8];
+
+        for ( int i = 0; i < 4; i++ )
+        {
+            trailer[i] = static_cast<char>((crc >> (8 * i)) & 0xff);
+            trailer[4 + i] = static_cast<char>((size >> (8 * i)) & 0xff);
+        }
+
+        if ( dest.write(trailer, sizeof(trailer)) != static_cast<qint64>(sizeof(trailer)) )
+        {
+            qWarning() << "Write error";
+            success = false;
+        }
+    }
+
+    if ( !success || !finished )
+    {
+        dest.close();
+        QFile::remove(destFile);
+        return false;
+    }
+
+    qCDebug(runtime) << "File compressed successfully";
+    return true;
+}
+
 bool FileCompressor::gunzipFile(const QString &sourceFile, const QString &destFile,
                                 const ProgressCallback &progress)
 {
@@ -335,3 +605,229 @@ bool FileCompressor::gunzipFileWithProgress(const QString &sourceFile, const QSt
 
     return result;
 }
+
+GzipReadDevice::GzipReadDevice(QIODevice *source, QObject *parent) :
+    QIODevice(parent),
+    source(source)
+{
+    FCT_IDENTIFICATION;
+}
+
+GzipReadDevice::GzipReadDevice(const QString &fileName, QObject *parent) :
+    QIODevice(parent),
+    ownedFile(new QFile(fileName)),
+    source(ownedFile.data())
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << fileName;
+}
+
+GzipReadDevice::~GzipReadDevice()
+{
+    FCT_IDENTIFICATION;
+
+    releaseStream();
+}
+
+bool GzipReadDevice::open(OpenMode mode)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << mode;
+
+    if ( mode & QIODevice::WriteOnly )
+    {
+        setErrorString(tr("Compressed input is read-only"));
+        return false;
+    }
+
+    if ( !source )
+    {
+        setErrorString(tr("No compressed input"));
+        return false;
+    }
+
+    if ( !source->isOpen() && !source->open(QIODevice::ReadOnly) )
+    {
+        setErrorString(source->errorString());
+        return false;
+    }
+
+    releaseStream();
+
+    strm = new z_stream{};
+
+    // 16 + MAX_WBITS tells zlib to parse gzip header/footer
+    if ( inflateInit2(strm, 16 + MAX_WBITS) != Z_OK )
+    {
+        delete strm;
+        strm = nullptr;
+        setErrorString(tr("Cannot initialize the decompressor"));
+        return false;
+    }
+
+    inBuffer.resize(INPUT_BUFFER_SIZE);
+    outBuffer.clear();
+    outPos = 0;
+    compressedRead = 0;
+    membersFinished = 0;
+    inMember = false;
+    finished = false;
+    failed = false;
+
+    return QIODevice::open(mode & ~QIODevice::Text);
+}
+
+void GzipReadDevice::close()
+{
+    FCT_IDENTIFICATION;
+
+    QIODevice::close();
+    releaseStream();
+
+    if ( ownedFile )
+        ownedFile->close();
+}
+
+bool GzipReadDevice::atEnd() const
+{
+    return finished && bytesAvailable() == 0;
+}
+
+qint64 GzipReadDevice::bytesAvailable() const
+{
+    return ( outBuffer.size() - outPos ) + QIODevice::bytesAvailable();
+}
+
+qint64 GzipReadDevice::compressedPosition() const
+{
+    return ( strm ) ? compressedRead - strm->avail_in : compressedRead;
+}
+
+qint64 GzipReadDevice::compressedSize() const
+{
+    return ( source && !source->isSequential() ) ? source->size() : 0;
+}
+
+bool GzipReadDevice::isGzipFile(const QString &fileName)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << fileName;
+
+    QFile file(fileName);
+
+    if ( !file.open(QIODevice::ReadOnly) )
+        return false;
+
+    return file.read(2) == QByteArray("\x1f\x8b", 2);
+}
+
+qint64 GzipReadDevice::readData(char *data, qint64 maxSize)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    qint64 total = 0;
+
+    while ( total < maxSize )
+    {
+        if ( outPos >= outBuffer.size() && !fillBuffer() )
+            break;
+
+        const qint64 length = qMin(maxSize - total, static_cast<qint64>(outBuffer.size() - outPos));
+        memcpy(data + total, outBuffer.constData() + outPos, length);
+        outPos += length;
+        total += length;
+    }
+
+    return ( total == 0 && failed ) ? -1 : total;
+}
+
+bool GzipReadDevice::fillBuffer()
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( finished || !strm )
+        return false;
+
+    outBuffer.resize(OUTPUT_BUFFER_SIZE);
+    outPos = 0;
+
+    strm->next_out = reinterpret_cast<Bytef*>(outBuffer.data());
+    strm->avail_out = OUTPUT_BUFFER_SIZE;
+
+    // read ahead until the output block is full
+    while ( strm->avail_out > 0 && !finished )
+    {
+        if ( strm->avail_in == 0 )
+        {
+            const qint64 bytesRead = source->read(inBuffer.data(), inBuffer.size());
+
+            if ( bytesRead < 0 )
+            {
+                qWarning() << "Read error" << source->errorString();
+                setErrorString(source->errorString());
+                failed = finished = true;
+                break;
+            }
+
+            if ( bytesRead == 0 )
+            {
+                if ( inMember )
+                {
+                    qWarning() << "Compressed input is truncated";
+                    setErrorString(tr("Compressed input is truncated"));
+                    failed = true;
+                }
+                finished = true;
+                break;
+            }
+
+            strm->next_in = reinterpret_cast<Bytef*>(inBuffer.data());
+            strm->avail_in = static_cast<uInt>(bytesRead);
+            compressedRead += bytesRead;
+        }
+
+        inMember = true;
+
+        const int ret = inflate(strm, Z_NO_FLUSH);
+
+        if ( ret == Z_STREAM_END )
+        {
+            // the next gzip member can follow
+            inMember = false;
+            membersFinished++;
+            inflateReset(strm);
+        }
+        else if ( ret == Z_DATA_ERROR && membersFinished > 0 && strm->total_out == 0 )
+        {
+            // gzip ignores trailing garbage (e.g. zero padding) after a member as well
+            qCDebug(runtime) << "Trailing data after the compressed input ignored";
+            inMember = false;
+            finished = true;
+        }
+        else if ( ret != Z_OK && ret != Z_BUF_ERROR )
+        {
+            qWarning() << "inflate error:" << ret;
+            setErrorString(tr("Compressed input is corrupted"));
+            failed = finished = true;
+        }
+    }
+
+    outBuffer.resize(OUTPUT_BUFFER_SIZE - strm->avail_out);
+
+    return !outBuffer.isEmpty();
+}
+
+void GzipReadDevice::releaseStream()
+{
+    FCT_IDENTIFICATION;
+
+    if ( !strm )
+        return;
+
+    inflateEnd(strm);
+    delete strm;
+    strm = nullptr;
+}
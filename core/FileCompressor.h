@@ -3,9 +3,13 @@
 
 #include <QString>
 #include <QByteArray>
+#include <QIODevice>
+#include <QScopedPointer>
 #include <functional>
 
 class QWidget;
+class QFile;
+struct z_stream_s;
 
 class FileCompressor
 {
@@ -19,10 +23,19 @@ public:
     // Decompress gzip data (in-memory)
     static QByteArray gunzip(const QByteArray &in);
 
-    // Compress file using gzip (streaming)
+    // Compress file using gzip (streaming); larger files are compressed by gzipFileParallel
     static bool gzipFile(const QString &sourceFile, const QString &destFile,
                          const ProgressCallback &progress = nullptr);
 
+    // Compress file using gzip on several threads (pigz-style).
+    // The file is split into fixed-size blocks which are deflated independently,
+    // each primed with the last 32 kB of the previous block as a dictionary.
+    // The result is one standard gzip member; progress is reported per block.
+    // threads <= 0 means QThread::idealThreadCount()
+    static bool gzipFileParallel(const QString &sourceFile, const QString &destFile,
+                                 const ProgressCallback &progress = nullptr,
+                                 int threads = 0);
+
     // Decompress gzip file (streaming)
     static bool gunzipFile(const QString &sourceFile, const QString &destFile,
                            const ProgressCallback &progress = nullptr);
@@ -34,4 +47,56 @@ public:
                                        QWidget *parent, const QString &title);
 };
 
+// Read-only sequential device decompressing a gzip stream on the fly.
+// It can be passed to QTextStream/QXmlStreamReader instead of the file itself,
+// so a compressed file is read without expanding it to a temporary file.
+// The decompressed data are read ahead in blocks; the position in the compressed
+// input is available for progress reporting. Concatenated gzip members are supported.
+class GzipReadDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    // the source device is not owned; it is opened read-only if it is not open
+    explicit GzipReadDevice(QIODevice *source, QObject *parent = nullptr);
+    explicit GzipReadDevice(const QString &fileName, QObject *parent = nullptr);
+    virtual ~GzipReadDevice();
+
+    virtual bool open(OpenMode mode) override;
+    virtual void close() override;
+    virtual bool isSequential() const override { return true; }
+    virtual bool atEnd() const override;
+    virtual qint64 bytesAvailable() const override;
+
+    // bytes of the compressed input consumed by the decompressor
+    qint64 compressedPosition() const;
+    qint64 compressedSize() const;
+
+    // gzip magic bytes at the beginning of the file
+    static bool isGzipFile(const QString &fileName);
+
+protected:
+    virtual qint64 readData(char *data, qint64 maxSize) override;
+    virtual qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    static const int INPUT_BUFFER_SIZE = 64 * 1024;
+    static const int OUTPUT_BUFFER_SIZE = 256 * 1024;
+
+    bool fillBuffer();
+    void releaseStream();
+
+    QScopedPointer<QFile> ownedFile;
+    QIODevice *source;
+    z_stream_s *strm = nullptr;
+    QByteArray inBuffer;
+    QByteArray outBuffer;
+    int outPos = 0;
+    qint64 compressedRead = 0;
+    int membersFinished = 0;
+    bool inMember = false;
+    bool finished = false;
+    bool failed = false;
+};
+
 #endif // QLOG_CORE_FILECOMPRESSOR_H
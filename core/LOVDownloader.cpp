@@ -22,6 +22,7 @@
 #include "data/Data.h"
 #include "core/csv.hpp"
 #include "core/FileCompressor.h"
+#include "core/SQLBulkLoad.h"
 
 MODULE_IDENTIFICATION("qlog.core.lovdownloader");
 
@@ -212,6 +213,9 @@ void LOVDownloader::parseCTY(const SourceDefinition &sourceDef, QTextStream &dat
 
     QRegularExpressionMatch matchExp;
 
+    // PRAGMAs cannot be changed inside the transaction
+    SQLBulkLoad bulkLoad;
+
     QSqlDatabase::database().transaction();
 
     if ( ! deleteTable("dxcc_prefixes_ad1c") )
@@ -368,6 +372,7 @@ void LOVDownloader::parseCTY(const SourceDefinition &sourceDef, QTextStream &dat
     {
         qCDebug(runtime) << "DXCC update finished:" << count << "entities loaded.";
         QSqlDatabase::database().commit();
+        Data::instance()->reloadDxccIndex();
     }
     else
     {
@@ -468,6 +473,9 @@ bool LOVDownloader::parseCSVGeneric(const SourceDefinition &sourceDef,
         return false;
     }
 
+    // PRAGMAs cannot be changed inside the transaction
+    SQLBulkLoad bulkLoad;
+
     QSqlDatabase::database().transaction();
 
     if ( !deleteTable(sourceDef.tableName) )
@@ -1037,6 +1045,7 @@ void LOVDownloader::parseClubLogCTY(const SourceDefinition &sourceDef, QTextStre
 
     QSqlDatabase::database().commit();
     qCDebug(runtime) << "ClubLog CTY import finished.";
+    Data::instance()->reloadDxccIndex();
 }
 
 void LOVDownloader::processReply(QNetworkReply *reply)
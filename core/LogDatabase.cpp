@@ -5,6 +5,8 @@
 #include <QSqlQuery>
 #include <QCoreApplication>
 #include <QUuid>
+#include <QThread>
+#include <QThreadStorage>
 
 #include <QStandardPaths>
 #include <QFile>
@@ -16,6 +18,7 @@
 #include "core/LogParam.h"
 #include "core/CredentialStore.h"
 #include "core/PlatformParameterManager.h"
+#include "core/SQLTuning.h"
 
 MODULE_IDENTIFICATION("qlog.core.logdatabase");
 
@@ -47,6 +50,27 @@ QString LogDatabase::currentPlatformId()
 #endif
 }
 
+// The thread-local part of the read-only connection pool; QThreadStorage
+// deletes it when its thread exits and the connection is removed with it
+class ReadOnlyConnection
+{
+public:
+    explicit ReadOnlyConnection(const QString &name) :
+        connectionName(name) {}
+
+    ~ReadOnlyConnection()
+    {
+        qCDebug(runtime) << "Removing read-only connection" << connectionName;
+
+        QSqlDatabase::database(connectionName, false).close();
+        QSqlDatabase::removeDatabase(connectionName);
+    }
+
+    const QString connectionName;
+};
+
+static QThreadStorage<ReadOnlyConnection *> readOnlyConnections;
+
 LogDatabase::LogDatabase()
 {
     FCT_IDENTIFICATION;
@@ -57,11 +81,11 @@ bool LogDatabase::hadPasswordImportWarning() const
     return passwordImportWarning;
 }
 
-bool LogDatabase::createSQLFunctions()
+bool LogDatabase::createSQLFunctions(const QSqlDatabase &db)
 {
     FCT_IDENTIFICATION;
 
-    QVariant v = QSqlDatabase::database().driver()->handle();
+    QVariant v = db.driver()->handle();
 
     if ( !v.isValid()
          || qstrcmp(v.typeName(), "sqlite3*") != 0 )
@@ -125,6 +149,44 @@ bool LogDatabase::createSQLFunctions()
     return true;
 }
 
+QSqlDatabase LogDatabase::readOnlyConnection()
+{
+    FCT_IDENTIFICATION;
+
+    if ( QCoreApplication::instance()
+         && QThread::currentThread() == QCoreApplication::instance()->thread() )
+        return QSqlDatabase::database();
+
+    if ( readOnlyConnections.hasLocalData() )
+        return QSqlDatabase::database(readOnlyConnections.localData()->connectionName);
+
+    const QString connectionName = QString("readonly_%1")
+                                   .arg(reinterpret_cast<quintptr>(QThread::currentThread()));
+
+    qCDebug(runtime) << "Opening read-only connection" << connectionName;
+
+    readOnlyConnections.setLocalData(new ReadOnlyConnection(connectionName));
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    db.setDatabaseName(dbFilename());
+    db.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_ENABLE_REGEXP;QSQLITE_BUSY_TIMEOUT=5000");
+
+    if ( !db.open() )
+    {
+        qWarning() << "Cannot open read-only connection" << db.lastError();
+        return db;
+    }
+
+    // read-only - only the cache and the memory mapping of the profile matter
+    if ( !SQLTuning::apply(SQLTuning::configuredProfile(), db) )
+        qCWarning(runtime) << "Cannot apply the database tuning profile to" << connectionName;
+
+    if ( !createSQLFunctions(db) )
+        qCWarning(runtime) << "Cannot create SQL functions for" << connectionName;
+
+    return db;
+}
+
 bool LogDatabase::atomicCopy(const QString &filename)
 {
     FCT_IDENTIFICATION;
@@ -261,6 +323,10 @@ bool LogDatabase::openDatabase()
         qCDebug(runtime) << "Pragma result:" << pragma;
     }
 
+    // a failed PRAGMA leaves the SQLite default - not fatal
+    if ( !SQLTuning::apply(SQLTuning::configuredProfile(), db) )
+        qWarning() << "Cannot apply the database tuning profile";
+
     return createSQLFunctions();
 }
 
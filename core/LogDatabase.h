@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QDir>
+#include <QSqlDatabase>
 
 struct DatabaseInfo
 {
@@ -53,7 +54,13 @@ public:
     bool atomicCopy(const QString &filename);
     bool openDatabase();
     bool schemaVersionUpgrade(bool force = false);
-    bool createSQLFunctions();
+    bool createSQLFunctions(const QSqlDatabase &db = QSqlDatabase::database());
+
+    // Read-only connection of the calling thread for heavy readers (statistics, awards, exports).
+    // The connection is opened on the first call in the thread and removed when the thread exits;
+    // WAL readers run concurrently with the writer on the main connection.
+    // The main thread gets the main connection.
+    QSqlDatabase readOnlyConnection();
 
 private:
     LogDatabase();
@@ -48,6 +48,26 @@ QDate LogParam::getLastBackupDate()
     return getParam("last_backup").toDate();
 }
 
+bool LogParam::setBackupFormat(const QString &format)
+{
+    return setParam("backup/format", format);
+}
+
+QString LogParam::getBackupFormat()
+{
+    return getParam("backup/format", "database").toString();
+}
+
+bool LogParam::setBackupCompressed(bool state)
+{
+    return setParam("backup/compress", state);
+}
+
+bool LogParam::getBackupCompressed()
+{
+    return getParam("backup/compress", true).toBool();
+}
+
 bool LogParam::setLogID(const QString &id)
 {
     return setParam("logid", id);
@@ -30,6 +30,10 @@ public:
      ********/
     static bool setLastBackupDate(const QDate date);
     static QDate getLastBackupDate();
+    static bool setBackupFormat(const QString &format);
+    static QString getBackupFormat();
+    static bool setBackupCompressed(bool state);
+    static bool getBackupCompressed();
 
     /*********
      * LogID
@@ -13,6 +13,7 @@
 #include "logformat/AdxFormat.h"
 #include "ui/DxWidget.h"
 #include "core/LogDatabase.h"
+#include "core/DatabaseBackup.h"
 
 MODULE_IDENTIFICATION("qlog.core.migration");
 
@@ -40,7 +41,8 @@ bool DBSchemaMigration::run(bool force)
     }
 
     qCDebug(runtime) << "Backup before migration";
-    backupAllQSOsToADX(true);
+    if ( !DatabaseBackup::instance()->backupNow(currentVersion) )
+        qWarning() << "Backup before migration failed";
 
     qCDebug(runtime) << "Starting database migration";
 
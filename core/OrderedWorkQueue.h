@@ -0,0 +1,106 @@
+#ifndef QLOG_CORE_ORDEREDWORKQUEUE_H
+#define QLOG_CORE_ORDEREDWORKQUEUE_H
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QMap>
+#include <QPair>
+
+// Hand-over between the stages of a pipeline that has to keep the input order
+// (ADIF import, export, gzip compression).
+// The producer pushes numbered items, any number of workers take them in any
+// order and the consumer receives the results back in the producer order.
+// The number of items between the producer and the consumer is limited,
+// so a slow consumer (e.g. the import waiting for the duplicate dialog) stops
+// the producer instead of buffering the whole file.
+template<typename Item>
+class OrderedWorkQueue
+{
+public:
+    explicit OrderedWorkQueue(int maxInFlight) :
+        maxInFlight(qMax(1, maxInFlight)) {}
+
+    // producer
+    void pushInput(const Item &item)
+    {
+        QMutexLocker locker(&mutex);
+
+        while ( inFlight >= maxInFlight )
+            slotAvailable.wait(&mutex);
+
+        input.enqueue(qMakePair(inputCount++, item));
+        inFlight++;
+        inputAvailable.wakeOne();
+    }
+
+    void finishInput()
+    {
+        QMutexLocker locker(&mutex);
+
+        inputFinished = true;
+        inputAvailable.wakeAll();
+        resultAvailable.wakeAll();
+    }
+
+    // workers - false when the producer is finished and nothing is left
+    bool takeInput(quint64 &seq, Item &item)
+    {
+        QMutexLocker locker(&mutex);
+
+        while ( input.isEmpty() && !inputFinished )
+            inputAvailable.wait(&mutex);
+
+        if ( input.isEmpty() )
+            return false;
+
+        const QPair<quint64, Item> next = input.dequeue();
+        seq = next.first;
+        item = next.second;
+        return true;
+    }
+
+    void pushResult(quint64 seq, const Item &item)
+    {
+        QMutexLocker locker(&mutex);
+
+        results.insert(seq, item);
+
+        if ( seq == resultCount )
+            resultAvailable.wakeAll();
+    }
+
+    // consumer - false when the results of all items have been taken
+    bool takeResult(Item &item)
+    {
+        QMutexLocker locker(&mutex);
+
+        while ( !results.contains(resultCount) )
+        {
+            if ( inputFinished && resultCount >= inputCount )
+                return false;
+
+            resultAvailable.wait(&mutex);
+        }
+
+        item = results.take(resultCount++);
+        inFlight--;
+        slotAvailable.wakeOne();
+        return true;
+    }
+
+private:
+    QMutex mutex;
+    QWaitCondition inputAvailable;
+    QWaitCondition resultAvailable;
+    QWaitCondition slotAvailable;
+    QQueue<QPair<quint64, Item>> input;
+    QMap<quint64, Item> results;
+    const int maxInFlight;
+    int inFlight = 0;
+    quint64 inputCount = 0;
+    quint64 resultCount = 0;
+    bool inputFinished = false;
+};
+
+#endif // QLOG_CORE_ORDEREDWORKQUEUE_H
@@ -0,0 +1,191 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include "SQLBulkLoad.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.core.sqlbulkload");
+
+SQLBulkLoad::SQLBulkLoad(const QSqlDatabase &db, int cacheSizeKiB) :
+    db(db)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << cacheSizeKiB;
+
+    origSettings = SQLTuning::currentSettings(this->db);
+
+    SQLTuning::Settings bulkSettings = SQLTuning::profileSettings(SQLTuning::BULK_LOAD);
+    bulkSettings.cacheSizeKiB = qAbs(cacheSizeKiB);
+
+    SQLTuning::apply(bulkSettings, this->db);
+
+    qCDebug(runtime) << "Bulk load started; original cache_size" << origSettings.cacheSizeKiB
+                     << "KiB temp_store" << origSettings.tempStore;
+}
+
+SQLBulkLoad::~SQLBulkLoad()
+{
+    FCT_IDENTIFICATION;
+
+    // the owner did not finish the load (e.g. an error path)
+    if ( !suspendedTriggers.isEmpty() )
+        resumeTriggers();
+
+    SQLTuning::apply(origSettings, db);
+}
+
+bool SQLBulkLoad::suspendTrigger(const QString &name)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << name;
+
+    QSqlQuery query(db);
+
+    if ( !query.prepare("SELECT sql FROM sqlite_master WHERE type = 'trigger' AND name = :name") )
+    {
+        qWarning() << "Cannot prepare trigger statement" << query.lastError();
+        return false;
+    }
+
+    query.bindValue(":name", name);
+
+    if ( !query.exec() )
+    {
+        qWarning() << "Cannot get trigger definition" << name << query.lastError();
+        return false;
+    }
+
+    if ( !query.next() )
+    {
+        // nothing to suspend
+        qCDebug(runtime) << "Trigger does not exist" << name;
+        return true;
+    }
+
+    const QString createStatement = query.value(0).toString();
+
+    if ( !query.exec(QString("DROP TRIGGER \"%1\"").arg(name)) )
+    {
+        qWarning() << "Cannot suspend trigger" << name << query.lastError();
+        return false;
+    }
+
+    suspendedTriggers.append(qMakePair(name, createStatement));
+    return true;
+}
+
+bool SQLBulkLoad::resumeTriggers()
+{
+    FCT_IDENTIFICATION;
+
+    QSqlQuery existsQuery(db);
+    QSqlQuery query(db);
+    bool ret = true;
+
+    if ( !existsQuery.prepare("SELECT 1 FROM sqlite_master WHERE type = 'trigger' AND name = :name") )
+    {
+        qWarning() << "Cannot prepare trigger statement" << existsQuery.lastError();
+        return false;
+    }
+
+    while ( !suspendedTriggers.isEmpty() )
+    {
+        const QPair<QString, QString> trigger = suspendedTriggers.takeLast();
+
+        // a rollback has already restored it
+        existsQuery.bindValue(":name", trigger.first);
+
+        if ( existsQuery.exec() && existsQuery.next() )
+            continue;
+
+        if ( !query.exec(trigger.second) )
+        {
+            qWarning() << "Cannot recreate trigger" << trigger.first << query.lastError();
+            ret = false;
+        }
+    }
+
+    return ret;
+}
+
+bool SQLBulkLoad::suspendContactTriggers()
+{
+    FCT_IDENTIFICATION;
+
+    // update_contacts_upload_status is AFTER UPDATE only - inserts do not fire it
+    return suspendTrigger("insert_contacts_autovalue");
+}
+
+void SQLBulkLoad::addInsertedContacts(qulonglong firstId, qulonglong lastId)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << firstId << lastId;
+
+    if ( firstId == 0 || lastId < firstId )
+        return;
+
+    // chunks are usually inserted one after another
+    if ( !insertedContactRanges.isEmpty()
+         && insertedContactRanges.last().second + 1 == firstId )
+    {
+        insertedContactRanges.last().second = lastId;
+        return;
+    }
+
+    insertedContactRanges.append(qMakePair(firstId, lastId));
+}
+
+bool SQLBulkLoad::finishContacts()
+{
+    FCT_IDENTIFICATION;
+
+    const bool applied = applyContactsAutovalue();
+    const bool resumed = resumeTriggers();
+
+    return applied && resumed;
+}
+
+bool SQLBulkLoad::applyContactsAutovalue()
+{
+    FCT_IDENTIFICATION;
+
+    if ( insertedContactRanges.isEmpty() )
+        return true;
+
+    // the same base callsign computation as the insert_contacts_autovalue trigger
+    QSqlQuery query(db);
+
+    if ( !query.prepare("INSERT OR REPLACE INTO contacts_autovalue (contactid, base_callsign) "
+                        "SELECT c.id, (WITH tokenizedCallsign(word, csv) AS ( SELECT '', c.callsign||'/' "
+                        "                                                 UNION ALL "
+                        "                                                 SELECT substr(csv, 0, instr(csv, '/')), substr(csv, instr(csv, '/') + 1) "
+                        "                                                 FROM tokenizedCallsign "
+                        "                                                 WHERE csv != '' ) "
+                        "              SELECT word FROM tokenizedCallsign "
+                        "              WHERE word != '' and word REGEXP '^([A-Z][0-9]|[A-Z]{1,2}|[0-9][A-Z])([0-9]|[0-9]+)([A-Z]+)$' LIMIT 1) "
+                        "FROM contacts c "
+                        "WHERE c.id BETWEEN :firstId AND :lastId") )
+    {
+        qWarning() << "Cannot prepare contacts_autovalue statement" << query.lastError();
+        return false;
+    }
+
+    for ( const QPair<qulonglong, qulonglong> &range : insertedContactRanges )
+    {
+        query.bindValue(":firstId", range.first);
+        query.bindValue(":lastId", range.second);
+
+        if ( !query.exec() )
+        {
+            qWarning() << "Cannot fill contacts_autovalue" << query.lastError();
+            return false;
+        }
+
+        qCDebug(runtime) << "contacts_autovalue filled for" << range.first << "-" << range.second;
+    }
+
+    insertedContactRanges.clear();
+    return true;
+}
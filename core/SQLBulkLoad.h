@@ -0,0 +1,50 @@
+#ifndef QLOG_CORE_SQLBULKLOAD_H
+#define QLOG_CORE_SQLBULKLOAD_H
+
+#include <QSqlDatabase>
+#include <QVariant>
+#include <QList>
+#include <QPair>
+#include "core/SQLTuning.h"
+
+// Bulk-load mode for large inserts (ADIF import, LOV downloads).
+//
+// The object switches the connection to the BULK_LOAD tuning profile for its lifetime
+// and restores the original settings in the destructor. The PRAGMAs cannot be changed
+// inside a transaction, therefore the object must be created before the transaction
+// is started and destroyed after it is committed.
+//
+// Inside the transaction, the per-row contacts triggers can be suspended. Their work is
+// applied by set-based statements over the inserted id ranges in finishContacts().
+// The triggers are dropped and recreated in the same transaction, so a rollback
+// restores them as well.
+class SQLBulkLoad
+{
+public:
+    // rows bound by one execBatch call
+    static const int CHUNK_SIZE = 500;
+
+    explicit SQLBulkLoad(const QSqlDatabase &db = QSqlDatabase::database(),
+                         int cacheSizeKiB = 64 * 1024);
+    ~SQLBulkLoad();
+
+    bool suspendTrigger(const QString &name);
+    bool resumeTriggers();
+
+    // suspends insert_contacts_autovalue
+    bool suspendContactTriggers();
+    void addInsertedContacts(qulonglong firstId, qulonglong lastId);
+
+    // fills contacts_autovalue for the inserted ranges and recreates the triggers
+    bool finishContacts();
+
+private:
+    bool applyContactsAutovalue();
+
+    QSqlDatabase db;
+    SQLTuning::Settings origSettings;
+    QList<QPair<QString, QString>> suspendedTriggers;           // name, create statement
+    QList<QPair<qulonglong, qulonglong>> insertedContactRanges; // first id, last id
+};
+
+#endif // QLOG_CORE_SQLBULKLOAD_H
@@ -0,0 +1,155 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSettings>
+#include "SQLTuning.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.core.sqltuning");
+
+SQLTuning::Settings SQLTuning::profileSettings(Profile profile)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << profile;
+
+    Settings settings;
+
+    switch ( profile )
+    {
+    case INTERACTIVE:
+        settings.synchronous = 2;
+        settings.cacheSizeKiB = 32 * 1024;
+        settings.mmapSize = 256 * 1024 * 1024;
+        settings.tempStore = 2;
+        settings.walAutocheckpoint = 1000;
+        break;
+
+    case BULK_LOAD:
+        settings.synchronous = 1;
+        settings.cacheSizeKiB = 64 * 1024;
+        settings.mmapSize = 256 * 1024 * 1024;
+        settings.tempStore = 2;
+        settings.walAutocheckpoint = 10000;
+        break;
+
+    case LOW_MEMORY:
+        settings.synchronous = 2;
+        settings.cacheSizeKiB = 2000;
+        settings.mmapSize = 0;
+        settings.tempStore = 1;
+        settings.walAutocheckpoint = 1000;
+        break;
+    }
+
+    return settings;
+}
+
+QString SQLTuning::profileName(Profile profile)
+{
+    switch ( profile )
+    {
+    case INTERACTIVE:
+        return QStringLiteral("interactive");
+    case BULK_LOAD:
+        return QStringLiteral("bulk_load");
+    case LOW_MEMORY:
+        return QStringLiteral("low_memory");
+    }
+
+    return QString();
+}
+
+SQLTuning::Profile SQLTuning::profileFromName(const QString &name, Profile defaultProfile)
+{
+    if ( name == profileName(INTERACTIVE) )
+        return INTERACTIVE;
+
+    if ( name == profileName(BULK_LOAD) )
+        return BULK_LOAD;
+
+    if ( name == profileName(LOW_MEMORY) )
+        return LOW_MEMORY;
+
+    return defaultProfile;
+}
+
+SQLTuning::Profile SQLTuning::configuredProfile()
+{
+    FCT_IDENTIFICATION;
+
+    QSettings settings; //platform-dependent, must be present
+
+    return profileFromName(settings.value("database/tuning_profile").toString());
+}
+
+SQLTuning::Settings SQLTuning::currentSettings(const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    Settings settings;
+    QSqlQuery query(db);
+
+    if ( query.exec("PRAGMA synchronous") && query.next() )
+        settings.synchronous = query.value(0).toInt();
+
+    // negative value = size in KiB, positive = pages
+    if ( query.exec("PRAGMA cache_size") && query.next() )
+    {
+        const qint64 cacheSize = query.value(0).toLongLong();
+
+        if ( cacheSize < 0 )
+            settings.cacheSizeKiB = -cacheSize;
+        else if ( query.exec("PRAGMA page_size") && query.next() )
+            settings.cacheSizeKiB = cacheSize * query.value(0).toLongLong() / 1024;
+    }
+
+    if ( query.exec("PRAGMA mmap_size") && query.next() )
+        settings.mmapSize = query.value(0).toLongLong();
+
+    if ( query.exec("PRAGMA temp_store") && query.next() )
+        settings.tempStore = query.value(0).toInt();
+
+    if ( query.exec("PRAGMA wal_autocheckpoint") && query.next() )
+        settings.walAutocheckpoint = query.value(0).toInt();
+
+    return settings;
+}
+
+bool SQLTuning::apply(const Settings &settings, const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << settings.synchronous << settings.cacheSizeKiB << settings.mmapSize
+                                 << settings.tempStore << settings.walAutocheckpoint;
+
+    QSqlQuery query(db);
+    bool ret = true;
+
+    const QStringList statements = {
+        QString("PRAGMA synchronous = %1").arg(settings.synchronous),
+        QString("PRAGMA cache_size = %1").arg(-qAbs(settings.cacheSizeKiB)),
+        QString("PRAGMA mmap_size = %1").arg(settings.mmapSize),
+        QString("PRAGMA temp_store = %1").arg(settings.tempStore),
+        QString("PRAGMA wal_autocheckpoint = %1").arg(settings.walAutocheckpoint)
+    };
+
+    for ( const QString &statement : statements )
+    {
+        if ( !query.exec(statement) )
+        {
+            qCWarning(runtime) << "Cannot execute" << statement << query.lastError().text();
+            ret = false;
+        }
+    }
+
+    return ret;
+}
+
+bool SQLTuning::apply(Profile profile, const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(runtime) << "Applying tuning profile" << profileName(profile);
+
+    return apply(profileSettings(profile), db);
+}
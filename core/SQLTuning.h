@@ -0,0 +1,58 @@
+#ifndef QLOG_CORE_SQLTUNING_H
+#define QLOG_CORE_SQLTUNING_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+// Named sets of the per-connection SQLite PRAGMAs.
+//
+// INTERACTIVE - the default for the main connection; WAL with synchronous=FULL,
+//               a bigger page cache and memory-mapped reads for a large log.
+// BULK_LOAD   - used by SQLBulkLoad around large inserts; synchronous=NORMAL,
+//               a bigger cache and rarer WAL checkpoints.
+// LOW_MEMORY  - SQLite defaults for the cache, no memory mapping; for small machines.
+//
+// The profiles of the main connection keep synchronous=FULL, the durability QLog
+// has always used, until the benchmark shows what NORMAL gains for a log. With
+// NORMAL in WAL mode the database stays consistent, but an OS crash or a power
+// loss can roll back the last commits before the checkpoint. BULK_LOAD accepts
+// that for the duration of a large import.
+// mmap_size is an upper limit - SQLite maps only the existing part of the file, so
+// 256 MiB covers the whole file of a log with a few hundred thousand QSOs without
+// reserving memory for small logs. SQLite falls back to read() when the mapping fails.
+//
+// tests/SQLTuningBenchmark compares the profiles with the SQLite defaults
+// (QLOG_RUN_SQL_TUNING_BENCHMARK=1). synchronous cannot be changed inside
+// a transaction, therefore a profile must be applied outside of it.
+class SQLTuning
+{
+public:
+    enum Profile
+    {
+        INTERACTIVE,
+        BULK_LOAD,
+        LOW_MEMORY
+    };
+
+    struct Settings
+    {
+        int synchronous = 2;            // 0 = OFF, 1 = NORMAL, 2 = FULL
+        qint64 cacheSizeKiB = 2000;
+        qint64 mmapSize = 0;            // bytes
+        int tempStore = 0;              // 0 = DEFAULT, 1 = FILE, 2 = MEMORY
+        int walAutocheckpoint = 1000;   // pages
+    };
+
+    static Settings profileSettings(Profile profile);
+    static QString profileName(Profile profile);
+    static Profile profileFromName(const QString &name, Profile defaultProfile = INTERACTIVE);
+
+    // the profile selected for the main connection (QSettings database/tuning_profile)
+    static Profile configuredProfile();
+
+    static Settings currentSettings(const QSqlDatabase &db = QSqlDatabase::database());
+    static bool apply(const Settings &settings, const QSqlDatabase &db = QSqlDatabase::database());
+    static bool apply(Profile profile, const QSqlDatabase &db = QSqlDatabase::database());
+};
+
+#endif // QLOG_CORE_SQLTUNING_H
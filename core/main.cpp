@@ -26,6 +26,8 @@
 #include "data/Data.h"
 #include "service/GenericCallbook.h"
 #include "core/LogDatabase.h"
+#include "core/DatabaseBackup.h"
+#include "core/DBTaskExecutor.h"
 
 MODULE_IDENTIFICATION("qlog.core.main");
 
@@ -471,17 +473,7 @@ int main(int argc, char* argv[])
             return 1;
         }
 
-        splash.showMessage(QObject::tr("Backuping Database"), Qt::AlignBottom|Qt::AlignCenter);
-
-        QCoreApplication::processEvents();
-
-        /* a migration can break a database therefore a backup is call before it */
-        if (!DBSchemaMigration::backupAllQSOsToADX())
-        {
-            QMessageBox::critical(nullptr, QMessageBox::tr("QLog Error"),
-                                  QMessageBox::tr("Could not export a QLog database to ADIF as a backup.<p>Try to export your log to ADIF manually"));
-        }
-
+        /* a migration can break a database therefore the migration makes a backup before it */
         splash.showMessage(QObject::tr("Migrating Database"), Qt::AlignBottom|Qt::AlignCenter);
 
         QCoreApplication::processEvents();
@@ -492,6 +484,16 @@ int main(int argc, char* argv[])
                                   QMessageBox::tr("Database migration failed."));
             return 1;
         }
+
+        /* the periodic backup runs in the background - the startup does not wait for it */
+        QObject::connect(DatabaseBackup::instance(), &DatabaseBackup::backupFinished,
+                         [](bool success, const QString &)
+        {
+            if ( !success )
+                QMessageBox::critical(nullptr, QMessageBox::tr("QLog Error"),
+                                      QMessageBox::tr("Could not back up the QLog database.<p>Try to export your log to ADIF manually"));
+        });
+        DatabaseBackup::instance()->startPeriodicBackup();
     }
 
     splash.showMessage(QObject::tr("Starting Application"), Qt::AlignBottom|Qt::AlignCenter);
@@ -522,6 +524,8 @@ int main(int argc, char* argv[])
         rc = app.exec();
     }
 
+    DatabaseBackup::instance()->stop();
+    DBTaskExecutor::instance()->stop();
     stopWorkerThread(cwKeyerThreadHandle, "CWKeyer");
     stopWorkerThread(rotThreadHandle, "Rotator");
     stopWorkerThread(rigThreadHandle, "Rig");
@@ -13289,7 +13289,7 @@ const int Data::tranlitIndexMap[] = {
 
 QString Data::removeAccents(const QString &input)
 {
-    FCT_IDENTIFICATION;
+    // Hot path - no FCT_IDENTIFICATION here
 
     // Based on iconv algorithm.
     // However, I don't want to use iconv here, because the library is too complex for what I actually need
@@ -13297,6 +13297,22 @@ QString Data::removeAccents(const QString &input)
     if ( input.isEmpty() )
         return QString();
 
+    // the common case - printable ASCII is returned unchanged without a copy
+    bool printableASCII = true;
+    for ( const QChar &character : input )
+    {
+        const char16_t charInt = character.unicode();
+
+        if ( ( charInt < 32 && charInt != '\r' && charInt != '\n' ) || charInt >= 128 )
+        {
+            printableASCII = false;
+            break;
+        }
+    }
+
+    if ( printableASCII )
+        return input;
+
     QString ret;
     for ( const QChar &character : input )
     {
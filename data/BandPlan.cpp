@@ -1,5 +1,7 @@
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QReadWriteLock>
+#include <algorithm>
 
 #include "BandPlan.h"
 #include "core/debug.h"
@@ -263,80 +265,179 @@ const QString BandPlan::freq2ExpectedMode(const double freq, QString &submode)
     return bandPlanMode2ExpectedMode(freq2BandMode(freq), submode);
 }
 
-const Band BandPlan::freq2Band(double freq)
+namespace
 {
-    FCT_IDENTIFICATION;
+// In-memory copy of the bands and modes tables. It is loaded on the first use
+// and dropped by BandPlan::invalidateCache() when the tables are edited.
+struct BandPlanCache
+{
+    struct Entry
+    {
+        Band band;
+        qint64 startHz;
+        qint64 endHz;
+        qint64 maxEndHz;    // max endHz of this and all previous entries
+        int id;
+        bool enabled;
+    };
+
+    bool loaded = false;
+    QVector<Entry> entries;              // ordered by start_freq
+    QHash<QString, int> nameIndex;       // band name -> entries index
+    QHash<QString, QString> modeGroups;  // mode name -> DXCC mode group
+};
 
-    qCDebug(function_parameters) << freq;
+BandPlanCache bandPlanCache;
+QReadWriteLock bandPlanCacheLock;
 
+bool loadBandPlanCache(BandPlanCache &cache)
+{
     QSqlQuery query;
 
-    if ( ! query.prepare("SELECT name, start_freq, end_freq, sat_designator "
-                         "FROM bands "
-                         "WHERE :freq_hz BETWEEN "
-                         "CAST(ROUND(start_freq * 1000000.0) AS INTEGER) AND "
-                         "CAST(ROUND(end_freq * 1000000.0) AS INTEGER)") )
+    if ( ! query.exec("SELECT id, name, start_freq, end_freq, sat_designator, enabled "
+                      "FROM bands") )
     {
-        qWarning() << "Cannot prepare Select statement";
-        return Band();
+        qWarning() << "Cannot execute select statement" << query.lastError();
+        return false;
     }
 
-    query.bindValue(0, MHz2Hz(freq));
+    QVector<BandPlanCache::Entry> entries;
 
-    if ( ! query.exec() )
+    while ( query.next() )
     {
-        qWarning() << "Cannot execute select statement" << query.lastError();
-        return Band();
+        BandPlanCache::Entry entry;
+        entry.id = query.value(0).toInt();
+        entry.band.name = query.value(1).toString();
+        entry.band.start = query.value(2).toDouble();
+        entry.band.end = query.value(3).toDouble();
+        entry.band.satDesignator = query.value(4).toString();
+        entry.enabled = query.value(5).toBool();
+        entry.startHz = MHz2Hz(entry.band.start);
+        entry.endHz = MHz2Hz(entry.band.end);
+        entry.maxEndHz = entry.endHz;
+        entries << entry;
     }
 
-    if ( query.next() )
+    std::sort(entries.begin(), entries.end(),
+              [](const BandPlanCache::Entry &a, const BandPlanCache::Entry &b)
     {
-        Band band;
-        band.name = query.value(0).toString();
-        band.start = query.value(1).toDouble();
-        band.end = query.value(2).toDouble();
-        band.satDesignator  = query.value(3).toString();
-        return band;
+        return ( a.band.start != b.band.start ) ? a.band.start < b.band.start
+                                                : a.id < b.id;
+    });
+
+    for ( int i = 1; i < entries.size(); ++i )
+        entries[i].maxEndHz = qMax(entries.at(i).endHz, entries.at(i - 1).maxEndHz);
+
+    QHash<QString, int> nameIndex;
+
+    for ( int i = 0; i < entries.size(); ++i )
+        nameIndex.insert(entries.at(i).band.name, i);
+
+    if ( ! query.exec("SELECT name, dxcc FROM modes") )
+    {
+        qWarning() << "Cannot execute select statement" << query.lastError();
+        return false;
     }
 
-    return Band();
+    QHash<QString, QString> modeGroups;
+
+    while ( query.next() )
+        modeGroups.insert(query.value(0).toString(), query.value(1).toString());
+
+    cache.entries = entries;
+    cache.nameIndex = nameIndex;
+    cache.modeGroups = modeGroups;
+    cache.loaded = true;
+
+    qCDebug(runtime) << "Band plan cache loaded:" << entries.size() << "bands,"
+                     << modeGroups.size() << "modes";
+    return true;
 }
 
-const Band BandPlan::bandName2Band(const QString &name)
+// returns with bandPlanCacheLock locked for reading; false if the cache cannot be loaded
+bool lockBandPlanCache()
+{
+    bandPlanCacheLock.lockForRead();
+
+    if ( bandPlanCache.loaded )
+        return true;
+
+    bandPlanCacheLock.unlock();
+
+    QWriteLocker writeLocker(&bandPlanCacheLock);
+
+    // another thread may have loaded it in the meantime
+    if ( !bandPlanCache.loaded && !loadBandPlanCache(bandPlanCache) )
+        return false;
+
+    writeLocker.unlock();
+    bandPlanCacheLock.lockForRead();
+
+    if ( bandPlanCache.loaded )
+        return true;
+
+    // invalidated between unlock and lock - the next call loads it again
+    bandPlanCacheLock.unlock();
+    return false;
+}
+}
+
+void BandPlan::invalidateCache()
 {
     FCT_IDENTIFICATION;
 
-    qCDebug(function_parameters) << name;
+    QWriteLocker locker(&bandPlanCacheLock);
+    bandPlanCache = BandPlanCache();
+}
 
-    QSqlQuery query;
+const Band BandPlan::freq2Band(double freq)
+{
+    // Hot path - no FCT_IDENTIFICATION here
 
-    if ( ! query.prepare("SELECT name, start_freq, end_freq, sat_designator "
-                       "FROM bands "
-                       "WHERE name = :name LIMIT 1") )
-    {
-        qWarning() << "Cannot prepare Select statement";
+    if ( !lockBandPlanCache() )
         return Band();
-    }
 
-    query.bindValue(0, name.toLower());
+    const qint64 freqHz = MHz2Hz(freq);
+    const QVector<BandPlanCache::Entry> &entries = bandPlanCache.entries;
 
-    if ( ! query.exec() )
+    // the first entry starting above the frequency
+    auto it = std::upper_bound(entries.cbegin(), entries.cend(), freqHz,
+                               [](qint64 value, const BandPlanCache::Entry &entry)
     {
-        qWarning() << "Cannot execute select statement" << query.lastError();
-        return Band();
-    }
+        return value < entry.startHz;
+    });
+
+    // the bands can overlap - the previous entries are checked as long as any of them
+    // can still reach the frequency. The lowest ID wins, as in the table order.
+    const BandPlanCache::Entry *found = nullptr;
 
-    if ( query.next() )
+    while ( it != entries.cbegin() )
     {
-        Band band;
-        band.name = query.value(0).toString();
-        band.start = query.value(1).toDouble();
-        band.end = query.value(2).toDouble();
-        band.satDesignator  = query.value(3).toString();
-        return band;
+        --it;
+
+        if ( it->maxEndHz < freqHz )
+            break;
+
+        if ( it->endHz >= freqHz && ( !found || it->id < found->id ) )
+            found = &(*it);
     }
 
-    return Band();
+    const Band ret = ( found ) ? found->band : Band();
+    bandPlanCacheLock.unlock();
+    return ret;
+}
+
+const Band BandPlan::bandName2Band(const QString &name)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( !lockBandPlanCache() )
+        return Band();
+
+    const int index = bandPlanCache.nameIndex.value(name.toLower(), -1);
+    const Band ret = ( index >= 0 ) ? bandPlanCache.entries.at(index).band : Band();
+    bandPlanCacheLock.unlock();
+    return ret;
 }
 
 const QList<Band> BandPlan::bandsList(const bool onlyDXCCBands,
@@ -346,92 +447,57 @@ const QList<Band> BandPlan::bandsList(const bool onlyDXCCBands,
 
     qCDebug(function_parameters) << onlyDXCCBands << onlyEnabled;
 
-    QSqlQuery query;
+    // a frequency from every DXCC Challenge band
+    static const double dxccBandFreqs[] = {1.9, 3.6, 7.1, 10.1, 14.1, 18.1, 21.1, 24.9, 28.1,
+                                           50.1, 145.1, 421.1, 1241.0, 2301.0, 10001.0};
     QList<Band> ret;
 
-    QString stmt(QLatin1String("SELECT name, start_freq, end_freq, sat_designator "
-                               "FROM bands WHERE 1 = 1 "));
-
-    if ( onlyEnabled )
-        stmt.append("AND enabled = 1 ");
-
-    if ( onlyDXCCBands )
-    {
-        stmt.append("AND ((1.9 between start_freq and end_freq) "
-                    "      OR (3.6 between start_freq and end_freq) "
-                    "      OR (7.1 between start_freq and end_freq) "
-                    "      OR (10.1 between start_freq and end_freq) "
-                    "      OR (14.1 between start_freq and end_freq) "
-                    "      OR (18.1 between start_freq and end_freq) "
-                    "      OR (21.1 between start_freq and end_freq) "
-                    "      OR (24.9 between start_freq and end_freq) "
-                    "      OR (28.1 between start_freq and end_freq) "
-                    "      OR (50.1 between start_freq and end_freq) "
-                    "      OR (145.1 between start_freq and end_freq) "
-                    "      OR (421.1 between start_freq and end_freq) "
-                    "      OR (1241.0 between start_freq and end_freq) "
-                    "      OR (2301.0 between start_freq and end_freq) "
-                    "      OR (10001.0 between start_freq and end_freq)) ");
-    }
-
-    stmt.append("ORDER BY start_freq ");
-
-    qCDebug(runtime) << stmt;
-
-    if ( ! query.prepare(stmt) )
-    {
-        qWarning() << "Cannot prepare Select statement";
+    if ( !lockBandPlanCache() )
         return ret;
-    }
 
-    if ( ! query.exec() )
-    {
-        qWarning() << "Cannot execute select statement" << query.lastError();
-        return ret;
-    }
+    const QVector<BandPlanCache::Entry> &entries = bandPlanCache.entries;
 
-    while ( query.next() )
+    for ( const BandPlanCache::Entry &entry : entries )
     {
-        Band band;
-        band.name = query.value(0).toString();
-        band.start = query.value(1).toDouble();
-        band.end = query.value(2).toDouble();
-        band.satDesignator = query.value(3).toString();
-        ret << band;
+        if ( onlyEnabled && !entry.enabled )
+            continue;
+
+        if ( onlyDXCCBands )
+        {
+            bool isDXCCBand = false;
+
+            for ( double dxccFreq : dxccBandFreqs )
+            {
+                if ( dxccFreq >= entry.band.start && dxccFreq <= entry.band.end )
+                {
+                    isDXCCBand = true;
+                    break;
+                }
+            }
+
+            if ( !isDXCCBand )
+                continue;
+        }
+
+        ret << entry.band;
     }
 
+    bandPlanCacheLock.unlock();
     return ret;
 }
 
 const QString BandPlan::modeToDXCCModeGroup(const QString &mode)
 {
-    FCT_IDENTIFICATION;
-
-    qCDebug(function_parameters) << mode;
+    // Hot path - no FCT_IDENTIFICATION here
 
     if ( mode.isEmpty() ) return QString();
 
-    QSqlQuery query;
-
-    if ( !query.prepare("SELECT modes.dxcc "
-                        "FROM modes "
-                        "WHERE modes.name = :mode LIMIT 1"))
-    {
-        qWarning() << "Cannot prepare Select statement";
+    if ( !lockBandPlanCache() )
         return QString();
-    }
-
-    query.bindValue(0, mode);
-
-    if ( query.exec() )
-    {
-        QString ret;
-        query.next();
-        ret = query.value(0).toString();
-        return ret;
-    }
 
-    return QString();
+    const QString ret = bandPlanCache.modeGroups.value(mode);
+    bandPlanCacheLock.unlock();
+    return ret;
 }
 
 const QString BandPlan::modeToModeGroup(const QString &mode)
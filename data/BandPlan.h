@@ -47,6 +47,9 @@ public:
                                        const bool onlyEnabled = false);
     static const QString modeToDXCCModeGroup(const QString &mode);
     static const QString modeToModeGroup(const QString &mode);
+    // drops the in-memory copy of the bands and modes tables; it must be called
+    // when the tables are changed
+    static void invalidateCache();
     static bool isFTxMode(const QString &mode);
     static bool isFTxBandMode(BandPlanMode mode);
     BandPlan();
@@ -38,7 +38,10 @@ Callsign::Callsign(const QString &callsign,
 const QRegularExpression Callsign::callsignRegEx()
 {
     FCT_IDENTIFICATION;
-    return QRegularExpression(callsignRegExString(), QRegularExpression::CaseInsensitiveOption);
+
+    // compile the pattern only once; QRegularExpression is implicitly shared
+    static const QRegularExpression callsignRE(callsignRegExString(), QRegularExpression::CaseInsensitiveOption);
+    return callsignRE;
 }
 
 const QString Callsign::callsignRegExString()
@@ -103,6 +106,29 @@ const QString Callsign::getSuffixWithDelimiter() const
     return suffixWithDelimiter;
 }
 
+const QString Callsign::getDXCCLookupPrefix() const
+{
+    FCT_IDENTIFICATION;
+
+    if ( !isValid() )
+        return QString();
+
+    if ( suffix.length() == 1 ) // some countries add single numbers as suffix to designate a call area, e.g. /4
+    {
+        bool isNumber = false;
+        (void)suffix.toInt(&isNumber);
+        if ( isNumber )
+            return basePrefix + suffix; // use the call prefix and the number from the suffix to find the dxcc
+    }
+    else if ( suffix.length() > 1
+              && !secondarySpecialSuffixes.contains(suffix) ) // if there is more than one character and it is not one of the special suffixes, we definitely have a call prefix as suffix
+    {
+        return suffix;
+    }
+
+    return fullCallsign; // use the callsign with optional prefix as default to find the dxcc
+}
+
 const QString Callsign::getWPXPrefix() const
 {
     FCT_IDENTIFICATION;
@@ -23,6 +23,7 @@ public:
     const QString getSuffix() const;
     const QString getSuffixWithDelimiter() const;
     const QString getWPXPrefix() const;
+    const QString getDXCCLookupPrefix() const;
     bool isValid() const;
 
 private:
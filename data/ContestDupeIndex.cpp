@@ -0,0 +1,191 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include "ContestDupeIndex.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.contestdupeindex");
+
+QString ContestDupeIndex::selectStatement()
+{
+    return QLatin1String("SELECT c.callsign, c.band, m.dxcc "
+                         "FROM contacts c "
+                         "     INNER JOIN modes m ON (m.name = c.mode) "
+                         "WHERE c.contest_id = :contestid "
+                         "      AND datetime(c.start_time) >= datetime(:date)");
+}
+
+bool ContestDupeIndex::load(const QString &contestID,
+                            const QDateTime &dupeStartTime,
+                            const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << contestID << dupeStartTime;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+
+    QSqlQuery query(db);
+
+    if ( !query.exec(QLatin1String("SELECT name, dxcc FROM modes")) )
+    {
+        qCWarning(runtime) << "Cannot load mode groups" << query.lastError();
+        clear();
+        return false;
+    }
+
+    while ( query.next() )
+        modeGroups.insert(query.value(0).toString(), query.value(1).toString());
+
+    if ( !query.prepare(selectStatement()) )
+    {
+        qCWarning(runtime) << "Cannot prepare Select statement" << query.lastError();
+        clear();
+        return false;
+    }
+
+    query.bindValue(":contestid", contestID);
+    query.bindValue(":date", dupeStartTime);
+
+    if ( !query.exec() )
+    {
+        qCWarning(runtime) << "Cannot execute Select statement" << query.lastError();
+        clear();
+        return false;
+    }
+
+    qulonglong qsos = 0;
+
+    while ( query.next() )
+    {
+        apply(query.value(0).toString(), query.value(1).toString(), query.value(2).toString(), 1);
+        qsos++;
+    }
+
+    activeContestID = contestID;
+    activeDupeStartTime = dupeStartTime;
+    loaded = true;
+
+    qCDebug(runtime) << "Contest dupe index loaded:" << qsos << "QSOs,"
+                     << callsigns.size() << "callsigns in" << timer.elapsed() << "ms";
+    return true;
+}
+
+void ContestDupeIndex::clear()
+{
+    FCT_IDENTIFICATION;
+
+    loaded = false;
+    activeContestID.clear();
+    activeDupeStartTime = QDateTime();
+    modeGroups.clear();
+    callsigns.clear();
+}
+
+void ContestDupeIndex::updateContact(const QSqlRecord &oldRecord, const QSqlRecord &newRecord)
+{
+    FCT_IDENTIFICATION;
+
+    removeContact(oldRecord);
+    addContact(newRecord);
+}
+
+qulonglong ContestDupeIndex::count(const QString &callsign) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    const auto callIt = callsigns.constFind(callsign);
+    return ( callIt != callsigns.constEnd() ) ? callIt->total : 0ULL;
+}
+
+qulonglong ContestDupeIndex::count(const QString &callsign, const QString &band) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    const auto callIt = callsigns.constFind(callsign);
+
+    if ( callIt == callsigns.constEnd() )
+        return 0ULL;
+
+    const auto bandIt = callIt->bands.constFind(band);
+    return ( bandIt != callIt->bands.constEnd() ) ? bandIt->total : 0ULL;
+}
+
+qulonglong ContestDupeIndex::count(const QString &callsign,
+                                   const QString &band,
+                                   const QString &modeGroup) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    const auto callIt = callsigns.constFind(callsign);
+
+    if ( callIt == callsigns.constEnd() )
+        return 0ULL;
+
+    const auto bandIt = callIt->bands.constFind(band);
+    return ( bandIt != callIt->bands.constEnd() ) ? bandIt->modes.value(modeGroup, 0ULL) : 0ULL;
+}
+
+void ContestDupeIndex::addCount(qulonglong &counter, int delta)
+{
+    if ( delta < 0 && counter < static_cast<qulonglong>(-delta) )
+    {
+        qCDebug(runtime) << "Counter underflow" << counter << delta;
+        counter = 0;
+        return;
+    }
+    counter += delta;
+}
+
+void ContestDupeIndex::apply(const QString &callsign,
+                             const QString &band,
+                             const QString &modeGroup,
+                             int delta)
+{
+    if ( delta < 0 && !callsigns.contains(callsign) )
+        return;
+
+    CallsignCounters &callCounters = callsigns[callsign];
+    addCount(callCounters.total, delta);
+
+    BandCounters &bandCounters = callCounters.bands[band];
+    addCount(bandCounters.total, delta);
+    addCount(bandCounters.modes[modeGroup], delta);
+
+    // do not keep empty entries for deleted QSOs
+    if ( bandCounters.modes.value(modeGroup) == 0 )
+        bandCounters.modes.remove(modeGroup);
+
+    if ( bandCounters.total == 0 )
+        callCounters.bands.remove(band);
+
+    if ( callCounters.total == 0 )
+        callsigns.remove(callsign);
+}
+
+void ContestDupeIndex::applyContact(const QSqlRecord &record, int delta)
+{
+    FCT_IDENTIFICATION;
+
+    if ( !loaded )
+        return;
+
+    if ( record.value("contest_id").toString() != activeContestID )
+        return;
+
+    const QDateTime &startTime = record.value("start_time").toDateTime();
+
+    if ( !startTime.isValid() || startTime < activeDupeStartTime )
+        return;
+
+    const auto modeIt = modeGroups.constFind(record.value("mode").toString());
+
+    // the mode is not in the modes table - not counted
+    if ( modeIt == modeGroups.constEnd() )
+        return;
+
+    apply(record.value("callsign").toString(), record.value("band").toString(), modeIt.value(), delta);
+}
@@ -0,0 +1,70 @@
+#ifndef QLOG_DATA_CONTESTDUPEINDEX_H
+#define QLOG_DATA_CONTESTDUPEINDEX_H
+
+#include <QHash>
+#include <QDateTime>
+#include <QSqlDatabase>
+#include <QSqlRecord>
+
+// In-memory QSO counters used to answer Data::countDupe without querying
+// the contacts table. The index is built for one contest ID and one dupe
+// start date and keeps the number of contest QSOs per callsign, per
+// callsign x band and per callsign x band x DXCC mode group.
+// Only QSOs whose mode is in the modes table are counted - the same as
+// the former SQL statement with INNER JOIN modes.
+class ContestDupeIndex
+{
+public:
+    bool load(const QString &contestID,
+              const QDateTime &dupeStartTime,
+              const QSqlDatabase &db = QSqlDatabase::database());
+    void clear();
+    bool isLoaded() const { return loaded; }
+    bool isLoadedFor(const QString &contestID, const QDateTime &dupeStartTime) const
+    {
+        return loaded && contestID == activeContestID && dupeStartTime == activeDupeStartTime;
+    }
+
+    void addContact(const QSqlRecord &record) { applyContact(record, 1); }
+    void removeContact(const QSqlRecord &record) { applyContact(record, -1); }
+    void updateContact(const QSqlRecord &oldRecord, const QSqlRecord &newRecord);
+
+    // number of contest QSOs with the callsign - on any band, on the band,
+    // on the band in the DXCC mode group (CW, PHONE, DIGITAL)
+    qulonglong count(const QString &callsign) const;
+    qulonglong count(const QString &callsign, const QString &band) const;
+    qulonglong count(const QString &callsign, const QString &band, const QString &modeGroup) const;
+
+    // returns the DXCC mode group for the mode name; an empty string if it is unknown
+    QString modeGroup(const QString &mode) const { return modeGroups.value(mode); }
+
+    // the statement of the contest QSOs (:contestid, :date);
+    // tests/QueryPlanTest checks its query plan
+    static QString selectStatement();
+
+private:
+    struct BandCounters
+    {
+        qulonglong total = 0;
+        QHash<QString, qulonglong> modes;    // DXCC mode group -> QSO count
+    };
+
+    struct CallsignCounters
+    {
+        qulonglong total = 0;
+        QHash<QString, BandCounters> bands;
+    };
+
+    static void addCount(qulonglong &counter, int delta);
+
+    void apply(const QString &callsign, const QString &band, const QString &modeGroup, int delta);
+    void applyContact(const QSqlRecord &record, int delta);
+
+    bool loaded = false;
+    QString activeContestID;
+    QDateTime activeDupeStartTime;
+    QHash<QString, QString> modeGroups;    // mode name -> DXCC mode group
+    QHash<QString, CallsignCounters> callsigns;
+};
+
+#endif // QLOG_DATA_CONTESTDUPEINDEX_H
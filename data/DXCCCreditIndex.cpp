@@ -0,0 +1,273 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <algorithm>
+#include "DXCCCreditIndex.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.dxcccreditindex");
+
+bool DXCCCreditIndex::load(const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+
+    QSqlQuery query(db);
+
+    // date and mode group are evaluated by SQLite to get the same values as the former statement
+    if ( !query.exec(QLatin1String("SELECT id, callsign, band, mode, start_time, prop_mode, credit_granted, "
+                                   "       date(start_time), dxcc, my_dxcc, "
+                                   "       (SELECT dxcc FROM modes WHERE upper(name) = upper(contacts.mode) LIMIT 1) "
+                                   "FROM contacts "
+                                   "ORDER BY start_time, id")) )
+    {
+        qCWarning(runtime) << "Cannot load contacts" << query.lastError();
+        clear();
+        return false;
+    }
+
+    while ( query.next() )
+    {
+        const QDate qsoDate = QDate::fromString(query.value(7).toString(), Qt::ISODate);
+
+        // no date - it cannot match any credit
+        if ( !qsoDate.isValid() )
+            continue;
+
+        Entry entry;
+        entry.id = query.value(0).toULongLong();
+        entry.callsign = query.value(1).toString();
+        entry.band = query.value(2).toString();
+        entry.mode = query.value(3).toString();
+        entry.startTime = query.value(4).toDateTime();
+        entry.propMode = query.value(5).toString();
+        entry.creditGranted = query.value(6).toString();
+        entry.upperCallsign = entry.callsign.toUpper();
+        entry.upperBand = entry.band.toUpper();
+        entry.upperMode = entry.mode.toUpper();
+        entry.upperPropMode = entry.propMode.toUpper();
+        entry.modeGroup = query.value(10).toString();
+        entry.day = qsoDate.toJulianDay();
+        entry.hasDxcc = !query.value(8).isNull();
+        entry.dxcc = query.value(8).toInt();
+        entry.hasMyDxcc = !query.value(9).isNull();
+        entry.myDxcc = query.value(9).toInt();
+
+        const int pos = contacts.size();
+        contacts.append(entry);
+
+        allContacts.append(pos);
+        callGroups[entry.callsign].append(pos);
+        upperCallGroups[entry.upperCallsign].append(pos);
+
+        if ( entry.hasDxcc )
+        {
+            dxccGroups[dxccKey(entry.dxcc)].append(pos);
+            dxccGroups[dxccKey(entry.dxcc, entry.upperBand)].append(pos);
+        }
+    }
+
+    // start_time order is not guaranteed to be the date order (time zones in the stored values)
+    auto sortGroup = [this](Group &group)
+    {
+        std::sort(group.begin(), group.end(), [this](int a, int b)
+        {
+            const qint64 dayA = contacts.at(a).day;
+            const qint64 dayB = contacts.at(b).day;
+            return ( dayA != dayB ) ? dayA < dayB : a < b;
+        });
+    };
+
+    sortGroup(allContacts);
+
+    for ( auto it = dxccGroups.begin(); it != dxccGroups.end(); ++it )
+        sortGroup(it.value());
+
+    for ( auto it = callGroups.begin(); it != callGroups.end(); ++it )
+        sortGroup(it.value());
+
+    for ( auto it = upperCallGroups.begin(); it != upperCallGroups.end(); ++it )
+        sortGroup(it.value());
+
+    loaded = true;
+
+    qCDebug(runtime) << "DXCC credit index loaded:" << contacts.size() << "QSOs,"
+                     << dxccGroups.size() << "DXCC groups in" << timer.elapsed() << "ms";
+    return true;
+}
+
+void DXCCCreditIndex::clear()
+{
+    FCT_IDENTIFICATION;
+
+    loaded = false;
+    contacts.clear();
+    allContacts.clear();
+    dxccGroups.clear();
+    callGroups.clear();
+    upperCallGroups.clear();
+}
+
+QList<int> DXCCCreditIndex::select(const Credit &credit,
+                                   CallMatch callMatch,
+                                   bool matchMode) const
+{
+    FCT_IDENTIFICATION;
+
+    QList<int> positions;
+
+    if ( !credit.qsoDate.isValid() )
+        return positions;
+
+    const qint64 firstDay = credit.qsoDate.toJulianDay() - 1;
+    const qint64 lastDay = credit.qsoDate.toJulianDay() + 1;
+
+    if ( !credit.dxcc.isEmpty() )
+    {
+        bool ok = false;
+        const int dxcc = credit.dxcc.toInt(&ok);
+
+        if ( !ok )
+            return positions;
+
+        collect(dxccGroups.value(dxccKey(dxcc, credit.band.toUpper())), firstDay, lastDay, positions);
+    }
+    else if ( callMatch == EXACT_CALL_MATCH )
+    {
+        collect(callGroups.value(credit.call.toUpper()), firstDay, lastDay, positions);
+    }
+    else if ( callMatch == PREFIX_CALL_MATCH )
+    {
+        const QString prefix = credit.call.toUpper();
+
+        for ( auto it = upperCallGroups.lowerBound(prefix);
+              it != upperCallGroups.constEnd() && it.key().startsWith(prefix);
+              ++it )
+            collect(it.value(), firstDay, lastDay, positions);
+    }
+    else
+    {
+        collect(allContacts, firstDay, lastDay, positions);
+    }
+
+    QList<int> ret;
+
+    for ( int pos : static_cast<const QList<int>&>(positions) )
+    {
+        if ( matches(contacts.at(pos), credit, callMatch, matchMode) )
+            ret << pos;
+    }
+
+    // the positions follow the load order, i.e. start_time, id
+    std::sort(ret.begin(), ret.end());
+
+    return ret;
+}
+
+void DXCCCreditIndex::setCreditGranted(int pos, const QString &value)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << pos << value;
+
+    if ( pos < 0 || pos >= contacts.size() )
+        return;
+
+    contacts[pos].creditGranted = value;
+}
+
+QString DXCCCreditIndex::dxccKey(int dxcc, const QString &upperBand)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    return ( upperBand.isEmpty() ) ? QString::number(dxcc)
+                                   : QString::number(dxcc) + QLatin1Char('|') + upperBand;
+}
+
+void DXCCCreditIndex::collect(const Group &group,
+                              qint64 firstDay,
+                              qint64 lastDay,
+                              QList<int> &positions) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    auto it = std::lower_bound(group.constBegin(), group.constEnd(), firstDay,
+                               [this](int pos, qint64 day)
+    {
+        return contacts.at(pos).day < day;
+    });
+
+    for ( ; it != group.constEnd() && contacts.at(*it).day <= lastDay; ++it )
+        positions << *it;
+}
+
+bool DXCCCreditIndex::matches(const Entry &entry,
+                              const Credit &credit,
+                              CallMatch callMatch,
+                              bool matchMode) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( !credit.band.isEmpty() && entry.upperBand != credit.band.toUpper() )
+        return false;
+
+    if ( !credit.propMode.isEmpty() )
+    {
+        if ( entry.upperPropMode != credit.propMode.toUpper() )
+            return false;
+    }
+    else if ( entry.upperPropMode == QLatin1String("SAT") )
+    {
+        // LoTW reports satellite credits with PROP_MODE=SAT/DXCC_SATELLITE.
+        // Keep normal DXCC credits from matching satellite QSOs by date/call/band.
+        return false;
+    }
+
+    if ( !credit.dxcc.isEmpty() && ( !entry.hasDxcc || entry.dxcc != credit.dxcc.toInt() ) )
+        return false;
+
+    if ( !credit.awardEntity.isEmpty() )
+    {
+        bool ok = false;
+        const int awardEntity = credit.awardEntity.toInt(&ok);
+
+        if ( !ok || !entry.hasMyDxcc || entry.myDxcc != awardEntity )
+            return false;
+    }
+
+    switch ( callMatch )
+    {
+    case EXACT_CALL_MATCH:
+        if ( entry.callsign != credit.call.toUpper() )
+            return false;
+        break;
+
+    case PREFIX_CALL_MATCH:
+        if ( !entry.upperCallsign.startsWith(credit.call.toUpper()) )
+            return false;
+        break;
+
+    case NO_CALL_MATCH:
+        break;
+    }
+
+    if ( matchMode )
+    {
+        if ( !credit.dxccModeGroup.isEmpty() )
+        {
+            if ( entry.modeGroup != credit.dxccModeGroup
+                 && ( credit.mode.isEmpty() || entry.upperMode != credit.mode.toUpper() ) )
+                return false;
+        }
+        else if ( !credit.mode.isEmpty() && entry.upperMode != credit.mode.toUpper() )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
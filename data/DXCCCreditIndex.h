@@ -0,0 +1,108 @@
+#ifndef QLOG_DATA_DXCCCREDITINDEX_H
+#define QLOG_DATA_DXCCCREDITINDEX_H
+
+#include <QHash>
+#include <QMap>
+#include <QVector>
+#include <QDateTime>
+#include <QSqlDatabase>
+
+// In-memory index of the contacts table used by the LoTW DXCC credit import.
+// The whole log is read by one scan; QSOs are grouped by DXCC and by DXCC/band
+// (and by callsign for credits without DXCC) and every group keeps its QSOs
+// sorted by the QSO date, so the +-1 day window is found by a binary search.
+// The mode group is not a part of the key because a credit is matched
+// without the mode when no QSO matches with it.
+// The matching rules are the same as the former SQL statement:
+//   ABS(JULIANDAY(date(start_time)) - JULIANDAY(date(:qso_date))) <= 1,
+//   upper(band) = upper(:band), upper(prop_mode) = upper(:prop_mode) or
+//   prop_mode is not SAT, dxcc = :dxcc, my_dxcc = :award_entity,
+//   callsign = upper(:call) or upper(callsign) LIKE upper(:call)%,
+//   mode group = :dxcc_mode_group or upper(mode) = upper(:mode);
+// the result is ordered by start_time, id
+class DXCCCreditIndex
+{
+public:
+    enum CallMatch
+    {
+        NO_CALL_MATCH,
+        EXACT_CALL_MATCH,
+        PREFIX_CALL_MATCH
+    };
+
+    struct Contact
+    {
+        qulonglong id = 0;
+        QString callsign;
+        QString band;
+        QString mode;
+        QDateTime startTime;
+        QString propMode;
+        QString creditGranted;
+    };
+
+    // empty values are not used for matching
+    struct Credit
+    {
+        QDate qsoDate;
+        QString call;
+        QString band;
+        QString propMode;
+        QString dxcc;
+        QString awardEntity;
+        QString mode;
+        QString dxccModeGroup;
+    };
+
+    bool load(const QSqlDatabase &db = QSqlDatabase::database());
+    void clear();
+    bool isLoaded() const { return loaded; }
+
+    // positions of the matching QSOs ordered by start_time, id
+    QList<int> select(const Credit &credit,
+                      CallMatch callMatch,
+                      bool matchMode) const;
+
+    const Contact &contact(int pos) const { return contacts.at(pos); }
+
+    // keeps the index in sync with a written credit_granted
+    void setCreditGranted(int pos, const QString &value);
+
+    int size() const { return contacts.size(); }
+
+private:
+    struct Entry : public Contact
+    {
+        QString upperCallsign;
+        QString upperBand;
+        QString upperMode;
+        QString upperPropMode;
+        QString modeGroup;
+        qint64 day = 0;             // Julian day of date(start_time)
+        int dxcc = 0;
+        int myDxcc = 0;
+        bool hasDxcc = false;
+        bool hasMyDxcc = false;
+    };
+
+    using Group = QVector<int>;     // positions sorted by day, position
+
+    static QString dxccKey(int dxcc, const QString &upperBand = QString());
+    void collect(const Group &group,
+                 qint64 firstDay,
+                 qint64 lastDay,
+                 QList<int> &positions) const;
+    bool matches(const Entry &entry,
+                 const Credit &credit,
+                 CallMatch callMatch,
+                 bool matchMode) const;
+
+    bool loaded = false;
+    QVector<Entry> contacts;
+    Group allContacts;
+    QHash<QString, Group> dxccGroups;
+    QHash<QString, Group> callGroups;           // stored callsign
+    QMap<QString, Group> upperCallGroups;       // upper(callsign) - ordered for the prefix match
+};
+
+#endif // QLOG_DATA_DXCCCREDITINDEX_H
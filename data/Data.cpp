@@ -229,7 +229,8 @@ Data::Data(QObject *parent) :
    QObject(parent),
    showDxccFlags(LogParam::getShowDxccFlags()),
    zd(nullptr),
-   isDXCCQueryValid(false)
+   isDXCCQueryValid(false),
+   dxccAD1CCache(1000)
 {
     FCT_IDENTIFICATION;
 
@@ -239,10 +240,6 @@ Data::Data(QObject *parent) :
     loadLegacyModes();
     loadDxccFlags();
     loadSatModes();
-    loadIOTA();
-    loadSOTA();
-    loadWWFF();
-    loadPOTA();
     loadTZ();
 
 
@@ -365,6 +362,8 @@ Data::Data(QObject *parent) :
                 "FROM wwff_directory "
                 "WHERE reference = :reference"
                 );
+
+    reloadDxccIndex();
 }
 
 Data::~Data()
@@ -377,129 +376,50 @@ Data::~Data()
     }
 }
 
-#define RETCODE(a)  \
-    dxccStatusCache.insert(dxcc, myDXCC, band, mode, new DxccStatus(a)); \
-    return ((a));
-
 DxccStatus Data::dxccStatus(int dxcc, const QString &band, const QString &mode)
 {
     FCT_IDENTIFICATION;
 
     qCDebug(function_parameters) << dxcc << " " << band << " " << mode;
 
-    const int myDXCC = StationProfilesManager::instance()->getCurProfile1().dxcc;
-
-    DxccStatus *statusFromCache = dxccStatusCache.value(dxcc, myDXCC, band, mode);
+    if ( !dxccStatusMatrix.isLoaded() && !dxccStatusMatrix.load() )
+    {
+        qWarning() << "Cannot load DXCC Status Matrix";
+        return DxccStatus::UnknownStatus;
+    }
 
-    if ( statusFromCache )
-        return *statusFromCache;
+    const int myDXCC = StationProfilesManager::instance()->getCurProfile1().dxcc;
 
     // FTx modes (FT8, FT4, FT2) are stored in contacts with modes.dxcc = 'DIGITAL',
     // so we use DIGITAL as the effective mode group when querying for FTx.
-    const QString modeForQuery = ( mode == BandPlan::MODE_GROUP_STRING_FTx )
-                                 ? BandPlan::MODE_GROUP_STRING_DIGITAL
-                                 : mode;
+    QString modeGroup = ( mode == BandPlan::MODE_GROUP_STRING_FTx )
+                        ? BandPlan::MODE_GROUP_STRING_DIGITAL
+                        : mode;
 
-    QString sql_mode(":mode");
-
-    if ( modeForQuery != BandPlan::MODE_GROUP_STRING_CW
-         && modeForQuery != BandPlan::MODE_GROUP_STRING_PHONE
-         && modeForQuery != BandPlan::MODE_GROUP_STRING_DIGITAL )
+    if ( modeGroup != BandPlan::MODE_GROUP_STRING_CW
+         && modeGroup != BandPlan::MODE_GROUP_STRING_PHONE
+         && modeGroup != BandPlan::MODE_GROUP_STRING_DIGITAL )
     {
-        sql_mode = "(SELECT modes.dxcc FROM modes WHERE modes.name = :mode LIMIT 1) ";
+        modeGroup = dxccStatusMatrix.modeGroup(modeGroup);
     }
 
-
-    QStringList dxccConfirmedByCond(QLatin1String("0=1")); // if no option is selected then always false
+    int confirmedBy = 0; // if no option is selected then always false
 
     if ( LogParam::getDxccConfirmedByLotwState() )
-        dxccConfirmedByCond << QLatin1String("all_dxcc_qsos.lotw_qsl_rcvd = 'Y'");
+        confirmedBy |= DxccStatusMatrix::CONFIRMED_BY_LOTW;
 
     if ( LogParam::getDxccConfirmedByPaperState() )
-        dxccConfirmedByCond << QLatin1String("all_dxcc_qsos.qsl_rcvd = 'Y'");
+        confirmedBy |= DxccStatusMatrix::CONFIRMED_BY_PAPER;
 
     if ( LogParam::getDxccConfirmedByEqslState() )
-        dxccConfirmedByCond << QLatin1String("all_dxcc_qsos.eqsl_qsl_rcvd = 'Y'");
-
-    QSqlQuery query;
-    QString sqlStatement = QString("WITH all_dxcc_qsos AS (SELECT DISTINCT contacts.mode, contacts.band, "
-                                         "                                       contacts.qsl_rcvd, contacts.lotw_qsl_rcvd, contacts.eqsl_qsl_rcvd "
-                                         "                       FROM contacts "
-                                         "                       WHERE dxcc = :dxcc %1) "
-                                         "  SELECT (SELECT 1 FROM all_dxcc_qsos LIMIT 1) as entity,"
-                                         "         (SELECT 1 FROM all_dxcc_qsos WHERE band = :band LIMIT 1) as band, "
-                                         "         (SELECT 1 FROM all_dxcc_qsos INNER JOIN modes ON (modes.name = all_dxcc_qsos.mode) "
-                                         "          WHERE modes.dxcc = %2 LIMIT 1) as mode, "
-                                         "         (SELECT 1 FROM all_dxcc_qsos INNER JOIN modes ON (modes.name = all_dxcc_qsos.mode) "
-                                         "          WHERE modes.dxcc = %3 AND all_dxcc_qsos.band = :band LIMIT 1) as slot, "
-                                         "         (SELECT 1 FROM all_dxcc_qsos INNER JOIN modes ON (modes.name = all_dxcc_qsos.mode) "
-                                         "          WHERE modes.dxcc = %4 AND all_dxcc_qsos.band = :band "
-                                         "                AND (%5) LIMIT 1) as confirmed")
-                                         .arg(( myDXCC != 0 ) ? QString(" AND my_dxcc = %1").arg(myDXCC)
-                                                                    : "",
-                                              sql_mode,
-                                              sql_mode,
-                                              sql_mode,
-                                              dxccConfirmedByCond.join(" OR "));
-
-    if ( ! query.prepare(sqlStatement) )
-    {
-        qWarning() << "Cannot prepare Select statement";
-        return DxccStatus::UnknownStatus;
-    }
-
-    query.bindValue(":dxcc", dxcc);
-    query.bindValue(":band", band);
-    query.bindValue(":mode", modeForQuery);
-
-    if ( ! query.exec() )
-    {
-        qWarning() << "Cannot execute Select statement" << query.lastError();
-        return DxccStatus::UnknownStatus;
-    }
-
-    if ( query.next() )
-    {
-        if ( query.value(0).toString().isEmpty() )
-        {
-            RETCODE(DxccStatus::NewEntity);
-        }
-
-        if ( query.value(1).toString().isEmpty() )
-        {
-            if ( query.value(2).toString().isEmpty() )
-            {
-                RETCODE(DxccStatus::NewBandMode);
-            }
-            else
-            {
-                RETCODE(DxccStatus::NewBand);
-            }
-        }
+        confirmedBy |= DxccStatusMatrix::CONFIRMED_BY_EQSL;
 
-        if ( query.value(2).toString().isEmpty() )
-        {
-            RETCODE(DxccStatus::NewMode);
-        }
-
-        if ( query.value(3).toString().isEmpty() )
-        {
-            RETCODE(DxccStatus::NewSlot);
-        }
+    const DxccStatus status = dxccStatusMatrix.status(dxcc, myDXCC, band, modeGroup, confirmedBy);
 
-        if ( query.value(4).toString().isEmpty() )
-        {
-            RETCODE(DxccStatus::Worked);
-        }
-        else
-        {
-            RETCODE(DxccStatus::Confirmed);
-        }
-    }
+    qCDebug(runtime) << "Status:" << status;
 
-    RETCODE(DxccStatus::UnknownStatus);
+    return status;
 }
-#undef RETCODE
 
 QStringList Data::contestList()
 {
@@ -931,6 +851,31 @@ QString Data::getIANATimeZone(double lat, double lon)
     return ret;
 }
 
+void Data::reloadDxccIndex()
+{
+    FCT_IDENTIFICATION;
+
+    // CTY can be reloaded by LOVDownloader; cached results may be obsolete
+    dxccAD1CCache.clear();
+
+    // the new snapshot is fully built before it is published;
+    // readers holding the previous one continue to use it
+    const DxccSnapshot::Ptr snapshot = DxccSnapshot::create();
+
+    QMutexLocker locker(&dxccSnapshotLock);
+    currentDxccSnapshot = snapshot;
+}
+
+DxccSnapshot::Ptr Data::dxccSnapshot() const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    // the lock protects only the pointer copy; lookups on the returned
+    // snapshot do not need any lock
+    QMutexLocker locker(&dxccSnapshotLock);
+    return currentDxccSnapshot;
+}
+
 QStringList Data::sigIDList()
 {
     FCT_IDENTIFICATION;
@@ -948,24 +893,130 @@ void Data::invalidateDXCCStatusCache(const QSqlRecord &record)
 {
     FCT_IDENTIFICATION;
 
-    dxccStatusCache.invalidate(record.value("dxcc").toInt(), StationProfilesManager::instance()->getCurProfile1().dxcc);
+    // the record has just been inserted
+    dxccStatusMatrix.addContact(record);
 }
 
 void Data::invalidateSetOfDXCCStatusCache(const QSet<uint> &entities)
 {
     FCT_IDENTIFICATION;
 
-    int myDXCC = StationProfilesManager::instance()->getCurProfile1().dxcc;
+    // the deleted records are not known here; the affected entities are aggregated again
+    if ( !dxccStatusMatrix.reloadEntities(entities) )
+        qWarning() << "Cannot reload DXCC Status Matrix for entities" << entities;
+}
 
-    for ( uint entity : entities )
-       dxccStatusCache.invalidate(entity, myDXCC);
+void Data::updateDXCCStatusCache(const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    // the record is going to be updated; the current values are still in DB
+    if ( !dxccStatusMatrix.isLoaded() )
+        return;
+
+    QSqlQuery query;
+
+    if ( !query.prepare(QLatin1String("SELECT my_dxcc, dxcc, band, mode, lotw_qsl_rcvd, qsl_rcvd, eqsl_qsl_rcvd "
+                                      "FROM contacts WHERE id = :id")) )
+    {
+        qWarning() << "Cannot prepare Select statement" << query.lastError();
+        dxccStatusMatrix.clear();
+        return;
+    }
+
+    query.bindValue(":id", record.value("id"));
+
+    if ( !query.exec() )
+    {
+        qWarning() << "Cannot execute Select statement" << query.lastError();
+        dxccStatusMatrix.clear();
+        return;
+    }
+
+    if ( query.next() )
+        dxccStatusMatrix.updateContact(query.record(), record);
+}
+
+void Data::updateDXCCStatusCacheContact(const QSqlRecord &oldRecord, const QSqlRecord &newRecord)
+{
+    FCT_IDENTIFICATION;
+
+    // the caller keeps the current values (e.g. updates written later in a batch);
+    // the cache must be loaded before the first deferred change
+    if ( !dxccStatusMatrix.isLoaded() && !dxccStatusMatrix.load() )
+    {
+        qWarning() << "Cannot load DXCC Status Matrix";
+        return;
+    }
+
+    dxccStatusMatrix.updateContact(oldRecord, newRecord);
 }
 
 void Data::clearDXCCStatusCache()
 {
     FCT_IDENTIFICATION;
 
-    dxccStatusCache.clear();
+    // it is loaded again when needed
+    dxccStatusMatrix.clear();
+}
+
+void Data::updateDupeIndexWhenQSOAdded(const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    QMutexLocker locker(&contestDupeIndexLock);
+    contestDupeIndex.addContact(record);
+}
+
+void Data::updateDupeIndexWhenQSODeleted(const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    QMutexLocker locker(&contestDupeIndexLock);
+    contestDupeIndex.removeContact(record);
+}
+
+void Data::updateDupeIndexWhenQSOUpdated(const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    QMutexLocker locker(&contestDupeIndexLock);
+
+    // the record is going to be updated; the current values are still in DB
+    if ( !contestDupeIndex.isLoaded() )
+        return;
+
+    QSqlQuery query;
+
+    if ( !query.prepare(QLatin1String("SELECT callsign, band, mode, contest_id, start_time "
+                                      "FROM contacts WHERE id = :id")) )
+    {
+        qWarning() << "Cannot prepare Select statement" << query.lastError();
+        contestDupeIndex.clear();
+        return;
+    }
+
+    query.bindValue(":id", record.value("id"));
+
+    if ( !query.exec() )
+    {
+        qWarning() << "Cannot execute Select statement" << query.lastError();
+        contestDupeIndex.clear();
+        return;
+    }
+
+    if ( query.next() )
+        contestDupeIndex.updateContact(query.record(), record);
+}
+
+void Data::clearDupeIndex()
+{
+    FCT_IDENTIFICATION;
+
+    QMutexLocker locker(&contestDupeIndexLock);
+
+    // it is loaded again when needed
+    contestDupeIndex.clear();
 }
 
 qulonglong Data::countDupe(const QString &callsign,
@@ -989,59 +1040,34 @@ qulonglong Data::countDupe(const QString &callsign,
          || !dupeStartTime.isValid() )
         return false;
 
-    QStringList whereClause =
-    {
-        "callsign = :callsign",
-        "contest_id = :contestid"
-    };
-
-    if ( dupeType >= DupeType::ALL_BANDS )
-        whereClause << QLatin1String("datetime(start_time) >= datetime(:date)");
+    Data *data = Data::instance();
+    QMutexLocker locker(&data->contestDupeIndexLock);
 
-    if ( dupeType >= DupeType::EACH_BAND)
-        whereClause << QLatin1String("band = :band");
-
-    // FTx modes are stored with modes.dxcc = 'DIGITAL', so map FTx to DIGITAL.
-    const QString modeForQuery = ( mode == BandPlan::MODE_GROUP_STRING_FTx )
-                                 ? BandPlan::MODE_GROUP_STRING_DIGITAL
-                                 : mode;
-
-    if ( dupeType >= DupeType::EACH_BAND_MODE )
+    // the index is built again when the contest ID or the dupe date is changed
+    if ( !data->contestDupeIndex.isLoadedFor(contestID, dupeStartTime)
+         && !data->contestDupeIndex.load(contestID, dupeStartTime) )
     {
-        QString sql_mode = (modeForQuery != BandPlan::MODE_GROUP_STRING_CW &&
-                            modeForQuery != BandPlan::MODE_GROUP_STRING_PHONE &&
-                            modeForQuery != BandPlan::MODE_GROUP_STRING_DIGITAL)
-                            ? "(SELECT modes.dxcc FROM modes WHERE modes.name = :mode LIMIT 1)"
-                            : ":mode";
-        whereClause << QString("m.dxcc = %1").arg(sql_mode);
+        qWarning() << "Cannot load Contest Dupe Index";
+        return false;
     }
 
-    QString queryString("SELECT COUNT(1) "
-                        "FROM contacts c "
-                        "INNER JOIN modes m ON (m.name = c.mode) "
-                        "WHERE %1 ");
+    if ( dupeType == DupeType::ALL_BANDS )
+        return data->contestDupeIndex.count(callsign);
 
-    QSqlQuery query;
+    if ( dupeType == DupeType::EACH_BAND )
+        return data->contestDupeIndex.count(callsign, band);
 
-    if ( ! query.prepare(queryString.arg(whereClause.join(" AND "))))
-    {
-        qWarning() << "Cannot prepare Select statement" << queryString.arg(whereClause.join(" AND "));
-        return false;
-    }
+    // FTx modes are stored with modes.dxcc = 'DIGITAL', so map FTx to DIGITAL.
+    QString modeGroup = ( mode == BandPlan::MODE_GROUP_STRING_FTx )
+                        ? BandPlan::MODE_GROUP_STRING_DIGITAL
+                        : mode;
 
-    query.bindValue(":callsign", callsign);
-    query.bindValue(":date", dupeStartTime);
-    query.bindValue(":band", band);
-    query.bindValue(":mode", modeForQuery);
-    query.bindValue(":contestid", contestID);
+    if ( modeGroup != BandPlan::MODE_GROUP_STRING_CW
+         && modeGroup != BandPlan::MODE_GROUP_STRING_PHONE
+         && modeGroup != BandPlan::MODE_GROUP_STRING_DIGITAL )
+        modeGroup = data->contestDupeIndex.modeGroup(modeGroup);
 
-    if ( ! query.exec() )
-    {
-        qWarning() << "Cannot execute Select statement" << query.lastError() << query.lastQuery();
-        return false;
-    }
-
-    return (query.first()) ? query.value(0).toULongLong() : 0ULL;
+    return data->contestDupeIndex.count(callsign, band, modeGroup);
 }
 
 QString Data::safeQueryString(const QUrlQuery &query)
@@ -1161,55 +1187,46 @@ void Data::loadSatModes()
     }
 }
 
-void Data::loadIOTA()
+RefStringTable::Ptr Data::refTable(RefStringTable::Ptr &table, const QString &statement)
 {
     FCT_IDENTIFICATION;
 
-    QSqlQuery query("SELECT iotaid, islandname FROM iota");
+    QMutexLocker locker(&refTablesLock);
 
-    while ( query.next() )
-    {
-        const QString &iotaID = query.value(0).toString();
-        const QString &islandName = query.value(1).toString();
-        iotaRef.insert(iotaID, islandName);
-    }
+    // built on the first use - most sessions never open a reference completer.
+    // A failed load stays null, so the next use tries again.
+    if ( !table )
+        table = RefStringTable::load(statement);
+
+    return table;
 }
 
-void Data::loadSOTA()
+RefStringTable::Ptr Data::iotaTable()
 {
     FCT_IDENTIFICATION;
 
-    QSqlQuery query("SELECT summit_code FROM sota_summits");
-
-    while ( query.next() )
-    {
-        const QString &summitCode = query.value(0).toString();
-        sotaRefID.insert(summitCode, QString());
-    }
+    return refTable(iotaRef, QLatin1String("SELECT iotaid, islandname FROM iota"));
 }
 
-void Data::loadWWFF()
+RefStringTable::Ptr Data::sotaTable()
 {
-    QSqlQuery query("SELECT reference FROM wwff_directory");
+    FCT_IDENTIFICATION;
 
-    while ( query.next() )
-    {
-        const QString &reference = query.value(0).toString();
-        wwffRefID.insert(reference, QString());
-    }
+    return refTable(sotaRef, QLatin1String("SELECT summit_code FROM sota_summits"));
 }
 
-void Data::loadPOTA()
+RefStringTable::Ptr Data::wwffTable()
 {
     FCT_IDENTIFICATION;
 
-    QSqlQuery query("SELECT reference FROM pota_directory");
+    return refTable(wwffRef, QLatin1String("SELECT reference FROM wwff_directory"));
+}
 
-    while ( query.next() )
-    {
-        const QString &reference = query.value(0).toString();
-        potaRefID.insert(reference, QString());
-    }
+RefStringTable::Ptr Data::potaTable()
+{
+    FCT_IDENTIFICATION;
+
+    return refTable(potaRef, QLatin1String("SELECT reference FROM pota_directory"));
 }
 
 QCompleter* Data::createCountyCompleter(int dxcc, QObject *parent)
@@ -1306,7 +1323,6 @@ DxccEntity Data::lookupDxcc(const QString &callsign)
 DxccEntity Data::lookupDxccAD1C(const QString &callsign)
 {
     FCT_IDENTIFICATION;
-    static QCache<QString, DxccEntity> localCache(1000);
 
     qCDebug(function_parameters) << callsign;
 
@@ -1314,95 +1330,80 @@ DxccEntity Data::lookupDxccAD1C(const QString &callsign)
         return  DxccEntity();
 
     DxccEntity dxccRet;
-    DxccEntity *dxccCached = localCache.object(callsign);
+    const DxccSnapshot::Ptr snapshot = dxccSnapshot();
 
-    if ( dxccCached )
+    if ( snapshot && snapshot->hasAD1C() )
     {
-        dxccRet = *dxccCached;
+        dxccRet = snapshot->lookupAD1C(callsign);
     }
     else
     {
-        if ( ! isDXCCQueryValid )
-        {
-            qWarning() << "Cannot prepare Select statement";
-            return DxccEntity();
-        }
-
-        QString lookupPrefix = callsign; // use the callsign with optional prefix as default to find the dxcc
+        // The in-memory index is not available (empty table or a load error)
+        // therefore the SQL query with the local cache is used as a fallback
         const Callsign parsedCallsign(callsign); // use Callsign to split the callsign into its parts
+        const QString &lookupPrefix = ( parsedCallsign.isValid() ) ? parsedCallsign.getDXCCLookupPrefix()
+                                                                   : callsign;
+        DxccEntity *dxccCached = dxccAD1CCache.object(callsign);
 
-        if ( parsedCallsign.isValid() )
+        if ( dxccCached )
         {
-            QString suffix = parsedCallsign.getSuffix();
-            if ( suffix.length() == 1 ) // some countries add single numbers as suffix to designate a call area, e.g. /4
-            {
-                bool isNumber = false;
-                (void)suffix.toInt(&isNumber);
-                if ( isNumber )
-                {
-                    lookupPrefix = parsedCallsign.getBasePrefix() + suffix; // use the call prefix and the number from the suffix to find the dxcc
-                }
-            }
-            else if ( suffix.length() > 1
-                      && !parsedCallsign.secondarySpecialSuffixes.contains(suffix) ) // if there is more than one character and it is not one of the special suffixes, we definitely have a call prefix as suffix
+            dxccRet = *dxccCached;
+        }
+        else
+        {
+            if ( ! isDXCCQueryValid )
             {
-                lookupPrefix = suffix;
+                qWarning() << "Cannot prepare Select statement";
+                return DxccEntity();
             }
-        }
 
-        queryDXCC.bindValue(":callsign", lookupPrefix);
+            queryDXCC.bindValue(":callsign", lookupPrefix);
 
-        if ( ! queryDXCC.exec() )
-        {
-            qWarning() << "Cannot execute Select statement" << queryDXCC.lastError() << queryDXCC.lastQuery();
-            return DxccEntity();
-        }
+            if ( ! queryDXCC.exec() )
+            {
+                qWarning() << "Cannot execute Select statement" << queryDXCC.lastError() << queryDXCC.lastQuery();
+                return DxccEntity();
+            }
 
-        if ( queryDXCC.next() )
-        {
-            dxccRet.dxcc = queryDXCC.value(0).toInt();
-            dxccRet.country = queryDXCC.value(1).toString();
-            dxccRet.prefix = queryDXCC.value(2).toString();
-            dxccRet.cont = queryDXCC.value(3).toString();
-            dxccRet.cqz = queryDXCC.value(4).toInt();
-            dxccRet.ituz = queryDXCC.value(5).toInt();
-            dxccRet.latlon[0] = queryDXCC.value(6).toDouble();
-            dxccRet.latlon[1] = queryDXCC.value(7).toDouble();
-            dxccRet.tz = queryDXCC.value(8).toFloat();
-            bool isExactMatch = queryDXCC.value(9).toBool();
-            dxccRet.flag = dxccFlag(dxccRet.dxcc);
-
-            if ( !isExactMatch )
+            if ( queryDXCC.next() )
             {
-                // find the exceptions to the exceptions
-                if (  dxccRet.prefix == "KG4" && parsedCallsign.getBase().size() != 5 )
+                dxccRet.dxcc = queryDXCC.value(0).toInt();
+                dxccRet.country = queryDXCC.value(1).toString();
+                dxccRet.prefix = queryDXCC.value(2).toString();
+                dxccRet.cont = queryDXCC.value(3).toString();
+                dxccRet.cqz = queryDXCC.value(4).toInt();
+                dxccRet.ituz = queryDXCC.value(5).toInt();
+                dxccRet.latlon[0] = queryDXCC.value(6).toDouble();
+                dxccRet.latlon[1] = queryDXCC.value(7).toDouble();
+                dxccRet.tz = queryDXCC.value(8).toFloat();
+                bool isExactMatch = queryDXCC.value(9).toBool();
+
+                if ( !isExactMatch )
                 {
-                    //only KG4AA - KG4ZZ are US Navy in Guantanamo Bay. Other KG4s are USA
-                    dxccRet = lookupDxccID(291); // USA
-
-                    //do not overwrite the original prefix
-                    dxccRet.prefix = "KG4";
+                    // find the exceptions to the exceptions
+                    if (  dxccRet.prefix == "KG4" && parsedCallsign.getBase().size() != 5 )
+                    {
+                        //only KG4AA - KG4ZZ are US Navy in Guantanamo Bay. Other KG4s are USA
+                        dxccRet = lookupDxccID(291); // USA
+
+                        //do not overwrite the original prefix
+                        dxccRet.prefix = "KG4";
+                    }
                 }
-            }
-
-            dxccCached = new DxccEntity;
 
-            if ( dxccCached )
+                dxccAD1CCache.insert(callsign, new DxccEntity(dxccRet));
+            }
+            else
             {
-                *dxccCached = dxccRet;
-                localCache.insert(callsign, dxccCached);
+                dxccRet.dxcc = 0;
+                dxccRet.ituz = 0;
+                dxccRet.cqz = 0;
+                dxccRet.tz = 0;
             }
         }
-        else
-        {
-            dxccRet.dxcc = 0;
-            dxccRet.ituz = 0;
-            dxccRet.cqz = 0;
-            dxccRet.tz = 0;
-        }
     }
 
-    // The cache stores DXCC data, while flag visibility is a live GUI setting.
+    // The index and the cache store DXCC data, while flag visibility is a live GUI setting.
     dxccRet.flag = dxccFlag(dxccRet.dxcc);
     return dxccRet;
 }
@@ -1413,6 +1414,15 @@ DxccEntity Data::lookupDxccIDAD1C(const int dxccID)
 
     qCDebug(function_parameters) << dxccID;
 
+    const DxccSnapshot::Ptr snapshot = dxccSnapshot();
+
+    if ( snapshot && snapshot->hasAD1C() )
+    {
+        DxccEntity dxccRet = snapshot->entityAD1C(dxccID);
+        dxccRet.flag = dxccFlag(dxccRet.dxcc);
+        return dxccRet;
+    }
+
     if ( !isDXCCIDAD1CQueryValid )
     {
         qWarning() << "Cannot prepare Select statement";
@@ -1457,6 +1467,15 @@ DxccEntity Data::lookupDxccIDClublog(const int dxccID)
 
     qCDebug(function_parameters) << dxccID;
 
+    const DxccSnapshot::Ptr snapshot = dxccSnapshot();
+
+    if ( snapshot && snapshot->hasClublog() )
+    {
+        DxccEntity dxccRet = snapshot->entityClublog(dxccID);
+        dxccRet.flag = dxccFlag(dxccRet.dxcc);
+        return dxccRet;
+    }
+
     if ( !isDXCCIDClublogQueryValid )
     {
         qWarning() << "Cannot prepare Select statement";
@@ -1518,33 +1537,25 @@ DxccEntity Data::lookupDxccClublog(const QString &callsign, const QDateTime &dat
 
     if ( callsign.isEmpty()) return  DxccEntity();
 
+    const DxccSnapshot::Ptr snapshot = dxccSnapshot();
+
+    if ( snapshot && snapshot->hasClublog() && snapshot->hasAD1C() )
+    {
+        DxccEntity dxccRet = snapshot->lookupClublog(callsign, date);
+        dxccRet.flag = dxccFlag(dxccRet.dxcc);
+        return dxccRet;
+    }
+
+    // The in-memory index is not available - fallback to SQL
     if ( ! isDXCCClublogQueryValid )
     {
         qWarning() << "Cannot prepare Select statement";
         return DxccEntity();
     }
 
-    QString lookupPrefix = callsign; // use the callsign with optional prefix as default to find the dxcc
     const Callsign parsedCallsign(callsign); // use Callsign to split the callsign into its parts
-
-    if ( parsedCallsign.isValid() )
-    {
-        QString suffix = parsedCallsign.getSuffix();
-        if ( suffix.length() == 1 ) // some countries add single numbers as suffix to designate a call area, e.g. /4
-        {
-            bool isNumber = false;
-            (void)suffix.toInt(&isNumber);
-            if ( isNumber )
-            {
-                lookupPrefix = parsedCallsign.getBasePrefix() + suffix; // use the call prefix and the number from the suffix to find the dxcc
-            }
-        }
-        else if ( suffix.length() > 1
-                  && !parsedCallsign.secondarySpecialSuffixes.contains(suffix) ) // if there is more than one character and it is not one of the special suffixes, we definitely have a call prefix as suffix
-        {
-            lookupPrefix = suffix;
-        }
-    }
+    const QString &lookupPrefix = ( parsedCallsign.isValid() ) ? parsedCallsign.getDXCCLookupPrefix()
+                                                               : callsign;
 
     queryDXCCClublog.bindValue(":modifiedcall", lookupPrefix);
     queryDXCCClublog.bindValue(":exactcall", callsign);
@@ -1571,8 +1582,8 @@ DxccEntity Data::lookupDxccClublog(const QString &callsign, const QDateTime &dat
         dxccRet.ituz = queryDXCCClublog.value(5).toInt();
         dxccRet.latlon[0] = queryDXCCClublog.value(6).toDouble();
         dxccRet.latlon[1] = queryDXCCClublog.value(7).toDouble();
-        dxccRet.tz = queryDXCCClublog.value(8).toFloat();
-        bool isExactMatch = queryDXCCClublog.value(9).toBool();
+        dxccRet.tz = 0; // Clublog does not provide TZ
+        bool isExactMatch = queryDXCCClublog.value(8).toBool();
         dxccRet.flag = dxccFlag(dxccRet.dxcc);
 
         if ( !isExactMatch )
@@ -1617,6 +1628,81 @@ DxccEntity Data::lookupDxccClublog(const QString &callsign, const QDateTime &dat
     return dxccRet;
 }
 
+QList<DxccEntity> Data::lookupDxccBatch(const QList<QString> &callsigns)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << callsigns.size();
+
+    const DxccSnapshot::Ptr snapshot = dxccSnapshot();
+
+    if ( snapshot && snapshot->hasAD1C() )
+    {
+        QList<DxccEntity> ret = snapshot->lookupAD1C(callsigns);
+
+        for ( DxccEntity &entity : ret )
+            entity.flag = dxccFlag(entity.dxcc);
+
+        return ret;
+    }
+
+    // SQL fallback - every distinct callsign is queried only once
+    QList<DxccEntity> ret;
+    QHash<QString, int> resolved;
+
+    ret.reserve(callsigns.size());
+
+    for ( const QString &callsign : callsigns )
+    {
+        const auto it = resolved.constFind(callsign);
+
+        if ( it != resolved.constEnd() )
+        {
+            ret.append(ret.at(it.value()));
+            continue;
+        }
+        resolved.insert(callsign, ret.size());
+        ret.append(lookupDxcc(callsign));
+    }
+
+    return ret;
+}
+
+QList<DxccEntity> Data::lookupDxccClublogBatch(const QList<QString> &callsigns,
+                                               const QList<QDateTime> &dates)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << callsigns.size() << dates.size();
+
+    if ( callsigns.size() != dates.size() )
+    {
+        qWarning() << "Callsign and date lists have different sizes";
+        return QList<DxccEntity>();
+    }
+
+    QList<DxccEntity> ret;
+    const DxccSnapshot::Ptr snapshot = dxccSnapshot();
+
+    if ( snapshot && snapshot->hasClublog() && snapshot->hasAD1C() )
+    {
+        ret = snapshot->lookupClublog(callsigns, dates);
+
+        for ( DxccEntity &entity : ret )
+            entity.flag = dxccFlag(entity.dxcc);
+
+        return ret;
+    }
+
+    // SQL fallback
+    ret.reserve(callsigns.size());
+
+    for ( int i = 0; i < callsigns.size(); ++i )
+        ret.append(lookupDxccClublog(callsigns.at(i), dates.at(i)));
+
+    return ret;
+}
+
 SOTAEntity Data::lookupSOTA(const QString &SOTACode)
 {
     FCT_IDENTIFICATION;
@@ -5,11 +5,14 @@
 #include <QColor>
 #include <QSqlQuery>
 #include "Dxcc.h"
+#include "DxccSnapshot.h"
+#include "DxccStatusMatrix.h"
+#include "ContestDupeIndex.h"
+#include "RefStringTable.h"
 #include "SOTAEntity.h"
 #include "WWFFEntity.h"
 #include "POTAEntity.h"
 #include "core/zonedetect.h"
-#include "core/QuadKeyCache.h"
 
 class QCompleter;
 
@@ -168,6 +171,8 @@ public:
     DxccEntity lookupDxccIDAD1C(const int dxccID);
     DxccEntity lookupDxccClublog(const QString &callsign, const QDateTime &date = QDateTime::currentDateTimeUtc());
     DxccEntity lookupDxccIDClublog(const int dxccID);
+    QList<DxccEntity> lookupDxccBatch(const QList<QString> &callsigns);
+    QList<DxccEntity> lookupDxccClublogBatch(const QList<QString> &callsigns, const QList<QDateTime> &dates);
     SOTAEntity lookupSOTA(const QString &SOTACode);
     POTAEntity lookupPOTA(const QString &POTACode);
     WWFFEntity lookupWWFF(const QString &reference);
@@ -184,22 +189,28 @@ public:
     QStringList satModesIDList() { return satModes.keys(); }
     QString satModeTextToID(const QString &satModeText) { return satModes.key(satModeText);}
     QString satModeIDToText(const QString &satModeID) { return satModes.value(satModeID);}
-    QStringList iotaList() { return iotaRef.values();}
-    QStringList iotaIDList() { return iotaRef.keys();}
-    QString iotaTextToID(const QString &iotaText) { return iotaRef.key(iotaText);}
-    QStringList sotaIDList() { return sotaRefID.keys();}
-    QStringList wwffIDList() { return wwffRefID.keys();}
-    QStringList potaIDList() { return potaRefID.keys();}
+    RefStringTable::Ptr iotaTable();
+    RefStringTable::Ptr sotaTable();
+    RefStringTable::Ptr wwffTable();
+    RefStringTable::Ptr potaTable();
     QString getIANATimeZone(double, double);
+    void reloadDxccIndex();
+    DxccSnapshot::Ptr dxccSnapshot() const;
     QStringList sigIDList();
     static QCompleter* createCountyCompleter(int dxcc, QObject *parent = nullptr);
+    void updateDXCCStatusCacheContact(const QSqlRecord &oldRecord, const QSqlRecord &newRecord);
 
 signals:
 
 public slots:
     void invalidateDXCCStatusCache(const QSqlRecord &record);
     void invalidateSetOfDXCCStatusCache(const QSet<uint> &entities);
+    void updateDXCCStatusCache(const QSqlRecord &record);
     void clearDXCCStatusCache();
+    void updateDupeIndexWhenQSOAdded(const QSqlRecord &record);
+    void updateDupeIndexWhenQSODeleted(const QSqlRecord &record);
+    void updateDupeIndexWhenQSOUpdated(const QSqlRecord &record);
+    void clearDupeIndex();
 
 private:
     void loadContests();
@@ -207,10 +218,7 @@ private:
     void loadLegacyModes();
     void loadDxccFlags();
     void loadSatModes();
-    void loadIOTA();
-    void loadSOTA();
-    void loadWWFF();
-    void loadPOTA();
+    RefStringTable::Ptr refTable(RefStringTable::Ptr &table, const QString &statement);
     void loadTZ();
 
     QHash<int, QVariantMap> dxccEntityStaticInfo;
@@ -218,10 +226,11 @@ private:
     QMap<QString, QString> propagationModes;
     QMap<QString, QPair<QString, QString>> legacyModes;
     QMap<QString, QString> satModes;
-    QMap<QString, QString> iotaRef;
-    QMap<QString, QString> sotaRefID;
-    QMap<QString, QString> wwffRefID;
-    QMap<QString, QString> potaRefID;
+    RefStringTable::Ptr iotaRef;
+    RefStringTable::Ptr sotaRef;
+    RefStringTable::Ptr wwffRef;
+    RefStringTable::Ptr potaRef;
+    QMutex refTablesLock;
     bool showDxccFlags;
     ZoneDetect * zd;
     QSqlQuery queryDXCC;
@@ -238,7 +247,12 @@ private:
     bool isPOTAQueryValid;
     bool isDXCCIDAD1CQueryValid;
     bool isDXCCIDClublogQueryValid;
-    QuadKeyCache<DxccStatus> dxccStatusCache;
+    DxccStatusMatrix dxccStatusMatrix;
+    DxccSnapshot::Ptr currentDxccSnapshot;
+    mutable QMutex dxccSnapshotLock;
+    ContestDupeIndex contestDupeIndex;
+    QMutex contestDupeIndexLock;
+    QCache<QString, DxccEntity> dxccAD1CCache;
 
     static const char translitTab[];
     static const int tranlitIndexMap[];
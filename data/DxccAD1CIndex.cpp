@@ -0,0 +1,168 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include "DxccAD1CIndex.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.dxccad1cindex");
+
+bool DxccAD1CIndex::load(const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+
+    QSqlQuery entityQuery(db);
+
+    if ( !entityQuery.exec("SELECT id, name, prefix, cont, cqz, ituz, lat, lon, tz "
+                           "FROM dxcc_entities_ad1c") )
+    {
+        qCWarning(runtime) << "Cannot load AD1C entities" << entityQuery.lastError();
+        return false;
+    }
+
+    while ( entityQuery.next() )
+    {
+        DxccEntity entity;
+        entity.dxcc = entityQuery.value(0).toInt();
+        entity.country = entityQuery.value(1).toString();
+        entity.prefix = entityQuery.value(2).toString();
+        entity.cont = entityQuery.value(3).toString();
+        entity.cqz = entityQuery.value(4).toInt();
+        entity.ituz = entityQuery.value(5).toInt();
+        entity.latlon[0] = entityQuery.value(6).toDouble();
+        entity.latlon[1] = entityQuery.value(7).toDouble();
+        entity.tz = entityQuery.value(8).toFloat();
+        entities.insert(entity.dxcc, entity);
+    }
+
+    QSqlQuery prefixQuery(db);
+
+    // rowid order - the first record wins if a prefix is present more than once
+    if ( !prefixQuery.exec("SELECT prefix, exact, dxcc, cqz, ituz "
+                           "FROM dxcc_prefixes_ad1c ORDER BY rowid") )
+    {
+        qCWarning(runtime) << "Cannot load AD1C prefixes" << prefixQuery.lastError();
+        clear();
+        return false;
+    }
+
+    while ( prefixQuery.next() )
+    {
+        const QString &prefix = prefixQuery.value(0).toString();
+        const bool exact = prefixQuery.value(1).toBool();
+        const PrefixRecord record = { prefixQuery.value(2).toInt(),
+                                      prefixQuery.value(3).toInt(),
+                                      prefixQuery.value(4).toInt() };
+
+        // a record without an entity would be removed by INNER JOIN in the SQL variant
+        if ( !entities.contains(record.dxcc) )
+            continue;
+
+        const int slot = prefixRecords.size();
+
+        if ( exact )
+        {
+            if ( exactRecords.contains(prefix) )
+                continue;
+            exactRecords.insert(prefix, slot);
+        }
+        else if ( !prefixTrie.insert(prefix, slot) )
+        {
+            qCDebug(runtime) << "Skipping prefix" << prefix;
+            continue;
+        }
+
+        prefixRecords.append(record);
+    }
+
+    qCDebug(runtime) << "AD1C index loaded:" << entities.size() << "entities,"
+                     << prefixTrie.size() << "prefixes,"
+                     << exactRecords.size() << "exact calls,"
+                     << prefixTrie.nodeCount() << "nodes in" << timer.elapsed() << "ms";
+
+    return true;
+}
+
+void DxccAD1CIndex::clear()
+{
+    FCT_IDENTIFICATION;
+
+    entities.clear();
+    prefixRecords.clear();
+    exactRecords.clear();
+    prefixTrie.clear();
+}
+
+DxccEntity DxccAD1CIndex::lookup(const QString &lookupPrefix, const QString &callsignBase) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    DxccEntity ret;
+
+    const auto exactIt = exactRecords.constFind(lookupPrefix);
+
+    if ( exactIt != exactRecords.constEnd()
+         && fillEntity(prefixRecords.at(exactIt.value()), ret) )
+        return ret;
+
+    const DxccPrefixTrie::MatchList &candidates = prefixTrie.matches(lookupPrefix);
+
+    for ( int slot : candidates )
+    {
+        if ( !fillEntity(prefixRecords.at(slot), ret) )
+            continue;
+
+        // find the exceptions to the exceptions
+        if ( ret.prefix == QLatin1String("KG4") && callsignBase.size() != 5 )
+        {
+            //only KG4AA - KG4ZZ are US Navy in Guantanamo Bay. Other KG4s are USA
+            ret = entity(291); // USA
+
+            //do not overwrite the original prefix
+            ret.prefix = "KG4";
+        }
+        return ret;
+    }
+
+    return emptyEntity();
+}
+
+DxccEntity DxccAD1CIndex::entity(int dxccID) const
+{
+    const auto it = entities.constFind(dxccID);
+    return ( it != entities.constEnd() ) ? it.value() : emptyEntity();
+}
+
+bool DxccAD1CIndex::fillEntity(const PrefixRecord &record, DxccEntity &entity) const
+{
+    const auto it = entities.constFind(record.dxcc);
+
+    if ( it == entities.constEnd() )
+        return false;
+
+    entity = it.value();
+
+    if ( record.cqz != 0 )
+        entity.cqz = record.cqz;
+
+    if ( record.ituz != 0 )
+        entity.ituz = record.ituz;
+
+    return true;
+}
+
+DxccEntity DxccAD1CIndex::emptyEntity()
+{
+    DxccEntity ret;
+    ret.dxcc = 0;
+    ret.ituz = 0;
+    ret.cqz = 0;
+    ret.tz = 0;
+    ret.latlon[0] = 0.0;
+    ret.latlon[1] = 0.0;
+    return ret;
+}
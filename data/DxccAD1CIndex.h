@@ -0,0 +1,41 @@
+#ifndef QLOG_DATA_DXCCAD1CINDEX_H
+#define QLOG_DATA_DXCCAD1CINDEX_H
+
+#include <QHash>
+#include <QSqlDatabase>
+#include "Dxcc.h"
+#include "DxccPrefixTrie.h"
+
+// In-memory copy of the dxcc_entities_ad1c/dxcc_prefixes_ad1c tables.
+// It resolves a callsign the same way as the AD1C SQL query in Data -
+// an exact record is preferred, otherwise the longest prefix wins.
+class DxccAD1CIndex
+{
+public:
+    bool load(const QSqlDatabase &db = QSqlDatabase::database());
+    void clear();
+    bool isEmpty() const { return entities.isEmpty(); }
+
+    // lookupPrefix - the string used for matching (see Callsign::getDXCCLookupPrefix)
+    // callsignBase - base part of the callsign; needed for the KG4 exception
+    DxccEntity lookup(const QString &lookupPrefix, const QString &callsignBase) const;
+    DxccEntity entity(int dxccID) const;
+
+private:
+    struct PrefixRecord
+    {
+        qint32 dxcc;
+        qint32 cqz;
+        qint32 ituz;
+    };
+
+    bool fillEntity(const PrefixRecord &record, DxccEntity &entity) const;
+    static DxccEntity emptyEntity();
+
+    QHash<int, DxccEntity> entities;
+    QVector<PrefixRecord> prefixRecords;
+    QHash<QString, int> exactRecords;
+    DxccPrefixTrie prefixTrie;
+};
+
+#endif // QLOG_DATA_DXCCAD1CINDEX_H
@@ -0,0 +1,272 @@
+#include <limits>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QTimeZone>
+#include "DxccClublogIndex.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.dxccclublogindex");
+
+bool DxccClublogIndex::load(const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+
+    QSqlQuery entityQuery(db);
+
+    if ( !entityQuery.exec("SELECT id, name, prefix, cont, cqz, ituz, lat, lon "
+                           "FROM dxcc_entities_clublog") )
+    {
+        qCWarning(runtime) << "Cannot load Clublog entities" << entityQuery.lastError();
+        return false;
+    }
+
+    while ( entityQuery.next() )
+    {
+        DxccEntity entity;
+        entity.dxcc = entityQuery.value(0).toInt();
+        entity.country = entityQuery.value(1).toString();
+        entity.prefix = entityQuery.value(2).toString();
+        entity.cont = entityQuery.value(3).toString();
+        entity.cqz = entityQuery.value(4).toInt();
+        entity.ituz = entityQuery.value(5).toInt();
+        entity.latlon[0] = entityQuery.value(6).toDouble();
+        entity.latlon[1] = entityQuery.value(7).toDouble();
+        entity.tz = 0;
+        entities.insert(entity.dxcc, entity);
+    }
+
+    QSqlQuery prefixQuery(db);
+
+    if ( !prefixQuery.exec("SELECT prefix, exact, dxcc, cqz, ituz, start, \"end\" "
+                           "FROM dxcc_prefixes_clublog ORDER BY rowid") )
+    {
+        qCWarning(runtime) << "Cannot load Clublog prefixes" << prefixQuery.lastError();
+        clear();
+        return false;
+    }
+
+    while ( prefixQuery.next() )
+    {
+        const QString &prefix = prefixQuery.value(0).toString();
+        const bool exact = prefixQuery.value(1).toBool();
+        const Interval interval = { parseTime(prefixQuery.value(5).toString(), std::numeric_limits<qint64>::min()),
+                                    parseTime(prefixQuery.value(6).toString(), std::numeric_limits<qint64>::max()),
+                                    prefixQuery.value(2).toInt(),
+                                    prefixQuery.value(3).toInt(),
+                                    prefixQuery.value(4).toInt() };
+
+        // a record without an entity would be removed by INNER JOIN in the SQL variant
+        if ( !entities.contains(interval.dxcc) )
+            continue;
+
+        if ( exact )
+        {
+            exactCalls[prefix].append(interval);
+            continue;
+        }
+
+        int slot = prefixTrie.find(prefix);
+
+        if ( slot < 0 )
+        {
+            slot = prefixIntervals.size();
+
+            if ( !prefixTrie.insert(prefix, slot) )
+            {
+                qCDebug(runtime) << "Skipping prefix" << prefix;
+                continue;
+            }
+            prefixIntervals.append(IntervalList());
+        }
+        prefixIntervals[slot].append(interval);
+    }
+
+    QSqlQuery zoneQuery(db);
+
+    if ( !zoneQuery.exec("SELECT call, cqz, start, \"end\" "
+                         "FROM dxcc_zone_exceptions_clublog ORDER BY record") )
+    {
+        qCWarning(runtime) << "Cannot load Clublog zone exceptions" << zoneQuery.lastError();
+        clear();
+        return false;
+    }
+
+    while ( zoneQuery.next() )
+    {
+        const Interval interval = { parseTime(zoneQuery.value(2).toString(), std::numeric_limits<qint64>::min()),
+                                    parseTime(zoneQuery.value(3).toString(), std::numeric_limits<qint64>::max()),
+                                    0,
+                                    zoneQuery.value(1).toInt(),
+                                    0 };
+        zoneExceptions[zoneQuery.value(0).toString()].append(interval);
+    }
+
+    for ( IntervalList &list : prefixIntervals )
+        sortIntervals(list);
+
+    for ( auto it = exactCalls.begin(); it != exactCalls.end(); ++it )
+        sortIntervals(it.value());
+
+    for ( auto it = zoneExceptions.begin(); it != zoneExceptions.end(); ++it )
+        sortIntervals(it.value());
+
+    qCDebug(runtime) << "Clublog index loaded:" << entities.size() << "entities,"
+                     << prefixTrie.size() << "prefixes,"
+                     << exactCalls.size() << "exact calls,"
+                     << zoneExceptions.size() << "zone exceptions in" << timer.elapsed() << "ms";
+
+    return true;
+}
+
+void DxccClublogIndex::clear()
+{
+    FCT_IDENTIFICATION;
+
+    entities.clear();
+    prefixIntervals.clear();
+    exactCalls.clear();
+    zoneExceptions.clear();
+    prefixTrie.clear();
+}
+
+bool DxccClublogIndex::lookup(const QString &lookupPrefix,
+                              const QString &exactCall,
+                              const QDateTime &date,
+                              DxccEntity &entity,
+                              bool *isExactMatch) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( !date.isValid() )
+        return false;
+
+    const qint64 time = date.toMSecsSinceEpoch();
+    const Interval *found = nullptr;
+    bool exact = false;
+
+    const auto exactIt = exactCalls.constFind(exactCall);
+
+    if ( exactIt != exactCalls.constEnd() )
+    {
+        found = findInterval(exactIt.value(), time);
+        exact = ( found != nullptr );
+    }
+
+    if ( !found )
+    {
+        const DxccPrefixTrie::MatchList &candidates = prefixTrie.matches(lookupPrefix);
+
+        for ( int slot : candidates )
+        {
+            found = findInterval(prefixIntervals.at(slot), time);
+            if ( found )
+                break;
+        }
+    }
+
+    if ( !found || !fillEntity(*found, entity) )
+        return false;
+
+    const auto zoneIt = zoneExceptions.constFind(exactCall);
+
+    if ( zoneIt != zoneExceptions.constEnd() )
+    {
+        const Interval *zone = findInterval(zoneIt.value(), time);
+
+        if ( zone )
+        {
+            // Clublog does not distribute ITUZ for zone exceptions
+            entity.cqz = zone->cqz;
+            entity.ituz = 0;
+        }
+    }
+
+    if ( isExactMatch )
+        *isExactMatch = exact;
+
+    return true;
+}
+
+DxccEntity DxccClublogIndex::entity(int dxccID) const
+{
+    const auto it = entities.constFind(dxccID);
+
+    if ( it != entities.constEnd() )
+        return it.value();
+
+    DxccEntity ret;
+    ret.dxcc = 0;
+    ret.ituz = 0;
+    ret.cqz = 0;
+    ret.tz = 0;
+    ret.latlon[0] = 0.0;
+    ret.latlon[1] = 0.0;
+    return ret;
+}
+
+qint64 DxccClublogIndex::parseTime(const QString &value, qint64 defaultValue)
+{
+    if ( value.isEmpty() )
+        return defaultValue;
+
+    QDateTime dateTime = QDateTime::fromString(value, Qt::ISODate);
+
+    if ( !dateTime.isValid() )
+        dateTime = QDateTime::fromString(value, QStringLiteral("yyyy-MM-dd hh:mm:ss"));
+
+    if ( !dateTime.isValid() )
+        return defaultValue;
+
+    // Clublog times without an offset are UTC
+    if ( dateTime.timeSpec() == Qt::LocalTime )
+        dateTime = QDateTime(dateTime.date(), dateTime.time(), QTimeZone::utc());
+
+    return dateTime.toMSecsSinceEpoch();
+}
+
+const DxccClublogIndex::Interval *DxccClublogIndex::findInterval(const IntervalList &list, qint64 time)
+{
+    // the list is sorted by the start time; the last interval starting
+    // before the time is the best candidate. Intervals can overlap,
+    // therefore continue to older intervals if it does not contain the time
+    Interval probe = { time, time, 0, 0, 0 };
+    auto it = std::upper_bound(list.cbegin(), list.cend(), probe);
+
+    while ( it != list.cbegin() )
+    {
+        --it;
+        if ( it->contains(time) )
+            return &(*it);
+    }
+
+    return nullptr;
+}
+
+void DxccClublogIndex::sortIntervals(IntervalList &list)
+{
+    std::stable_sort(list.begin(), list.end());
+}
+
+bool DxccClublogIndex::fillEntity(const Interval &interval, DxccEntity &entity) const
+{
+    const auto it = entities.constFind(interval.dxcc);
+
+    if ( it == entities.constEnd() )
+        return false;
+
+    entity = it.value();
+
+    if ( interval.cqz != 0 )
+        entity.cqz = interval.cqz;
+
+    if ( interval.ituz != 0 )
+        entity.ituz = interval.ituz;
+
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef QLOG_DATA_DXCCCLUBLOGINDEX_H
+#define QLOG_DATA_DXCCCLUBLOGINDEX_H
+
+#include <QHash>
+#include <QVector>
+#include <QDateTime>
+#include <QSqlDatabase>
+#include "Dxcc.h"
+#include "DxccPrefixTrie.h"
+
+// In-memory copy of the Clublog CTY tables (dxcc_entities_clublog,
+// dxcc_prefixes_clublog and dxcc_zone_exceptions_clublog).
+// Every prefix and exact call holds a list of validity intervals sorted by
+// the start time, so a (callsign, date) query is answered without SQL.
+class DxccClublogIndex
+{
+public:
+    bool load(const QSqlDatabase &db = QSqlDatabase::database());
+    void clear();
+    bool isEmpty() const { return entities.isEmpty(); }
+
+    // lookupPrefix - the string used for the prefix matching (see Callsign::getDXCCLookupPrefix)
+    // exactCall - the full callsign used for exceptions and zone exceptions
+    // returns false if no record is valid at the date
+    bool lookup(const QString &lookupPrefix,
+                const QString &exactCall,
+                const QDateTime &date,
+                DxccEntity &entity,
+                bool *isExactMatch = nullptr) const;
+    DxccEntity entity(int dxccID) const;
+
+    static qint64 parseTime(const QString &value, qint64 defaultValue);
+
+private:
+    struct Interval
+    {
+        qint64 start;
+        qint64 end;
+        qint32 dxcc;
+        qint32 cqz;
+        qint32 ituz;
+
+        bool contains(qint64 time) const { return start <= time && time <= end; }
+        bool operator<(const Interval &other) const { return start < other.start; }
+    };
+
+    using IntervalList = QVector<Interval>;
+
+    static const Interval *findInterval(const IntervalList &list, qint64 time);
+    static void sortIntervals(IntervalList &list);
+    bool fillEntity(const Interval &interval, DxccEntity &entity) const;
+
+    QHash<int, DxccEntity> entities;
+    QVector<IntervalList> prefixIntervals;     // indexed by the trie slot
+    QHash<QString, IntervalList> exactCalls;
+    QHash<QString, IntervalList> zoneExceptions;
+    DxccPrefixTrie prefixTrie;
+};
+
+#endif // QLOG_DATA_DXCCCLUBLOGINDEX_H
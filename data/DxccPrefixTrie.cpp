@@ -0,0 +1,91 @@
+#include "DxccPrefixTrie.h"
+
+bool DxccPrefixTrie::insert(const QString &prefix, int slot)
+{
+    if ( prefix.isEmpty() || slot < 0 )
+        return false;
+
+    if ( nodes.isEmpty() )
+        nodes.append(Node());
+
+    int nodeIndex = 0;
+
+    for ( const QChar &c : prefix )
+    {
+        const int symbol = symbolIndex(c);
+
+        if ( symbol < 0 )
+            return false;
+
+        int next = nodes.at(nodeIndex).children[symbol];
+
+        if ( next < 0 )
+        {
+            next = nodes.size();
+            nodes.append(Node());
+            nodes[nodeIndex].children[symbol] = next;
+        }
+        nodeIndex = next;
+    }
+
+    if ( nodes.at(nodeIndex).slot >= 0 )
+        return false;
+
+    nodes[nodeIndex].slot = slot;
+    slotCount++;
+    return true;
+}
+
+int DxccPrefixTrie::find(const QString &prefix) const
+{
+    if ( nodes.isEmpty() || prefix.isEmpty() )
+        return -1;
+
+    int nodeIndex = 0;
+
+    for ( const QChar &c : prefix )
+    {
+        const int symbol = symbolIndex(c);
+
+        if ( symbol < 0 )
+            return -1;
+
+        nodeIndex = nodes.at(nodeIndex).children[symbol];
+
+        if ( nodeIndex < 0 )
+            return -1;
+    }
+
+    return nodes.at(nodeIndex).slot;
+}
+
+DxccPrefixTrie::MatchList DxccPrefixTrie::matches(const QString &key) const
+{
+    MatchList ret;
+
+    if ( nodes.isEmpty() )
+        return ret;
+
+    const Node *data = nodes.constData();
+    int nodeIndex = 0;
+
+    for ( const QChar &c : key )
+    {
+        const int symbol = symbolIndex(c);
+
+        if ( symbol < 0 )
+            break;
+
+        nodeIndex = data[nodeIndex].children[symbol];
+
+        if ( nodeIndex < 0 )
+            break;
+
+        if ( data[nodeIndex].slot >= 0 )
+            ret.append(data[nodeIndex].slot);
+    }
+
+    // the walk collects the shortest prefix first
+    std::reverse(ret.begin(), ret.end());
+    return ret;
+}
@@ -0,0 +1,57 @@
+#ifndef QLOG_DATA_DXCCPREFIXTRIE_H
+#define QLOG_DATA_DXCCPREFIXTRIE_H
+
+#include <algorithm>
+#include <QString>
+#include <QVector>
+#include <QVarLengthArray>
+
+// Prefix trie over the callsign alphabet (A-Z, 0-9, '/').
+// Every node can carry a slot - an index to the caller's payload table.
+// The trie does not own any payload; it only answers the question
+// "which stored prefixes are prefixes of this callsign", longest first.
+class DxccPrefixTrie
+{
+public:
+    using MatchList = QVarLengthArray<int, 16>;
+
+    // returns false if the prefix contains an unsupported character
+    // or the prefix already holds a slot (the first inserted slot wins)
+    bool insert(const QString &prefix, int slot);
+
+    // returns the slot stored exactly at the prefix or -1
+    int find(const QString &prefix) const;
+
+    // returns slots of all stored prefixes of the key, the longest prefix first
+    MatchList matches(const QString &key) const;
+
+    void clear() { nodes.clear(); slotCount = 0; }
+    bool isEmpty() const { return slotCount == 0; }
+    int size() const { return slotCount; }
+    int nodeCount() const { return nodes.size(); }
+
+private:
+    static const int ALPHABET_SIZE = 37;
+
+    struct Node
+    {
+        Node() : slot(-1) { std::fill(children, children + ALPHABET_SIZE, -1); }
+        qint32 children[ALPHABET_SIZE];
+        qint32 slot;
+    };
+
+    static int symbolIndex(QChar c)
+    {
+        const ushort u = c.unicode();
+        if ( u >= 'A' && u <= 'Z' ) return u - 'A';
+        if ( u >= 'a' && u <= 'z' ) return u - 'a';
+        if ( u >= '0' && u <= '9' ) return 26 + (u - '0');
+        if ( u == '/' ) return 36;
+        return -1;
+    }
+
+    QVector<Node> nodes;
+    int slotCount = 0;
+};
+
+#endif // QLOG_DATA_DXCCPREFIXTRIE_H
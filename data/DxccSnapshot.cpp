@@ -0,0 +1,174 @@
+#include <QElapsedTimer>
+#include "DxccSnapshot.h"
+#include "Callsign.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.dxccsnapshot");
+
+DxccSnapshot::Ptr DxccSnapshot::create(const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    DxccSnapshot *snapshot = new DxccSnapshot();
+
+    if ( !snapshot->ad1cIndex.load(db) )
+        qCWarning(runtime) << "Cannot build DXCC AD1C index";
+
+    if ( !snapshot->clublogIndex.load(db) )
+        qCWarning(runtime) << "Cannot build DXCC Clublog index";
+
+    qCDebug(runtime) << "DXCC snapshot created in" << timer.elapsed() << "ms";
+
+    return Ptr(snapshot);
+}
+
+DxccEntity DxccSnapshot::lookupAD1C(const QString &callsign) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( callsign.isEmpty() )
+        return DxccEntity();
+
+    const ParsedCallsign &parsed = parse(callsign);
+    return ad1cIndex.lookup(parsed.lookupPrefix, parsed.base);
+}
+
+DxccEntity DxccSnapshot::lookupClublog(const QString &callsign, const QDateTime &date) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( callsign.isEmpty() )
+        return DxccEntity();
+
+    const ParsedCallsign &parsed = parse(callsign);
+    return resolveClublog(callsign, parsed, ad1cIndex.lookup(parsed.lookupPrefix, parsed.base), date);
+}
+
+QList<DxccEntity> DxccSnapshot::lookupAD1C(const QList<QString> &callsigns) const
+{
+    FCT_IDENTIFICATION;
+
+    QList<DxccEntity> ret;
+    ret.reserve(callsigns.size());
+
+    // callsign -> position of its first occurrence in ret
+    QHash<QString, int> resolved;
+    resolved.reserve(callsigns.size());
+
+    for ( const QString &callsign : callsigns )
+    {
+        const auto it = resolved.constFind(callsign);
+
+        if ( it != resolved.constEnd() )
+        {
+            ret.append(ret.at(it.value()));
+            continue;
+        }
+
+        resolved.insert(callsign, ret.size());
+        ret.append(lookupAD1C(callsign));
+    }
+
+    qCDebug(runtime) << callsigns.size() << "callsigns," << resolved.size() << "distinct";
+
+    return ret;
+}
+
+QList<DxccEntity> DxccSnapshot::lookupClublog(const QList<QString> &callsigns,
+                                              const QList<QDateTime> &dates) const
+{
+    FCT_IDENTIFICATION;
+
+    QList<DxccEntity> ret;
+
+    if ( callsigns.size() != dates.size() )
+    {
+        qCWarning(runtime) << "Callsign and date lists have different sizes"
+                           << callsigns.size() << dates.size();
+        return ret;
+    }
+
+    ret.reserve(callsigns.size());
+
+    // the callsign parsing and the AD1C part do not depend on the date;
+    // they are resolved once per distinct callsign
+    struct Resolved
+    {
+        ParsedCallsign parsed;
+        DxccEntity ad1c;
+    };
+    QHash<QString, Resolved> resolved;
+    resolved.reserve(callsigns.size());
+
+    for ( int i = 0; i < callsigns.size(); ++i )
+    {
+        const QString &callsign = callsigns.at(i);
+
+        if ( callsign.isEmpty() )
+        {
+            ret.append(DxccEntity());
+            continue;
+        }
+
+        auto it = resolved.find(callsign);
+
+        if ( it == resolved.end() )
+        {
+            Resolved entry;
+            entry.parsed = parse(callsign);
+            entry.ad1c = ad1cIndex.lookup(entry.parsed.lookupPrefix, entry.parsed.base);
+            it = resolved.insert(callsign, entry);
+        }
+
+        ret.append(resolveClublog(callsign, it->parsed, it->ad1c, dates.at(i)));
+    }
+
+    qCDebug(runtime) << callsigns.size() << "callsigns," << resolved.size() << "distinct";
+
+    return ret;
+}
+
+DxccSnapshot::ParsedCallsign DxccSnapshot::parse(const QString &callsign)
+{
+    const Callsign parsedCallsign(callsign);
+    ParsedCallsign ret;
+
+    ret.lookupPrefix = ( parsedCallsign.isValid() ) ? parsedCallsign.getDXCCLookupPrefix()
+                                                    : callsign;
+    ret.base = parsedCallsign.getBase();
+    return ret;
+}
+
+DxccEntity DxccSnapshot::resolveClublog(const QString &callsign,
+                                        const ParsedCallsign &parsed,
+                                        const DxccEntity &ad1cDXCCData,
+                                        const QDateTime &date) const
+{
+    DxccEntity dxccRet;
+    bool isExactMatch = false;
+
+    if ( !clublogIndex.lookup(parsed.lookupPrefix, callsign, date, dxccRet, &isExactMatch) )
+        return ad1cDXCCData;
+
+    // find the exceptions to the exceptions
+    if ( !isExactMatch
+         && dxccRet.prefix == QLatin1String("KG4")
+         && parsed.base.size() != 5 )
+    {
+        //only KG4AA - KG4ZZ are US Navy in Guantanamo Bay. Other KG4s are USA
+        dxccRet = ad1cIndex.entity(291); // USA
+
+        //do not overwrite the original prefix
+        dxccRet.prefix = "KG4";
+    }
+
+    // Clublog does not distribute ITUZ for the zone exceptions;
+    // AD1C is used when it agrees on the entity and the CQ zone
+    if ( ad1cDXCCData.dxcc == dxccRet.dxcc && ad1cDXCCData.cqz == dxccRet.cqz )
+        dxccRet.ituz = ad1cDXCCData.ituz;
+
+    return dxccRet;
+}
@@ -0,0 +1,63 @@
+#ifndef QLOG_DATA_DXCCSNAPSHOT_H
+#define QLOG_DATA_DXCCSNAPSHOT_H
+
+#include <QSharedPointer>
+#include <QDateTime>
+#include <QSqlDatabase>
+#include "Dxcc.h"
+#include "DxccAD1CIndex.h"
+#include "DxccClublogIndex.h"
+
+// Immutable set of the DXCC indexes loaded from the AD1C and Clublog tables.
+// The snapshot is never modified after create() therefore all lookup methods
+// can be called from any thread without locking. Data publishes a new snapshot
+// after every CTY update; a reader holding the old Ptr keeps using it until
+// the reader releases it.
+// Note: DxccEntity::flag is not filled - the flag visibility is a GUI setting
+// (see Data::dxccFlag).
+class DxccSnapshot
+{
+public:
+    using Ptr = QSharedPointer<const DxccSnapshot>;
+
+    // Loads the indexes from the database. It must be called from the thread
+    // that owns the db connection.
+    static Ptr create(const QSqlDatabase &db = QSqlDatabase::database());
+
+    bool hasAD1C() const { return !ad1cIndex.isEmpty(); }
+    bool hasClublog() const { return !clublogIndex.isEmpty(); }
+
+    DxccEntity lookupAD1C(const QString &callsign) const;
+    DxccEntity lookupClublog(const QString &callsign,
+                             const QDateTime &date = QDateTime::currentDateTimeUtc()) const;
+
+    // Batch variants - every distinct callsign is parsed and resolved only once.
+    // The results are returned in the input order.
+    QList<DxccEntity> lookupAD1C(const QList<QString> &callsigns) const;
+    // dates[i] belongs to callsigns[i]; both lists must have the same size
+    QList<DxccEntity> lookupClublog(const QList<QString> &callsigns,
+                                    const QList<QDateTime> &dates) const;
+
+    DxccEntity entityAD1C(int dxccID) const { return ad1cIndex.entity(dxccID); }
+    DxccEntity entityClublog(int dxccID) const { return clublogIndex.entity(dxccID); }
+
+private:
+    DxccSnapshot() = default;
+
+    struct ParsedCallsign
+    {
+        QString lookupPrefix;
+        QString base;
+    };
+
+    static ParsedCallsign parse(const QString &callsign);
+    DxccEntity resolveClublog(const QString &callsign,
+                              const ParsedCallsign &parsed,
+                              const DxccEntity &ad1cDXCCData,
+                              const QDateTime &date) const;
+
+    DxccAD1CIndex ad1cIndex;
+    DxccClublogIndex clublogIndex;
+};
+
+#endif // QLOG_DATA_DXCCSNAPSHOT_H
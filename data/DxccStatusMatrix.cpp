@@ -0,0 +1,290 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include "DxccStatusMatrix.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.dxccstatusmatrix");
+
+const int DxccStatusMatrix::ALL_MY_DXCC;
+
+bool DxccStatusMatrix::load(const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+
+    if ( !loadModeGroups(db) || !aggregate(db, -1) )
+    {
+        clear();
+        return false;
+    }
+
+    loaded = true;
+
+    qCDebug(runtime) << "DXCC status matrix loaded:" << rows.size() << "rows,"
+                     << bandIndexes.size() << "bands,"
+                     << modeIndexes.size() << "mode groups in" << timer.elapsed() << "ms";
+    return true;
+}
+
+bool DxccStatusMatrix::reloadEntities(const QSet<uint> &entities, const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << entities;
+
+    // not loaded yet - the first load reads the current data
+    if ( !loaded )
+        return true;
+
+    for ( uint entity : entities )
+    {
+        for ( auto it = rows.begin(); it != rows.end(); )
+        {
+            if ( static_cast<quint32>(it.key()) == entity )
+                it = rows.erase(it);
+            else
+                ++it;
+        }
+
+        if ( !aggregate(db, static_cast<int>(entity)) )
+        {
+            // the matrix would be inconsistent; it is loaded again on the next use
+            clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void DxccStatusMatrix::clear()
+{
+    FCT_IDENTIFICATION;
+
+    loaded = false;
+    modeGroups.clear();
+    bandIndexes.clear();
+    modeIndexes.clear();
+    rows.clear();
+}
+
+void DxccStatusMatrix::updateContact(const QSqlRecord &oldRecord, const QSqlRecord &newRecord)
+{
+    FCT_IDENTIFICATION;
+
+    removeContact(oldRecord);
+    addContact(newRecord);
+}
+
+DxccStatus DxccStatusMatrix::status(int dxcc,
+                                    int myDxcc,
+                                    const QString &band,
+                                    const QString &modeGroup,
+                                    int confirmedBy) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    const auto rowIt = rows.constFind(rowKey(( myDxcc != 0 ) ? myDxcc : static_cast<int>(ALL_MY_DXCC), dxcc));
+
+    if ( rowIt == rows.constEnd() || rowIt->total == 0 )
+        return DxccStatus::NewEntity;
+
+    const EntityRow &row = rowIt.value();
+    const int bandIdx = bandIndexes.value(band, -1);
+    const int modeIdx = modeIndexes.value(modeGroup, -1);
+    const bool bandWorked = bandIdx >= 0 && bandIdx < row.bands.size() && row.bands.at(bandIdx) > 0;
+    const bool modeWorked = modeIdx >= 0 && modeIdx < row.modes.size() && row.modes.at(modeIdx) > 0;
+
+    if ( !bandWorked )
+        return ( modeWorked ) ? DxccStatus::NewBand : DxccStatus::NewBandMode;
+
+    if ( !modeWorked )
+        return DxccStatus::NewMode;
+
+    const Counters slot = ( bandIdx < row.slots.size() && modeIdx < row.slots.at(bandIdx).size() )
+                          ? row.slots.at(bandIdx).at(modeIdx)
+                          : Counters();
+
+    if ( slot.worked == 0 )
+        return DxccStatus::NewSlot;
+
+    if ( ( ( confirmedBy & CONFIRMED_BY_LOTW ) && slot.lotw > 0 )
+         || ( ( confirmedBy & CONFIRMED_BY_PAPER ) && slot.paper > 0 )
+         || ( ( confirmedBy & CONFIRMED_BY_EQSL ) && slot.eqsl > 0 ) )
+        return DxccStatus::Confirmed;
+
+    return DxccStatus::Worked;
+}
+
+void DxccStatusMatrix::addCount(quint32 &counter, qint64 delta)
+{
+    if ( delta < 0 && counter < static_cast<quint64>(-delta) )
+    {
+        qCDebug(runtime) << "Counter underflow" << counter << delta;
+        counter = 0;
+        return;
+    }
+    counter = static_cast<quint32>(counter + delta);
+}
+
+bool DxccStatusMatrix::loadModeGroups(const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    QSqlQuery query(db);
+
+    if ( !query.exec("SELECT name, dxcc FROM modes") )
+    {
+        qCWarning(runtime) << "Cannot load mode groups" << query.lastError();
+        return false;
+    }
+
+    while ( query.next() )
+        modeGroups.insert(query.value(0).toString(), query.value(1).toString());
+
+    return true;
+}
+
+QString DxccStatusMatrix::aggregateStatement(bool singleDxcc)
+{
+    return QString("SELECT c.my_dxcc, c.dxcc, c.band, m.dxcc, COUNT(*), "
+                   "       SUM(CASE WHEN c.lotw_qsl_rcvd = 'Y' THEN 1 ELSE 0 END), "
+                   "       SUM(CASE WHEN c.qsl_rcvd = 'Y' THEN 1 ELSE 0 END), "
+                   "       SUM(CASE WHEN c.eqsl_qsl_rcvd = 'Y' THEN 1 ELSE 0 END) "
+                   "FROM contacts c "
+                   "     LEFT JOIN modes m ON (m.name = c.mode) "
+                   "WHERE c.dxcc IS NOT NULL %1 "
+                   "GROUP BY c.my_dxcc, c.dxcc, c.band, m.dxcc")
+            .arg(( singleDxcc ) ? QLatin1String("AND c.dxcc = :dxcc") : QLatin1String(""));
+}
+
+bool DxccStatusMatrix::aggregate(const QSqlDatabase &db, int dxcc)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << dxcc;
+
+    QSqlQuery query(db);
+
+    if ( !query.prepare(aggregateStatement(dxcc >= 0)) )
+    {
+        qCWarning(runtime) << "Cannot prepare aggregate statement" << query.lastError();
+        return false;
+    }
+
+    if ( dxcc >= 0 )
+        query.bindValue(":dxcc", dxcc);
+
+    if ( !query.exec() )
+    {
+        qCWarning(runtime) << "Cannot execute aggregate statement" << query.lastError();
+        return false;
+    }
+
+    while ( query.next() )
+    {
+        apply(query.value(0).toInt(),
+              query.value(1).toInt(),
+              query.value(2).toString(),
+              query.value(3).toString(),
+              query.value(4).toLongLong(),
+              query.value(5).toLongLong(),
+              query.value(6).toLongLong(),
+              query.value(7).toLongLong());
+    }
+    return true;
+}
+
+int DxccStatusMatrix::bandIndex(const QString &band)
+{
+    auto it = bandIndexes.constFind(band);
+
+    if ( it != bandIndexes.constEnd() )
+        return it.value();
+
+    const int index = bandIndexes.size();
+    bandIndexes.insert(band, index);
+    return index;
+}
+
+int DxccStatusMatrix::modeIndex(const QString &modeGroup)
+{
+    if ( modeGroup.isEmpty() )
+        return -1;
+
+    auto it = modeIndexes.constFind(modeGroup);
+
+    if ( it != modeIndexes.constEnd() )
+        return it.value();
+
+    const int index = modeIndexes.size();
+    modeIndexes.insert(modeGroup, index);
+    return index;
+}
+
+void DxccStatusMatrix::apply(int myDxcc, int dxcc, const QString &band, const QString &modeGroup,
+                             qint64 count, qint64 lotw, qint64 paper, qint64 eqsl)
+{
+    const int bandIdx = bandIndex(band);
+    const int modeIdx = modeIndex(modeGroup);
+
+    // the same QSO is counted in its my_dxcc row and in the row for all my_dxcc
+    for ( const int rowMyDxcc : { myDxcc, static_cast<int>(ALL_MY_DXCC) } )
+    {
+        EntityRow &row = rows[rowKey(rowMyDxcc, dxcc)];
+
+        addCount(row.total, count);
+
+        if ( row.bands.size() <= bandIdx )
+            row.bands.resize(bandIdx + 1);
+        addCount(row.bands[bandIdx], count);
+
+        // the mode is not in the modes table - counted only for the entity and the band
+        if ( modeIdx < 0 )
+            continue;
+
+        if ( row.modes.size() <= modeIdx )
+            row.modes.resize(modeIdx + 1);
+        addCount(row.modes[modeIdx], count);
+
+        if ( row.slots.size() <= bandIdx )
+            row.slots.resize(bandIdx + 1);
+
+        QVector<Counters> &bandSlots = row.slots[bandIdx];
+
+        if ( bandSlots.size() <= modeIdx )
+            bandSlots.resize(modeIdx + 1);
+
+        Counters &slot = bandSlots[modeIdx];
+        addCount(slot.worked, count);
+        addCount(slot.lotw, lotw);
+        addCount(slot.paper, paper);
+        addCount(slot.eqsl, eqsl);
+    }
+}
+
+void DxccStatusMatrix::applyContact(const QSqlRecord &record, int sign)
+{
+    FCT_IDENTIFICATION;
+
+    if ( !loaded )
+        return;
+
+    const QVariant &dxcc = record.value("dxcc");
+
+    if ( dxcc.isNull() )
+        return;
+
+    apply(record.value("my_dxcc").toInt(),
+          dxcc.toInt(),
+          record.value("band").toString(),
+          modeGroup(record.value("mode").toString()),
+          sign,
+          ( record.value("lotw_qsl_rcvd").toString() == QLatin1String("Y") ) ? sign : 0,
+          ( record.value("qsl_rcvd").toString() == QLatin1String("Y") ) ? sign : 0,
+          ( record.value("eqsl_qsl_rcvd").toString() == QLatin1String("Y") ) ? sign : 0);
+}
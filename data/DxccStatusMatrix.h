@@ -0,0 +1,95 @@
+#ifndef QLOG_DATA_DXCCSTATUSMATRIX_H
+#define QLOG_DATA_DXCCSTATUSMATRIX_H
+
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QSqlDatabase>
+#include <QSqlRecord>
+#include "Dxcc.h"
+
+// In-memory worked/confirmed matrix used to answer Data::dxccStatus.
+// For every (my_dxcc, dxcc) pair it keeps QSO counters per band, per DXCC
+// mode group and per band x mode group slot, together with the number of
+// LoTW, paper and eQSL confirmations of the slot. Counters are used instead
+// of plain bits so that a deleted or changed QSO can be subtracted without
+// rescanning the logbook.
+// The matrix is filled by one aggregate scan over contacts and then kept
+// in sync by addContact/removeContact or by reloading single entities.
+class DxccStatusMatrix
+{
+public:
+    enum ConfirmedBy
+    {
+        CONFIRMED_BY_LOTW = 0b1,
+        CONFIRMED_BY_PAPER = 0b10,
+        CONFIRMED_BY_EQSL = 0b100
+    };
+
+    // myDxcc value used for the statistics over all my_dxcc values
+    static const int ALL_MY_DXCC = -1;
+
+    bool load(const QSqlDatabase &db = QSqlDatabase::database());
+    bool reloadEntities(const QSet<uint> &entities,
+                        const QSqlDatabase &db = QSqlDatabase::database());
+    void clear();
+    bool isLoaded() const { return loaded; }
+
+    void addContact(const QSqlRecord &record) { applyContact(record, 1); }
+    void removeContact(const QSqlRecord &record) { applyContact(record, -1); }
+    void updateContact(const QSqlRecord &oldRecord, const QSqlRecord &newRecord);
+
+    // modeGroup is a DXCC mode group (CW, PHONE, DIGITAL) - see modeGroup()
+    // myDxcc == 0 means all my_dxcc values
+    DxccStatus status(int dxcc,
+                      int myDxcc,
+                      const QString &band,
+                      const QString &modeGroup,
+                      int confirmedBy) const;
+
+    // returns the DXCC mode group for the mode name; an empty string if it is unknown
+    QString modeGroup(const QString &mode) const { return modeGroups.value(mode); }
+
+    // the aggregate statement - over all entities or for one (:dxcc);
+    // tests/QueryPlanTest checks its query plan
+    static QString aggregateStatement(bool singleDxcc);
+
+private:
+    struct Counters
+    {
+        quint32 worked = 0;
+        quint32 lotw = 0;
+        quint32 paper = 0;
+        quint32 eqsl = 0;
+    };
+
+    struct EntityRow
+    {
+        quint32 total = 0;
+        QVector<quint32> bands;               // [band index] -> QSO count
+        QVector<quint32> modes;               // [mode group index] -> QSO count
+        QVector<QVector<Counters>> slots;     // [band index][mode group index]
+    };
+
+    static quint64 rowKey(int myDxcc, int dxcc)
+    {
+        return ( static_cast<quint64>(static_cast<quint32>(myDxcc)) << 32 ) | static_cast<quint32>(dxcc);
+    }
+    static void addCount(quint32 &counter, qint64 delta);
+
+    bool loadModeGroups(const QSqlDatabase &db);
+    bool aggregate(const QSqlDatabase &db, int dxcc);
+    int bandIndex(const QString &band);
+    int modeIndex(const QString &modeGroup);
+    void apply(int myDxcc, int dxcc, const QString &band, const QString &modeGroup,
+               qint64 count, qint64 lotw, qint64 paper, qint64 eqsl);
+    void applyContact(const QSqlRecord &record, int sign);
+
+    bool loaded = false;
+    QHash<QString, QString> modeGroups;    // mode name -> DXCC mode group
+    QHash<QString, int> bandIndexes;
+    QHash<QString, int> modeIndexes;
+    QHash<quint64, EntityRow> rows;
+};
+
+#endif // QLOG_DATA_DXCCSTATUSMATRIX_H
@@ -0,0 +1,149 @@
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QTimeZone>
+#include <cmath>
+#include <algorithm>
+#include "ImportDupeIndex.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.importdupeindex");
+
+bool ImportDupeIndex::load(const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    clear();
+
+    QSqlQuery query(db);
+
+    // start time is converted by SQLite itself to get the same value as JULIANDAY in the former statement
+    if ( !query.exec(QLatin1String("SELECT id, callsign, upper(band), upper(mode), COALESCE(sat_name, ''), "
+                                   "       (JULIANDAY(start_time) - 2440587.5) * 86400000.0 "
+                                   "FROM contacts "
+                                   "WHERE start_time IS NOT NULL")) )
+    {
+        qCWarning(runtime) << "Cannot load contacts" << query.lastError();
+        clear();
+        return false;
+    }
+
+    while ( query.next() )
+    {
+        const QVariant &startMSecs = query.value(5);
+
+        if ( startMSecs.isNull() )
+            continue;
+
+        insert(groupKey(query.value(1).toString(),
+                        query.value(2).toString(),
+                        query.value(3).toString(),
+                        query.value(4).toString()),
+               std::llround(startMSecs.toDouble()),
+               query.value(0).toULongLong());
+    }
+
+    loaded = true;
+
+    qCDebug(runtime) << "Import dupe index loaded:" << qsoCount << "QSOs,"
+                     << groups.size() << "groups in" << timer.elapsed() << "ms";
+    return true;
+}
+
+void ImportDupeIndex::clear()
+{
+    FCT_IDENTIFICATION;
+
+    loaded = false;
+    qsoCount = 0;
+    groups.clear();
+}
+
+void ImportDupeIndex::addContact(qulonglong id,
+                                 const QString &callsign,
+                                 const QString &band,
+                                 const QString &mode,
+                                 const QString &satName,
+                                 const QDateTime &startTime)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << id << callsign << band << mode << satName << startTime;
+
+    if ( !startTime.isValid() )
+        return;
+
+    insert(groupKey(callsign, band.toUpper(), mode.toUpper(), satName),
+           startTime.toMSecsSinceEpoch(),
+           id);
+}
+
+qulonglong ImportDupeIndex::findDuplicate(const QString &callsign,
+                                          const QString &band,
+                                          const QString &mode,
+                                          const QString &satName,
+                                          const QDateTime &startTime) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( !startTime.isValid() )
+        return 0;
+
+    const auto groupIt = groups.constFind(groupKey(callsign.toUpper(), band.toUpper(), mode.toUpper(), satName));
+
+    if ( groupIt == groups.constEnd() )
+        return 0;
+
+    // the former statement compared against the start time formatted with a second precision
+    const qint64 startSecs = startTime.toTimeZone(QTimeZone::utc()).toSecsSinceEpoch();
+    const qint64 startMSecs = startSecs * 1000;
+    const QVector<TimeEntry> &entries = groupIt.value();
+
+    // the first QSO after the beginning of the window
+    const auto it = std::upper_bound(entries.constBegin(), entries.constEnd(),
+                                     startMSecs - DUPE_WINDOW_MSECS,
+                                     [](qint64 value, const TimeEntry &entry)
+    {
+        return value < entry.first;
+    });
+
+    if ( it != entries.constEnd() && it->first < startMSecs + DUPE_WINDOW_MSECS )
+        return it->second;
+
+    return 0;
+}
+
+QString ImportDupeIndex::groupKey(const QString &callsign,
+                                  const QString &band,
+                                  const QString &mode,
+                                  const QString &satName)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    // the unit separator cannot be a part of the callsign, band, mode or sat name
+    const QChar separator(0x1F);
+    return callsign + separator + band + separator + mode + separator + satName;
+}
+
+void ImportDupeIndex::insert(const QString &key, qint64 startMSecs, qulonglong id)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    QVector<TimeEntry> &entries = groups[key];
+    const TimeEntry entry(startMSecs, id);
+
+    // the contacts are usually loaded and imported in the time order - append is the common case
+    if ( entries.isEmpty() || entries.constLast().first <= startMSecs )
+        entries.append(entry);
+    else
+        entries.insert(std::upper_bound(entries.begin(), entries.end(), entry,
+                                        [](const TimeEntry &a, const TimeEntry &b)
+        {
+            return a.first < b.first;
+        }), entry);
+
+    qsoCount++;
+}
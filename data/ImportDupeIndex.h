@@ -0,0 +1,58 @@
+#ifndef QLOG_DATA_IMPORTDUPEINDEX_H
+#define QLOG_DATA_IMPORTDUPEINDEX_H
+
+#include <QHash>
+#include <QVector>
+#include <QPair>
+#include <QDateTime>
+#include <QSqlDatabase>
+
+// In-memory index of the contacts table used by the import duplicate check.
+// QSOs are grouped by (callsign, upper band, upper mode, sat_name) and every
+// group keeps the QSO start times sorted, so the 30-minute window is found
+// by a binary search instead of evaluating JULIANDAY for every candidate row.
+// The matching rules are the same as the former SQL statement:
+//   callsign = upper(:callsign), upper(mode/band) = upper(:mode/:band),
+//   COALESCE(sat_name, '') = COALESCE(:sat_name, ''),
+//   |start_time - :startdate| < 30 minutes, :startdate with a second precision
+class ImportDupeIndex
+{
+public:
+    static const qint64 DUPE_WINDOW_MSECS = 30 * 60 * 1000;
+
+    bool load(const QSqlDatabase &db = QSqlDatabase::database());
+    void clear();
+    bool isLoaded() const { return loaded; }
+
+    // the values are passed as they are stored in the contacts table
+    void addContact(qulonglong id,
+                    const QString &callsign,
+                    const QString &band,
+                    const QString &mode,
+                    const QString &satName,
+                    const QDateTime &startTime);
+
+    // returns the contacts.id of a duplicate QSO; 0 if no duplicate exists
+    qulonglong findDuplicate(const QString &callsign,
+                             const QString &band,
+                             const QString &mode,
+                             const QString &satName,
+                             const QDateTime &startTime) const;
+
+    int size() const { return qsoCount; }
+
+private:
+    using TimeEntry = QPair<qint64, qulonglong>;    // start time in msecs since epoch, contacts.id
+
+    static QString groupKey(const QString &callsign,
+                            const QString &band,
+                            const QString &mode,
+                            const QString &satName);
+    void insert(const QString &key, qint64 startMSecs, qulonglong id);
+
+    bool loaded = false;
+    int qsoCount = 0;
+    QHash<QString, QVector<TimeEntry>> groups;
+};
+
+#endif // QLOG_DATA_IMPORTDUPEINDEX_H
@@ -0,0 +1,190 @@
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QPair>
+#include <algorithm>
+#include <cstring>
+#include "RefStringTable.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.data.refstringtable");
+
+RefStringTable::Ptr RefStringTable::load(const QString &statement, const QSqlDatabase &db)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << statement;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlQuery query(db);
+
+    if ( !query.exec(statement) )
+    {
+        qCWarning(runtime) << "Cannot load reference table" << query.lastError();
+        return Ptr();
+    }
+
+    RefStringTable *table = new RefStringTable();
+
+    const bool withValues = query.record().count() > 1;
+    QVector<QPair<QByteArray, QByteArray>> rows;
+
+    while ( query.next() )
+    {
+        rows.append(qMakePair(query.value(0).toString().toUtf8(),
+                              ( withValues ) ? query.value(1).toString().toUtf8() : QByteArray()));
+    }
+
+    // the stable sort keeps the DB order of duplicates; the last one wins
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const QPair<QByteArray, QByteArray> &a, const QPair<QByteArray, QByteArray> &b)
+    {
+        return a.first < b.first;
+    });
+
+    int keyBytes = 0;
+    int valueBytes = 0;
+
+    for ( const auto &row : rows )
+    {
+        keyBytes += row.first.size();
+        valueBytes += row.second.size();
+    }
+
+    table->keyData.reserve(keyBytes);
+    table->keyOffsets.reserve(rows.size() + 1);
+
+    if ( withValues )
+    {
+        table->valueData.reserve(valueBytes);
+        table->valueOffsets.reserve(rows.size() + 1);
+        table->valueOffsets.append(0);
+    }
+
+    for ( int i = 0; i < rows.size(); ++i )
+    {
+        if ( i + 1 < rows.size() && rows.at(i + 1).first == rows.at(i).first )
+            continue;
+
+        table->keyData.append(rows.at(i).first);
+        table->keyOffsets.append(table->keyData.size());
+
+        if ( withValues )
+        {
+            table->valueData.append(rows.at(i).second);
+            table->valueOffsets.append(table->valueData.size());
+        }
+    }
+
+    qCDebug(runtime) << "Reference table loaded:" << table->size() << "codes,"
+                     << table->keyData.size() + table->valueData.size() << "bytes in"
+                     << timer.elapsed() << "ms";
+
+    return Ptr(table);
+}
+
+QString RefStringTable::key(int index) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( index < 0 || index >= size() )
+        return QString();
+
+    return QString::fromUtf8(keyData.constData() + keyOffsets.at(index),
+                             keyOffsets.at(index + 1) - keyOffsets.at(index));
+}
+
+QString RefStringTable::value(int index) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( !hasValues() || index < 0 || index >= size() )
+        return QString();
+
+    return QString::fromUtf8(valueData.constData() + valueOffsets.at(index),
+                             valueOffsets.at(index + 1) - valueOffsets.at(index));
+}
+
+int RefStringTable::indexOf(const QString &key) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    const QByteArray &utf8Key = key.toUtf8();
+    int low = 0;
+    int high = size();
+
+    while ( low < high )
+    {
+        const int mid = low + ( high - low ) / 2;
+        const int cmp = compareKey(mid, utf8Key);
+
+        if ( cmp == 0 )
+            return mid;
+
+        if ( cmp < 0 )
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return -1;
+}
+
+QPair<int, int> RefStringTable::prefixRange(const QString &prefix) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    const QByteArray &utf8Prefix = prefix.toUtf8();
+
+    // the keys with the prefix follow the keys lower than the prefix
+    int low = 0;
+    int high = size();
+
+    while ( low < high )
+    {
+        const int mid = low + ( high - low ) / 2;
+
+        if ( compareKey(mid, utf8Prefix) < 0 )
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    const int first = low;
+    high = size();
+
+    while ( low < high )
+    {
+        const int mid = low + ( high - low ) / 2;
+
+        if ( keyStartsWith(mid, utf8Prefix) )
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return qMakePair(first, low);
+}
+
+int RefStringTable::compareKey(int index, const QByteArray &other) const
+{
+    const int length = keyOffsets.at(index + 1) - keyOffsets.at(index);
+    const int cmp = std::memcmp(keyData.constData() + keyOffsets.at(index),
+                                other.constData(),
+                                qMin(length, static_cast<int>(other.size())));
+
+    if ( cmp != 0 )
+        return cmp;
+
+    return ( length < other.size() ) ? -1 : ( ( length > other.size() ) ? 1 : 0 );
+}
+
+bool RefStringTable::keyStartsWith(int index, const QByteArray &prefix) const
+{
+    const int length = keyOffsets.at(index + 1) - keyOffsets.at(index);
+
+    return length >= prefix.size()
+           && std::memcmp(keyData.constData() + keyOffsets.at(index), prefix.constData(), prefix.size()) == 0;
+}
@@ -0,0 +1,53 @@
+#ifndef QLOG_DATA_REFSTRINGTABLE_H
+#define QLOG_DATA_REFSTRINGTABLE_H
+
+#include <QByteArray>
+#include <QVector>
+#include <QPair>
+#include <QString>
+#include <QSharedPointer>
+#include <QSqlDatabase>
+
+// Immutable sorted table of reference codes (SOTA, POTA, WWFF, IOTA) with
+// an optional text per code. All codes are stored in one contiguous UTF-8
+// buffer addressed by an offset array, which replaces one map node and one
+// QString allocation per reference. Codes are sorted by their UTF-8 bytes
+// so membership and prefix queries are binary searches.
+class RefStringTable
+{
+public:
+    using Ptr = QSharedPointer<const RefStringTable>;
+
+    // The statement returns the code in the first column and optionally
+    // the text in the second one. Duplicate codes keep the last row.
+    // Returns a null pointer if the statement fails.
+    static Ptr load(const QString &statement,
+                    const QSqlDatabase &db = QSqlDatabase::database());
+
+    int size() const { return keyOffsets.size() - 1; }
+    bool isEmpty() const { return size() <= 0; }
+    bool hasValues() const { return !valueOffsets.isEmpty(); }
+
+    QString key(int index) const;
+    QString value(int index) const;
+
+    // returns -1 if the key is not in the table
+    int indexOf(const QString &key) const;
+    bool contains(const QString &key) const { return indexOf(key) >= 0; }
+
+    // index range [first, second) of the keys starting with the prefix
+    QPair<int, int> prefixRange(const QString &prefix) const;
+
+private:
+    RefStringTable() = default;
+
+    int compareKey(int index, const QByteArray &other) const;
+    bool keyStartsWith(int index, const QByteArray &prefix) const;
+
+    QByteArray keyData;
+    QVector<quint32> keyOffsets = {0};    // key i is [keyOffsets[i], keyOffsets[i + 1])
+    QByteArray valueData;
+    QVector<quint32> valueOffsets;        // empty if the statement has no text column
+};
+
+#endif // QLOG_DATA_REFSTRINGTABLE_H
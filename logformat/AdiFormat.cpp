@@ -1,6 +1,8 @@
 #include <QSqlRecord>
 #include <QDebug>
 #include <QSqlField>
+#include <QBuffer>
+#include <QFileDevice>
 #include "data/Data.h"
 #include "AdiFormat.h"
 #include "core/debug.h"
@@ -39,9 +41,12 @@ void AdiFormat::exportContact(const QSqlRecord& record,
     QSqlRecord exportRecord(record);
     normalizeGridFields(exportRecord);
 
+    // the whole record is written to the stream at once
+    rowBuffered = true;
     writeSQLRecord(exportRecord, applTags);
-
-    stream << "<eor>\n\n";
+    rowBuffer.append(QLatin1String("<eor>\n\n"));
+    rowBuffered = false;
+    flushRow();
 }
 
 void AdiFormat::normalizeGridFields(QSqlRecord &record)
@@ -63,7 +68,7 @@ void AdiFormat::normalizeGridFields(QSqlRecord &record)
 void AdiFormat::writeField(const QString &name, bool presenceCondition,
                            const QString &value, const QString &type)
 {
-    FCT_IDENTIFICATION;
+    // Hot path - no FCT_IDENTIFICATION here
 
     qCDebug(function_parameters)<< name
                                 << presenceCondition
@@ -72,84 +77,191 @@ void AdiFormat::writeField(const QString &name, bool presenceCondition,
 
     if (!presenceCondition) return;
 
+    appendField(QLatin1Char('<') + name + QLatin1Char(':'),
+                ( type.isEmpty() ) ? QStringLiteral(">") : QLatin1Char(':') + type + QLatin1Char('>'),
+                value,
+                preserveFieldLineBreaks(name, type));
+}
+
+void AdiFormat::writeExportColumn(const ExportColumn &column, const QString &value)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    appendField(column.tagPrefix, column.tagSuffix, value, column.preserveLineBreaks);
+}
+
+void AdiFormat::appendField(const QString &tagPrefix,
+                            const QString &tagSuffix,
+                            const QString &value,
+                            bool preserveLineBreaks)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( value.isEmpty() ) return;
+
     /* ADIF does not support UTF-8 characterset therefore the Accents are remove */
     const QString accentless(normalizeLineBreaks(Data::removeAccents(value),
-                                                 preserveFieldLineBreaks(name, type),
+                                                 preserveLineBreaks,
                                                  QStringLiteral("\r\n")));
 
-    qCDebug(runtime) << "Accentless: " << accentless;
+    if ( accentless.isEmpty() ) return;
 
-    if ( value.isEmpty() || accentless.isEmpty() ) return;
+    rowBuffer.append(tagPrefix);
+    rowBuffer.append(QString::number(accentless.size()));
+    rowBuffer.append(tagSuffix);
+    rowBuffer.append(accentless);
+    rowBuffer.append(QLatin1Char('\n'));
 
-    stream << "<" << name << ":" << accentless.size();
+    if ( !rowBuffered )
+        flushRow();
+}
+
+void AdiFormat::flushRow()
+{
+    // Hot path - no FCT_IDENTIFICATION here
 
-    if (!type.isEmpty()) stream << ":" << type;
+    if ( rowBuffer.isEmpty() ) return;
 
-    stream << ">" << accentless << '\n';
+    stream << rowBuffer;
+
+    // keep the allocated capacity for the next record
+    rowBuffer.resize(0);
 }
 
-void AdiFormat::writeSQLRecord(const QSqlRecord &record,
-                               QMap<QString, QString> *applTags)
+AdiFormat::ExportColumn AdiFormat::exportColumn(int index,
+                                                const QString &ADIFName,
+                                                OutputFieldFormatter formatter,
+                                                const QString &outputType)
 {
-    FCT_IDENTIFICATION;
+    ExportColumn column;
+
+    column.index = index;
+    column.ADIFName = ADIFName;
+    column.outputType = outputType;
+    column.formatter = fieldFormatter(formatter);
+    column.preserveLineBreaks = preserveFieldLineBreaks(ADIFName, outputType);
+    column.isApplicationField = ADIFName.startsWith(QStringLiteral("app_"), Qt::CaseInsensitive);
+    column.tagPrefix = QLatin1Char('<') + ADIFName + QLatin1Char(':');
+    column.tagSuffix = ( outputType.isEmpty() ) ? QStringLiteral(">")
+                                                : QLatin1Char(':') + outputType + QLatin1Char('>');
+    column.elementName = ADIFName.toUpper();
+    return column;
+}
 
-    for ( int i = 0; i <= record.count(); i++)
-    {
-        const QSqlField &tmpField = record.field(i);
-        const ExportParams &ExportParams = DB2ADIFExportParams.value(tmpField.name());
-
-        if ( ExportParams.isValid )
-            writeField(ExportParams.ADIFName,
-                       tmpField.isValid(),
-                       formatOuput(ExportParams.formatter, tmpField.value()),
-                       ExportParams.outputType );
-    }
+const AdiFormat::ExportPlan &AdiFormat::exportPlanFor(const QSqlRecord &record)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    bool sameLayout = ( exportPlan.fieldNames.size() == record.count() );
 
-    const QVariant &startVariant = record.value("start_time");
+    for ( int i = 0; sameLayout && i < record.count(); i++ )
+        sameLayout = ( record.fieldName(i) == exportPlan.fieldNames.at(i) );
 
-    if ( startVariant.isValid() )
+    if ( sameLayout && !exportPlan.fieldNames.isEmpty() )
+        return exportPlan;
+
+    qCDebug(runtime) << "Compiling export plan for" << record.count() << "columns";
+
+    exportPlan = ExportPlan();
+
+    for ( int i = 0; i < record.count(); i++ )
     {
-        const QDateTime &time_start = startVariant.toDateTime().toTimeZone(QTimeZone::utc());
-        writeField("qso_date", startVariant.isValid(),
-                   formatOuput(OutputFieldFormatter::TODATE, time_start));
-        writeField("time_on", startVariant.isValid(),
-                   formatOuput(OutputFieldFormatter::TOTIME, time_start));
+        const QString &fieldName = record.fieldName(i);
+        exportPlan.fieldNames << fieldName;
+
+        const ExportParams &params = DB2ADIFExportParams.value(fieldName);
+
+        if ( params.isValid )
+            exportPlan.columns << exportColumn(i, params.ADIFName, params.formatter, params.outputType);
     }
 
-    const QVariant &endVariant = record.value("end_time");
+    exportPlan.startTimeIndex = record.indexOf("start_time");
+    exportPlan.endTimeIndex = record.indexOf("end_time");
+    exportPlan.fieldsIndex = record.indexOf("fields");
+    exportPlan.qsoDate = exportColumn(exportPlan.startTimeIndex, "qso_date", OutputFieldFormatter::TODATE);
+    exportPlan.timeOn = exportColumn(exportPlan.startTimeIndex, "time_on", OutputFieldFormatter::TOTIME);
+    exportPlan.qsoDateOff = exportColumn(exportPlan.endTimeIndex, "qso_date_off", OutputFieldFormatter::TODATE);
+    exportPlan.timeOff = exportColumn(exportPlan.endTimeIndex, "time_off", OutputFieldFormatter::TOTIME);
+
+    const QStringList &intlFieldNames = fieldname2INTLNameMapping.values();
 
-    if ( endVariant.isValid() )
+    for ( const QString &intlFieldName : intlFieldNames )
     {
-        const QDateTime &time_end = record.value("end_time").toDateTime().toTimeZone(QTimeZone::utc());
-        writeField("qso_date_off", endVariant.isValid(),
-                   formatOuput(OutputFieldFormatter::TODATE, time_end));
-        writeField("time_off", endVariant.isValid(),
-                   formatOuput(OutputFieldFormatter::TOTIME, time_end));
+        const int index = record.indexOf(intlFieldName);
+
+        if ( index >= 0 )
+            exportPlan.intlColumns << exportColumn(index, intlFieldName);
     }
 
-    const QJsonObject &fields = QJsonDocument::fromJson(record.value("fields").toByteArray()).object();
+    return exportPlan;
+}
+
+void AdiFormat::writeSQLRecord(const QSqlRecord &record,
+                               QMap<QString, QString> *applTags)
+{
+    FCT_IDENTIFICATION;
+
+    const bool ownRow = !rowBuffered;
+    rowBuffered = true;
+
+    const ExportPlan &plan = exportPlanFor(record);
 
-    const QStringList &keys = fields.keys();
-    for (const QString &key : keys)
+    for ( const ExportColumn &column : plan.columns )
+        writeExportColumn(column, (this->*column.formatter)(record.value(column.index)));
+
+    if ( plan.startTimeIndex >= 0 )
     {
-        if ( !isExportableFieldName(key) )
+        const QVariant &startVariant = record.value(plan.startTimeIndex);
+
+        if ( startVariant.isValid() )
         {
-            qCDebug(runtime) << "Skipping invalid ADIF field from fields JSON:" << key;
-            continue;
+            const QDateTime &time_start = startVariant.toDateTime().toTimeZone(QTimeZone::utc());
+            writeExportColumn(plan.qsoDate, (this->*plan.qsoDate.formatter)(time_start));
+            writeExportColumn(plan.timeOn, (this->*plan.timeOn.formatter)(time_start));
         }
+    }
+
+    if ( plan.endTimeIndex >= 0 )
+    {
+        const QVariant &endVariant = record.value(plan.endTimeIndex);
 
-        const QJsonValue fieldValue = fields.value(key);
-        if ( fieldValue.isObject() )
+        if ( endVariant.isValid() )
         {
-            const QJsonObject fieldObject = fieldValue.toObject();
-            writeField(key,
-                       ALWAYS_PRESENT,
-                       fieldObject.value(QStringLiteral("value")).toString(),
-                       fieldObject.value(QStringLiteral("type")).toString());
+            const QDateTime &time_end = endVariant.toDateTime().toTimeZone(QTimeZone::utc());
+            writeExportColumn(plan.qsoDateOff, (this->*plan.qsoDateOff.formatter)(time_end));
+            writeExportColumn(plan.timeOff, (this->*plan.timeOff.formatter)(time_end));
         }
-        else
+    }
+
+    const QByteArray &fieldsData = ( plan.fieldsIndex >= 0 ) ? record.value(plan.fieldsIndex).toByteArray()
+                                                             : QByteArray();
+
+    if ( !fieldsData.isEmpty() )
+    {
+        const QJsonObject &fields = QJsonDocument::fromJson(fieldsData).object();
+
+        const QStringList &keys = fields.keys();
+        for (const QString &key : keys)
         {
-            writeField(key, ALWAYS_PRESENT, fieldValue.toString());
+            if ( !isExportableFieldName(key) )
+            {
+                qCDebug(runtime) << "Skipping invalid ADIF field from fields JSON:" << key;
+                continue;
+            }
+
+            const QJsonValue fieldValue = fields.value(key);
+            if ( fieldValue.isObject() )
+            {
+                const QJsonObject fieldObject = fieldValue.toObject();
+                writeField(key,
+                           ALWAYS_PRESENT,
+                           fieldObject.value(QStringLiteral("value")).toString(),
+                           fieldObject.value(QStringLiteral("type")).toString());
+            }
+            else
+            {
+                writeField(key, ALWAYS_PRESENT, fieldValue.toString());
+            }
         }
     }
 
@@ -162,6 +274,12 @@ void AdiFormat::writeSQLRecord(const QSqlRecord &record,
            writeField(appkey, ALWAYS_PRESENT, applTags->value(appkey));
        }
     }
+
+    if ( ownRow )
+    {
+        rowBuffered = false;
+        flushRow();
+    }
 }
 
 bool AdiFormat::isExportableFieldName(const QString &name)
@@ -584,31 +702,28 @@ void AdiFormat::contactFields2SQLRecord(QMap<QString, QVariant> &contact, QSqlRe
 
 const QString AdiFormat::formatOuput(OutputFieldFormatter formatter, const QVariant &in)
 {
-    QString ret;
+    return (this->*fieldFormatter(formatter))(in);
+}
 
+AdiFormat::FieldFormatter AdiFormat::fieldFormatter(OutputFieldFormatter formatter)
+{
+    // the formatters are virtual - the call through the pointer uses the derived format
     switch (formatter)
     {
     case TOLOWER:
-        ret = toLower(in);
-        break;
+        return &AdiFormat::toLower;
     case TOUPPER:
-        ret = toUpper(in);
-        break;
+        return &AdiFormat::toUpper;
     case TODATE:
-        ret = toDate(in);
-        break;
+        return &AdiFormat::toDate;
     case TOTIME:
-        ret = toTime(in);
-        break;
+        return &AdiFormat::toTime;
     case REMOVEDEFAULTVALUEN:
-        ret = removeDefaulValueN(in);
-        break;
+        return &AdiFormat::removeDefaulValueN;
     case TOSTRING:
     default:
-        ret = toString(in);
+        return &AdiFormat::toString;
     }
-
-    return ret;
 }
 
 const QString AdiFormat::toString(const QVariant &var)
@@ -753,6 +868,9 @@ QString AdiFormat::normalizeLineBreaks(const QString &value,
                                        bool preserveLineBreaks,
                                        const QString &lineBreak)
 {
+    if ( !value.contains(QLatin1Char('\n')) && !value.contains(QLatin1Char('\r')) )
+        return value;
+
     QString normalized(value);
     normalized.replace(QStringLiteral("\r\n"), QStringLiteral("\n"));
     normalized.replace(QLatin1Char('\r'), QLatin1Char('\n'));
@@ -769,6 +887,43 @@ bool AdiFormat::readContact(QMap<QString, QVariant>& contact)
 {
     FCT_IDENTIFICATION;
 
+    if ( tokenizerMode == TOKENIZER_UNDECIDED )
+        tokenizerMode = ( attachTokenizer() ) ? TOKENIZER_ACTIVE : TOKENIZER_UNAVAILABLE;
+
+    return ( tokenizerMode == TOKENIZER_ACTIVE ) ? readContactFromTokenizer(contact)
+                                                 : readContactFromStream(contact);
+}
+
+bool AdiFormat::readContactFromTokenizer(QVariantMap &contact)
+{
+    FCT_IDENTIFICATION;
+
+    AdiTokenizer::Field tokenField;
+
+    while ( tokenizer.next(tokenField) )
+    {
+        if ( tokenField.header )
+        {
+            if ( tokenField.valueLength > 0 )
+                headerFields.insert(QString(tokenizer.name(tokenField)).toLower(),
+                                    QString(tokenizer.value(tokenField)));
+            continue;
+        }
+
+        if ( tokenizer.isName(tokenField, "eor") )
+            return true;
+
+        if ( tokenField.nameLength > 0 )
+            contact[QString(tokenizer.name(tokenField)).toLower()] = QVariant(QString(tokenizer.value(tokenField)));
+    }
+
+    return false;
+}
+
+bool AdiFormat::readContactFromStream(QVariantMap &contact)
+{
+    FCT_IDENTIFICATION;
+
     while (!stream.atEnd())
     {
         QString field;
@@ -791,6 +946,91 @@ bool AdiFormat::readContact(QMap<QString, QVariant>& contact)
     return false;
 }
 
+bool AdiFormat::attachTokenizer()
+{
+    FCT_IDENTIFICATION;
+
+    QIODevice *device = stream.device();
+
+    if ( !device || !device->isOpen() || !device->isReadable() || device->isSequential() )
+        return false;
+
+    // QTextStream can already hold buffered data - its pos() is the logical position
+    const qint64 startPos = stream.pos();
+
+    if ( startPos < 0 || startPos > device->size() )
+        return false;
+
+    QByteArray data;
+
+    if ( QBuffer *buffer = qobject_cast<QBuffer *>(device) )
+    {
+        // share the buffer content - QBuffer data is not copied
+        data = buffer->data();
+        if ( startPos > 0 )
+            data = data.mid(startPos);
+    }
+    else if ( QFileDevice *file = qobject_cast<QFileDevice *>(device) )
+    {
+        const qint64 mapSize = file->size() - startPos;
+        uchar *map = ( mapSize > 0 ) ? file->map(startPos, mapSize) : nullptr;
+
+        if ( map )
+        {
+            mappedFile = file;
+            mappedData = map;
+            data = QByteArray::fromRawData(reinterpret_cast<const char *>(map), mapSize);
+        }
+        else if ( device->seek(startPos) )
+            data = device->readAll();
+        else
+            return false;
+    }
+    else if ( device->seek(startPos) )
+        data = device->readAll();
+    else
+        return false;
+
+    // QTextStream switches to UTF-8 when it detects BOM - keep its decoding for such files
+    if ( startPos == 0 && stream.autoDetectUnicode() && data.startsWith("\xEF\xBB\xBF") )
+    {
+        qCDebug(runtime) << "UTF-8 BOM detected, using the stream parser";
+        releaseTokenizer();
+        device->seek(startPos);
+        return false;
+    }
+
+    qCDebug(runtime) << "Tokenizer attached, bytes" << data.size() << "mapped" << ( mappedData != nullptr );
+
+    tokenizerStartPos = startPos;
+    tokenizer.reset(data);
+    return true;
+}
+
+void AdiFormat::releaseTokenizer()
+{
+    FCT_IDENTIFICATION;
+
+    tokenizer.reset(QByteArray());
+
+    if ( mappedData && mappedFile )
+        mappedFile->unmap(mappedData);
+
+    mappedData = nullptr;
+    mappedFile.clear();
+    tokenizerMode = TOKENIZER_UNDECIDED;
+}
+
+qint64 AdiFormat::importStreamPosition()
+{
+    FCT_IDENTIFICATION;
+
+    if ( tokenizerMode == TOKENIZER_ACTIVE )
+        return tokenizerStartPos + tokenizer.position();
+
+    return LogFormat::importStreamPosition();
+}
+
 AdiFormat::AdiFormat(QTextStream &stream, bool preserveFieldLengths) :
     LogFormat(stream)
 {
@@ -806,6 +1046,21 @@ AdiFormat::AdiFormat(QTextStream &stream, bool preserveFieldLengths) :
 #endif
 }
 
+LogFormat *AdiFormat::createExportWorker(QTextStream &workerStream) const
+{
+    FCT_IDENTIFICATION;
+
+    // ADI records do not depend on each other
+    return new AdiFormat(workerStream);
+}
+
+AdiFormat::~AdiFormat()
+{
+    FCT_IDENTIFICATION;
+
+    releaseTokenizer();
+}
+
 bool AdiFormat::importNext(QSqlRecord& record)
 {
     FCT_IDENTIFICATION;
@@ -833,6 +1088,7 @@ void AdiFormat::importStart()
     headerFields.clear();
     state = START;
     inHeader = false;
+    releaseTokenizer();
 }
 
 bool AdiFormat::importNextDXCCCredit(DXCCCreditRecord &credit)
@@ -1,13 +1,19 @@
 #ifndef QLOG_LOGFORMAT_ADIFORMAT_H
 #define QLOG_LOGFORMAT_ADIFORMAT_H
 
+#include <QPointer>
+#include <QVector>
 #include "LogFormat.h"
+#include "AdiTokenizer.h"
+
+class QFileDevice;
 
 class AdiFormat : public LogFormat
 {
 public:
     explicit AdiFormat(QTextStream& stream,
                        bool preserveFieldLengths = true);
+    virtual ~AdiFormat();
 
     virtual bool importNext(QSqlRecord& ) override;
 
@@ -34,6 +40,8 @@ public:
 protected:
     virtual bool importNextDXCCCredit(DXCCCreditRecord&) override;
     virtual void importStart() override;
+    virtual qint64 importStreamPosition() override;
+    virtual LogFormat *createExportWorker(QTextStream &workerStream) const override;
     virtual void writeField(const QString &name,
                             bool presenceCondition,
                             const QString &value,
@@ -62,6 +70,9 @@ protected:
 
     const QString formatOuput(OutputFieldFormatter formatter, const QVariant &in);
 
+    typedef const QString (AdiFormat::*FieldFormatter)(const QVariant &);
+    static FieldFormatter fieldFormatter(OutputFieldFormatter formatter);
+
     virtual const QString toString(const QVariant &);
     virtual const QString toLower(const QVariant &);
     virtual const QString toUpper(const QVariant &);
@@ -92,6 +103,43 @@ protected:
 
     static QHash<QString, AdiFormat::ExportParams> DB2ADIFExportParams;
 
+    // one exported column of the record
+    struct ExportColumn
+    {
+        int index = -1;
+        QString ADIFName;
+        QString outputType;
+        FieldFormatter formatter = nullptr;
+        bool preserveLineBreaks = false;
+        bool isApplicationField = false;
+        QString tagPrefix;      // ADI: <name:
+        QString tagSuffix;      // ADI: :type> or >
+        QString elementName;    // ADX: NAME
+    };
+
+    // The export plan is compiled once for a record layout. Records of one export
+    // share the layout, therefore the field names are not looked up for every record.
+    struct ExportPlan
+    {
+        QStringList fieldNames;
+        QVector<ExportColumn> columns;
+        int startTimeIndex = -1;
+        int endTimeIndex = -1;
+        int fieldsIndex = -1;
+        ExportColumn qsoDate;
+        ExportColumn timeOn;
+        ExportColumn qsoDateOff;
+        ExportColumn timeOff;
+        QVector<ExportColumn> intlColumns;
+    };
+
+    const ExportPlan &exportPlanFor(const QSqlRecord &record);
+    static ExportColumn exportColumn(int index,
+                                     const QString &ADIFName,
+                                     OutputFieldFormatter formatter = OutputFieldFormatter::TOSTRING,
+                                     const QString &outputType = QString());
+    virtual void writeExportColumn(const ExportColumn &column, const QString &value);
+
     const QString ADIF_VERSION_STRING = "3.1.7";
     const QString PROGRAMID_STRING = "QLog";
 
@@ -99,6 +147,10 @@ private:
 
     void readField(QString& field,
                    QString& value);
+    bool readContactFromStream(QVariantMap &contact);
+    bool readContactFromTokenizer(QVariantMap &contact);
+    bool attachTokenizer();
+    void releaseTokenizer();
     QDate parseDate(const QString &date);
     QTime parseTime(const QString &time);
     QString parseQslRcvd(const QString &value);
@@ -128,10 +180,31 @@ private:
                                     QSqlRecord &contact);
     static bool isExportableFieldName(const QString &name);
     static bool isMultilineField(const QString &name);
+    void appendField(const QString &tagPrefix,
+                     const QString &tagSuffix,
+                     const QString &value,
+                     bool preserveLineBreaks);
+    void flushRow();
+
+    enum TokenizerMode {
+        TOKENIZER_UNDECIDED,
+        TOKENIZER_ACTIVE,
+        TOKENIZER_UNAVAILABLE
+    };
+
+    ExportPlan exportPlan;
+    QString rowBuffer;
+    bool rowBuffered = false;
 
     QVariantMap headerFields;
     ParserState state = START;
     bool inHeader = false;
+
+    AdiTokenizer tokenizer;
+    TokenizerMode tokenizerMode = TOKENIZER_UNDECIDED;
+    qint64 tokenizerStartPos = 0;
+    QPointer<QFileDevice> mappedFile;
+    uchar *mappedData = nullptr;
 };
 
 #endif // QLOG_LOGFORMAT_ADIFORMAT_H
@@ -0,0 +1,168 @@
+#include <cstring>
+#include "AdiTokenizer.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.logformat.aditokenizer");
+
+AdiTokenizer::AdiTokenizer(const QByteArray &data)
+{
+    reset(data);
+}
+
+void AdiTokenizer::reset(const QByteArray &inData)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << inData.size();
+
+    data = inData;
+    pos = 0;
+    state = START;
+    inHeader = false;
+}
+
+bool AdiTokenizer::next(Field &field)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    const char *d = data.constData();
+    const qsizetype end = data.size();
+
+    if ( state == START )
+    {
+        while ( pos < end && isSpace(d[pos]) )
+            ++pos;
+
+        if ( pos >= end )
+            return false;
+
+        // ADIF Spec:
+        // A Header begins with any character other than <
+        inHeader = ( d[pos] != '<' );
+        state = TAGS;
+    }
+
+    while ( pos < end )
+    {
+        const char *tagStart = static_cast<const char *>(memchr(d + pos, '<', end - pos));
+
+        if ( !tagStart )
+        {
+            pos = end;
+            return false;
+        }
+
+        pos = tagStart - d + 1;
+
+        field = Field();
+        field.header = inHeader;
+        field.nameOffset = pos;
+
+        while ( pos < end && d[pos] != ':' && d[pos] != '>' )
+            ++pos;
+
+        if ( pos >= end )
+            return false;
+
+        field.nameLength = pos - field.nameOffset;
+        trim(field.nameOffset, field.nameLength);
+
+        if ( d[pos] == '>' )
+        {
+            ++pos;
+
+            if ( inHeader && isName(field, "eoh") )
+            {
+                inHeader = false;
+                continue;
+            }
+            return true;
+        }
+
+        // skip ':' and read the length specifier
+        ++pos;
+
+        qsizetype length = 0;
+        bool validLength = true;
+
+        while ( pos < end && d[pos] != ':' && d[pos] != '>' )
+        {
+            const char c = d[pos++];
+
+            if ( c >= '0' && c <= '9' )
+            {
+                // anything longer than the buffer is clamped below
+                if ( length <= end )
+                    length = length * 10 + ( c - '0' );
+            }
+            else if ( !isSpace(c) )
+                validLength = false;
+        }
+
+        if ( pos >= end )
+            return false;
+
+        if ( d[pos] == ':' )
+        {
+            field.typeOffset = ++pos;
+
+            while ( pos < end && d[pos] != '>' )
+                ++pos;
+
+            if ( pos >= end )
+                return false;
+
+            field.typeLength = pos - field.typeOffset;
+            trim(field.typeOffset, field.typeLength);
+        }
+
+        // skip '>'
+        ++pos;
+
+        field.valueOffset = pos;
+        field.valueLength = ( validLength ) ? qMin(length, end - pos) : 0;
+        pos += field.valueLength;
+        return true;
+    }
+
+    return false;
+}
+
+bool AdiTokenizer::isName(const Field &field, const char *lowerName) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    const char *name = data.constData() + field.nameOffset;
+
+    for ( qsizetype i = 0; i < field.nameLength; ++i )
+    {
+        if ( lowerName[i] == '\0' )
+            return false;
+
+        char c = name[i];
+
+        if ( c >= 'A' && c <= 'Z' )
+            c += 'a' - 'A';
+
+        if ( c != lowerName[i] )
+            return false;
+    }
+
+    return lowerName[field.nameLength] == '\0';
+}
+
+void AdiTokenizer::trim(qsizetype &offset, qsizetype &length) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    const char *d = data.constData();
+
+    while ( length > 0 && isSpace(d[offset]) )
+    {
+        ++offset;
+        --length;
+    }
+
+    while ( length > 0 && isSpace(d[offset + length - 1]) )
+        --length;
+}
@@ -0,0 +1,74 @@
+#ifndef QLOG_LOGFORMAT_ADITOKENIZER_H
+#define QLOG_LOGFORMAT_ADITOKENIZER_H
+
+#include <QByteArray>
+#include <QLatin1String>
+
+// Zero-copy ADIF tokenizer.
+// It walks a byte buffer (a mapped file or a QByteArray shared with the source device)
+// and returns every field as byte offsets into that buffer. Nothing is copied
+// or decoded - the caller converts only the names and values it wants to keep.
+// Field lengths are in bytes as the ADIF specification defines them.
+class AdiTokenizer
+{
+public:
+    struct Field
+    {
+        qsizetype nameOffset = 0;
+        qsizetype nameLength = 0;
+        qsizetype typeOffset = 0;
+        qsizetype typeLength = 0;
+        qsizetype valueOffset = 0;
+        qsizetype valueLength = 0;
+        bool header = false;
+    };
+
+    AdiTokenizer() {};
+    explicit AdiTokenizer(const QByteArray &data);
+
+    void reset(const QByteArray &data);
+    bool next(Field &field);
+
+    QLatin1String name(const Field &field) const
+    {
+        return QLatin1String(data.constData() + field.nameOffset, field.nameLength);
+    }
+
+    QLatin1String type(const Field &field) const
+    {
+        return QLatin1String(data.constData() + field.typeOffset, field.typeLength);
+    }
+
+    QLatin1String value(const Field &field) const
+    {
+        return QLatin1String(data.constData() + field.valueOffset, field.valueLength);
+    }
+
+    bool isName(const Field &field, const char *lowerName) const;
+    qsizetype position() const { return pos; }
+    qsizetype size() const { return data.size(); }
+    bool atEnd() const { return pos >= data.size(); }
+
+private:
+    enum ParserState
+    {
+        START,
+        TAGS
+    };
+
+    static bool isSpace(char c)
+    {
+        // the same set QTextStream skips for Latin1 input
+        const uchar u = static_cast<uchar>(c);
+        return u == ' ' || ( u >= '\t' && u <= '\r' ) || u == 0x85 || u == 0xA0;
+    }
+
+    void trim(qsizetype &offset, qsizetype &length) const;
+
+    QByteArray data;
+    qsizetype pos = 0;
+    ParserState state = START;
+    bool inHeader = false;
+};
+
+#endif // QLOG_LOGFORMAT_ADITOKENIZER_H
@@ -193,7 +193,7 @@ void AdxFormat::writeField(const QString &name,
                            const QString &value,
                            const QString &type)
 {
-    FCT_IDENTIFICATION;
+    // Hot path - no FCT_IDENTIFICATION here
 
     qCDebug(function_parameters)<< name
                                 << presenceCondition
@@ -212,6 +212,25 @@ void AdxFormat::writeField(const QString &name,
     writer->writeTextElement(name.toUpper(), outputValue);
 }
 
+void AdxFormat::writeExportColumn(const ExportColumn &column, const QString &value)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( column.isApplicationField )
+    {
+        writeField(column.ADIFName, true, value, column.outputType);
+        return;
+    }
+
+    const QString outputValue(normalizeLineBreaks(value,
+                                                  column.preserveLineBreaks,
+                                                  QStringLiteral("\n")));
+
+    if ( outputValue.isEmpty() ) return;
+
+    writer->writeTextElement(column.elementName, outputValue);
+}
+
 void AdxFormat::writeSQLRecord(const QSqlRecord &record, QMap<QString, QString> *applTags)
 {
     FCT_IDENTIFICATION;
@@ -219,13 +238,10 @@ void AdxFormat::writeSQLRecord(const QSqlRecord &record, QMap<QString, QString>
     AdiFormat::writeSQLRecord(record, applTags);
 
     // Add _INTL fields
+    const ExportPlan &plan = exportPlanFor(record);
 
-    const QStringList &fieldMappingList = fieldname2INTLNameMapping.values();
-    for ( const QString& value :  fieldMappingList )
-    {
-        const QVariant &tmp = record.value(value);
-        writeField(value, tmp.isValid(), tmp.toString());
-    }
+    for ( const ExportColumn &column : plan.intlColumns )
+        writeExportColumn(column, record.value(column.index).toString());
 }
 
 bool AdxFormat::readContact(QVariantMap & contact)
@@ -20,12 +20,15 @@ public:
     virtual void exportEnd() override;
 
 protected:
+    // the XML writer keeps the document state - the records cannot be formatted apart
+    virtual LogFormat *createExportWorker(QTextStream &) const override { return nullptr; }
     virtual void writeField(const QString &name,
                             bool presenceCondition,
                             const QString &value,
                             const QString &type="") override;
     virtual void writeSQLRecord(const QSqlRecord& record,
                                 QMap<QString, QString> *applTags) override;
+    virtual void writeExportColumn(const ExportColumn &column, const QString &value) override;
     virtual bool readContact(QVariantMap& ) override;
 
 private:
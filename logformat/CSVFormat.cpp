@@ -62,12 +62,19 @@ void CSVFormat::setDelimiter(const QChar &inDelimiter)
     delimiter = inDelimiter;
 }
 
+void CSVFormat::writeExportColumn(const ExportColumn &column, const QString &value)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    writeField(column.ADIFName, true, value, column.outputType);
+}
+
 void CSVFormat::writeField(const QString &name,
                            bool presenceCondition,
                            const QString &value,
                            const QString &type)
 {
-    FCT_IDENTIFICATION;
+    // Hot path - no FCT_IDENTIFICATION here
 
     qCDebug(function_parameters)<< name
                                 << presenceCondition
@@ -92,7 +99,7 @@ const QString CSVFormat::toTime(const QVariant &var)
 
 QString CSVFormat::csvStringValue(const QString &value)
 {
-    FCT_IDENTIFICATION;
+    // Hot path - no FCT_IDENTIFICATION here
 
     QString csvValue(value);
     csvValue.replace("\"", "\"\"");
@@ -23,6 +23,7 @@ protected:
                             bool presenceCondition,
                             const QString &value,
                             const QString &type="") override;
+    virtual void writeExportColumn(const ExportColumn &column, const QString &value) override;
     const QString toDate(const QVariant &) override;
     const QString toTime(const QVariant &) override;
 
@@ -1,4 +1,3 @@
-#include <QJsonDocument>
 #include <QSqlRecord>
 #include "JsonFormat.h"
 #include "core/debug.h"
@@ -9,7 +8,21 @@ void JsonFormat::exportStart()
 {
     FCT_IDENTIFICATION;
 
-    data = QJsonArray();
+    exportedCount = 0;
+
+    QString header;
+
+    header.append(QLatin1String("{\n"));
+    header.append(QLatin1String("    \"header\": {\n"));
+    writeObjectMember(header, 2, QStringLiteral("adif_ver"), ADIF_VERSION_STRING, false);
+    writeObjectMember(header, 2, QStringLiteral("created_timestamp"),
+                      QDateTime::currentDateTimeUtc().toString("yyyyMMdd hhmmss"), false);
+    writeObjectMember(header, 2, QStringLiteral("programid"), PROGRAMID_STRING, false);
+    writeObjectMember(header, 2, QStringLiteral("programversion"), VERSION, true);
+    header.append(QLatin1String("    },\n"));
+    header.append(QLatin1String("    \"records\": [\n"));
+
+    stream << header;
 }
 
 void JsonFormat::exportContact(const QSqlRecord& record, QMap<QString, QString>*applTags)
@@ -18,25 +31,98 @@ void JsonFormat::exportContact(const QSqlRecord& record, QMap<QString, QString>*
 
     qCDebug(function_parameters)<<record;
 
-    contact = QJsonObject();
+    contact.clear();
     writeSQLRecord(record, applTags);
-    data.append(contact);
+
+    // keep the allocated capacity for the next record
+    recordBuffer.resize(0);
+
+    if ( exportedCount > 0 )
+        recordBuffer.append(QLatin1String(",\n"));
+
+    recordBuffer.append(QLatin1String("        {\n"));
+
+    int remaining = contact.size();
+
+    for ( auto it = contact.constBegin(); it != contact.constEnd(); ++it )
+        writeObjectMember(recordBuffer, 3, it.key(), it.value(), --remaining == 0);
+
+    recordBuffer.append(QLatin1String("        }"));
+
+    stream << recordBuffer;
+    exportedCount++;
 }
 
 void JsonFormat::exportEnd()
 {
     FCT_IDENTIFICATION;
 
-    QJsonObject msg;
-    QJsonObject headerData;
-    headerData["adif_ver"] = ADIF_VERSION_STRING;
-    headerData["programid"] = PROGRAMID_STRING;
-    headerData["programversion"] = VERSION;
-    headerData["created_timestamp"] = QDateTime::currentDateTimeUtc().toString("yyyyMMdd hhmmss");
-    msg["header"] = headerData;
-    msg["records"] = data;
-    QJsonDocument doc(msg);
-    stream << doc.toJson();
+    if ( exportedCount > 0 )
+        stream << "\n";
+
+    stream << "    ]\n}\n";
+}
+
+void JsonFormat::writeObjectMember(QString &out,
+                                   int indent,
+                                   const QString &key,
+                                   const QString &value,
+                                   bool last) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    out.append(QString(indent * 4, QLatin1Char(' ')));
+    out.append(jsonString(key));
+    out.append(QLatin1String(": "));
+    out.append(jsonString(value));
+    out.append(( last ) ? QLatin1String("\n") : QLatin1String(",\n"));
+}
+
+QString JsonFormat::jsonString(const QString &value)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    // the same escaping as QJsonDocument
+    static const char hex[] = "0123456789abcdef";
+
+    QString ret;
+    ret.reserve(value.size() + 2);
+    ret.append(QLatin1Char('"'));
+
+    for ( const QChar &character : value )
+    {
+        const char16_t u = character.unicode();
+
+        switch ( u )
+        {
+        case '"': ret.append(QLatin1String("\\\"")); break;
+        case '\\': ret.append(QLatin1String("\\\\")); break;
+        case '\b': ret.append(QLatin1String("\\b")); break;
+        case '\f': ret.append(QLatin1String("\\f")); break;
+        case '\n': ret.append(QLatin1String("\\n")); break;
+        case '\r': ret.append(QLatin1String("\\r")); break;
+        case '\t': ret.append(QLatin1String("\\t")); break;
+        default:
+            if ( u < 0x20 )
+            {
+                ret.append(QLatin1String("\\u00"));
+                ret.append(QLatin1Char(hex[u >> 4]));
+                ret.append(QLatin1Char(hex[u & 0xf]));
+            }
+            else
+                ret.append(character);
+        }
+    }
+
+    ret.append(QLatin1Char('"'));
+    return ret;
+}
+
+void JsonFormat::writeExportColumn(const ExportColumn &column, const QString &value)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    writeField(column.ADIFName, true, value, column.outputType);
 }
 
 void JsonFormat::writeField(const QString &name,
@@ -44,7 +130,7 @@ void JsonFormat::writeField(const QString &name,
                             const QString &value,
                             const QString &type)
 {
-    FCT_IDENTIFICATION;
+    // Hot path - no FCT_IDENTIFICATION here
 
     qCDebug(function_parameters)<< name
                                 << presenceCondition
@@ -1,7 +1,7 @@
 #ifndef QLOG_LOGFORMAT_JSONFORMAT_H
 #define QLOG_LOGFORMAT_JSONFORMAT_H
 
-#include <QJsonArray>
+#include <QMap>
 #include "AdxFormat.h"
 
 class JsonFormat : public AdxFormat
@@ -22,10 +22,22 @@ protected:
                             bool presenceCondition,
                             const QString &value,
                             const QString &type="") override;
+    virtual void writeExportColumn(const ExportColumn &column, const QString &value) override;
 
 private:
-   QJsonArray data;
-   QJsonObject contact;
+    // The document is written incrementally - the header in exportStart, every record
+    // in exportContact and the closing brackets in exportEnd. The output is the same as
+    // QJsonDocument::toJson(QJsonDocument::Indented) of the whole document.
+    void writeObjectMember(QString &out,
+                           int indent,
+                           const QString &key,
+                           const QString &value,
+                           bool last) const;
+    static QString jsonString(const QString &value);
+
+    QMap<QString, QString> contact;    // sorted as QJsonObject keys
+    QString recordBuffer;
+    long exportedCount = 0;
 };
 
 #endif // QLOG_LOGFORMAT_JSONFORMAT_H
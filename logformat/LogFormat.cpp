@@ -1,5 +1,6 @@
 #include <QtSql>
 #include <QSqlDriver>
+#include <QThread>
 #include "LogFormat.h"
 #include "AdiFormat.h"
 #include "AdxFormat.h"
@@ -12,6 +13,11 @@
 #include "data/Gridsquare.h"
 #include "data/Callsign.h"
 #include "data/BandPlan.h"
+#include "data/ImportDupeIndex.h"
+#include "data/DXCCCreditIndex.h"
+#include "core/SQLBulkLoad.h"
+#include "core/FileCompressor.h"
+#include "core/LogDatabase.h"
 #include "service/lotw/Lotw.h"
 #include "models/LogbookModel.h"
 #include "core/QSOFilterManager.h"
@@ -91,6 +97,17 @@ LogFormat* LogFormat::open(LogFormat::Type type, QTextStream& stream) {
     }
 }
 
+qint64 LogFormat::importStreamPosition()
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    // the decompressed stream has no position - the progress follows the compressed file
+    if ( GzipReadDevice *gzipDevice = qobject_cast<GzipReadDevice *>(stream.device()) )
+        return gzipDevice->compressedPosition();
+
+    return stream.pos();
+}
+
 void LogFormat::setDefaults(QMap<QString, QString>& defaults) {
     FCT_IDENTIFICATION;
 
@@ -279,6 +296,10 @@ void LogFormat::setDuplicateQSOCallback(duplicateQSOBehaviour (*func)(QSqlRecord
 
 #define RECORDIDX(a) ( (a) - 1 )
 
+#define IMPORT_BATCH_SIZE 256
+#define EXPORT_CHUNK_SIZE 2000
+#define QSL_MERGE_CHUNK_SIZE 1000
+
 unsigned long LogFormat::runImport(QTextStream& importLogStream,
                                    const StationProfile *defaultStationProfile,
                                    unsigned long *warnings,
@@ -295,714 +316,985 @@ unsigned long LogFormat::runImport(QTextStream& importLogStream,
 
     QSqlQuery dupQuery;
     QSqlQuery insertQuery;
-
-    // It is important to use callsign index here
-    if ( ! dupQuery.prepare("SELECT * FROM contacts "
-                            "WHERE callsign=upper(:callsign) "
-                            "AND upper(mode)=upper(:mode) "
-                            "AND upper(band)=upper(:band) "
-                            "AND COALESCE(sat_name, '') = COALESCE(:sat_name, '') "
-                            "AND ABS(JULIANDAY(start_time)-JULIANDAY(datetime(:startdate)))*24*60<30") )
-    {
-        qWarning() << "cannot prepare Dup statement";
-        return 0;
-    }
-
-
-    QSqlDatabase::database().transaction();
+    ImportDupeIndex dupeIndex;
 
     QSqlTableModel model;
     model.setTable("contacts");
     model.removeColumn(model.fieldIndex("id"));
-    QSqlRecord record = model.record();
+    const QSqlRecord recordTemplate = model.record();
     duplicateQSOBehaviour dupSetting = LogFormat::ASK_NEXT;
 
-    auto setIfEmpty = [&](int column, const QString &value)
-    {
-        if ( record.value(RECORDIDX(column)).toString().isEmpty() && !value.isEmpty() )
-            record.setValue(RECORDIDX(column), value);
-    };
-
-    auto setMyDefaultProfile = [&]()
-    {
-        setIfEmpty(LogbookModel::COLUMN_MY_DXCC, QString::number(defaultStationProfile->dxcc));
-        setIfEmpty(LogbookModel::COLUMN_STATION_CALLSIGN, defaultStationProfile->callsign);
-        setIfEmpty(LogbookModel::COLUMN_MY_GRIDSQUARE, defaultStationProfile->locator);
-        setIfEmpty(LogbookModel::COLUMN_MY_NAME, Data::removeAccents(defaultStationProfile->operatorName));
-        setIfEmpty(LogbookModel::COLUMN_MY_NAME_INTL, defaultStationProfile->operatorName);
-        setIfEmpty(LogbookModel::COLUMN_OPERATOR, defaultStationProfile->operatorCallsign);
-        setIfEmpty(LogbookModel::COLUMN_MY_CITY_INTL, defaultStationProfile->qthName);
-        setIfEmpty(LogbookModel::COLUMN_MY_CITY, Data::removeAccents(defaultStationProfile->qthName));
-        setIfEmpty(LogbookModel::COLUMN_MY_IOTA, defaultStationProfile->iota);
-        setIfEmpty(LogbookModel::COLUMN_MY_POTA_REF, defaultStationProfile->pota);
-        setIfEmpty(LogbookModel::COLUMN_MY_SOTA_REF, defaultStationProfile->sota);
-        setIfEmpty(LogbookModel::COLUMN_MY_SIG_INTL, defaultStationProfile->sig);
-        setIfEmpty(LogbookModel::COLUMN_MY_SIG, Data::removeAccents(defaultStationProfile->sig));
-        setIfEmpty(LogbookModel::COLUMN_MY_SIG_INFO_INTL, defaultStationProfile->sigInfo);
-        setIfEmpty(LogbookModel::COLUMN_MY_SIG_INFO, Data::removeAccents(defaultStationProfile->sigInfo));
-        setIfEmpty(LogbookModel::COLUMN_MY_VUCC_GRIDS, defaultStationProfile->vucc);
-        setIfEmpty(LogbookModel::COLUMN_MY_ITU_ZONE, QString::number(defaultStationProfile->ituz));
-        setIfEmpty(LogbookModel::COLUMN_MY_CQ_ZONE, QString::number(defaultStationProfile->cqz));
-        setIfEmpty(LogbookModel::COLUMN_MY_COUNTRY_INTL, defaultStationProfile->country);
-        setIfEmpty(LogbookModel::COLUMN_MY_COUNTRY, Data::removeAccents(defaultStationProfile->country));
-        setIfEmpty(LogbookModel::COLUMN_MY_CNTY, Data::removeAccents(defaultStationProfile->county));
-        setIfEmpty(LogbookModel::COLUMN_MY_DARC_DOK, Data::removeAccents(defaultStationProfile->darcDOK));
-    };
-
-    auto setMyEntity = [&](const DxccEntity &myEntity)
+    // the import ends without any record when the statements cannot be prepared;
+    // they are prepared before the transaction is started and the triggers are suspended
+    auto abortImport = [this]()
     {
-        // force overwrite
-        record.setValue(RECORDIDX(LogbookModel::COLUMN_MY_DXCC), myEntity.dxcc);
-        record.setValue(RECORDIDX(LogbookModel::COLUMN_MY_COUNTRY), Data::removeAccents(myEntity.country));
-        record.setValue(RECORDIDX(LogbookModel::COLUMN_MY_COUNTRY_INTL), myEntity.country);
-
-        // other DXCC related values ​​are not closely related to DXCC value and could have been filled
-        // therefore check if it is present or not.
-        setIfEmpty(LogbookModel::COLUMN_MY_ITU_ZONE, QString::number(myEntity.ituz));
-        setIfEmpty(LogbookModel::COLUMN_MY_CQ_ZONE, QString::number(myEntity.cqz));
+        emit finished(0);
+        this->importEnd();
     };
 
-    auto lookupAndSetMyEntityByCallsign = [&] (const QString& recordMyDXCC)
+    // the duplicates are searched in memory, the full row is read only for the duplicate callback
+    if ( ! dupQuery.prepare("SELECT * FROM contacts WHERE id = :id") )
     {
-        const DxccEntity &myEntity = Data::instance()->lookupDxcc(recordMyDXCC);
-
-        if ( myEntity.dxcc == 0 )  // My DXCC not found
-        {
-            writeImportLog(importLogStream,
-                           WARNING_SEVERITY,
-                           errors,
-                           warnings,
-                           processedRec,
-                           record,
-                           tr("Cannot find My DXCC Entity Info"));
-        }
-        else
-        {
-            setMyEntity(myEntity);
-        }
-    };
+        qWarning() << "cannot prepare Dup statement";
+        abortImport();
+        return 0;
+    }
 
     if ( !insertQuery.prepare( QSqlDatabase::database().driver()->sqlStatement(QSqlDriver::InsertStatement,
                                                                                "contacts",
-                                                                               record,
+                                                                               recordTemplate,
                                                                                true)) )
     {
         qWarning() << "cannot prepare Insert statement" << insertQuery.lastError();
+        abortImport();
+        return 0;
+    }
+
+    if ( !dupeIndex.load() )
+    {
+        qWarning() << "cannot load Dup index";
+        abortImport();
         return 0;
     }
 
-    while (true)
+    // PRAGMAs cannot be changed inside the transaction
+    SQLBulkLoad bulkLoad;
+
+    QSqlDatabase::database().transaction();
+
+    // contacts_autovalue is filled for the whole import at the end
+    if ( !bulkLoad.suspendContactTriggers() )
+        qWarning() << "cannot suspend contacts triggers - using per-row triggers";
+
+    /* The import is a pipeline:
+     *   parser thread -> enrichment workers (band, DXCC, my station, pfx, distance) -> writer (this thread)
+     * The writer owns the db connection, therefore the duplicate check, the duplicate callback,
+     * the insert and the import log stay here and the records are written in the file order.
+     */
+
+    // load the band plan cache on this thread, the workers only read it
+    BandPlan::freq2Band(0.0);
+
+    // the workers can use only the immutable DXCC snapshot. Without it, the lookups
+    // need the db connection and the writer enriches the records itself.
+    DxccSnapshot::Ptr dxcc = Data::instance()->dxccSnapshot();
+
+    if ( dxcc && !( dxcc->hasAD1C() && dxcc->hasClublog() ) )
+        dxcc.clear();
+
+    // the parser and the writer have their own threads
+    const int workerCount = ( dxcc ) ? qMax(1, QThread::idealThreadCount() - 2) : 0;
+
+    qCDebug(runtime) << "Import enrichment workers" << workerCount;
+
+    OrderedWorkQueue<ImportBatch> queue(( workerCount + 1 ) * 4);
+
+    QThread *parserThread = QThread::create([this, &queue, &recordTemplate]()
+    {
+        parseImportBatches(queue, recordTemplate);
+    });
+    parserThread->start();
+
+    QList<QThread *> workerThreads;
+
+    for ( int i = 0; i < workerCount; i++ )
     {
-        record.clearValues();
+        QThread *workerThread = QThread::create([this, &queue, dxcc, defaultStationProfile]()
+        {
+            quint64 seq = 0;
+            ImportBatch batch;
 
-        if (!this->importNext(record)) break;
+            while ( queue.takeInput(seq, batch) )
+            {
+                enrichImportBatch(batch, dxcc, defaultStationProfile);
+                queue.pushResult(seq, batch);
+            }
+        });
+        workerThread->start();
+        workerThreads << workerThread;
+    }
 
-        processedRec++;
+    /* The accepted records are inserted in chunks by execBatch.
+     * A chunk is inserted in a savepoint. If it fails, it is rolled back and inserted
+     * record by record to get the error for the import log.
+     * The records of the current chunk are not in the db yet. They are kept in a separate
+     * dupe index and the chunk is flushed before a duplicate inside it is reported.
+     * The log lines written while a chunk is pending wait with its records and the chunk
+     * flush writes them in the record order.
+     */
+    QList<ImportPendingInsert> pendingInserts;
+    QVector<QVariantList> pendingColumns(recordTemplate.count());
+    ImportDupeIndex pendingDupeIndex;
 
-        for ( const QString &message : importWarnings )
-            writeImportLog(importLogStream, WARNING_SEVERITY, errors, warnings,
-                           processedRec, record, message);
+    // the inserted records - the error of a rolled back import is logged for each of them
+    QList<QPair<unsigned long, QString>> insertedRecords; // record no, log record info
 
-        /* Compute the Band if missing
-         *   Band is one of the mandatory fields
-         */
+    auto addToDupeIndex = [&dupeIndex](qulonglong id, const QSqlRecord &record)
+    {
+        dupeIndex.addContact(id,
+                             record.value(RECORDIDX(LogbookModel::COLUMN_CALL)).toString(),
+                             record.value(RECORDIDX(LogbookModel::COLUMN_BAND)).toString(),
+                             record.value(RECORDIDX(LogbookModel::COLUMN_MODE)).toString(),
+                             record.value(RECORDIDX(LogbookModel::COLUMN_SAT_NAME)).toString(),
+                             record.value(RECORDIDX(LogbookModel::COLUMN_TIME_ON)).toDateTime());
+    };
 
-        if ( record.value(RECORDIDX(LogbookModel::COLUMN_BAND)).toString().isEmpty()
-             && !record.value(RECORDIDX(LogbookModel::COLUMN_FREQUENCY)).toString().isEmpty() )
+    auto importLog = [&](unsigned long recordNo,
+                         const QSqlRecord &record,
+                         ImportLogSeverity severity,
+                         const QString &message)
+    {
+        if ( pendingInserts.isEmpty() )
         {
-            double freq = record.value(RECORDIDX(LogbookModel::COLUMN_FREQUENCY)).toDouble();
-            record.setValue(RECORDIDX(LogbookModel::COLUMN_BAND), BandPlan::freq2Band(freq).name);
+            writeImportLog(importLogStream, severity, errors, warnings, recordNo, record, message);
+            return;
         }
 
-        // needed later
-        const QVariant &call = record.value(RECORDIDX(LogbookModel::COLUMN_CALL));
-        const QVariant &mycall = record.value(RECORDIDX(LogbookModel::COLUMN_STATION_CALLSIGN));
-        const QVariant &band = record.value(RECORDIDX(LogbookModel::COLUMN_BAND));
-        const QVariant &mode = record.value(RECORDIDX(LogbookModel::COLUMN_MODE));
-        const QDateTime &start_time = record.value(RECORDIDX(LogbookModel::COLUMN_TIME_ON)).toDateTime();
-        const QVariant &sota = record.value(RECORDIDX(LogbookModel::COLUMN_SOTA_REF));
-        const QVariant &mysota = record.value(RECORDIDX(LogbookModel::COLUMN_MY_SOTA_REF));
-        const QVariant &satName = record.value(RECORDIDX(LogbookModel::COLUMN_SAT_NAME));
-
-        /* checking matching fields if they are not empty */
-        if ( !start_time.isValid()
-             || call.toString().isEmpty()
-             || band.toString().isEmpty()
-             || mode.toString().isEmpty())
+        ImportLogLine line;
+        line.recordNo = recordNo;
+        line.record = record;
+        line.entry.severity = severity;
+        line.entry.message = message;
+        pendingInserts.last().followingLog.append(line);
+    };
+
+    auto writeInsertResult = [&](const ImportPendingInsert &pending,
+                                 bool inserted,
+                                 const QString &error)
+    {
+        if ( inserted )
         {
+            const QString recordInfo = importLogRecordInfo(pending.record);
+
             writeImportLog(importLogStream,
-                           ERROR_SEVERITY,
+                           INFO_SEVERITY,
                            errors,
                            warnings,
-                           processedRec,
-                           record,
-                           tr("A minimal set of fields not present (start_time, call, band, mode, station_callsign)"));
-            qWarning() << "Import does not contain minimal set of fields (start_time, call, band, mode, station_callsign)";
-            qCDebug(runtime) << record;
-            continue;
+                           pending.recordNo,
+                           recordInfo,
+                           tr("Imported"));
+            insertedRecords.append(qMakePair(pending.recordNo, recordInfo));
+            count++;
         }
+        else
+            writeImportLog(importLogStream,
+                           ERROR_SEVERITY,
+                           errors,
+                           warnings,
+                           pending.recordNo,
+                           pending.record,
+                           tr("Cannot insert to database") + " - " + error);
 
-        if ( processedRec % 1000 == 0)
-        {
-            emit importPosition(stream.pos());
-        }
+        for ( const ImportLogLine &line : pending.followingLog )
+            writeImportLog(importLogStream, line.entry.severity, errors, warnings,
+                           line.recordNo, line.record, line.entry.message);
+    };
+
+    auto flushInserts = [&]()
+    {
+        if ( pendingInserts.isEmpty() )
+            return;
+
+        QSqlQuery savepointQuery;
+        bool batchInserted = savepointQuery.exec("SAVEPOINT import_chunk");
 
-        if ( isDateRange() )
+        if ( batchInserted )
         {
-            if (!inDateRange(start_time.date()))
+            for ( int i = 0; i < pendingColumns.size(); i++ )
+                insertQuery.bindValue(i, pendingColumns.at(i));
+
+            batchInserted = insertQuery.execBatch();
+
+            if ( !batchInserted )
             {
-                writeImportLog(importLogStream,
-                               WARNING_SEVERITY,
-                               errors,
-                               warnings,
-                               processedRec,
-                               record,
-                               tr("Outside the selected Date Range"));
-                continue;
+                qCDebug(runtime) << "Chunk insert failed - inserting one by one" << insertQuery.lastError();
+                savepointQuery.exec("ROLLBACK TO import_chunk");
             }
+
+            savepointQuery.exec("RELEASE import_chunk");
         }
 
-        if ( dupSetting != ACCEPT_ALL )
+        if ( batchInserted )
         {
-            dupQuery.bindValue(":callsign", call);
-            dupQuery.bindValue(":mode", mode);
-            dupQuery.bindValue(":band", band);
-            dupQuery.bindValue(":startdate", start_time.toTimeZone(QTimeZone::utc()).toString("yyyy-MM-dd hh:mm:ss"));
-            dupQuery.bindValue(":sat_name", satName);
+            // the connection is the only writer inside the transaction,
+            // therefore the chunk has got consecutive ids
+            const qulonglong lastId = insertQuery.lastInsertId().toULongLong();
+            const qulonglong firstId = lastId - pendingInserts.size() + 1;
 
-            if ( !dupQuery.exec() )
+            for ( int i = 0; i < pendingInserts.size(); i++ )
             {
-                qWarning() << "Cannot exect DUP statement";
+                const ImportPendingInsert &pending = pendingInserts.at(i);
+
+                writeInsertResult(pending, true, QString());
+
+                // duplicates within the imported file
+                addToDupeIndex(firstId + i, pending.record);
             }
 
-            if ( dupQuery.next() )
+            bulkLoad.addInsertedContacts(firstId, lastId);
+        }
+        else
+        {
+            for ( const ImportPendingInsert &pending : pendingInserts )
             {
-                if ( dupSetting == SKIP_ALL)
-                {
-                    writeImportLog(importLogStream,
-                                   WARNING_SEVERITY,
-                                   errors,
-                                   warnings,
-                                   processedRec,
-                                   record,
-                                   tr("Duplicate"));
-                    continue;
-                }
+                for ( int i = 0; i < pending.record.count(); i++ )
+                    insertQuery.bindValue(i, pending.record.value(i));
 
-                /* Duplicate QSO found */
-                if ( duplicateQSOFunc )
+                if ( ! insertQuery.exec() )
                 {
-                    QSqlRecord dupRecord;
-                    dupRecord= dupQuery.record();
-                    dupSetting = duplicateQSOFunc(&record, &dupRecord);
+                    writeInsertResult(pending, false, insertQuery.lastError().text());
+                    qWarning() << "Cannot insert a record to Contact Table - " << insertQuery.lastError();
+                    qCDebug(runtime) << pending.record;
                 }
-
-                switch ( dupSetting )
+                else
                 {
-                case ACCEPT_ALL:
-                case ACCEPT_ONE:
-                case ASK_NEXT:
-                    break;
+                    writeInsertResult(pending, true, QString());
 
-                case SKIP_ONE:
-                case SKIP_ALL:
-                    writeImportLog(importLogStream,
-                                   WARNING_SEVERITY,
-                                   errors,
-                                   warnings,
-                                   processedRec,
-                                   record,
-                                   tr("Duplicate"));
-                    continue;
-                    break;
+                    const qulonglong id = insertQuery.lastInsertId().toULongLong();
+                    addToDupeIndex(id, pending.record);
+                    bulkLoad.addInsertedContacts(id, id);
                 }
             }
         }
 
-        /* Adding information which are important for QLog or QLog knows/compute them */
-        /************************/
-        /* Add DXCC Entity Info */
-        /************************/
-        const int recordDXCCId = record.value(RECORDIDX(LogbookModel::COLUMN_DXCC)).toInt();  // 0 = NaN or not present
-                                                                                              // otherwise = DXCC ID
-        DxccEntity entity;
+        pendingInserts.clear();
+        pendingDupeIndex.clear();
 
-        if ( recordDXCCId != 0 )
-        {
-            // get additional DXCC info
-            entity = Data::instance()->lookupDxccIDAD1C(recordDXCCId);
+        for ( QVariantList &column : pendingColumns )
+            column.clear();
+    };
 
-            // if DXCC is not present on AD1C list, try Clublog, no CQZ and ITUZ info here
-            if ( entity.dxcc == 0 )
-                entity = Data::instance()->lookupDxccIDClublog(recordDXCCId);
+    ImportBatch batch;
 
-            // no record in clublog, only Warning, because DXCC number is present
-            if ( entity.dxcc == 0 )
-                writeImportLog(importLogStream, WARNING_SEVERITY, errors, warnings,
-                               processedRec, record, tr("DXCC Info is missing"));
-        }
-        else if ( !fillMissingDxcc )
-        {
-            // DXCC info is missing in the source and fillMissingDXCC is disabled - ERROR - QLog needs DXCC
-            writeImportLog(importLogStream, ERROR_SEVERITY, errors, warnings,
-                           processedRec, record, tr("DXCC Info is missing"));
-            continue;
-        }
-        else
+    while ( true )
+    {
+        if ( workerCount == 0 )
         {
-            // DXCC info is missing in the source and fillMissingDXCC is enabled, try to find on AD1C list
-            entity = Data::instance()->lookupDxccAD1C(call.toString());
-            if ( entity.dxcc == 0 )
-                // if DXCC is not present on AD1C list, try Clublog, no CQZ and ITUZ info here
-                entity = Data::instance()->lookupDxccClublog(call.toString(), start_time);
+            quint64 seq = 0;
 
-            if ( entity.dxcc == 0 )
-            {
-                // no record in clublog - ERROR - QLog needs DXCC
-                writeImportLog(importLogStream, ERROR_SEVERITY, errors, warnings,
-                               processedRec, record, tr("DXCC Info is missing"));
-                continue;
-            }
+            if ( !queue.takeInput(seq, batch) )
+                break;
+
+            enrichImportBatch(batch, dxcc, defaultStationProfile);
+            queue.pushResult(seq, batch);
         }
 
-        if ( entity.dxcc != 0 )
+        if ( !queue.takeResult(batch) )
+            break;
+
+        for ( ImportRecord &item : batch.records )
         {
-            record.setValue(RECORDIDX(LogbookModel::COLUMN_DXCC), entity.dxcc);
-            record.setValue(RECORDIDX(LogbookModel::COLUMN_COUNTRY), Data::removeAccents(entity.country));
-            record.setValue(RECORDIDX(LogbookModel::COLUMN_COUNTRY_INTL), entity.country);
-
-            // other DXCC related values ​​are not closely related to DXCC value and could have been filled
-            // therefore check if it is present or not.
-            setIfEmpty(LogbookModel::COLUMN_CONTINENT, entity.cont);
-            setIfEmpty(LogbookModel::COLUMN_ITUZ, QString::number(entity.ituz));
-            setIfEmpty(LogbookModel::COLUMN_CQZ, QString::number(entity.cqz));
-        };
+            QSqlRecord &record = item.record;
 
-        /************************/
-        /* Add My Station Info  */
-        /************************/
+            processedRec = item.recordNo;
 
-        int recordMyDXCCId = record.value(RECORDIDX(LogbookModel::COLUMN_MY_DXCC)).toInt(); // 0 = NAN or not present
-                                                                                            // otherwise = DXCC ID
-        const QString &myCallString = mycall.toString();
+            for ( const QString &message : item.parseWarnings )
+                importLog(processedRec, record, WARNING_SEVERITY, message);
 
-        if ( defaultStationProfile )
-        {
-            // default is enabled
+            for ( const ImportLogEntry &entry : item.checkLog )
+                importLog(processedRec, record, entry.severity, entry.message);
 
-            // Case 1: Both recordMyDXCCId and myCallString are empty
-            if (  recordMyDXCCId == 0 && myCallString.isEmpty()  )
-            {
-                setMyDefaultProfile();
-            }
-            // Case 2: recordMyDXCCId is empty, myCallString is not
-            else if ( recordMyDXCCId == 0 )
+            if ( item.rejectedByCheck )
+                continue;
+
+            if ( processedRec % 1000 == 0)
             {
-                if ( defaultStationProfile->callsign == myCallString )
-                    setMyDefaultProfile();
-                else
-                    lookupAndSetMyEntityByCallsign(myCallString);
+                emit importPosition(batch.streamPosition);
             }
-            // Case 3: myCallString is empty, recordMyDXCCId is not
-            else if ( myCallString.isEmpty() )
+
+            // needed later
+            const QVariant &call = record.value(RECORDIDX(LogbookModel::COLUMN_CALL));
+            const QVariant &band = record.value(RECORDIDX(LogbookModel::COLUMN_BAND));
+            const QVariant &mode = record.value(RECORDIDX(LogbookModel::COLUMN_MODE));
+            const QDateTime &start_time = record.value(RECORDIDX(LogbookModel::COLUMN_TIME_ON)).toDateTime();
+            const QVariant &sota = record.value(RECORDIDX(LogbookModel::COLUMN_SOTA_REF));
+            const QVariant &mysota = record.value(RECORDIDX(LogbookModel::COLUMN_MY_SOTA_REF));
+            const QVariant &satName = record.value(RECORDIDX(LogbookModel::COLUMN_SAT_NAME));
+
+            if ( dupSetting != ACCEPT_ALL )
             {
-                if ( defaultStationProfile->dxcc == recordMyDXCCId )
-                    setMyDefaultProfile();
-                else
+                qulonglong dupID = dupeIndex.findDuplicate(call.toString(),
+                                                           band.toString(),
+                                                           mode.toString(),
+                                                           satName.toString(),
+                                                           start_time);
+
+                // the duplicate can wait in the current chunk - insert it to get its id
+                if ( dupID == 0
+                     && pendingDupeIndex.findDuplicate(call.toString(),
+                                                       band.toString(),
+                                                       mode.toString(),
+                                                       satName.toString(),
+                                                       start_time) != 0 )
                 {
-                    // no Station Callsign = ERROR
-                    writeImportLog(importLogStream,
-                                   ERROR_SEVERITY,
-                                   errors,
-                                   warnings,
-                                   processedRec,
-                                   record,
-                                   tr("no Station Callsign present"));
-                    continue;
+                    flushInserts();
+                    dupID = dupeIndex.findDuplicate(call.toString(),
+                                                    band.toString(),
+                                                    mode.toString(),
+                                                    satName.toString(),
+                                                    start_time);
                 }
-            }
-             // Case 4: Both recordMyDXCCId and myCallString are not empty
-            else
-            {
-                if ( defaultStationProfile->callsign == myCallString )
+
+                if ( dupID != 0 )
                 {
-                    if ( defaultStationProfile->dxcc == recordMyDXCCId )
-                        setMyDefaultProfile();
-                    else   
+                    if ( dupSetting == SKIP_ALL)
                     {
-                        // no Station Callsign = ERROR
-                        writeImportLog(importLogStream,
-                                       ERROR_SEVERITY,
-                                       errors,
-                                       warnings,
-                                       processedRec,
-                                       record,
-                                       tr("no Station Callsign present"));
+                        importLog(processedRec, record, WARNING_SEVERITY, tr("Duplicate"));
                         continue;
                     }
-                }
-                else
-                    lookupAndSetMyEntityByCallsign(myCallString);
-            }
-        }
-        else
-        {
-            // default is disabled
-            if ( myCallString.isEmpty() )
-            {
-                // no Station Callsign = ERROR
-                writeImportLog(importLogStream,
-                               ERROR_SEVERITY,
-                               errors,
-                               warnings,
-                               processedRec,
-                               record,
-                               tr("no Station Callsign present"));
-                continue;
-            }
-            else
-            {
-                const DxccEntity &myEntity = ( recordMyDXCCId != 0 ) ? Data::instance()->lookupDxccID(recordMyDXCCId)
-                                                                     : Data::instance()->lookupDxcc(myCallString);
 
-                if ( myEntity.dxcc == 0 )  // My DXCC not found
-                {
-                    writeImportLog(importLogStream,
-                                   WARNING_SEVERITY,
-                                   errors,
-                                   warnings,
-                                   processedRec,
-                                   record,
-                                   tr("Cannot find My DXCC Entity Info"));
-                }
-                else
-                    setMyEntity(myEntity);
-            }
-        }
+                    /* Duplicate QSO found */
+                    if ( duplicateQSOFunc )
+                    {
+                        QSqlRecord dupRecord;
 
-        /***********/
-        /* Add PFX */
-        /***********/
+                        dupQuery.bindValue(":id", dupID);
 
-        if ( record.value(RECORDIDX(LogbookModel::COLUMN_PREFIX)).toString().isEmpty() )
-        {
-            const QString &pfxRef = Callsign(call.toString()).getWPXPrefix();
+                        if ( dupQuery.exec() && dupQuery.next() )
+                            dupRecord = dupQuery.record();
+                        else
+                            qWarning() << "Cannot exect DUP statement" << dupQuery.lastError();
 
-            if ( !pfxRef.isEmpty() )
-            {
-                record.setValue(RECORDIDX(LogbookModel::COLUMN_PREFIX), pfxRef);
+                        dupSetting = duplicateQSOFunc(&record, &dupRecord);
+                    }
+
+                    switch ( dupSetting )
+                    {
+                    case ACCEPT_ALL:
+                    case ACCEPT_ONE:
+                    case ASK_NEXT:
+                        break;
+
+                    case SKIP_ONE:
+                    case SKIP_ALL:
+                        importLog(processedRec, record, WARNING_SEVERITY, tr("Duplicate"));
+                        continue;
+                        break;
+                    }
+                }
             }
-        }
 
-        /********************/
-        /* Compute Distance */
-        /********************/
-        const QString &gridsquare = record.value(RECORDIDX(LogbookModel::COLUMN_GRID)).toString();
-        const QString &my_gridsquare = record.value(RECORDIDX(LogbookModel::COLUMN_MY_GRIDSQUARE)).toString();
+            for ( const ImportLogEntry &entry : item.enrichLog )
+                importLog(processedRec, record, entry.severity, entry.message);
 
-        if ( !gridsquare.isEmpty()
-             && !my_gridsquare.isEmpty()
-             && record.value(RECORDIDX(LogbookModel::COLUMN_DISTANCE)).toString().isEmpty() )
-        {
-            const Gridsquare grid(gridsquare);
-            const Gridsquare my_grid(my_gridsquare);
-            double distance;
+            if ( item.rejectedByEnrich )
+                continue;
 
-            if ( my_grid.distanceTo(grid, distance) )
+            /*************************/
+            /* Compute Alt from SOTA */
+            /*************************/
+            if ( record.value(RECORDIDX(LogbookModel::COLUMN_ALTITUDE)).toString().isEmpty()
+                 && !sota.toString().isEmpty() )
             {
-                record.setValue(RECORDIDX(LogbookModel::COLUMN_DISTANCE), distance);
+                const SOTAEntity &sotaInfo = Data::instance()->lookupSOTA(sota.toString());
+                if ( sotaInfo.summitCode.compare(sota.toString(), Qt::CaseInsensitive)
+                     && !sotaInfo.summitName.isEmpty() )
+                {
+                    record.setValue(RECORDIDX(LogbookModel::COLUMN_ALTITUDE),sotaInfo.altm);
+                }
             }
-        }
 
-        /*************************/
-        /* Compute Alt from SOTA */
-        /*************************/
-        if ( record.value(RECORDIDX(LogbookModel::COLUMN_ALTITUDE)).toString().isEmpty()
-             && !sota.toString().isEmpty() )
-        {
-            const SOTAEntity &sotaInfo = Data::instance()->lookupSOTA(sota.toString());
-            if ( sotaInfo.summitCode.compare(sota.toString(), Qt::CaseInsensitive)
-                 && !sotaInfo.summitName.isEmpty() )
+            /*******************************/
+            /* Compute My Alt from My SOTA */
+            /*******************************/
+            if ( record.value(RECORDIDX(LogbookModel::COLUMN_MY_ALTITUDE)).toString().isEmpty()
+                 && !mysota.toString().isEmpty() )
             {
-                record.setValue(RECORDIDX(LogbookModel::COLUMN_ALTITUDE),sotaInfo.altm);
+                const SOTAEntity &sotaInfo = Data::instance()->lookupSOTA(mysota.toString());
+                if ( sotaInfo.summitCode.compare(sota.toString(), Qt::CaseInsensitive)
+                     && !sotaInfo.summitName.isEmpty() )
+                {
+                    record.setValue(RECORDIDX(LogbookModel::COLUMN_MY_ALTITUDE),sotaInfo.altm);
+                }
             }
-        }
 
-        /*******************************/
-        /* Compute My Alt from My SOTA */
-        /*******************************/
-        if ( record.value(RECORDIDX(LogbookModel::COLUMN_MY_ALTITUDE)).toString().isEmpty()
-             && !mysota.toString().isEmpty() )
-        {
-            const SOTAEntity &sotaInfo = Data::instance()->lookupSOTA(mysota.toString());
-            if ( sotaInfo.summitCode.compare(sota.toString(), Qt::CaseInsensitive)
-                 && !sotaInfo.summitName.isEmpty() )
+            /******************/
+            /* PREPARE INSERT */
+            /******************/
+            for ( int i = 0; i < record.count(); i++ )
             {
-                record.setValue(RECORDIDX(LogbookModel::COLUMN_MY_ALTITUDE),sotaInfo.altm);
+                pendingColumns[i] << record.value(i);
             }
-        }
 
-        /******************/
-        /* PREPARE INSERT */
-        /******************/
-        // Bind all values
-        for ( int i = 0; i < record.count(); i++ )
-        {
-            insertQuery.bindValue(i, record.value(i));
+            ImportPendingInsert pending;
+            pending.recordNo = processedRec;
+            pending.record = record;
+            pendingInserts.append(pending);
+
+            pendingDupeIndex.addContact(pendingInserts.size(),
+                                        call.toString(),
+                                        band.toString(),
+                                        mode.toString(),
+                                        satName.toString(),
+                                        start_time);
+
+            if ( pendingInserts.size() >= SQLBulkLoad::CHUNK_SIZE )
+                flushInserts();
         }
+    }
 
-        if ( ! insertQuery.exec() )
-        {
+    flushInserts();
+
+    parserThread->wait();
+    delete parserThread;
+
+    for ( QThread *workerThread : workerThreads )
+    {
+        workerThread->wait();
+        delete workerThread;
+    }
+
+    if ( !bulkLoad.finishContacts() )
+    {
+        qWarning() << "Cannot finish contacts bulk load - rollback";
+        QSqlDatabase::database().rollback();
+
+        for ( const QPair<unsigned long, QString> &inserted : insertedRecords )
             writeImportLog(importLogStream,
                            ERROR_SEVERITY,
                            errors,
                            warnings,
-                           processedRec,
-                           record,
-                           tr("Cannot insert to database") + " - " + insertQuery.lastError().text());
-            qWarning() << "Cannot insert a record to Contact Table - " << insertQuery.lastError();
-            qCDebug(runtime) << record;
-        }
-        else
-        {
-            writeImportLog(importLogStream,
-                           INFO_SEVERITY,
-                           errors,
-                           warnings,
-                           processedRec,
-                           record,
-                           tr("Imported"));
-            count++;
-        }
+                           inserted.first,
+                           inserted.second,
+                           tr("Import rolled back - cannot update contacts"));
+        count = 0;
     }
+    else
+        QSqlDatabase::database().commit();
 
-    emit importPosition(stream.pos());
+    emit importPosition(importStreamPosition());
     emit finished(count);
 
-    QSqlDatabase::database().commit();
+    if ( count > 0 )
+    {
+        Data::instance()->clearDXCCStatusCache();
+        Data::instance()->clearDupeIndex();
+    }
 
     this->importEnd();
 
     return count;
 }
 
-#undef RECORDIDX
-
-QStringList LogFormat::splitCreditValues(const QString &value)
+void LogFormat::parseImportBatches(OrderedWorkQueue<ImportBatch> &queue,
+                                   const QSqlRecord &recordTemplate)
 {
-    QStringList ret;
-    const QStringList values = value.split(',',
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
-                                           Qt::SkipEmptyParts);
-#else
-                                           QString::SkipEmptyParts);
-#endif
+    FCT_IDENTIFICATION;
 
-    for ( const QString &rawValue : values )
+    // runs on the parser thread - only the format reader and the stream are used here
+    unsigned long recordNo = 0;
+    ImportBatch batch;
+
+    while ( true )
     {
-        const QString trimmed = rawValue.trimmed();
-        if ( !trimmed.isEmpty() )
-            ret << trimmed;
-    }
+        ImportRecord item;
+        item.record = recordTemplate;
 
-    return ret;
-}
+        if ( !this->importNext(item.record) ) break;
 
-QString LogFormat::mergeCreditValues(const QString &currentValue, const QString &newValue)
-{
-    QStringList merged;
-    QSet<QString> seen;
+        item.recordNo = ++recordNo;
+        item.parseWarnings = importWarnings;
+        batch.records.append(item);
 
-    auto appendIfMissing = [&merged, &seen](const QString &value)
-    {
-        const QString key = value.toUpper();
-        if ( !seen.contains(key) )
+        if ( batch.records.size() >= IMPORT_BATCH_SIZE )
         {
-            seen.insert(key);
-            merged << value;
+            batch.streamPosition = importStreamPosition();
+            queue.pushInput(batch);
+            batch = ImportBatch();
         }
-    };
-
-    const QStringList currentValues = splitCreditValues(currentValue);
-    for ( const QString &value : currentValues )
-        appendIfMissing(value);
+    }
 
-    const QStringList newValues = splitCreditValues(newValue);
-    for ( const QString &value : newValues )
-        appendIfMissing(value);
+    if ( !batch.records.isEmpty() )
+    {
+        batch.streamPosition = importStreamPosition();
+        queue.pushInput(batch);
+    }
 
-    return merged.join(',');
+    queue.finishInput();
 }
 
-bool LogFormat::isSatelliteDXCCCredit(const DXCCCreditRecord &credit)
+void LogFormat::checkImportRecord(ImportRecord &item)
 {
-    return splitCreditValues(credit.creditGranted).contains("DXCC_SATELLITE",
-                                                            Qt::CaseInsensitive);
-}
+    // Hot path - no FCT_IDENTIFICATION here
 
-bool LogFormat::isDXCCEntityCode(const QString &call)
-{
-    bool ok = false;
-    call.trimmed().toUInt(&ok);
-    return ok;
-}
+    QSqlRecord &record = item.record;
 
-QString LogFormat::escapeSqlLikePattern(const QString &value)
-{
-    QString ret = value;
-    ret.replace("\\", "\\\\");
-    ret.replace("%", "\\%");
-    ret.replace("_", "\\_");
-    return ret;
-}
+    /* Compute the Band if missing
+     *   Band is one of the mandatory fields
+     */
 
-QString LogFormat::formatDXCCCreditReport(const DXCCCreditRecord &credit,
-                                          const QStringList &addInfo)
-{
-    QString bandOrPropMode = credit.band;
-    if ( !credit.propMode.isEmpty() )
-        bandOrPropMode = bandOrPropMode.isEmpty() ? credit.propMode : bandOrPropMode + "/" + credit.propMode;
+    if ( record.value(RECORDIDX(LogbookModel::COLUMN_BAND)).toString().isEmpty()
+         && !record.value(RECORDIDX(LogbookModel::COLUMN_FREQUENCY)).toString().isEmpty() )
+    {
+        double freq = record.value(RECORDIDX(LogbookModel::COLUMN_FREQUENCY)).toDouble();
+        record.setValue(RECORDIDX(LogbookModel::COLUMN_BAND), BandPlan::freq2Band(freq).name);
+    }
 
-    return QString("%1; %2; %3%4 %5")
-        .arg(credit.qsoDate.isValid() ? credit.qsoDate.toString(Qt::ISODate) : "-",
-             credit.call.isEmpty() ? "-" : credit.call,
-             bandOrPropMode.isEmpty() ? "-" : bandOrPropMode,
-             addInfo.isEmpty() ? "" : ";",
-             addInfo.join(", "));
+    const QDateTime &start_time = record.value(RECORDIDX(LogbookModel::COLUMN_TIME_ON)).toDateTime();
+
+    /* checking matching fields if they are not empty */
+    if ( !start_time.isValid()
+         || record.value(RECORDIDX(LogbookModel::COLUMN_CALL)).toString().isEmpty()
+         || record.value(RECORDIDX(LogbookModel::COLUMN_BAND)).toString().isEmpty()
+         || record.value(RECORDIDX(LogbookModel::COLUMN_MODE)).toString().isEmpty())
+    {
+        item.checkLog.append(ImportLogEntry{ERROR_SEVERITY,
+                                            tr("A minimal set of fields not present (start_time, call, band, mode, station_callsign)")});
+        item.rejectedByCheck = true;
+        qWarning() << "Import does not contain minimal set of fields (start_time, call, band, mode, station_callsign)";
+        qCDebug(runtime) << record;
+        return;
+    }
+
+    if ( isDateRange() && !inDateRange(start_time.date()) )
+    {
+        item.checkLog.append(ImportLogEntry{WARNING_SEVERITY, tr("Outside the selected Date Range")});
+        item.rejectedByCheck = true;
+    }
 }
 
-bool LogFormat::selectDXCCCreditMatches(const DXCCCreditRecord &credit,
-                                        const DXCCCreditCallMatch callMatch,
-                                        const bool matchMode,
-                                        QList<DXCCCreditMatch> &matches,
-                                        QString &error)
+void LogFormat::enrichImportBatch(ImportBatch &batch,
+                                  const DxccSnapshot::Ptr &dxcc,
+                                  const StationProfile *defaultStationProfile)
 {
-    matches.clear();
-    error.clear();
+    FCT_IDENTIFICATION;
 
-    QStringList where =
+    QList<QString> lookupCallsigns;
+
+    for ( ImportRecord &item : batch.records )
     {
-        "ABS(JULIANDAY(date(start_time)) - JULIANDAY(date(:qso_date))) <= 1"
-    };
+        checkImportRecord(item);
 
-    // DXCC credits can come from LoTW or paper cards, and users may import
-    // credits before importing QSL state. Do not require local QSL received flags.
+        if ( item.rejectedByCheck )
+            continue;
 
-    if ( !credit.band.isEmpty() )
-        where << "upper(band) = upper(:band)";
+        const QString &myCallsign = item.record.value(RECORDIDX(LogbookModel::COLUMN_STATION_CALLSIGN)).toString();
 
-    if ( !credit.propMode.isEmpty() )
+        if ( !myCallsign.isEmpty() )
+            lookupCallsigns << myCallsign;
+
+        if ( fillMissingDxcc && item.record.value(RECORDIDX(LogbookModel::COLUMN_DXCC)).toInt() == 0 )
+            lookupCallsigns << item.record.value(RECORDIDX(LogbookModel::COLUMN_CALL)).toString();
+    }
+
+    // every distinct callsign of the batch is resolved only once
+    const QList<DxccEntity> &ad1cEntities = importLookupAD1C(dxcc, lookupCallsigns);
+    QHash<QString, DxccEntity> callEntities;
+
+    for ( int i = 0; i < lookupCallsigns.size() && i < ad1cEntities.size(); i++ )
+        callEntities.insert(lookupCallsigns.at(i), ad1cEntities.at(i));
+
+    // missing DXCC which is not on AD1C list - try Clublog with the QSO date
+    QList<QString> clublogCallsigns;
+    QList<QDateTime> clublogDates;
+    QList<int> clublogRecords;
+
+    if ( fillMissingDxcc )
     {
-        where << "upper(prop_mode) = upper(:prop_mode)";
+        for ( int i = 0; i < batch.records.size(); i++ )
+        {
+            const QSqlRecord &record = batch.records.at(i).record;
+
+            if ( batch.records.at(i).rejectedByCheck
+                 || record.value(RECORDIDX(LogbookModel::COLUMN_DXCC)).toInt() != 0 )
+                continue;
+
+            const QString &callsign = record.value(RECORDIDX(LogbookModel::COLUMN_CALL)).toString();
+
+            if ( callEntities.value(callsign).dxcc != 0 )
+                continue;
+
+            clublogCallsigns << callsign;
+            clublogDates << record.value(RECORDIDX(LogbookModel::COLUMN_TIME_ON)).toDateTime();
+            clublogRecords << i;
+        }
     }
-    else
+
+    QHash<int, DxccEntity> clublogEntities;
+
+    if ( !clublogCallsigns.isEmpty() )
     {
-        // LoTW reports satellite credits with PROP_MODE=SAT/DXCC_SATELLITE.
-        // Keep normal DXCC credits from matching satellite QSOs by date/call/band.
-        where << "(prop_mode IS NULL OR upper(prop_mode) <> 'SAT')";
+        const QList<DxccEntity> &entities = importLookupClublog(dxcc, clublogCallsigns, clublogDates);
+
+        for ( int i = 0; i < clublogRecords.size() && i < entities.size(); i++ )
+            clublogEntities.insert(clublogRecords.at(i), entities.at(i));
+    }
+
+    for ( int i = 0; i < batch.records.size(); i++ )
+    {
+        ImportRecord &item = batch.records[i];
+
+        if ( !item.rejectedByCheck )
+            enrichImportRecord(item, dxcc, defaultStationProfile,
+                               callEntities, clublogEntities.value(i));
     }
+}
 
-    if ( !credit.dxcc.isEmpty() )
-        where << "dxcc = :dxcc";
+void LogFormat::enrichImportRecord(ImportRecord &item,
+                                   const DxccSnapshot::Ptr &dxcc,
+                                   const StationProfile *defaultStationProfile,
+                                   const QHash<QString, DxccEntity> &callEntities,
+                                   const DxccEntity &clublogEntity)
+{
+    // Hot path - no FCT_IDENTIFICATION here
 
-    if ( !credit.awardEntity.isEmpty() )
-        where << "my_dxcc = :award_entity";
+    QSqlRecord &record = item.record;
 
-    switch ( callMatch )
+    auto addImportLog = [&](ImportLogSeverity severity, const QString &message)
     {
-    case EXACT_CALL_MATCH:
-        where << "callsign = upper(:call)";
-        break;
+        item.enrichLog.append(ImportLogEntry{severity, message});
+    };
 
-    case PREFIX_CALL_MATCH:
-        where << "upper(callsign) LIKE upper(:call_prefix) ESCAPE '\\'";
-        break;
+    auto setIfEmpty = [&](int column, const QString &value)
+    {
+        if ( record.value(RECORDIDX(column)).toString().isEmpty() && !value.isEmpty() )
+            record.setValue(RECORDIDX(column), value);
+    };
 
-    case NO_CALL_MATCH:
-        break;
-    }
+    auto setMyDefaultProfile = [&]()
+    {
+        setIfEmpty(LogbookModel::COLUMN_MY_DXCC, QString::number(defaultStationProfile->dxcc));
+        setIfEmpty(LogbookModel::COLUMN_STATION_CALLSIGN, defaultStationProfile->callsign);
+        setIfEmpty(LogbookModel::COLUMN_MY_GRIDSQUARE, defaultStationProfile->locator);
+        setIfEmpty(LogbookModel::COLUMN_MY_NAME, Data::removeAccents(defaultStationProfile->operatorName));
+        setIfEmpty(LogbookModel::COLUMN_MY_NAME_INTL, defaultStationProfile->operatorName);
+        setIfEmpty(LogbookModel::COLUMN_OPERATOR, defaultStationProfile->operatorCallsign);
+        setIfEmpty(LogbookModel::COLUMN_MY_CITY_INTL, defaultStationProfile->qthName);
+        setIfEmpty(LogbookModel::COLUMN_MY_CITY, Data::removeAccents(defaultStationProfile->qthName));
+        setIfEmpty(LogbookModel::COLUMN_MY_IOTA, defaultStationProfile->iota);
+        setIfEmpty(LogbookModel::COLUMN_MY_POTA_REF, defaultStationProfile->pota);
+        setIfEmpty(LogbookModel::COLUMN_MY_SOTA_REF, defaultStationProfile->sota);
+        setIfEmpty(LogbookModel::COLUMN_MY_SIG_INTL, defaultStationProfile->sig);
+        setIfEmpty(LogbookModel::COLUMN_MY_SIG, Data::removeAccents(defaultStationProfile->sig));
+        setIfEmpty(LogbookModel::COLUMN_MY_SIG_INFO_INTL, defaultStationProfile->sigInfo);
+        setIfEmpty(LogbookModel::COLUMN_MY_SIG_INFO, Data::removeAccents(defaultStationProfile->sigInfo));
+        setIfEmpty(LogbookModel::COLUMN_MY_VUCC_GRIDS, defaultStationProfile->vucc);
+        setIfEmpty(LogbookModel::COLUMN_MY_ITU_ZONE, QString::number(defaultStationProfile->ituz));
+        setIfEmpty(LogbookModel::COLUMN_MY_CQ_ZONE, QString::number(defaultStationProfile->cqz));
+        setIfEmpty(LogbookModel::COLUMN_MY_COUNTRY_INTL, defaultStationProfile->country);
+        setIfEmpty(LogbookModel::COLUMN_MY_COUNTRY, Data::removeAccents(defaultStationProfile->country));
+        setIfEmpty(LogbookModel::COLUMN_MY_CNTY, Data::removeAccents(defaultStationProfile->county));
+        setIfEmpty(LogbookModel::COLUMN_MY_DARC_DOK, Data::removeAccents(defaultStationProfile->darcDOK));
+    };
 
-    if ( matchMode )
+    auto setMyEntity = [&](const DxccEntity &myEntity)
+    {
+        // force overwrite
+        record.setValue(RECORDIDX(LogbookModel::COLUMN_MY_DXCC), myEntity.dxcc);
+        record.setValue(RECORDIDX(LogbookModel::COLUMN_MY_COUNTRY), Data::removeAccents(myEntity.country));
+        record.setValue(RECORDIDX(LogbookModel::COLUMN_MY_COUNTRY_INTL), myEntity.country);
+
+        // other DXCC related values ​​are not closely related to DXCC value and could have been filled
+        // therefore check if it is present or not.
+        setIfEmpty(LogbookModel::COLUMN_MY_ITU_ZONE, QString::number(myEntity.ituz));
+        setIfEmpty(LogbookModel::COLUMN_MY_CQ_ZONE, QString::number(myEntity.cqz));
+    };
+
+    auto lookupAndSetMyEntityByCallsign = [&] (const QString& recordMyDXCC)
     {
-        if ( !credit.dxccModeGroup.isEmpty() )
+        const DxccEntity &myEntity = callEntities.value(recordMyDXCC);
+
+        if ( myEntity.dxcc == 0 )  // My DXCC not found
         {
-            QString modeCondition = "(SELECT dxcc FROM modes WHERE upper(name) = upper(contacts.mode) LIMIT 1) = :dxcc_mode_group";
-            if ( !credit.mode.isEmpty() )
-                modeCondition = "(" + modeCondition + " OR upper(mode) = upper(:mode))";
-            where << modeCondition;
+            addImportLog(WARNING_SEVERITY, tr("Cannot find My DXCC Entity Info"));
         }
-        else if ( !credit.mode.isEmpty() )
+        else
         {
-            where << "upper(mode) = upper(:mode)";
+            setMyEntity(myEntity);
         }
-    }
+    };
 
-    QSqlQuery query;
-    const QString sql = QString("SELECT id, callsign, band, mode, start_time, prop_mode, credit_granted "
-                                "FROM contacts WHERE %1 ORDER BY start_time, id").arg(where.join(" AND "));
+    const QVariant &call = record.value(RECORDIDX(LogbookModel::COLUMN_CALL));
+    const QVariant &mycall = record.value(RECORDIDX(LogbookModel::COLUMN_STATION_CALLSIGN));
 
-    if ( !query.prepare(sql) )
+    /* Adding information which are important for QLog or QLog knows/compute them */
+    /************************/
+    /* Add DXCC Entity Info */
+    /************************/
+    const int recordDXCCId = record.value(RECORDIDX(LogbookModel::COLUMN_DXCC)).toInt();  // 0 = NaN or not present
+                                                                                          // otherwise = DXCC ID
+    DxccEntity entity;
+
+    if ( recordDXCCId != 0 )
     {
-        error = query.lastError().text();
-        return false;
+        // get additional DXCC info
+        entity = importEntityAD1C(dxcc, recordDXCCId);
+
+        // if DXCC is not present on AD1C list, try Clublog, no CQZ and ITUZ info here
+        if ( entity.dxcc == 0 )
+            entity = importEntityClublog(dxcc, recordDXCCId);
+
+        // no record in clublog, only Warning, because DXCC number is present
+        if ( entity.dxcc == 0 )
+            addImportLog(WARNING_SEVERITY, tr("DXCC Info is missing"));
+    }
+    else if ( !fillMissingDxcc )
+    {
+        // DXCC info is missing in the source and fillMissingDXCC is disabled - ERROR - QLog needs DXCC
+        addImportLog(ERROR_SEVERITY, tr("DXCC Info is missing"));
+        item.rejectedByEnrich = true;
+        return;
     }
+    else
+    {
+        // DXCC info is missing in the source and fillMissingDXCC is enabled, try to find on AD1C list
+        entity = callEntities.value(call.toString());
+        if ( entity.dxcc == 0 )
+            // if DXCC is not present on AD1C list, try Clublog (resolved for the whole batch)
+            entity = clublogEntity;
 
-    query.bindValue(":qso_date", credit.qsoDate.toString(Qt::ISODate));
+        if ( entity.dxcc == 0 )
+        {
+            // no record in clublog - ERROR - QLog needs DXCC
+            addImportLog(ERROR_SEVERITY, tr("DXCC Info is missing"));
+            item.rejectedByEnrich = true;
+            return;
+        }
+    }
 
-    if ( !credit.band.isEmpty() )
-        query.bindValue(":band", credit.band);
+    if ( entity.dxcc != 0 )
+    {
+        record.setValue(RECORDIDX(LogbookModel::COLUMN_DXCC), entity.dxcc);
+        record.setValue(RECORDIDX(LogbookModel::COLUMN_COUNTRY), Data::removeAccents(entity.country));
+        record.setValue(RECORDIDX(LogbookModel::COLUMN_COUNTRY_INTL), entity.country);
 
-    if ( !credit.propMode.isEmpty() )
-        query.bindValue(":prop_mode", credit.propMode);
+        // other DXCC related values ​​are not closely related to DXCC value and could have been filled
+        // therefore check if it is present or not.
+        setIfEmpty(LogbookModel::COLUMN_CONTINENT, entity.cont);
+        setIfEmpty(LogbookModel::COLUMN_ITUZ, QString::number(entity.ituz));
+        setIfEmpty(LogbookModel::COLUMN_CQZ, QString::number(entity.cqz));
+    };
 
-    if ( !credit.dxcc.isEmpty() )
-        query.bindValue(":dxcc", credit.dxcc);
+    /************************/
+    /* Add My Station Info  */
+    /************************/
 
-    if ( !credit.awardEntity.isEmpty() )
-        query.bindValue(":award_entity", credit.awardEntity);
+    int recordMyDXCCId = record.value(RECORDIDX(LogbookModel::COLUMN_MY_DXCC)).toInt(); // 0 = NAN or not present
+                                                                                        // otherwise = DXCC ID
+    const QString &myCallString = mycall.toString();
 
-    switch ( callMatch )
+    if ( defaultStationProfile )
     {
-    case EXACT_CALL_MATCH:
-        query.bindValue(":call", credit.call);
-        break;
+        // default is enabled
 
-    case PREFIX_CALL_MATCH:
-        query.bindValue(":call_prefix", escapeSqlLikePattern(credit.call) + "%");
-        break;
+        // Case 1: Both recordMyDXCCId and myCallString are empty
+        if (  recordMyDXCCId == 0 && myCallString.isEmpty()  )
+        {
+            setMyDefaultProfile();
+        }
+        // Case 2: recordMyDXCCId is empty, myCallString is not
+        else if ( recordMyDXCCId == 0 )
+        {
+            if ( defaultStationProfile->callsign == myCallString )
+                setMyDefaultProfile();
+            else
+                lookupAndSetMyEntityByCallsign(myCallString);
+        }
+        // Case 3: myCallString is empty, recordMyDXCCId is not
+        else if ( myCallString.isEmpty() )
+        {
+            if ( defaultStationProfile->dxcc == recordMyDXCCId )
+                setMyDefaultProfile();
+            else
+            {
+                // no Station Callsign = ERROR
+                addImportLog(ERROR_SEVERITY, tr("no Station Callsign present"));
+                item.rejectedByEnrich = true;
+                return;
+            }
+        }
+         // Case 4: Both recordMyDXCCId and myCallString are not empty
+        else
+        {
+            if ( defaultStationProfile->callsign == myCallString )
+            {
+                if ( defaultStationProfile->dxcc == recordMyDXCCId )
+                    setMyDefaultProfile();
+                else
+                {
+                    // no Station Callsign = ERROR
+                    addImportLog(ERROR_SEVERITY, tr("no Station Callsign present"));
+                    item.rejectedByEnrich = true;
+                    return;
+                }
+            }
+            else
+                lookupAndSetMyEntityByCallsign(myCallString);
+        }
+    }
+    else
+    {
+        // default is disabled
+        if ( myCallString.isEmpty() )
+        {
+            // no Station Callsign = ERROR
+            addImportLog(ERROR_SEVERITY, tr("no Station Callsign present"));
+            item.rejectedByEnrich = true;
+            return;
+        }
+        else
+        {
+            const DxccEntity &myEntity = ( recordMyDXCCId != 0 ) ? importEntityAD1C(dxcc, recordMyDXCCId)
+                                                                 : callEntities.value(myCallString);
 
-    case NO_CALL_MATCH:
-        break;
+            if ( myEntity.dxcc == 0 )  // My DXCC not found
+            {
+                addImportLog(WARNING_SEVERITY, tr("Cannot find My DXCC Entity Info"));
+            }
+            else
+                setMyEntity(myEntity);
+        }
     }
 
-    if ( matchMode )
+    /***********/
+    /* Add PFX */
+    /***********/
+
+    if ( record.value(RECORDIDX(LogbookModel::COLUMN_PREFIX)).toString().isEmpty() )
     {
-        if ( !credit.dxccModeGroup.isEmpty() )
-            query.bindValue(":dxcc_mode_group", credit.dxccModeGroup);
-        if ( !credit.mode.isEmpty() )
-            query.bindValue(":mode", credit.mode);
+        const QString &pfxRef = Callsign(call.toString()).getWPXPrefix();
+
+        if ( !pfxRef.isEmpty() )
+        {
+            record.setValue(RECORDIDX(LogbookModel::COLUMN_PREFIX), pfxRef);
+        }
     }
 
-    if ( !query.exec() )
+    /********************/
+    /* Compute Distance */
+    /********************/
+    const QString &gridsquare = record.value(RECORDIDX(LogbookModel::COLUMN_GRID)).toString();
+    const QString &my_gridsquare = record.value(RECORDIDX(LogbookModel::COLUMN_MY_GRIDSQUARE)).toString();
+
+    if ( !gridsquare.isEmpty()
+         && !my_gridsquare.isEmpty()
+         && record.value(RECORDIDX(LogbookModel::COLUMN_DISTANCE)).toString().isEmpty() )
     {
-        error = query.lastError().text();
-        return false;
+        const Gridsquare grid(gridsquare);
+        const Gridsquare my_grid(my_gridsquare);
+        double distance;
+
+        if ( my_grid.distanceTo(grid, distance) )
+        {
+            record.setValue(RECORDIDX(LogbookModel::COLUMN_DISTANCE), distance);
+        }
     }
+}
 
-    while ( query.next() )
+// DXCC lookups of the import enrichment stage - the snapshot when it runs on the workers,
+// Data (db connection of the calling thread) otherwise
+
+QList<DxccEntity> LogFormat::importLookupAD1C(const DxccSnapshot::Ptr &dxcc,
+                                              const QList<QString> &callsigns)
+{
+    FCT_IDENTIFICATION;
+
+    return ( dxcc ) ? dxcc->lookupAD1C(callsigns)
+                    : Data::instance()->lookupDxccBatch(callsigns);
+}
+
+QList<DxccEntity> LogFormat::importLookupClublog(const DxccSnapshot::Ptr &dxcc,
+                                                 const QList<QString> &callsigns,
+                                                 const QList<QDateTime> &dates)
+{
+    FCT_IDENTIFICATION;
+
+    return ( dxcc ) ? dxcc->lookupClublog(callsigns, dates)
+                    : Data::instance()->lookupDxccClublogBatch(callsigns, dates);
+}
+
+DxccEntity LogFormat::importEntityAD1C(const DxccSnapshot::Ptr &dxcc, int dxccID)
+{
+    FCT_IDENTIFICATION;
+
+    return ( dxcc ) ? dxcc->entityAD1C(dxccID)
+                    : Data::instance()->lookupDxccIDAD1C(dxccID);
+}
+
+DxccEntity LogFormat::importEntityClublog(const DxccSnapshot::Ptr &dxcc, int dxccID)
+{
+    FCT_IDENTIFICATION;
+
+    return ( dxcc ) ? dxcc->entityClublog(dxccID)
+                    : Data::instance()->lookupDxccIDClublog(dxccID);
+}
+
+#undef IMPORT_BATCH_SIZE
+
+#undef RECORDIDX
+
+QStringList LogFormat::splitCreditValues(const QString &value)
+{
+    QStringList ret;
+    const QStringList values = value.split(',',
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
+                                           Qt::SkipEmptyParts);
+#else
+                                           QString::SkipEmptyParts);
+#endif
+
+    for ( const QString &rawValue : values )
     {
-        DXCCCreditMatch match;
-        match.id = query.value(0).toULongLong();
-        match.callsign = query.value(1).toString();
-        match.band = query.value(2).toString();
-        match.mode = query.value(3).toString();
-        match.startTime = query.value(4).toDateTime();
-        match.propMode = query.value(5).toString();
-        match.creditGranted = query.value(6).toString();
-        matches << match;
+        const QString trimmed = rawValue.trimmed();
+        if ( !trimmed.isEmpty() )
+            ret << trimmed;
     }
 
-    return true;
+    return ret;
+}
+
+QString LogFormat::mergeCreditValues(const QString &currentValue, const QString &newValue)
+{
+    QStringList merged;
+    QSet<QString> seen;
+
+    auto appendIfMissing = [&merged, &seen](const QString &value)
+    {
+        const QString key = value.toUpper();
+        if ( !seen.contains(key) )
+        {
+            seen.insert(key);
+            merged << value;
+        }
+    };
+
+    const QStringList currentValues = splitCreditValues(currentValue);
+    for ( const QString &value : currentValues )
+        appendIfMissing(value);
+
+    const QStringList newValues = splitCreditValues(newValue);
+    for ( const QString &value : newValues )
+        appendIfMissing(value);
+
+    return merged.join(',');
+}
+
+bool LogFormat::isSatelliteDXCCCredit(const DXCCCreditRecord &credit)
+{
+    return splitCreditValues(credit.creditGranted).contains("DXCC_SATELLITE",
+                                                            Qt::CaseInsensitive);
+}
+
+bool LogFormat::isDXCCEntityCode(const QString &call)
+{
+    bool ok = false;
+    call.trimmed().toUInt(&ok);
+    return ok;
+}
+
+QString LogFormat::formatDXCCCreditReport(const DXCCCreditRecord &credit,
+                                          const QStringList &addInfo)
+{
+    QString bandOrPropMode = credit.band;
+    if ( !credit.propMode.isEmpty() )
+        bandOrPropMode = bandOrPropMode.isEmpty() ? credit.propMode : bandOrPropMode + "/" + credit.propMode;
+
+    return QString("%1; %2; %3%4 %5")
+        .arg(credit.qsoDate.isValid() ? credit.qsoDate.toString(Qt::ISODate) : "-",
+             credit.call.isEmpty() ? "-" : credit.call,
+             bandOrPropMode.isEmpty() ? "-" : bandOrPropMode,
+             addInfo.isEmpty() ? "" : ";",
+             addInfo.join(", "));
 }
 
 void LogFormat::runDXCCCreditImport()
@@ -1013,6 +1305,19 @@ void LogFormat::runDXCCCreditImport()
 
     this->importStart();
 
+    // all credits are matched against one scan of the log
+    DXCCCreditIndex index;
+
+    struct DXCCCreditUpdate
+    {
+        qulonglong id;
+        DXCCCreditRecord credit;
+        QStringList details;
+    };
+
+    QList<DXCCCreditUpdate> updates;
+    QMap<qulonglong, QString> updatedCredits;   // contacts.id, credit_granted
+
     while ( true )
     {
         DXCCCreditRecord credit;
@@ -1022,7 +1327,7 @@ void LogFormat::runDXCCCreditImport()
         stats.qsosDownloaded++;
 
         if ( stats.qsosDownloaded % 100 == 0 )
-            emit importPosition(stream.pos());
+            emit importPosition(importStreamPosition());
 
         credit.dxccModeGroup = LotwDXCCCreditDownloader::dxccModeGroupFromLotw(credit.dxccModeGroup);
 
@@ -1046,64 +1351,50 @@ void LogFormat::runDXCCCreditImport()
             continue;
         }
 
+        if ( !index.isLoaded() && !index.load() )
+        {
+            stats.errorQSLs.append(formatDXCCCreditReport(credit, {tr("cannot load QSOs")}));
+            continue;
+        }
+
         const bool hasExactCall = !credit.call.isEmpty() && !callIsDXCCEntityCode;
         const bool canUseDXCCOnlyMatch = !hasExactCall;
         const bool hasMode = !credit.dxccModeGroup.isEmpty() || !credit.mode.isEmpty();
-        QList<DXCCCreditMatch> matches;
-        QString sqlError;
+
+        DXCCCreditIndex::Credit indexCredit;
+        indexCredit.qsoDate = credit.qsoDate;
+        indexCredit.call = credit.call;
+        indexCredit.band = credit.band;
+        indexCredit.propMode = credit.propMode;
+        indexCredit.dxcc = credit.dxcc;
+        indexCredit.awardEntity = credit.awardEntity;
+        indexCredit.mode = credit.mode;
+        indexCredit.dxccModeGroup = credit.dxccModeGroup;
+
+        QList<int> matches;
 
         if ( hasExactCall )
         {
-            if ( !selectDXCCCreditMatches(credit, EXACT_CALL_MATCH, hasMode, matches, sqlError) )
-            {
-                stats.errorQSLs.append(formatDXCCCreditReport(credit, {sqlError}));
-                continue;
-            }
+            matches = index.select(indexCredit, DXCCCreditIndex::EXACT_CALL_MATCH, hasMode);
 
             if ( matches.isEmpty() && hasMode )
-            {
-                if ( !selectDXCCCreditMatches(credit, EXACT_CALL_MATCH, false, matches, sqlError) )
-                {
-                    stats.errorQSLs.append(formatDXCCCreditReport(credit, {sqlError}));
-                    continue;
-                }
-            }
+                matches = index.select(indexCredit, DXCCCreditIndex::EXACT_CALL_MATCH, false);
 
             if ( matches.isEmpty() )
             {
-                if ( !selectDXCCCreditMatches(credit, PREFIX_CALL_MATCH, hasMode, matches, sqlError) )
-                {
-                    stats.errorQSLs.append(formatDXCCCreditReport(credit, {sqlError}));
-                    continue;
-                }
+                matches = index.select(indexCredit, DXCCCreditIndex::PREFIX_CALL_MATCH, hasMode);
 
                 if ( matches.isEmpty() && hasMode )
-                {
-                    if ( !selectDXCCCreditMatches(credit, PREFIX_CALL_MATCH, false, matches, sqlError) )
-                    {
-                        stats.errorQSLs.append(formatDXCCCreditReport(credit, {sqlError}));
-                        continue;
-                    }
-                }
+                    matches = index.select(indexCredit, DXCCCreditIndex::PREFIX_CALL_MATCH, false);
             }
         }
 
         if ( matches.isEmpty() && !credit.dxcc.isEmpty() && canUseDXCCOnlyMatch )
         {
-            if ( !selectDXCCCreditMatches(credit, NO_CALL_MATCH, hasMode, matches, sqlError) )
-            {
-                stats.errorQSLs.append(formatDXCCCreditReport(credit, {sqlError}));
-                continue;
-            }
+            matches = index.select(indexCredit, DXCCCreditIndex::NO_CALL_MATCH, hasMode);
 
             if ( matches.isEmpty() && hasMode )
-            {
-                if ( !selectDXCCCreditMatches(credit, NO_CALL_MATCH, false, matches, sqlError) )
-                {
-                    stats.errorQSLs.append(formatDXCCCreditReport(credit, {sqlError}));
-                    continue;
-                }
-            }
+                matches = index.select(indexCredit, DXCCCreditIndex::NO_CALL_MATCH, false);
         }
 
         if ( matches.isEmpty() )
@@ -1112,33 +1403,15 @@ void LogFormat::runDXCCCreditImport()
             continue;
         }
 
-        QSqlQuery updateQuery;
-        if ( !updateQuery.prepare("UPDATE contacts SET credit_granted = :credit_granted WHERE id = :id") )
-        {
-            stats.errorQSLs.append(formatDXCCCreditReport(credit, {updateQuery.lastError().text()}));
-            continue;
-        }
-
-        for ( const DXCCCreditMatch &match : static_cast<const QList<DXCCCreditMatch>&>(matches) )
+        for ( int pos : static_cast<const QList<int>&>(matches) )
         {
+            const DXCCCreditIndex::Contact &match = index.contact(pos);
             const QString mergedCredits = mergeCreditValues(match.creditGranted, credit.creditGranted);
             const QString normalizedCurrentCredits = splitCreditValues(match.creditGranted).join(',');
 
             if ( mergedCredits == normalizedCurrentCredits )
                 continue;
 
-            updateQuery.bindValue(":credit_granted", mergedCredits);
-            updateQuery.bindValue(":id", match.id);
-
-            if ( !updateQuery.exec() )
-            {
-                stats.errorQSLs.append(formatDXCCCreditReport(credit,
-                                                              {tr("cannot update QSO %1: %2")
-                                                                   .arg(match.id)
-                                                                   .arg(updateQuery.lastError().text())}));
-                continue;
-            }
-
             QStringList details;
             if ( matches.size() > 1 && match.startTime.isValid() )
             {
@@ -1147,11 +1420,68 @@ void LogFormat::runDXCCCreditImport()
             }
             details << tr("credit_granted:") + " " + credit.creditGranted;
 
-            stats.updatedQSOs.append(formatDXCCCreditReport(credit, details));
+            updatedCredits.insert(match.id, mergedCredits);
+            updates.append({match.id, credit, details});
+
+            // the next credits see the merged value
+            index.setCreditGranted(pos, mergedCredits);
         }
     }
 
-    emit importPosition(stream.pos());
+    emit importPosition(importStreamPosition());
+
+    // all updated QSOs are written by one batched statement
+    if ( !updatedCredits.isEmpty() )
+    {
+        QSqlDatabase database = QSqlDatabase::database();
+        QSqlQuery updateQuery;
+        QString updateError;
+        QVariantList creditValues;
+        QVariantList ids;
+
+        for ( auto it = updatedCredits.constBegin(); it != updatedCredits.constEnd(); ++it )
+        {
+            ids << it.key();
+            creditValues << it.value();
+        }
+
+        if ( !database.transaction() )
+            updateError = database.lastError().text();
+        else if ( !updateQuery.prepare("UPDATE contacts SET credit_granted = ? WHERE id = ?") )
+            updateError = updateQuery.lastError().text();
+        else
+        {
+            updateQuery.addBindValue(creditValues);
+            updateQuery.addBindValue(ids);
+
+            if ( !updateQuery.execBatch() )
+                updateError = updateQuery.lastError().text();
+            else if ( !database.commit() )
+                updateError = database.lastError().text();
+        }
+
+        if ( !updateError.isEmpty() )
+        {
+            qWarning() << "Cannot update DXCC credits" << updateError;
+
+            if ( !database.rollback() )
+                qWarning() << "Cannot rollback DXCC credit transaction:" << database.lastError();
+        }
+
+        for ( const DXCCCreditUpdate &update : static_cast<const QList<DXCCCreditUpdate>&>(updates) )
+        {
+            if ( !updateError.isEmpty() )
+            {
+                stats.errorQSLs.append(formatDXCCCreditReport(update.credit,
+                                                              {tr("cannot update QSO %1: %2")
+                                                                   .arg(update.id)
+                                                                   .arg(updateError)}));
+                continue;
+            }
+
+            stats.updatedQSOs.append(formatDXCCCreditReport(update.credit, update.details));
+        }
+    }
 
     this->importEnd();
 
@@ -1182,10 +1512,8 @@ void LogFormat::runQSLImport(QSLFrom fromService)
     QSLMergeStat stats = {QStringList(), QStringList(), QStringList(), QStringList(), 0};
     this->importStart();
 
-    QSqlTableModel model;
-    model.setTable("contacts");
-    QSqlRecord QSLRecord = model.record(0);
     QSqlDatabase database = QSqlDatabase::database();
+    QSqlRecord downloadedRecord = database.record("contacts");
 
     if ( !database.transaction() )
     {
@@ -1200,7 +1528,6 @@ void LogFormat::runQSLImport(QSLFrom fromService)
     auto failImport = [&](const QString &error)
     {
         qWarning() << error;
-        model.revertAll();
         if ( !database.rollback() )
             qWarning() << "Cannot rollback QSL import transaction:" << database.lastError();
         Data::instance()->clearDXCCStatusCache();
@@ -1208,431 +1535,624 @@ void LogFormat::runQSLImport(QSLFrom fromService)
         emit QSLMergeFailed(error);
     };
 
+    /* The downloaded QSLs are processed in chunks. Each chunk is stored to
+     * a temporary table and matched against the log by one join; the matched
+     * contacts are loaded at once, updated in memory in the download order
+     * and the changed columns are written back when the chunk is finished.
+     */
+    QSqlQuery tableQuery;
+
+    if ( !tableQuery.exec("DROP TABLE IF EXISTS temp.qsl_import_records")
+         || !tableQuery.exec(qslImportTableStatement()) )
+    {
+        failImport(tr("Cannot create QSL import table: ") + tableQuery.lastError().text());
+        return;
+    }
+
+    QSqlQuery insertQuery;
+
+    if ( !insertQuery.prepare("INSERT INTO temp.qsl_import_records "
+                              "VALUES (:seq, upper(:callsign), upper(:band), upper(COALESCE(:sat_name, '')), "
+                              "        upper(:mode), :start_ts, upper(:station_callsign), :mode_group)") )
+    {
+        failImport(tr("Cannot prepare QSL import statement: ") + insertQuery.lastError().text());
+        return;
+    }
+
+    const QString matchStmt = qslImportMatchStatement(fromService);
+
+    struct QSLMatchCandidate
+    {
+        qulonglong id;
+        bool exactMode;
+        bool modeGroup;
+        bool exactTime;
+    };
+
+    struct ContactUpdate
+    {
+        QStringList columns;
+        QVector<QVariantList> values;
+        QVariantList ids;
+    };
+
     // Cache for mode to dxcc group lookups; avoids repeated DB queries for the same
     // mode value when processing large imports (LoTW fallback path only).
     QMap<QString, QString> modeGroupCache;
 
-    while ( true )
-    {
-        QSLRecord.clearValues();
+    QList<QSqlRecord> chunkRecords;
+    QStringList chunkModeGroups;
+    bool inputFinished = false;
 
-        if ( !this->importNext(QSLRecord) ) break;
-
-        stats.qsosDownloaded++;
+    while ( !inputFinished )
+    {
+        chunkRecords.clear();
+        chunkModeGroups.clear();
 
-        if ( stats.qsosDownloaded % 100 == 0 )
+        if ( !tableQuery.exec("DELETE FROM temp.qsl_import_records") )
         {
-            emit importPosition(stream.pos());
+            failImport(tr("Cannot clear QSL import table: ") + tableQuery.lastError().text());
+            return;
         }
 
-        // needed later
-        const QVariant &call = QSLRecord.value("callsign");
-        const QVariant &band = QSLRecord.value("band");
-        const QVariant &mode = QSLRecord.value("mode");
-        const QVariant &start_time = QSLRecord.value("start_time");
-        const QVariant &satName = QSLRecord.value("sat_name");
-        const QString stationCallsign = QSLRecord.value("station_callsign").toString().trimmed();
-
-        /* checking matching fields if they are not empty */
-        if ( !start_time.toDateTime().isValid()
-             || call.toString().isEmpty()
-             || band.toString().isEmpty()
-             || mode.toString().isEmpty()
-             || ( fromService == LOTW && stationCallsign.isEmpty() ) )
+        while ( chunkRecords.size() < QSL_MERGE_CHUNK_SIZE )
         {
-            qWarning() << "QSL import does not contain all required matching fields";
-            qCDebug(runtime) << QSLRecord;
-            stats.errorQSLs.append(
-                        reportFormatter(start_time.toDateTime(),
-                                        call.toString(),
-                                        mode.toString(),
-                                        QStringList(),
-                                        fromService == LOTW ? stationCallsign : QString()));
+            downloadedRecord.clearValues();
+
+            if ( !this->importNext(downloadedRecord) )
+            {
+                inputFinished = true;
+                break;
+            }
+
+            stats.qsosDownloaded++;
+
+            if ( stats.qsosDownloaded % 100 == 0 )
+            {
+                emit importPosition(importStreamPosition());
+            }
+
+            const QVariant &call = downloadedRecord.value("callsign");
+            const QVariant &band = downloadedRecord.value("band");
+            const QVariant &mode = downloadedRecord.value("mode");
+            const QVariant &start_time = downloadedRecord.value("start_time");
+            const QString stationCallsign = downloadedRecord.value("station_callsign").toString().trimmed();
+
+            /* checking matching fields if they are not empty */
+            if ( !start_time.toDateTime().isValid()
+                 || call.toString().isEmpty()
+                 || band.toString().isEmpty()
+                 || mode.toString().isEmpty()
+                 || ( fromService == LOTW && stationCallsign.isEmpty() ) )
+            {
+                qWarning() << "QSL import does not contain all required matching fields";
+                qCDebug(runtime) << downloadedRecord;
+                stats.errorQSLs.append(
+                            reportFormatter(start_time.toDateTime(),
+                                            call.toString(),
+                                            mode.toString(),
+                                            QStringList(),
+                                            fromService == LOTW ? stationCallsign : QString()));
+                continue;
+            }
+
+            // LoTW fallback: LoTW confirms QSOs when both sides specify modes in the same
+            // group (CW / PHONE / DATA).
+            QString dxccGroup;
+
+            if ( fromService == LOTW )
+            {
+                const QString modeStr = mode.toString();
+                dxccGroup = LotwBase::lotwGroupNameToDxcc(modeStr);
+
+                if ( dxccGroup.isEmpty() )
+                {
+                    if ( !modeGroupCache.contains(modeStr) )
+                        modeGroupCache.insert(modeStr, BandPlan::modeToDXCCModeGroup(modeStr));
+                    dxccGroup = modeGroupCache.value(modeStr);
+                }
+            }
+
+            insertQuery.bindValue(":seq", chunkRecords.size());
+            insertQuery.bindValue(":callsign", call);
+            insertQuery.bindValue(":band", band);
+            insertQuery.bindValue(":sat_name", downloadedRecord.value("sat_name"));
+            insertQuery.bindValue(":mode", mode);
+            insertQuery.bindValue(":start_ts", start_time.toDateTime().toSecsSinceEpoch());
+            insertQuery.bindValue(":station_callsign", stationCallsign);
+            insertQuery.bindValue(":mode_group", dxccGroup.isEmpty() ? QVariant() : QVariant(dxccGroup));
+
+            if ( !insertQuery.exec() )
+            {
+                failImport(tr("Cannot store QSL for matching: ") + insertQuery.lastError().text());
+                return;
+            }
+
+            chunkRecords.append(downloadedRecord);
+            chunkModeGroups.append(dxccGroup);
+        }
+
+        if ( chunkRecords.isEmpty() )
             continue;
+
+        QVector<QList<QSLMatchCandidate>> candidates(chunkRecords.size());
+        QSqlQuery matchQuery;
+
+        if ( !matchQuery.exec(matchStmt) )
+        {
+            failImport(tr("Cannot match QSLs: ") + matchQuery.lastError().text());
+            return;
         }
 
-        const QString startTimeStr = start_time.toDateTime().toTimeZone(QTimeZone::utc()).toString("yyyy-MM-dd hh:mm:ss");
-
-        // Common filter conditions — shared by all match attempts
-        QString baseFilter = QString(
-            "callsign=upper('%1') AND upper(band)=upper('%2') AND "
-            "upper(COALESCE(sat_name, '')) = upper('%3') AND "
-            "ABS(STRFTIME('%s', start_time)-"
-            "STRFTIME('%s', datetime('%4'))) <= %5 "
-        ).arg(call.toString(),
-              band.toString(),
-              satName.toString(),
-              startTimeStr,
-              QString::number(fromService == EQSL ? 3600 : 1800));
-
-        if ( fromService == LOTW )
+        while ( matchQuery.next() )
         {
-            QString escapedStationCallsign = stationCallsign;
-            escapedStationCallsign.replace('\'', QStringLiteral("''"));
-            baseFilter += QString(
-                " AND upper(COALESCE(NULLIF(TRIM(station_callsign), ''), TRIM(operator))) "
-                "= upper('%1')"
-            ).arg(escapedStationCallsign);
+            const QSLMatchCandidate candidate = {matchQuery.value(1).toULongLong(),
+                                                 matchQuery.value(2).toBool(),
+                                                 matchQuery.value(3).toBool(),
+                                                 matchQuery.value(4).toBool()};
+            candidates[matchQuery.value(0).toInt()].append(candidate);
         }
 
-        // First attempt: exact mode match (used for eQSL; also the fast path for LoTW)
-        model.setFilter(baseFilter + QString(" AND upper(mode)=upper('%1')").arg(mode.toString()));
-        model.select();
+        // the match attempts of the original per-record selects
+        QVector<qulonglong> matchedIds(chunkRecords.size(), 0);
+        QStringList matchedIdList;
 
-        // LoTW fallback: LoTW confirms QSOs when both sides specify modes in the same
-        // group (CW / PHONE / DATA).
+        for ( int i = 0; i < chunkRecords.size(); i++ )
+        {
+            const QSqlRecord &record = chunkRecords.at(i);
+            const QList<QSLMatchCandidate> &recordCandidates = candidates.at(i);
+            QList<QSLMatchCandidate> matches;
+
+            // First attempt: exact mode match (used for eQSL; also the fast path for LoTW)
+            for ( const QSLMatchCandidate &candidate : recordCandidates )
+                if ( candidate.exactMode )
+                    matches.append(candidate);
+
+            // Two submitted descriptions of a QSO match if
+
+            // https://lotw.arrl.org/lotw-help/frequently-asked-questions/#datamatch
+            // your QSO description specifies a callsign that matches the Callsign Certificate specified by the Station Location your QSO partner used to digitally sign the QSO
+            // your QSO partner's QSO description specifies a callsign that matches the Callsign Certificate specified by the Station Location you used to digitally sign the QSO
+            // both QSO descriptions specify start times within 30 minutes of each other
+            // both QSO descriptions specify the same band
+            // both QSO descriptions specify the same mode (an exact mode match), or must specify modes belonging to the same Mode Group
+            // for satellite QSOs, both QSO descriptions must specify the same satellite, and a propagation mode of SAT
+            if ( matches.size() != 1 && fromService == LOTW && !chunkModeGroups.at(i).isEmpty() )
+            {
+                qCDebug(runtime) << "LoTW: mode group fallback" << record.value("mode") << "->" << chunkModeGroups.at(i);
+                matches.clear();
 
-        // Two submitted descriptions of a QSO match if
+                for ( const QSLMatchCandidate &candidate : recordCandidates )
+                    if ( candidate.modeGroup )
+                        matches.append(candidate);
+            }
 
-        // https://lotw.arrl.org/lotw-help/frequently-asked-questions/#datamatch
-        // your QSO description specifies a callsign that matches the Callsign Certificate specified by the Station Location your QSO partner used to digitally sign the QSO
-        // your QSO partner's QSO description specifies a callsign that matches the Callsign Certificate specified by the Station Location you used to digitally sign the QSO
-        // both QSO descriptions specify start times within 30 minutes of each other
-        // both QSO descriptions specify the same band
-        // both QSO descriptions specify the same mode (an exact mode match), or must specify modes belonging to the same Mode Group
-        // for satellite QSOs, both QSO descriptions must specify the same satellite, and a propagation mode of SAT
-        if ( model.rowCount() != 1 && fromService == LOTW )
-        {
-            const QString modeStr = mode.toString();
-            QString dxccGroup = LotwBase::lotwGroupNameToDxcc(modeStr);
+            const bool multipleMatches = matches.size() > 1;
 
-            if ( dxccGroup.isEmpty() )
+            // A LoTW report contains the timestamp of the user's submitted QSO.
+            // Use it to disambiguate otherwise valid candidates.
+            if ( multipleMatches && fromService == LOTW )
             {
-                if ( !modeGroupCache.contains(modeStr) )
-                    modeGroupCache.insert(modeStr, BandPlan::modeToDXCCModeGroup(modeStr));
-                dxccGroup = modeGroupCache.value(modeStr);
+                const QList<QSLMatchCandidate> timeCandidates = matches;
+                matches.clear();
+
+                for ( const QSLMatchCandidate &candidate : timeCandidates )
+                    if ( candidate.exactTime )
+                        matches.append(candidate);
             }
 
-            if ( !dxccGroup.isEmpty() )
+            if ( matches.size() != 1 )
             {
-                qCDebug(runtime) << "LoTW: mode group fallback" << mode << "->" << dxccGroup;
-                model.setFilter(baseFilter + QString(
-                    " AND (SELECT dxcc FROM modes WHERE upper(name)=upper(mode) LIMIT 1) = '%1'"
-                ).arg(dxccGroup));
-                model.select();
+                const QString unmatchedReason = multipleMatches
+                        ? tr("Reason: multiple matches")
+                        : tr("Reason: no match");
+
+                stats.unmatchedQSLs.append(
+                            reportFormatter(record.value("start_time").toDateTime(),
+                                            record.value("callsign").toString(),
+                                            record.value("mode").toString(),
+                                            {unmatchedReason},
+                                            fromService == LOTW ? record.value("station_callsign").toString().trimmed()
+                                                                : QString()));
+                continue;
             }
+
+            matchedIds[i] = matches.first().id;
+            matchedIdList << QString::number(matches.first().id);
         }
 
-        const bool multipleMatches = model.rowCount() > 1;
+        // current values of all matched contacts
+        QHash<qulonglong, QSqlRecord> loadedContacts;
 
-        // A LoTW report contains the timestamp of the user's submitted QSO.
-        // Use it to disambiguate otherwise valid candidates.
-        if ( multipleMatches && fromService == LOTW )
+        if ( !matchedIdList.isEmpty() )
         {
-            model.setFilter(model.filter() + QString(
-                " AND STRFTIME('%s', start_time) = "
-                "STRFTIME('%s', datetime('%1'))"
-            ).arg(startTimeStr));
-            model.select();
-        }
+            QSqlQuery contactQuery;
 
-        if ( model.rowCount() != 1 )
-        {
-            const QString unmatchedReason = multipleMatches
-                    ? tr("Reason: multiple matches")
-                    : tr("Reason: no match");
+            // ids are numbers - no need to bind them
+            if ( !contactQuery.exec(QString("SELECT * FROM contacts WHERE id IN (%1)").arg(matchedIdList.join(","))) )
+            {
+                failImport(tr("Cannot load matched QSOs: ") + contactQuery.lastError().text());
+                return;
+            }
 
-            stats.unmatchedQSLs.append(
-                        reportFormatter(start_time.toDateTime(),
-                                        call.toString(),
-                                        mode.toString(),
-                                        {unmatchedReason},
-                                        fromService == LOTW ? stationCallsign : QString()));
-            continue;
+            while ( contactQuery.next() )
+            {
+                const QSqlRecord contact = contactQuery.record();
+                loadedContacts.insert(contact.value("id").toULongLong(), contact);
+            }
         }
 
-        /* we have one row for updating */
-        /* lets update it */
-        QSqlRecord originalRecord = model.record(0);
+        // the updated values; a contact can be matched by more QSLs
+        QHash<qulonglong, QSqlRecord> contacts = loadedContacts;
+        // the update order; the set answers the membership checks
+        QList<qulonglong> updatedContactIds;
+        QSet<qulonglong> updatedContactIdSet;
 
-        switch ( fromService )
+        auto storeContact = [&](qulonglong contactId, const QSqlRecord &record)
         {
-        case LOTW:
-        {
-            /* https://lotw.arrl.org/lotw-help/developer-query-qsos-qsls/?lang=en */
-            // always try to update contact from received QSL
-            if ( QSLRecord.value("qsl_rcvd").toString() == 'Y' ) // qsl_rcvd is OK because LoTW sends lotw_qsl_rcvd value in qsl_rcvd
+            Data::instance()->updateDXCCStatusCacheContact(contacts.value(contactId), record);
+            contacts.insert(contactId, record);
+
+            if ( !updatedContactIdSet.contains(contactId) )
             {
-                QStringList updatedFields;
-                bool callUpdate = false;
-                bool newlyReceived = (QSLRecord.value("qsl_rcvd").toString() != originalRecord.value("lotw_qsl_rcvd").toString());
+                updatedContactIdSet.insert(contactId);
+                updatedContactIds.append(contactId);
+            }
+        };
+
+        for ( int i = 0; i < chunkRecords.size(); i++ )
+        {
+            const qulonglong contactId = matchedIds.at(i);
+
+            if ( contactId == 0 || !contacts.contains(contactId) )
+                continue;
+
+            const QSqlRecord &QSLRecord = chunkRecords.at(i);
+
+            // needed later
+            const QVariant &call = QSLRecord.value("callsign");
+            const QVariant &band = QSLRecord.value("band");
+            const QVariant &mode = QSLRecord.value("mode");
+            const QVariant &start_time = QSLRecord.value("start_time");
+            const QVariant &satName = QSLRecord.value("sat_name");
+            const QString stationCallsign = QSLRecord.value("station_callsign").toString().trimmed();
 
-                qCDebug(runtime) << "Attempt to" << (newlyReceived ? "force " : "") << "update QSO" << call.toString()
-                                 << band.toString() << start_time.toString();
+            /* we have one row for updating */
+            /* lets update it */
+            QSqlRecord originalRecord = contacts.value(contactId);
 
-                auto conditionUpdate = [&](const QString &contactKey,
-                                           const QString &qslKey,
-                                           bool forceUpdate = false)
+            switch ( fromService )
+            {
+            case LOTW:
+            {
+                /* https://lotw.arrl.org/lotw-help/developer-query-qsos-qsls/?lang=en */
+                // always try to update contact from received QSL
+                if ( QSLRecord.value("qsl_rcvd").toString() == 'Y' ) // qsl_rcvd is OK because LoTW sends lotw_qsl_rcvd value in qsl_rcvd
                 {
-                    if ( !QSLRecord.value(qslKey).toString().isEmpty()
-                        && ( forceUpdate || originalRecord.value(contactKey).toString().isEmpty() ) )
+                    QStringList updatedFields;
+                    bool callUpdate = false;
+                    bool newlyReceived = (QSLRecord.value("qsl_rcvd").toString() != originalRecord.value("lotw_qsl_rcvd").toString());
+
+                    qCDebug(runtime) << "Attempt to" << (newlyReceived ? "force " : "") << "update QSO" << call.toString()
+                                     << band.toString() << start_time.toString();
+
+                    auto conditionUpdate = [&](const QString &contactKey,
+                                               const QString &qslKey,
+                                               bool forceUpdate = false)
                     {
-                        qCDebug(runtime) << "Updating:" << contactKey
-                                         << "to" << QSLRecord.value(qslKey).toString()
-                                         << (forceUpdate ? "force update" : "");
-                        updatedFields.append(contactKey + "(" + QSLRecord.value(qslKey).toString()  +")");
-                        originalRecord.setValue(contactKey, QSLRecord.value(qslKey));
-                        return true;
-                    }
-                    return false;
-                };
+                        if ( !QSLRecord.value(qslKey).toString().isEmpty()
+                            && ( forceUpdate || originalRecord.value(contactKey).toString().isEmpty() ) )
+                        {
+                            qCDebug(runtime) << "Updating:" << contactKey
+                                             << "to" << QSLRecord.value(qslKey).toString()
+                                             << (forceUpdate ? "force update" : "");
+                            updatedFields.append(contactKey + "(" + QSLRecord.value(qslKey).toString()  +")");
+                            originalRecord.setValue(contactKey, QSLRecord.value(qslKey));
+                            return true;
+                        }
+                        return false;
+                    };
 
-                auto conditionUpdateSpecial = [&](const QString &contactKey,
-                                                  const QString &qslKey,
-                                                  bool forceUpdate = false)
-                {
-                    QString contactValue = originalRecord.value(contactKey).toString();
-                    QString QSLValue = QSLRecord.value(qslKey).toString();
-                    contactValue.remove(reLeadingZero);
-                    QSLValue.remove(reLeadingZero);
+                    auto conditionUpdateSpecial = [&](const QString &contactKey,
+                                                      const QString &qslKey,
+                                                      bool forceUpdate = false)
+                    {
+                        QString contactValue = originalRecord.value(contactKey).toString();
+                        QString QSLValue = QSLRecord.value(qslKey).toString();
+                        contactValue.remove(reLeadingZero);
+                        QSLValue.remove(reLeadingZero);
+
+                        if ( !QSLValue.isEmpty()
+                            && ( forceUpdate || contactValue != QSLValue ) )
+                        {
+                            qCDebug(runtime) << "Updating:" << contactKey
+                                             << "from" << originalRecord.value(contactKey).toString()
+                                             << "to" << QSLValue
+                                             << (forceUpdate ? "force update" : "");
+                            updatedFields.append(contactKey + "(" + QSLRecord.value(qslKey).toString()  +")");
+                            originalRecord.setValue(contactKey, QSLValue);
+                            return true;
+                        }
+                        return false;
+                    };
 
-                    if ( !QSLValue.isEmpty()
-                        && ( forceUpdate || contactValue != QSLValue ) )
+                    auto conditionUpdateChanged = [&](const QString &contactKey,
+                                                      const QVariant &qslValue)
                     {
+                        if ( qslValue.toString().isEmpty()
+                             || originalRecord.value(contactKey).toString().compare(
+                                    qslValue.toString(), Qt::CaseInsensitive) == 0 )
+                            return false;
+
                         qCDebug(runtime) << "Updating:" << contactKey
                                          << "from" << originalRecord.value(contactKey).toString()
-                                         << "to" << QSLValue
-                                         << (forceUpdate ? "force update" : "");
-                        updatedFields.append(contactKey + "(" + QSLRecord.value(qslKey).toString()  +")");
-                        originalRecord.setValue(contactKey, QSLValue);
+                                         << "to" << qslValue.toString();
+                        updatedFields.append(contactKey + "(" + qslValue.toString() + ")");
+                        originalRecord.setValue(contactKey, qslValue);
                         return true;
-                    }
-                    return false;
-                };
+                    };
 
-                auto conditionUpdateChanged = [&](const QString &contactKey,
-                                                  const QVariant &qslValue)
-                {
-                    if ( qslValue.toString().isEmpty()
-                         || originalRecord.value(contactKey).toString().compare(
-                                qslValue.toString(), Qt::CaseInsensitive) == 0 )
-                        return false;
+                    auto mergeCreditUpdate = [&](const QString &contactKey,
+                                                 const QString &qslKey)
+                    {
+                        const QString qslCredits = QSLRecord.value(qslKey).toString();
+                        if ( qslCredits.isEmpty() )
+                            return false;
+
+                        const QString currentCredits = originalRecord.value(contactKey).toString();
+                        const QString mergedCredits = mergeCreditValues(currentCredits, qslCredits);
+                        const QString normalizedCurrentCredits = splitCreditValues(currentCredits).join(',');
+
+                        if ( mergedCredits == normalizedCurrentCredits )
+                            return false;
+
+                        qCDebug(runtime) << "Merging:" << contactKey
+                                         << "from" << currentCredits
+                                         << "with" << qslCredits
+                                         << "to" << mergedCredits;
+                        updatedFields.append(contactKey + "(" + mergedCredits + ")");
+                        originalRecord.setValue(contactKey, mergedCredits);
+                        return true;
+                    };
+
+                    callUpdate |= conditionUpdate("lotw_qsl_rcvd", "qsl_rcvd", newlyReceived);
+                    callUpdate |= conditionUpdate("lotw_qslrdate", "qsl_rdate", newlyReceived);
+                    callUpdate |= conditionUpdateChanged("dxcc", QSLRecord.value("dxcc"));
+
+                    const QString lotwCountry = QSLRecord.value("country").toString();
+                    callUpdate |= conditionUpdateChanged("country", Data::removeAccents(lotwCountry));
+                    callUpdate |= conditionUpdateChanged("country_intl", lotwCountry);
+                    callUpdate |= conditionUpdateChanged("cont", QSLRecord.value("cont"));
+
+                    callUpdate |= mergeCreditUpdate("credit_granted", "credit_granted");
+                    callUpdate |= mergeCreditUpdate("credit_submitted", "credit_submitted");
+                    callUpdate |= conditionUpdate("pfx", "pfx", newlyReceived);
+                    callUpdate |= conditionUpdate("iota", "iota", newlyReceived);
+                    callUpdate |= conditionUpdate("vucc_grids", "vucc_grids", newlyReceived);
+                    callUpdate |= conditionUpdate("state", "state", newlyReceived);
+                    callUpdate |= conditionUpdate("cnty", "cnty", newlyReceived);
+                    callUpdate |= conditionUpdateSpecial("ituz", "ituz", newlyReceived);
+                    callUpdate |= conditionUpdateSpecial("cqz", "cqz", newlyReceived);
+
+                    const QString origGrig = originalRecord.value("gridsquare").toString();
+                    const Gridsquare dxNewGrid(QSLRecord.value("gridsquare").toString());
+
+                    if ( ( newlyReceived
+                           ||  origGrig.isEmpty()
+                           || ( origGrig.length() < QSLRecord.value("gridsquare").toString().length()
+                                && dxNewGrid.isValid()
+                                && dxNewGrid.getGrid().contains(origGrig) ) )
+                        && !dxNewGrid.getGrid().isEmpty() )
+                    {
+                        const Gridsquare myGrid(originalRecord.value("my_gridsquare").toString());
 
-                    qCDebug(runtime) << "Updating:" << contactKey
-                                     << "from" << originalRecord.value(contactKey).toString()
-                                     << "to" << qslValue.toString();
-                    updatedFields.append(contactKey + "(" + qslValue.toString() + ")");
-                    originalRecord.setValue(contactKey, qslValue);
-                    return true;
-                };
+                        originalRecord.setValue("gridsquare", dxNewGrid.getGrid());
 
-                auto mergeCreditUpdate = [&](const QString &contactKey,
-                                             const QString &qslKey)
-                {
-                    const QString qslCredits = QSLRecord.value(qslKey).toString();
-                    if ( qslCredits.isEmpty() )
-                        return false;
+                        double distance;
 
-                    const QString currentCredits = originalRecord.value(contactKey).toString();
-                    const QString mergedCredits = mergeCreditValues(currentCredits, qslCredits);
-                    const QString normalizedCurrentCredits = splitCreditValues(currentCredits).join(',');
+                        if ( myGrid.distanceTo(dxNewGrid, distance) )
+                        {
+                            originalRecord.setValue("distance", QVariant(distance));
+                        }
+                        qCDebug(runtime) << "Updating: grid from " << origGrig << "to" << dxNewGrid.getGrid();
+                        updatedFields.append("gridsquare (" + dxNewGrid.getGrid()  +")");
+                        callUpdate |= true;
+                    }
 
-                    if ( mergedCredits == normalizedCurrentCredits )
-                        return false;
+                    if ( callUpdate )
+                    {
+                        qCDebug(runtime) << "Calling update for" << call << band << mode << start_time << satName;
+                        storeContact(contactId, originalRecord);
+                        if ( newlyReceived )
+                        {
+                            const DxccStatus status = Data::instance()->dxccStatus(originalRecord.value("dxcc").toInt(), band.toString(), mode.toString());
+                            stats.newQSLs.append(
+                                        reportFormatter(start_time.toDateTime(),
+                                                        call.toString(),
+                                                        mode.toString(),
+                                                        {tr("DXCC State:") + " " + Data::statusToText(status)},
+                                                        stationCallsign));
+                        }
+                        else
+                            stats.updatedQSOs.append(
+                                        reportFormatter(start_time.toDateTime(),
+                                                        call.toString(),
+                                                        mode.toString(),
+                                                        updatedFields,
+                                                        stationCallsign));
+                    }
+                }
+                break;
+            }
 
-                    qCDebug(runtime) << "Merging:" << contactKey
-                                     << "from" << currentCredits
-                                     << "with" << qslCredits
-                                     << "to" << mergedCredits;
-                    updatedFields.append(contactKey + "(" + mergedCredits + ")");
-                    originalRecord.setValue(contactKey, mergedCredits);
-                    return true;
-                };
-
-                callUpdate |= conditionUpdate("lotw_qsl_rcvd", "qsl_rcvd", newlyReceived);
-                callUpdate |= conditionUpdate("lotw_qslrdate", "qsl_rdate", newlyReceived);
-                callUpdate |= conditionUpdateChanged("dxcc", QSLRecord.value("dxcc"));
-
-                const QString lotwCountry = QSLRecord.value("country").toString();
-                callUpdate |= conditionUpdateChanged("country", Data::removeAccents(lotwCountry));
-                callUpdate |= conditionUpdateChanged("country_intl", lotwCountry);
-                callUpdate |= conditionUpdateChanged("cont", QSLRecord.value("cont"));
-
-                callUpdate |= mergeCreditUpdate("credit_granted", "credit_granted");
-                callUpdate |= mergeCreditUpdate("credit_submitted", "credit_submitted");
-                callUpdate |= conditionUpdate("pfx", "pfx", newlyReceived);
-                callUpdate |= conditionUpdate("iota", "iota", newlyReceived);
-                callUpdate |= conditionUpdate("vucc_grids", "vucc_grids", newlyReceived);
-                callUpdate |= conditionUpdate("state", "state", newlyReceived);
-                callUpdate |= conditionUpdate("cnty", "cnty", newlyReceived);
-                callUpdate |= conditionUpdateSpecial("ituz", "ituz", newlyReceived);
-                callUpdate |= conditionUpdateSpecial("cqz", "cqz", newlyReceived);
-
-                const QString origGrig = originalRecord.value("gridsquare").toString();
-                const Gridsquare dxNewGrid(QSLRecord.value("gridsquare").toString());
-
-                if ( ( newlyReceived
-                       ||  origGrig.isEmpty()
-                       || ( origGrig.length() < QSLRecord.value("gridsquare").toString().length()
-                            && dxNewGrid.isValid()
-                            && dxNewGrid.getGrid().contains(origGrig) ) )
-                    && !dxNewGrid.getGrid().isEmpty() )
+            case EQSL:
+            {
+                /* http://www.eqsl.cc/qslcard/DownloadInBox.txt */
+                /*   CALL
+                     QSO_DATE
+                     TIME_ON
+                     BAND
+                     MODE
+                     SUBMODE (tag only present if non-blank)
+                     PROP_MODE (tag only present if non-blank)
+                     RST_SENT (will be the sender's RST Sent, not yours)
+                     RST_RCVD (we do not capture this in uploads, so will normally be 0 length)
+                     QSL_SENT (always Y)
+                     QSL_SENT_VIA (always E)
+                     QSLMSG (if non-null and containing only valid printable ASCII characters)
+                     QSLMSG_INTL (if non-null and containing international characters - see ADIF V3 specs)
+                     APP_EQSL_SWL (tag only present if sender is SWL and then always Y)
+                     APP_EQSL_AG (tag only present if sender has Authenticity Guaranteed status and then always Y)
+                     EQSL_AG (current Authenticity Guaranteed status)
+                     GRIDSQUARE (tag only present if non-blank and at least 4 long)
+                */
+                // Unlike LoTW, eQSL data does not refresh other contact fields after
+                // the confirmation is received. EQSL_AG is updated whenever provided.
+                const bool newlyReceived = originalRecord.value("eqsl_qsl_rcvd").toString() != 'Y';
+                const QString eqslAg = QSLRecord.value("eqsl_ag").toString();
+                const bool eqslAgChanged = !eqslAg.isEmpty()
+                        && originalRecord.value("eqsl_ag").toString() != eqslAg;
+
+                if ( eqslAgChanged )
+                    originalRecord.setValue("eqsl_ag", eqslAg);
+
+                if ( newlyReceived )
                 {
-                    const Gridsquare myGrid(originalRecord.value("my_gridsquare").toString());
+                    originalRecord.setValue("eqsl_qsl_rcvd", QSLRecord.value("qsl_sent"));
 
-                    originalRecord.setValue("gridsquare", dxNewGrid.getGrid());
+                    originalRecord.setValue("eqsl_qslrdate", QDateTime::currentDateTimeUtc().date().toString("yyyy-MM-dd"));
 
-                    double distance;
+                    Gridsquare dxNewGrid(QSLRecord.value("gridsquare").toString());
 
-                    if ( myGrid.distanceTo(dxNewGrid, distance) )
+                    if ( dxNewGrid.isValid()
+                         && ( originalRecord.value("gridsquare").toString().isEmpty()
+                              ||
+                              dxNewGrid.getGrid().contains(originalRecord.value("gridsquare").toString()))
+                         )
                     {
-                        originalRecord.setValue("distance", QVariant(distance));
+                        Gridsquare myGrid(originalRecord.value("my_gridsquare").toString());
+
+                        originalRecord.setValue("gridsquare", dxNewGrid.getGrid());
+
+                        double distance;
+
+                        if ( myGrid.distanceTo(dxNewGrid, distance) )
+                        {
+                            originalRecord.setValue("distance", QVariant(distance));
+                        }
                     }
-                    qCDebug(runtime) << "Updating: grid from " << origGrig << "to" << dxNewGrid.getGrid();
-                    updatedFields.append("gridsquare (" + dxNewGrid.getGrid()  +")");
-                    callUpdate |= true;
+
+                    const QString &prevValue = originalRecord.value("qslmsg_rcvd").toString();
+                    const QString &newValue = QSLRecord.value("qslmsg").toString();
+
+                    if ( !newValue.isEmpty() )
+                        originalRecord.setValue("qslmsg_rcvd", prevValue.isEmpty() ? "eQSL: " + newValue : prevValue + "| eQSL: " + newValue);
+
+                    // temporary removed - ADIF 3.1.5 has no INTL equivalent for qslmsg_rcvd
+                    //originalRecord.setValue("qslmsg_int", QSLRecord.value("qslmsg_int"));
+
+                    // QSL_RCVD_VIA belongs to the paper QSL_RCVD status. eQSL
+                    // confirmations are tracked separately in EQSL_QSL_RCVD.
                 }
 
-                if ( callUpdate )
-                {
-                    qCDebug(runtime) << "Calling update for" << call << band << mode << start_time << satName;
-                    if ( !model.setRecord(0, originalRecord) )
-                    {
-                        qCDebug(runtime) << originalRecord;
-                        failImport(tr("Cannot update QSO in logbook: ")
-                                   + model.lastError().text());
-                        return;
-                    }
+                if ( !newlyReceived && !eqslAgChanged )
+                    break;
 
-                    if ( !model.submitAll() )
-                    {
-                        failImport(tr("Cannot update QSO in logbook: ")
-                                   + model.lastError().text());
-                        return;
-                    }
-                    if ( newlyReceived )
-                    {
-                        const DxccStatus status = Data::instance()->dxccStatus(originalRecord.value("dxcc").toInt(), band.toString(), mode.toString());
-                        stats.newQSLs.append(
-                                    reportFormatter(start_time.toDateTime(),
-                                                    call.toString(),
-                                                    mode.toString(),
-                                                    {tr("DXCC State:") + " " + Data::statusToText(status)},
-                                                    stationCallsign));
-                    }
-                    else
-                        stats.updatedQSOs.append(
-                                    reportFormatter(start_time.toDateTime(),
-                                                    call.toString(),
-                                                    mode.toString(),
-                                                    updatedFields,
-                                                    stationCallsign));
+                storeContact(contactId, originalRecord);
+
+                if ( newlyReceived )
+                {
+                    const DxccStatus status = Data::instance()->dxccStatus(originalRecord.value("dxcc").toInt(), band.toString(), mode.toString());
+                    stats.newQSLs.append(reportFormatter(start_time.toDateTime(), call.toString(), mode.toString(), {tr("DXCC State:") + " " + Data::statusToText(status)}));
+                }
+                else
+                {
+                    stats.updatedQSOs.append(
+                                reportFormatter(start_time.toDateTime(),
+                                                call.toString(),
+                                                mode.toString(),
+                                                {QStringLiteral("EQSL_AG: ") + eqslAg}));
                 }
+
+                break;
             }
-            break;
-        }
 
-        case EQSL:
-        {
-            /* http://www.eqsl.cc/qslcard/DownloadInBox.txt */
-            /*   CALL
-                 QSO_DATE
-                 TIME_ON
-                 BAND
-                 MODE
-                 SUBMODE (tag only present if non-blank)
-                 PROP_MODE (tag only present if non-blank)
-                 RST_SENT (will be the sender's RST Sent, not yours)
-                 RST_RCVD (we do not capture this in uploads, so will normally be 0 length)
-                 QSL_SENT (always Y)
-                 QSL_SENT_VIA (always E)
-                 QSLMSG (if non-null and containing only valid printable ASCII characters)
-                 QSLMSG_INTL (if non-null and containing international characters - see ADIF V3 specs)
-                 APP_EQSL_SWL (tag only present if sender is SWL and then always Y)
-                 APP_EQSL_AG (tag only present if sender has Authenticity Guaranteed status and then always Y)
-                 EQSL_AG (current Authenticity Guaranteed status)
-                 GRIDSQUARE (tag only present if non-blank and at least 4 long)
-            */
-            // Unlike LoTW, eQSL data does not refresh other contact fields after
-            // the confirmation is received. EQSL_AG is updated whenever provided.
-            const bool newlyReceived = originalRecord.value("eqsl_qsl_rcvd").toString() != 'Y';
-            const QString eqslAg = QSLRecord.value("eqsl_ag").toString();
-            const bool eqslAgChanged = !eqslAg.isEmpty()
-                    && originalRecord.value("eqsl_ag").toString() != eqslAg;
-
-            if ( eqslAgChanged )
-                originalRecord.setValue("eqsl_ag", eqslAg);
-
-            if ( newlyReceived )
-            {
-                originalRecord.setValue("eqsl_qsl_rcvd", QSLRecord.value("qsl_sent"));
+            default:
+                qCDebug(runtime) << "Unknown QSL import";
+            }
+        }
 
-                originalRecord.setValue("eqsl_qslrdate", QDateTime::currentDateTimeUtc().date().toString("yyyy-MM-dd"));
+        // only the changed columns are written; contacts with the same changed
+        // columns share one statement
+        QMap<QString, ContactUpdate> updates;
 
-                Gridsquare dxNewGrid(QSLRecord.value("gridsquare").toString());
+        for ( qulonglong contactId : static_cast<const QList<qulonglong>&>(updatedContactIds) )
+        {
+            const QSqlRecord &loaded = loadedContacts[contactId];
+            const QSqlRecord &updated = contacts[contactId];
+            QStringList columns;
+            QVariantList values;
 
-                if ( dxNewGrid.isValid()
-                     && ( originalRecord.value("gridsquare").toString().isEmpty()
-                          ||
-                          dxNewGrid.getGrid().contains(originalRecord.value("gridsquare").toString()))
-                     )
+            for ( int i = 0; i < updated.count(); i++ )
+            {
+                if ( updated.value(i) != loaded.value(i) )
                 {
-                    Gridsquare myGrid(originalRecord.value("my_gridsquare").toString());
+                    columns << updated.fieldName(i);
+                    values << updated.value(i);
+                }
+            }
 
-                    originalRecord.setValue("gridsquare", dxNewGrid.getGrid());
+            if ( columns.isEmpty() )
+                continue;
 
-                    double distance;
+            ContactUpdate &update = updates[columns.join(",")];
 
-                    if ( myGrid.distanceTo(dxNewGrid, distance) )
-                    {
-                        originalRecord.setValue("distance", QVariant(distance));
-                    }
-                }
+            if ( update.columns.isEmpty() )
+            {
+                update.columns = columns;
+                update.values.resize(columns.size());
+            }
 
-                const QString &prevValue = originalRecord.value("qslmsg_rcvd").toString();
-                const QString &newValue = QSLRecord.value("qslmsg").toString();
+            for ( int i = 0; i < values.size(); i++ )
+                update.values[i] << values.at(i);
 
-                if ( !newValue.isEmpty() )
-                    originalRecord.setValue("qslmsg_rcvd", prevValue.isEmpty() ? "eQSL: " + newValue : prevValue + "| eQSL: " + newValue);
+            update.ids << contactId;
+        }
 
-                // temporary removed - ADIF 3.1.5 has no INTL equivalent for qslmsg_rcvd
-                //originalRecord.setValue("qslmsg_int", QSLRecord.value("qslmsg_int"));
+        for ( const ContactUpdate &update : static_cast<const QMap<QString, ContactUpdate>&>(updates) )
+        {
+            QStringList assignments;
 
-                // QSL_RCVD_VIA belongs to the paper QSL_RCVD status. eQSL
-                // confirmations are tracked separately in EQSL_QSL_RCVD.
-            }
+            for ( const QString &column : update.columns )
+                assignments << QString("\"%1\" = ?").arg(column);
 
-            if ( !newlyReceived && !eqslAgChanged )
-                break;
+            QSqlQuery updateQuery;
 
-            if ( !model.setRecord(0, originalRecord) )
+            if ( !updateQuery.prepare(QString("UPDATE contacts SET %1 WHERE id = ?").arg(assignments.join(", "))) )
             {
-                qCDebug(runtime) << originalRecord;
                 failImport(tr("Cannot update QSO in logbook: ")
-                           + model.lastError().text());
+                           + updateQuery.lastError().text());
                 return;
             }
 
-            if ( !model.submitAll() )
+            for ( const QVariantList &columnValues : update.values )
+                updateQuery.addBindValue(columnValues);
+
+            updateQuery.addBindValue(update.ids);
+
+            if ( !updateQuery.execBatch() )
             {
                 failImport(tr("Cannot update QSO in logbook: ")
-                           + model.lastError().text());
+                           + updateQuery.lastError().text());
                 return;
             }
-
-            if ( newlyReceived )
-            {
-                const DxccStatus status = Data::instance()->dxccStatus(originalRecord.value("dxcc").toInt(), band.toString(), mode.toString());
-                stats.newQSLs.append(reportFormatter(start_time.toDateTime(), call.toString(), mode.toString(), {tr("DXCC State:") + " " + Data::statusToText(status)}));
-            }
-            else
-            {
-                stats.updatedQSOs.append(
-                            reportFormatter(start_time.toDateTime(),
-                                            call.toString(),
-                                            mode.toString(),
-                                            {QStringLiteral("EQSL_AG: ") + eqslAg}));
-            }
-
-            break;
-        }
-
-        default:
-            qCDebug(runtime) << "Unknown QSL import";
         }
     }
 
-    emit importPosition(stream.pos());
+    emit importPosition(importStreamPosition());
+
+    if ( !tableQuery.exec("DROP TABLE IF EXISTS temp.qsl_import_records") )
+        qWarning() << "Cannot drop QSL import table" << tableQuery.lastError();
 
     if ( !database.commit() )
     {
@@ -1653,6 +2173,16 @@ long LogFormat::runExport()
 
     this->exportStart();
 
+    const long parallelCount = runParallelExport();
+
+    if ( parallelCount >= 0 )
+    {
+        emit exportProgress(100);
+
+        this->exportEnd();
+        return parallelCount;
+    }
+
     QSqlQuery query;
 
     QString queryStmt = QString("SELECT %1 FROM contacts WHERE %2 ORDER BY start_time ASC").arg(exportedFields.join(", "), getWhereClause());
@@ -1698,6 +2228,174 @@ long LogFormat::runExport()
     return count;
 }
 
+// Export engine for the formats providing createExportWorker.
+// The filtered ids are split into chunks, worker threads format the chunks
+// over the read-only connections of the LogDatabase pool (the log runs in WAL mode, so the readers
+// do not block each other) and the calling thread writes the formatted chunks
+// to the stream in the original order.
+// Returns -1 when the export has to run serially; nothing is written in that case.
+long LogFormat::runParallelExport()
+{
+    FCT_IDENTIFICATION;
+
+    const int workerCount = QThread::idealThreadCount() - 1;
+    // the pool connections open the log file - any other main database is exported serially
+    if ( workerCount < 1 || QSqlDatabase::database().databaseName() != LogDatabase::dbFilename() )
+        return -1;
+
+    {
+        QString probeOutput;
+        QTextStream probeStream(&probeOutput);
+        QScopedPointer<LogFormat> probeFormat(createExportWorker(probeStream));
+
+        if ( !probeFormat )
+            return -1;
+    }
+
+    QSqlQuery idQuery;
+
+    const QString idStmt = QString("SELECT id FROM contacts WHERE %1 ORDER BY start_time ASC, id ASC").arg(getWhereClause());
+
+    qCDebug(runtime) << idStmt;
+
+    if ( ! idQuery.prepare(idStmt) )
+    {
+        qWarning() << "Cannot prepare id select statement" << idQuery.lastError();
+        return -1;
+    }
+
+    bindWhereClause(idQuery);
+
+    if ( ! idQuery.exec() )
+    {
+        qWarning() << "Cannot execute id select statement" << idQuery.lastError();
+        return -1;
+    }
+
+    QList<qulonglong> ids;
+
+    while ( idQuery.next() )
+        ids << idQuery.value(0).toULongLong();
+
+    idQuery.finish();
+
+    // not worth starting the threads
+    if ( ids.size() <= EXPORT_CHUNK_SIZE )
+        return -1;
+
+    qCDebug(runtime) << "Parallel export of" << ids.size() << "records;" << workerCount << "workers";
+
+    OrderedWorkQueue<ExportChunk> queue(( workerCount + 1 ) * 2);
+
+    QThread *feederThread = QThread::create([&queue, &ids]()
+    {
+        for ( int i = 0; i < ids.size(); i += EXPORT_CHUNK_SIZE )
+        {
+            ExportChunk chunk;
+            chunk.ids = ids.mid(i, EXPORT_CHUNK_SIZE);
+            queue.pushInput(chunk);
+        }
+        queue.finishInput();
+    });
+
+    QList<QThread *> workerThreads;
+
+    for ( int i = 0; i < workerCount; i++ )
+    {
+        workerThreads << QThread::create([this, &queue]()
+        {
+            // the connection of the thread is removed by the pool when the thread exits
+            QSqlDatabase db = LogDatabase::instance()->readOnlyConnection();
+            const bool opened = db.isOpen();
+
+            QString output;
+            QTextStream outputStream(&output);
+            QScopedPointer<LogFormat> format(createExportWorker(outputStream));
+
+            quint64 seq;
+            ExportChunk chunk;
+
+            while ( queue.takeInput(seq, chunk) )
+            {
+                chunk.failed = !opened || !exportChunk(db, *format, chunk);
+                outputStream.flush();
+
+                // a failed chunk is formatted again by the writer
+                if ( !chunk.failed )
+                    chunk.output = output;
+
+                output.clear();
+                queue.pushResult(seq, chunk);
+            }
+        });
+    }
+
+    feederThread->start();
+
+    for ( QThread *thread : static_cast<const QList<QThread *>&>(workerThreads) )
+        thread->start();
+
+    long count = 0L;
+    ExportChunk chunk;
+
+    while ( queue.takeResult(chunk) )
+    {
+        if ( chunk.failed )
+        {
+            qWarning() << "Export chunk failed in the worker - formatting it serially";
+            exportChunk(QSqlDatabase::database(), *this, chunk);
+        }
+        else
+            stream << chunk.output;
+
+        count += chunk.count;
+        emit exportProgress((int)(count * 100 / ids.size()));
+    }
+
+    feederThread->wait();
+    delete feederThread;
+
+    for ( QThread *thread : static_cast<const QList<QThread *>&>(workerThreads) )
+    {
+        thread->wait();
+        delete thread;
+    }
+
+    return count;
+}
+
+bool LogFormat::exportChunk(const QSqlDatabase &db,
+                            LogFormat &format,
+                            ExportChunk &chunk) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    QStringList idList;
+
+    for ( qulonglong id : static_cast<const QList<qulonglong>&>(chunk.ids) )
+        idList << QString::number(id);
+
+    QSqlQuery query(db);
+
+    // ids are numbers - no need to bind them
+    if ( ! query.exec(QString("SELECT %1 FROM contacts WHERE id IN (%2) ORDER BY start_time ASC, id ASC")
+                      .arg(exportedFields.join(", "), idList.join(","))) )
+    {
+        qWarning() << "Cannot execute export chunk statement" << query.lastError();
+        return false;
+    }
+
+    chunk.count = 0;
+
+    while ( query.next() )
+    {
+        format.exportContact(query.record());
+        chunk.count++;
+    }
+
+    return true;
+}
+
 long LogFormat::runExport(const QList<QSqlRecord> &selectedQSOs)
 {
     FCT_IDENTIFICATION;
@@ -1783,12 +2481,23 @@ void LogFormat::writeImportLog(QTextStream& errorLogStream,
 {
     FCT_IDENTIFICATION;
 
+    writeImportLog(errorLogStream, severity, error, warning, recordNo, importLogRecordInfo(record), msg);
+}
+
+void LogFormat::writeImportLog(QTextStream& errorLogStream,
+                               ImportLogSeverity severity,
+                               unsigned long *error,
+                               unsigned long *warning,
+                               const unsigned long recordNo,
+                               const QString &recordInfo,
+                               const QString &msg)
+{
+    FCT_IDENTIFICATION;
+
     errorLogStream << QString("[QSO#%1]: ").arg(recordNo)
                    << importLogSeverityToString(severity)
                    << msg
-                   << QString(" (%1; %2; %3)").arg(record.value("start_time").toDateTime().toTimeZone(QTimeZone::utc()).toString(locale.formatDateShortWithYYYY()),
-                                                   record.value("callsign").toString(),
-                                                   record.value("mode").toString())
+                   << recordInfo
                    << "\n";
     switch (severity)
     {
@@ -1797,3 +2506,12 @@ void LogFormat::writeImportLog(QTextStream& errorLogStream,
     case INFO_SEVERITY: break;
     }
 }
+
+QString LogFormat::importLogRecordInfo(const QSqlRecord &record)
+{
+    FCT_IDENTIFICATION;
+
+    return QString(" (%1; %2; %3)").arg(record.value("start_time").toDateTime().toTimeZone(QTimeZone::utc()).toString(locale.formatDateShortWithYYYY()),
+                                        record.value("callsign").toString(),
+                                        record.value("mode").toString());
+}
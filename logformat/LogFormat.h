@@ -7,8 +7,10 @@
 
 #include "core/LogLocale.h"
 #include "data/StationProfile.h"
+#include "data/DxccSnapshot.h"
+#include "core/OrderedWorkQueue.h"
 
-class QSqlRecord;
+#include <QSqlRecord>
 
 struct QSLMergeStat {
     QStringList newQSLs;
@@ -57,6 +59,50 @@ public:
                             unsigned long *warnings,
                             unsigned long *errors);
     void runQSLImport(QSLFrom fromService);
+
+    // Statements of runQSLImport. They are defined in the header so that
+    // tests/QueryPlanTest checks the query plan of the real statement.
+    static QString qslImportTableStatement()
+    {
+        return QLatin1String("CREATE TEMP TABLE qsl_import_records ("
+                             " seq INTEGER PRIMARY KEY,"
+                             " callsign TEXT,"
+                             " band TEXT,"
+                             " sat_name TEXT,"
+                             " mode TEXT,"
+                             " start_ts INTEGER,"
+                             " station_callsign TEXT,"
+                             " mode_group TEXT)");
+    }
+
+    // The candidates matching the exact mode or (LoTW) the mode group are selected at once;
+    // the match attempts of runQSLImport only filter them.
+    static QString qslImportMatchStatement(QSLFrom fromService)
+    {
+        QString matchStmt = QString(
+            "SELECT q.seq, c.id, "
+            "       upper(c.mode) = q.mode, "
+            "       (SELECT dxcc FROM modes WHERE upper(name) = upper(c.mode) LIMIT 1) = q.mode_group, "
+            "       CAST(STRFTIME('%s', c.start_time) AS INTEGER) = q.start_ts "
+            "FROM temp.qsl_import_records q "
+            "     INNER JOIN contacts c ON c.callsign = q.callsign "
+            "WHERE upper(c.band) = q.band "
+            "      AND upper(COALESCE(c.sat_name, '')) = q.sat_name "
+            "      AND ABS(STRFTIME('%s', c.start_time) - q.start_ts) <= %1 "
+            "      AND ( upper(c.mode) = q.mode "
+            "            OR (SELECT dxcc FROM modes WHERE upper(name) = upper(c.mode) LIMIT 1) = q.mode_group ) "
+        ).arg(fromService == EQSL ? 3600 : 1800);
+
+        if ( fromService == LOTW )
+        {
+            matchStmt += " AND upper(COALESCE(NULLIF(TRIM(c.station_callsign), ''), TRIM(c.operator))) "
+                         "= q.station_callsign ";
+        }
+
+        matchStmt += "ORDER BY q.seq, c.id";
+        return matchStmt;
+    }
+
     void runDXCCCreditImport();
     long runExport();
     long runExport(const QList<QSqlRecord>&);
@@ -109,19 +155,14 @@ protected:
     void addImportWarning(const QString &message) { importWarnings.append(message); }
     void clearImportWarnings() { importWarnings.clear(); }
     virtual bool importNextDXCCCredit(DXCCCreditRecord&) { return false; }
+    // byte position in the imported data - formats that do not read through the stream override it;
+    // the position in the compressed file for a compressed input
+    virtual qint64 importStreamPosition();
+    // a format writing the records independently of each other returns a new instance
+    // writing to workerStream - the export then formats the records in parallel
+    virtual LogFormat *createExportWorker(QTextStream &) const { return nullptr; }
 
 private:
-    struct DXCCCreditMatch
-    {
-        qulonglong id = 0;
-        QString callsign;
-        QString band;
-        QString mode;
-        QDateTime startTime;
-        QString propMode;
-        QString creditGranted;
-    };
-
     enum ImportLogSeverity
     {
         INFO_SEVERITY,
@@ -129,11 +170,48 @@ private:
         ERROR_SEVERITY
     };
 
-    enum DXCCCreditCallMatch
+    struct ImportLogEntry
+    {
+        ImportLogSeverity severity;
+        QString message;
+    };
+
+    // one record travelling through the import pipeline
+    struct ImportRecord
+    {
+        unsigned long recordNo = 0;
+        QSqlRecord record;
+        QStringList parseWarnings;
+        // written before the duplicate check; a rejected record is not checked for duplicates
+        QList<ImportLogEntry> checkLog;
+        bool rejectedByCheck = false;
+        // written after the duplicate check
+        QList<ImportLogEntry> enrichLog;
+        bool rejectedByEnrich = false;
+    };
+
+    struct ImportBatch
+    {
+        QList<ImportRecord> records;
+        qint64 streamPosition = 0;
+    };
+
+    // a log line of a record that waits for the chunked contacts insert
+    struct ImportLogLine
+    {
+        unsigned long recordNo = 0;
+        QSqlRecord record;
+        ImportLogEntry entry;
+    };
+
+    // an accepted record waiting for the chunked contacts insert
+    struct ImportPendingInsert
     {
-        NO_CALL_MATCH,
-        EXACT_CALL_MATCH,
-        PREFIX_CALL_MATCH
+        unsigned long recordNo = 0;
+        QSqlRecord record;
+        // the log lines written after this record and before the next pending record;
+        // they follow its insert result to keep the import log in the record order
+        QList<ImportLogLine> followingLog;
     };
 
     bool isDateRange();
@@ -146,14 +224,40 @@ private:
                                      const QString &newValue);
     static bool isSatelliteDXCCCredit(const DXCCCreditRecord &credit);
     static bool isDXCCEntityCode(const QString &call);
-    static QString escapeSqlLikePattern(const QString &value);
     static QString formatDXCCCreditReport(const DXCCCreditRecord &credit,
                                           const QStringList &addInfo = QStringList());
-    static bool selectDXCCCreditMatches(const DXCCCreditRecord &credit,
-                                        const DXCCCreditCallMatch callMatch,
-                                        const bool matchMode,
-                                        QList<DXCCCreditMatch> &matches,
-                                        QString &error);
+
+    struct ExportChunk
+    {
+        QList<qulonglong> ids;
+        QString output;
+        long count = 0;
+        bool failed = false;
+    };
+
+    long runParallelExport();
+    bool exportChunk(const QSqlDatabase &db,
+                     LogFormat &format,
+                     ExportChunk &chunk) const;
+
+    void parseImportBatches(OrderedWorkQueue<ImportBatch> &queue,
+                            const QSqlRecord &recordTemplate);
+    void checkImportRecord(ImportRecord &item);
+    void enrichImportBatch(ImportBatch &batch,
+                           const DxccSnapshot::Ptr &dxcc,
+                           const StationProfile *defaultStationProfile);
+    void enrichImportRecord(ImportRecord &item,
+                            const DxccSnapshot::Ptr &dxcc,
+                            const StationProfile *defaultStationProfile,
+                            const QHash<QString, DxccEntity> &callEntities,
+                            const DxccEntity &clublogEntity);
+    static QList<DxccEntity> importLookupAD1C(const DxccSnapshot::Ptr &dxcc,
+                                              const QList<QString> &callsigns);
+    static QList<DxccEntity> importLookupClublog(const DxccSnapshot::Ptr &dxcc,
+                                                 const QList<QString> &callsigns,
+                                                 const QList<QDateTime> &dates);
+    static DxccEntity importEntityAD1C(const DxccSnapshot::Ptr &dxcc, int dxccID);
+    static DxccEntity importEntityClublog(const DxccSnapshot::Ptr &dxcc, int dxccID);
 
     void writeImportLog(QTextStream& errorLogStream,
                         ImportLogSeverity severity,
@@ -165,6 +269,14 @@ private:
                         const unsigned long recordNo,
                         const QSqlRecord &record,
                         const QString &msg);
+    void writeImportLog(QTextStream& errorLogStream,
+                        ImportLogSeverity severity,
+                        unsigned long *error,
+                        unsigned long *warning,
+                        const unsigned long recordNo,
+                        const QString &recordInfo,
+                        const QString &msg);
+    QString importLogRecordInfo(const QSqlRecord &record);
     QDate filterStartDate, filterEndDate;
     QString filterMyCallsign;
     QString filterMyGridsquare;
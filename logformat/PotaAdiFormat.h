@@ -21,6 +21,10 @@ public:
     void setExportDirectory(const QString &dir);
     ~PotaAdiFormat();
 
+protected:
+    // the records are split into per-park files
+    virtual LogFormat *createExportWorker(QTextStream &) const override { return nullptr; }
+
 private:
     QString exportDir;
     QDateTime currentDate;
@@ -3,7 +3,7 @@
 #include <QFont>
 
 AwardsTableModel::AwardsTableModel(QObject* parent) :
-    QSqlQueryModel(parent)
+    DBQueryResultModel(parent)
 {
 
 }
@@ -16,8 +16,8 @@ QVariant AwardsTableModel::data(const QModelIndex &index, int role) const
      * 2 - Worked row
      * 3 - Per DXCC Entity row
      */
-    int originRowType = QSqlQueryModel::data(this->index(index.row(), 0), Qt::DisplayRole).toInt();
-    QVariant originCellValue = QSqlQueryModel::data(index, Qt::DisplayRole);
+    int originRowType = DBQueryResultModel::data(this->index(index.row(), 0), Qt::DisplayRole).toInt();
+    QVariant originCellValue = DBQueryResultModel::data(index, Qt::DisplayRole);
     int cellIntValue = originCellValue.toInt();
 
     if ( role == Qt::DisplayRole
@@ -26,8 +26,8 @@ QVariant AwardsTableModel::data(const QModelIndex &index, int role) const
     {
         unsigned int count = 0;
         for ( int i = 3; i <= columnCount(); i++ )
-            count += QSqlQueryModel::data(this->index(index.row(), i),
-                                          Qt::DisplayRole).toInt();
+            count += DBQueryResultModel::data(this->index(index.row(), i),
+                                              Qt::DisplayRole).toInt();
         return tr("Slots: ") + QString::number(count) + "  ";
     }
 
@@ -72,5 +72,5 @@ QVariant AwardsTableModel::data(const QModelIndex &index, int role) const
         return font;
     }
 
-    return QSqlQueryModel::data(index, role);
+    return DBQueryResultModel::data(index, role);
 }
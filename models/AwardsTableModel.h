@@ -1,10 +1,9 @@
 #ifndef QLOG_MODELS_AWARDSTABLEMODEL_H
 #define QLOG_MODELS_AWARDSTABLEMODEL_H
 
-#include <QAbstractTableModel>
-#include <QSqlTableModel>
+#include "models/DBQueryResultModel.h"
 
-class AwardsTableModel : public QSqlQueryModel
+class AwardsTableModel : public DBQueryResultModel
 {
     Q_OBJECT
 
@@ -0,0 +1,82 @@
+#include "DBQueryResultModel.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.models.dbqueryresultmodel");
+
+DBQueryResultModel::DBQueryResultModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+    FCT_IDENTIFICATION;
+}
+
+void DBQueryResultModel::setResult(const DBQueryResult &newResult)
+{
+    FCT_IDENTIFICATION;
+
+    if ( !newResult.ok )
+        qCWarning(runtime) << "Query failed" << newResult.error;
+
+    // the header overrides belong to the previous columns
+    beginResetModel();
+    result = newResult;
+    horizontalHeaders.clear();
+    endResetModel();
+}
+
+void DBQueryResultModel::clear()
+{
+    FCT_IDENTIFICATION;
+
+    setResult(DBQueryResult());
+}
+
+int DBQueryResultModel::rowCount(const QModelIndex &parent) const
+{
+    return ( parent.isValid() ) ? 0 : result.rows.size();
+}
+
+int DBQueryResultModel::columnCount(const QModelIndex &parent) const
+{
+    return ( parent.isValid() ) ? 0 : result.columns.size();
+}
+
+QVariant DBQueryResultModel::data(const QModelIndex &index, int role) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( !index.isValid()
+         || index.row() >= result.rows.size()
+         || ( role != Qt::DisplayRole && role != Qt::EditRole ) )
+        return QVariant();
+
+    return result.rows.at(index.row()).value(index.column());
+}
+
+QVariant DBQueryResultModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if ( orientation == Qt::Horizontal )
+    {
+        const QPair<int, int> key(section, ( role == Qt::EditRole ) ? Qt::DisplayRole : role);
+
+        if ( horizontalHeaders.contains(key) )
+            return horizontalHeaders.value(key);
+
+        if ( role == Qt::DisplayRole && section >= 0 && section < result.columns.size() )
+            return result.columns.at(section);
+    }
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+bool DBQueryResultModel::setHeaderData(int section, Qt::Orientation orientation,
+                                       const QVariant &value, int role)
+{
+    FCT_IDENTIFICATION;
+
+    if ( orientation != Qt::Horizontal || section < 0 || section >= columnCount() )
+        return false;
+
+    horizontalHeaders.insert(qMakePair(section, ( role == Qt::EditRole ) ? Qt::DisplayRole : role), value);
+    emit headerDataChanged(orientation, section, section);
+    return true;
+}
@@ -0,0 +1,33 @@
+#ifndef QLOG_MODELS_DBQUERYRESULTMODEL_H
+#define QLOG_MODELS_DBQUERYRESULTMODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include "core/DBTaskExecutor.h"
+
+// Read-only table model over the rows of a DBTaskExecutor request.
+// It replaces QSqlQueryModel for the views whose statement runs in the
+// background - the model is filled when the result arrives.
+class DBQueryResultModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit DBQueryResultModel(QObject *parent = nullptr);
+
+    void setResult(const DBQueryResult &result);
+    void clear();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool setHeaderData(int section, Qt::Orientation orientation,
+                       const QVariant &value, int role = Qt::EditRole) override;
+
+private:
+    DBQueryResult result;
+    QHash<QPair<int, int>, QVariant> horizontalHeaders;   // (section, role)
+};
+
+#endif // QLOG_MODELS_DBQUERYRESULTMODEL_H
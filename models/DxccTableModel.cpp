@@ -7,13 +7,13 @@
 #include "data/Data.h"
 #include "core/LogParam.h"
 
-DxccTableModel::DxccTableModel(QObject* parent) : QSqlQueryModel(parent) {}
+DxccTableModel::DxccTableModel(QObject* parent) : DBQueryResultModel(parent) {}
 
 QVariant DxccTableModel::data(const QModelIndex &index, int role) const
 {
 
     if ( index.column() == 0 )
-        return QSqlQueryModel::data(index, role);
+        return DBQueryResultModel::data(index, role);
 
     switch ( role )
     {
@@ -42,7 +42,7 @@ QVariant DxccTableModel::data(const QModelIndex &index, int role) const
 
     case Qt::DisplayRole:
     {
-        const QString &currData = QSqlQueryModel::data(index, Qt::DisplayRole).toString();
+        const QString &currData = DBQueryResultModel::data(index, Qt::DisplayRole).toString();
 
         if ( currData.isEmpty() || currData.size() < 3 )
             return QString();
@@ -72,5 +72,5 @@ QVariant DxccTableModel::data(const QModelIndex &index, int role) const
     }
     }
 
-    return QSqlQueryModel::data(index, role);
+    return DBQueryResultModel::data(index, role);
 }
@@ -2,10 +2,12 @@
 #define QLOG_MODELS_DXCCTABLEMODEL_H
 
 #include <QObject>
-#include <QSqlTableModel>
+#include "models/DBQueryResultModel.h"
 
-class DxccTableModel : public QSqlQueryModel
+class DxccTableModel : public DBQueryResultModel
 {
+    Q_OBJECT
+
 public:
     explicit DxccTableModel(QObject* parent = nullptr);
 
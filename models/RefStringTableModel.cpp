@@ -0,0 +1,124 @@
+#include <QEvent>
+#include <QWidget>
+#include <QLineEdit>
+#include "RefStringTableModel.h"
+#include "core/debug.h"
+
+MODULE_IDENTIFICATION("qlog.models.refstringtablemodel");
+
+RefStringTableModel::RefStringTableModel(const Loader &loader,
+                                         QWidget *trigger,
+                                         Qt::MatchFlag filterMode,
+                                         QObject *parent)
+    : QAbstractListModel(parent),
+      loader(loader),
+      firstRow(0),
+      lastRow(0)
+{
+    FCT_IDENTIFICATION;
+
+    qCDebug(function_parameters) << filterMode;
+
+    if ( filterMode == Qt::MatchStartsWith )
+        prefixEdit = qobject_cast<QLineEdit *>(trigger);
+
+    // QLineEdit updates the completer after textEdited is emitted,
+    // so the completer always filters the current range
+    if ( prefixEdit )
+        connect(prefixEdit.data(), &QLineEdit::textEdited, this, &RefStringTableModel::updateRange);
+
+    if ( trigger )
+        trigger->installEventFilter(this);
+    else
+        loadTable();
+}
+
+int RefStringTableModel::rowCount(const QModelIndex &parent) const
+{
+    if ( parent.isValid() || !table )
+        return 0;
+
+    return lastRow - firstRow;
+}
+
+QVariant RefStringTableModel::data(const QModelIndex &index, int role) const
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( !table || !index.isValid() )
+        return QVariant();
+
+    if ( role == Qt::DisplayRole || role == Qt::EditRole )
+        return table->key(firstRow + index.row());
+
+    if ( role == Qt::ToolTipRole && table->hasValues() )
+        return table->value(firstRow + index.row());
+
+    return QVariant();
+}
+
+bool RefStringTableModel::eventFilter(QObject *watched, QEvent *event)
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( event->type() == QEvent::FocusIn )
+    {
+        loadTable();
+
+        // a failed load is repeated on the next focus
+        if ( table )
+            watched->removeEventFilter(this);
+    }
+
+    return QAbstractListModel::eventFilter(watched, event);
+}
+
+void RefStringTableModel::loadTable()
+{
+    FCT_IDENTIFICATION;
+
+    if ( table || !loader )
+        return;
+
+    const RefStringTable::Ptr loadedTable = loader();
+
+    if ( !loadedTable )
+    {
+        qCDebug(runtime) << "Reference table is not available";
+        return;
+    }
+
+    // the completer invalidates its cache on the reset
+    beginResetModel();
+    table = loadedTable;
+    firstRow = 0;
+    lastRow = table->size();
+    endResetModel();
+
+    updateRange();
+}
+
+void RefStringTableModel::updateRange()
+{
+    // Hot path - no FCT_IDENTIFICATION here
+
+    if ( !table || !prefixEdit )
+        return;
+
+    // the completion prefix - the same split as MultiselectCompleter::splitPath
+    const QString &text = prefixEdit->text();
+    int pos = text.lastIndexOf(',') + 1;
+
+    while ( pos < text.length() && text.at(pos) == QLatin1Char(' ') )
+        pos++;
+
+    const QPair<int, int> range = table->prefixRange(text.mid(pos).toUpper());
+
+    if ( range.first == firstRow && range.second == lastRow )
+        return;
+
+    beginResetModel();
+    firstRow = range.first;
+    lastRow = range.second;
+    endResetModel();
+}
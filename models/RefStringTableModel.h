@@ -0,0 +1,54 @@
+#ifndef QLOG_MODELS_REFSTRINGTABLEMODEL_H
+#define QLOG_MODELS_REFSTRINGTABLEMODEL_H
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <functional>
+#include "data/RefStringTable.h"
+
+class QWidget;
+class QLineEdit;
+
+// Read-only list model over a shared RefStringTable - the codes are not
+// copied into the model. The table is sorted, so completers can use
+// QCompleter::CaseSensitivelySortedModel.
+//
+// The table is requested from the loader when the trigger widget gets
+// the focus for the first time. Until then, and while the loader returns
+// a null table, the model is empty.
+//
+// With Qt::MatchStartsWith and a QLineEdit trigger, the model serves only
+// the prefix range of the edited code (the text after the last comma for
+// the multiselect completers). The range is a binary search in the table,
+// so the case-insensitive completer scans only the matching codes instead
+// of the whole table. The reference codes are upper case.
+class RefStringTableModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    using Loader = std::function<RefStringTable::Ptr()>;
+
+    explicit RefStringTableModel(const Loader &loader,
+                                 QWidget *trigger,
+                                 Qt::MatchFlag filterMode,
+                                 QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    void loadTable();
+    void updateRange();
+
+    Loader loader;
+    RefStringTable::Ptr table;
+    QPointer<QLineEdit> prefixEdit;
+    int firstRow;
+    int lastRow;                  // the rows of the model are the table rows [firstRow, lastRow)
+};
+
+#endif // QLOG_MODELS_REFSTRINGTABLEMODEL_H
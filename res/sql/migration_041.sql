@@ -0,0 +1,7 @@
+CREATE INDEX IF NOT EXISTS contacts_callsign_start_time_idx ON contacts (callsign, start_time);
+DROP INDEX IF EXISTS contacts_callsign_idx;
+
+CREATE INDEX IF NOT EXISTS contacts_dxcc_status_idx ON contacts (dxcc, my_dxcc, band, mode, lotw_qsl_rcvd, qsl_rcvd, eqsl_qsl_rcvd);
+DROP INDEX IF EXISTS contacts_dxcc_idx;
+
+CREATE INDEX IF NOT EXISTS contacts_contest_id_idx ON contacts (contest_id, start_time, callsign, band, mode);
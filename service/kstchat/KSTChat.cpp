@@ -584,6 +584,8 @@ void KSTChat::finalizeShowUsersCommand(const QStringList &buffer)
 
     userList.clear();
 
+    QList<QString> callsigns;
+
     for ( const QString &record : static_cast<const QList<QString>&>(buffer) )
     {
         QRegularExpressionMatch match = recordRE.match(record);
@@ -594,14 +596,8 @@ void KSTChat::finalizeShowUsersCommand(const QStringList &buffer)
             user.callsign = match.captured(1).remove('(').remove(')');
             user.grid = Gridsquare(match.captured(2));
             user.stationComment = match.captured(3);
-            user.dxcc = Data::instance()->lookupDxcc(user.callsign);
             user.status = DxccStatus::UnknownStatus;
-            if ( contact )
-            {
-                const QString &modeGroup = BandPlan::modeToDXCCModeGroup(contact->getMode());
-                user.status = Data::instance()->dxccStatus(user.dxcc.dxcc, contact->getBand(), modeGroup);
-                user.dupeCount = Data::countDupe(user.callsign, contact->getBand(), modeGroup);
-            }
+            callsigns << user.callsign;
             userList << user;
         }
         else
@@ -609,6 +605,23 @@ void KSTChat::finalizeShowUsersCommand(const QStringList &buffer)
             qCDebug(runtime) << "Record does not match the pattern";
         }
     }
+
+    // resolve the whole list at once
+    const QList<DxccEntity> &entities = Data::instance()->lookupDxccBatch(callsigns);
+    const QString &modeGroup = ( contact ) ? BandPlan::modeToDXCCModeGroup(contact->getMode())
+                                           : QString();
+
+    for ( int i = 0; i < userList.size(); ++i )
+    {
+        KSTUsersInfo &user = userList[i];
+        user.dxcc = entities.at(i);
+
+        if ( contact )
+        {
+            user.status = Data::instance()->dxccStatus(user.dxcc.dxcc, contact->getBand(), modeGroup);
+            user.dupeCount = Data::countDupe(user.callsign, contact->getBand(), modeGroup);
+        }
+    }
     emit usersListUpdated();
     QTimer::singleShot(1000 * KST_UPDATE_USERS_LIST, this, [this]()
     {
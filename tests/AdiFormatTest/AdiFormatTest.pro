@@ -12,10 +12,12 @@ SOURCES += \
     test_stubs.cpp \
     ../../core/LogLocale.cpp \
     ../../data/Accents.cpp \
-    ../../logformat/AdiFormat.cpp
+    ../../logformat/AdiFormat.cpp \
+    ../../logformat/AdiTokenizer.cpp
 
 HEADERS += \
     ../../core/LogLocale.h \
     ../../data/Data.h \
     ../../logformat/AdiFormat.h \
+    ../../logformat/AdiTokenizer.h \
     ../../logformat/LogFormat.h
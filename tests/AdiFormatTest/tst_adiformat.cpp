@@ -4,8 +4,10 @@
 #include <QJsonObject>
 #include <QSqlField>
 #include <QSqlRecord>
+#include <QTemporaryFile>
 
 #include "logformat/AdiFormat.h"
+#include "logformat/AdiTokenizer.h"
 
 class TestAdiFormat : public AdiFormat
 {
@@ -20,6 +22,11 @@ public:
         return readContact(contact);
     }
 
+    qint64 importPositionForTest()
+    {
+        return importStreamPosition();
+    }
+
     void writeFieldForTest(const QString &name,
                            bool presenceCondition,
                            const QString &value,
@@ -46,6 +53,9 @@ private slots:
     void parserSkipsMixedCaseHeaderTerminator();
     void parserPreservesLengthDelimitedCRLFData();
     void parserReadsMultipleContactsAndMixedCaseEor();
+    void tokenizerReturnsFieldViews();
+    void tokenizerMatchesStreamParser();
+    void tokenizerReadsMappedFile();
     void writeFieldFormatsTagLengthAndType();
     void writeFieldNormalizesLineBreaksByFieldType();
     void exportStartWritesAdifHeader();
@@ -53,6 +63,7 @@ private slots:
     void writeSqlRecordExportsApplicationTags();
     void writeSqlRecordExportsRawFieldsFiltersInvalidNames();
     void exportContactNormalizesGridAndTerminatesRecord();
+    void exportContactFollowsRecordLayoutChange();
     void importNextMapsAdiFieldsAndStoresUnknownFields();
     void importNextNormalizesConstrainedEnumFields();
     void importNextStoresZeroLengthFields();
@@ -74,6 +85,7 @@ private:
     static void appendField(QSqlRecord &record,
                             const QString &name,
                             const QVariant &value);
+    static QList<QVariantMap> readAllContacts(TestAdiFormat &format);
 };
 
 void AdiFormatTest::initTestCase()
@@ -125,6 +137,19 @@ void AdiFormatTest::appendField(QSqlRecord &record,
     record.append(field);
 }
 
+QList<QVariantMap> AdiFormatTest::readAllContacts(TestAdiFormat &format)
+{
+    QList<QVariantMap> contacts;
+    QVariantMap contact;
+
+    while ( format.readContactForTest(contact) )
+    {
+        contacts.append(contact);
+        contact.clear();
+    }
+    return contacts;
+}
+
 void AdiFormatTest::constructorDisablesDeviceTextMode()
 {
     QByteArray input;
@@ -225,6 +250,113 @@ void AdiFormatTest::parserReadsMultipleContactsAndMixedCaseEor()
     QCOMPARE(contact.value(QStringLiteral("call")).toString(), QStringLiteral("OK2BB"));
 }
 
+void AdiFormatTest::tokenizerReturnsFieldViews()
+{
+    QByteArray input("header <ADIF_VER:5>3.1.7 <EOH>\r\n");
+    input += "< CALL :5>OK1AA<FREQ:6:N>14.074<QSL_VIA>";
+    input += "<COMMENT:3>abcdef<eor>";
+
+    AdiTokenizer tokenizer(input);
+    AdiTokenizer::Field field;
+
+    QVERIFY(tokenizer.next(field));
+    QVERIFY(field.header);
+    QCOMPARE(QString(tokenizer.name(field)), QStringLiteral("ADIF_VER"));
+    QCOMPARE(QString(tokenizer.value(field)), QStringLiteral("3.1.7"));
+
+    QVERIFY(tokenizer.next(field));
+    QVERIFY(!field.header);
+    QVERIFY(tokenizer.isName(field, "call"));
+    QCOMPARE(QString(tokenizer.value(field)), QStringLiteral("OK1AA"));
+    QCOMPARE(input.mid(field.valueOffset, field.valueLength), QByteArray("OK1AA"));
+
+    QVERIFY(tokenizer.next(field));
+    QCOMPARE(QString(tokenizer.name(field)), QStringLiteral("FREQ"));
+    QCOMPARE(QString(tokenizer.type(field)), QStringLiteral("N"));
+    QCOMPARE(QString(tokenizer.value(field)), QStringLiteral("14.074"));
+
+    QVERIFY(tokenizer.next(field));
+    QCOMPARE(QString(tokenizer.name(field)), QStringLiteral("QSL_VIA"));
+    QCOMPARE(field.valueLength, qsizetype(0));
+
+    QVERIFY(tokenizer.next(field));
+    QCOMPARE(QString(tokenizer.value(field)), QStringLiteral("abc"));
+
+    QVERIFY(tokenizer.next(field));
+    QVERIFY(tokenizer.isName(field, "eor"));
+    QVERIFY(!tokenizer.isName(field, "eoh"));
+
+    QVERIFY(!tokenizer.next(field));
+    QVERIFY(tokenizer.atEnd());
+}
+
+void AdiFormatTest::tokenizerMatchesStreamParser()
+{
+    QByteArray input("Exported header\r\n");
+    input += tag("ADIF_VER", "3.1.7");
+    input += tag("USERDEF1", "SWR", "N");
+    input += "<EOH>\r\n";
+    input += tag("CALL", "OK1AA");
+    input += tag("ADDRESS", "Line 1\r\nLine 2");
+    input += tag("NAME", "Ji\xF8\xED");
+    input += "<QSL_VIA:0>\r\n";
+    input += tag("swr", "1.5");
+    input += "<eOr>\r\n";
+    input += tag("CALL", "OK2BB");
+    input += tag("COMMENT", "a <b> c");
+    input += "<EOR>\r\n";
+    input += tag("CALL", "OK3CC");
+
+    // QBuffer device - tokenizer path
+    QByteArray tokenizerInput(input);
+    QBuffer buffer(&tokenizerInput);
+    QVERIFY(buffer.open(QIODevice::ReadOnly | QIODevice::Text));
+    QTextStream tokenizerStream(&buffer);
+    TestAdiFormat tokenizerFormat(tokenizerStream);
+
+    // string without device - stream parser path
+    QString streamInput = QString::fromLatin1(input);
+    QTextStream stringStream(&streamInput, QIODevice::ReadOnly);
+    TestAdiFormat streamFormat(stringStream);
+
+    const QList<QVariantMap> tokenizerContacts = readAllContacts(tokenizerFormat);
+    const QList<QVariantMap> streamContacts = readAllContacts(streamFormat);
+
+    QCOMPARE(tokenizerContacts.size(), 2);
+    QVERIFY(tokenizerContacts == streamContacts);
+    QCOMPARE(tokenizerContacts.at(0).value(QStringLiteral("name")).toString(),
+             QString::fromLatin1("Ji\xF8\xED"));
+    QCOMPARE(tokenizerContacts.at(1).value(QStringLiteral("comment")).toString(),
+             QStringLiteral("a <b> c"));
+    QCOMPARE(tokenizerFormat.importPositionForTest(), qint64(input.size()));
+}
+
+void AdiFormatTest::tokenizerReadsMappedFile()
+{
+    QByteArray input;
+    for ( int i = 0; i < 100; i++ )
+    {
+        input += tag("CALL", "OK1AA");
+        input += tag("STX", QByteArray::number(i));
+        input += "<EOR>\n";
+    }
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(input), qint64(input.size()));
+    QVERIFY(file.flush());
+    QVERIFY(file.seek(0));
+
+    QTextStream stream(&file);
+    TestAdiFormat format(stream);
+
+    const QList<QVariantMap> contacts = readAllContacts(format);
+
+    QCOMPARE(contacts.size(), 100);
+    QCOMPARE(contacts.last().value(QStringLiteral("stx")).toString(), QStringLiteral("99"));
+    QCOMPARE(format.importPositionForTest(), qint64(input.size()));
+}
+
 void AdiFormatTest::writeFieldFormatsTagLengthAndType()
 {
     QCOMPARE(writeField(QStringLiteral("FREQ"), true, QStringLiteral("14.074"), QStringLiteral("N")),
@@ -378,6 +510,39 @@ void AdiFormatTest::exportContactNormalizesGridAndTerminatesRecord()
     QVERIFY(output.endsWith("<eor>\n\n"));
 }
 
+void AdiFormatTest::exportContactFollowsRecordLayoutChange()
+{
+    QSqlRecord first;
+    appendField(first, QStringLiteral("callsign"), QStringLiteral("OK1AA"));
+    appendField(first, QStringLiteral("band"), QStringLiteral("20M"));
+
+    QSqlRecord second;
+    appendField(second, QStringLiteral("band"), QStringLiteral("40M"));
+    appendField(second, QStringLiteral("qsl_rcvd"), QStringLiteral("Y"));
+    appendField(second, QStringLiteral("callsign"), QStringLiteral("DL1AB"));
+    appendField(second,
+                QStringLiteral("start_time"),
+                QDateTime(QDate(2026, 5, 28), QTime(12, 34, 56), Qt::UTC));
+
+    QByteArray output;
+    QBuffer buffer(&output);
+    QVERIFY(buffer.open(QIODevice::WriteOnly | QIODevice::Text));
+    QTextStream stream(&buffer);
+    TestAdiFormat format(stream);
+
+    format.exportContact(first);
+    format.exportContact(first);
+    format.exportContact(second);
+    format.exportContact(first);
+    stream.flush();
+
+    const QByteArray firstRecord("<call:5>OK1AA\n<band:3>20m\n<eor>\n\n");
+    const QByteArray secondRecord("<band:3>40m\n<qsl_rcvd:1>Y\n<call:5>DL1AB\n"
+                                  "<qso_date:8>20260528\n<time_on:6>123456\n<eor>\n\n");
+
+    QCOMPARE(output, firstRecord + firstRecord + secondRecord + firstRecord);
+}
+
 void AdiFormatTest::importNextMapsAdiFieldsAndStoresUnknownFields()
 {
     QByteArray input;
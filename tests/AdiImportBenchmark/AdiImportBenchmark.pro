@@ -11,13 +11,19 @@ SOURCES += \
     tst_adiimportbenchmark.cpp \
     ../AdiFormatTest/test_stubs.cpp \
     ../../core/LogLocale.cpp \
+    ../../core/SQLBulkLoad.cpp \
+    ../../core/SQLTuning.cpp \
     ../../data/Accents.cpp \
-    ../../logformat/AdiFormat.cpp
+    ../../logformat/AdiFormat.cpp \
+    ../../logformat/AdiTokenizer.cpp
 
 HEADERS += \
     ../../core/LogLocale.h \
+    ../../core/SQLBulkLoad.h \
+    ../../core/SQLTuning.h \
     ../../data/Data.h \
     ../../logformat/AdiFormat.h \
+    ../../logformat/AdiTokenizer.h \
     ../../logformat/LogFormat.h
 
 RESOURCES += \
@@ -11,7 +11,9 @@
 #include <QTextStream>
 
 #include "core/Migration.h"
+#include "core/SQLBulkLoad.h"
 #include "logformat/AdiFormat.h"
+#include "logformat/AdiTokenizer.h"
 
 class TestAdiFormat : public AdiFormat
 {
@@ -56,15 +58,21 @@ struct BenchmarkSample
 
 struct StageTimings
 {
+    qint64 tokenizeMs = 0;
+    qint64 streamParseMs = 0;
     qint64 parseMs = 0;
     qint64 parseAndMapMs = 0;
     qint64 duplicateCurrentExistingIndexesMs = 0;
     qint64 insertMs = 0;
+    qint64 bulkInsertMs = 0;
     qint64 logMs = 0;
+    int tokenizedFields = 0;
+    int streamParsed = 0;
     int parsed = 0;
     int mapped = 0;
     int duplicateHits = 0;
     int inserted = 0;
+    int bulkInserted = 0;
     int existingContactIndexCount = 0;
     qsizetype logBytes = 0;
 };
@@ -88,10 +96,13 @@ private:
     static QByteArray generateAdi(const QVector<BenchmarkSample> &samples);
     static bool executeSqlFile(int version, QString *error);
     static bool resetDatabase(QString *error);
+    static bool createContactTriggers(QString *error);
     static QStringList contactIndexNames(QString *error);
     static QSqlRecord contactRecordTemplate();
     static void setRecordValue(QSqlRecord &record, const QString &field, const QVariant &value);
     static void fillRecord(QSqlRecord &record, const BenchmarkSample &sample, int index);
+    static qint64 measureTokenize(const QByteArray &adi, int *fields);
+    static qint64 measureStreamParse(const QByteArray &adi, int *parsed);
     static qint64 measureParse(const QByteArray &adi, int *parsed);
     static qint64 measureParseAndMap(const QByteArray &adi, const QSqlRecord &recordTemplate, int *mapped);
     static bool populateDuplicateCandidates(const QVector<BenchmarkSample> &samples, QString *error);
@@ -102,6 +113,10 @@ private:
                                 const QSqlRecord &recordTemplate,
                                 int *inserted,
                                 QString *error);
+    static qint64 measureBulkInsert(const QVector<BenchmarkSample> &samples,
+                                    const QSqlRecord &recordTemplate,
+                                    int *inserted,
+                                    QString *error);
     static qint64 measureImportLog(const QVector<BenchmarkSample> &samples,
                                    const QSqlRecord &recordTemplate,
                                    qsizetype *logBytes);
@@ -150,6 +165,12 @@ void AdiImportBenchmark::benchmarkImportStages()
     QVERIFY(recordTemplate.count() > 0);
 
     StageTimings timings;
+    timings.tokenizeMs = measureTokenize(adi, &timings.tokenizedFields);
+    QVERIFY(timings.tokenizedFields > recordCount);
+
+    timings.streamParseMs = measureStreamParse(adi, &timings.streamParsed);
+    QCOMPARE(timings.streamParsed, recordCount);
+
     timings.parseMs = measureParse(adi, &timings.parsed);
     QCOMPARE(timings.parsed, recordCount);
 
@@ -160,7 +181,7 @@ void AdiImportBenchmark::benchmarkImportStages()
     QVERIFY2(populateDuplicateCandidates(samples, &error), qPrintable(error));
     const QStringList existingContactIndexes = contactIndexNames(&error);
     QVERIFY2(error.isEmpty(), qPrintable(error));
-    QVERIFY(existingContactIndexes.contains(QStringLiteral("contacts_callsign_idx")));
+    QVERIFY(existingContactIndexes.contains(QStringLiteral("contacts_callsign_start_time_idx")));
     QVERIFY(existingContactIndexes.contains(QStringLiteral("contacts_band_idx")));
     QVERIFY(existingContactIndexes.contains(QStringLiteral("contacts_mode_idx")));
     QVERIFY(existingContactIndexes.contains(QStringLiteral("contacts_start_time_idx")));
@@ -171,14 +192,37 @@ void AdiImportBenchmark::benchmarkImportStages()
     QVERIFY2(timings.duplicateCurrentExistingIndexesMs >= 0, qPrintable(error));
 
     QVERIFY2(resetDatabase(&error), qPrintable(error));
+    QVERIFY2(createContactTriggers(&error), qPrintable(error));
     const QSqlRecord insertRecordTemplate = contactRecordTemplate();
     timings.insertMs = measureInsert(samples, insertRecordTemplate, &timings.inserted, &error);
     QVERIFY2(timings.insertMs >= 0, qPrintable(error));
     QCOMPARE(timings.inserted, recordCount);
 
+    QVERIFY2(resetDatabase(&error), qPrintable(error));
+    QVERIFY2(createContactTriggers(&error), qPrintable(error));
+    timings.bulkInsertMs = measureBulkInsert(samples, insertRecordTemplate, &timings.bulkInserted, &error);
+    QVERIFY2(timings.bulkInsertMs >= 0, qPrintable(error));
+    QCOMPARE(timings.bulkInserted, recordCount);
+
+    // the set-based fill must create the rows of the per-row trigger
+    QSqlQuery autovalueQuery(QStringLiteral("SELECT COUNT(*) FROM contacts_autovalue"));
+    QVERIFY(autovalueQuery.next());
+    QCOMPARE(autovalueQuery.value(0).toInt(), recordCount);
+
     timings.logMs = measureImportLog(samples, recordTemplate, &timings.logBytes);
 
     const qint64 mappingEstimate = qMax<qint64>(0, timings.parseAndMapMs - timings.parseMs);
+    const double adiMB = adi.size() / (1024.0 * 1024.0);
+    const QString throughput =
+        QStringLiteral("ADI parse throughput: tokenizer_ms=%1, tokenizer_MBps=%2, "
+                       "stream_parse_ms=%3, stream_parse_records_per_s=%4, "
+                       "parse_ms=%5, parse_records_per_s=%6")
+            .arg(timings.tokenizeMs)
+            .arg(adiMB * 1000.0 / qMax<qint64>(1, timings.tokenizeMs), 0, 'f', 1)
+            .arg(timings.streamParseMs)
+            .arg(recordCount * 1000LL / qMax<qint64>(1, timings.streamParseMs))
+            .arg(timings.parseMs)
+            .arg(recordCount * 1000LL / qMax<qint64>(1, timings.parseMs));
     const QString report =
         QStringLiteral("ADI import benchmark: records=%1, adif_kB=%2, "
                        "contacts_existing_index_count=%3, parse_ms=%4, parse_map_ms=%5, "
@@ -196,6 +240,16 @@ void AdiImportBenchmark::benchmarkImportStages()
             .arg(timings.logMs)
             .arg(timings.logBytes / 1024);
 
+    const QString insertThroughput =
+        QStringLiteral("DB insert throughput: per_row_ms=%1, per_row_rows_per_s=%2, "
+                       "bulk_ms=%3, bulk_rows_per_s=%4")
+            .arg(timings.insertMs)
+            .arg(recordCount * 1000LL / qMax<qint64>(1, timings.insertMs))
+            .arg(timings.bulkInsertMs)
+            .arg(recordCount * 1000LL / qMax<qint64>(1, timings.bulkInsertMs));
+
+    qInfo().noquote() << throughput;
+    qInfo().noquote() << insertThroughput;
     qInfo().noquote() << report;
 }
 
@@ -425,6 +479,31 @@ bool AdiImportBenchmark::resetDatabase(QString *error)
     return true;
 }
 
+bool AdiImportBenchmark::createContactTriggers(QString *error)
+{
+    // created by the migration code, not by the SQL files
+    QSqlQuery query;
+    if ( !query.exec(QStringLiteral("CREATE TRIGGER insert_contacts_autovalue "
+                                    "AFTER INSERT ON contacts "
+                                    "FOR EACH ROW "
+                                    "BEGIN "
+                                    "  INSERT OR REPLACE INTO contacts_autovalue (contactid, base_callsign) "
+                                    "  VALUES (NEW.id, (WITH tokenizedCallsign(word, csv) AS ( SELECT '', NEW.callsign||'/' "
+                                    "                                                UNION ALL "
+                                    "                                                SELECT substr(csv, 0, instr(csv, '/')), substr(csv, instr(csv, '/') + 1) "
+                                    "                                                FROM tokenizedCallsign "
+                                    "                                                WHERE csv != '' ) "
+                                    "                   SELECT word FROM tokenizedCallsign "
+                                    "                   WHERE word != '' and word REGEXP '^([A-Z][0-9]|[A-Z]{1,2}|[0-9][A-Z])([0-9]|[0-9]+)([A-Z]+)$' LIMIT 1)); "
+                                    "END;")) )
+    {
+        *error = query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
 QStringList AdiImportBenchmark::contactIndexNames(QString *error)
 {
     QStringList names;
@@ -506,6 +585,45 @@ void AdiImportBenchmark::fillRecord(QSqlRecord &record,
                    QStringLiteral("{\"app_qlog_benchmark\":\"%1\"}").arg(index));
 }
 
+qint64 AdiImportBenchmark::measureTokenize(const QByteArray &adi, int *fields)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    AdiTokenizer tokenizer(adi);
+    AdiTokenizer::Field field;
+
+    int count = 0;
+    while ( tokenizer.next(field) )
+        ++count;
+
+    *fields = count;
+    return timer.elapsed();
+}
+
+qint64 AdiImportBenchmark::measureStreamParse(const QByteArray &adi, int *parsed)
+{
+    // a string stream has no device - AdiFormat falls back to the QTextStream parser
+    QString input = QString::fromLatin1(adi);
+    QTextStream stream(&input, QIODevice::ReadOnly);
+    TestAdiFormat format(stream);
+    format.importStartForTest();
+
+    QVariantMap contact;
+    QElapsedTimer timer;
+    timer.start();
+
+    int count = 0;
+    while ( format.readContactForTest(contact) )
+    {
+        ++count;
+        contact.clear();
+    }
+
+    *parsed = count;
+    return timer.elapsed();
+}
+
 qint64 AdiImportBenchmark::measureParse(const QByteArray &adi, int *parsed)
 {
     QByteArray input(adi);
@@ -683,6 +801,85 @@ qint64 AdiImportBenchmark::measureInsert(const QVector<BenchmarkSample> &samples
     return elapsed;
 }
 
+qint64 AdiImportBenchmark::measureBulkInsert(const QVector<BenchmarkSample> &samples,
+                                             const QSqlRecord &recordTemplate,
+                                             int *inserted,
+                                             QString *error)
+{
+    QSqlRecord record(recordTemplate);
+    QSqlQuery insertQuery;
+    if ( !insertQuery.prepare(QSqlDatabase::database().driver()->sqlStatement(QSqlDriver::InsertStatement,
+                                                                              QStringLiteral("contacts"),
+                                                                              record,
+                                                                              true)) )
+    {
+        *error = insertQuery.lastError().text();
+        return -1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    int count = 0;
+    qint64 elapsed = 0;
+
+    {
+        SQLBulkLoad bulkLoad;
+
+        QSqlDatabase::database().transaction();
+
+        if ( !bulkLoad.suspendContactTriggers() )
+        {
+            *error = QStringLiteral("Cannot suspend contacts triggers");
+            QSqlDatabase::database().rollback();
+            return -1;
+        }
+
+        QVector<QVariantList> columns(record.count());
+
+        for ( int i = 0; i < samples.size(); ++i )
+        {
+            fillRecord(record, samples.at(i), i);
+
+            for ( int field = 0; field < record.count(); ++field )
+                columns[field] << record.value(field);
+
+            if ( columns[0].size() < SQLBulkLoad::CHUNK_SIZE && i + 1 < samples.size() )
+                continue;
+
+            for ( int field = 0; field < columns.size(); ++field )
+                insertQuery.bindValue(field, columns.at(field));
+
+            if ( !insertQuery.execBatch() )
+            {
+                *error = insertQuery.lastError().text();
+                QSqlDatabase::database().rollback();
+                return -1;
+            }
+
+            const qulonglong lastId = insertQuery.lastInsertId().toULongLong();
+            bulkLoad.addInsertedContacts(lastId - columns[0].size() + 1, lastId);
+            count += columns[0].size();
+
+            for ( QVariantList &column : columns )
+                column.clear();
+        }
+
+        if ( !bulkLoad.finishContacts() )
+        {
+            *error = QStringLiteral("Cannot finish contacts bulk load");
+            QSqlDatabase::database().rollback();
+            return -1;
+        }
+
+        elapsed = timer.elapsed();
+        QSqlDatabase::database().commit();
+    }
+
+    *inserted = count;
+    return elapsed;
+}
+
 qint64 AdiImportBenchmark::measureImportLog(const QVector<BenchmarkSample> &samples,
                                             const QSqlRecord &recordTemplate,
                                             qsizetype *logBytes)
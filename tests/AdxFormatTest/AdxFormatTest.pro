@@ -13,11 +13,13 @@ SOURCES += \
     ../../core/LogLocale.cpp \
     ../../data/Accents.cpp \
     ../../logformat/AdxFormat.cpp \
-    ../../logformat/AdiFormat.cpp
+    ../../logformat/AdiFormat.cpp \
+    ../../logformat/AdiTokenizer.cpp
 
 HEADERS += \
     ../../core/LogLocale.h \
     ../../data/Data.h \
     ../../logformat/AdxFormat.h \
     ../../logformat/AdiFormat.h \
+    ../../logformat/AdiTokenizer.h \
     ../../logformat/LogFormat.h
@@ -12,6 +12,11 @@ LogFormat::LogFormat(QTextStream &stream) :
 
 LogFormat::~LogFormat() = default;
 
+qint64 LogFormat::importStreamPosition()
+{
+    return stream.pos();
+}
+
 void LogFormat::setDefaults(QMap<QString, QString> &defaults)
 {
     this->defaults = &defaults;
@@ -37,6 +42,26 @@ void Data::invalidateSetOfDXCCStatusCache(const QSet<uint> &)
 {
 }
 
+void Data::updateDXCCStatusCache(const QSqlRecord &)
+{
+}
+
 void Data::clearDXCCStatusCache()
 {
 }
+
+void Data::updateDupeIndexWhenQSOAdded(const QSqlRecord &)
+{
+}
+
+void Data::updateDupeIndexWhenQSODeleted(const QSqlRecord &)
+{
+}
+
+void Data::updateDupeIndexWhenQSOUpdated(const QSqlRecord &)
+{
+}
+
+void Data::clearDupeIndex()
+{
+}
@@ -38,6 +38,8 @@ private slots:
     void isFTxMode();
     void isFTxBandMode_data();
     void isFTxBandMode();
+    void bandName2Band();
+    void cacheInvalidation();
 };
 
 void BandPlanTest::initTestCase()
@@ -380,6 +382,59 @@ void BandPlanTest::isFTxBandMode()
     QCOMPARE(BandPlan::isFTxBandMode(mode), expected);
 }
 
+void BandPlanTest::bandName2Band()
+{
+    QCOMPARE(BandPlan::bandName2Band(QStringLiteral("20m")).name, QStringLiteral("20m"));
+    QCOMPARE(BandPlan::bandName2Band(QStringLiteral("70CM")).name, QStringLiteral("70cm"));
+    QCOMPARE(BandPlan::bandName2Band(QStringLiteral("2m")).start, 144.000);
+    QVERIFY(BandPlan::bandName2Band(QStringLiteral("11m")).name.isEmpty());
+    QVERIFY(BandPlan::modeToDXCCModeGroup(QStringLiteral("OLIVIA")).isEmpty());
+    QVERIFY(BandPlan::freq2Band(12.0).name.isEmpty());
+}
+
+void BandPlanTest::cacheInvalidation()
+{
+    // warm up the cache
+    QVERIFY(BandPlan::freq2Band(27.1).name.isEmpty());
+
+    QSqlQuery query;
+    QVERIFY2(query.exec("INSERT INTO bands (name, start_freq, end_freq, enabled, sat_designator) "
+                        "VALUES ('11m', 26.965, 27.405, 0, NULL)"),
+             qPrintable(lastErrorString(query)));
+    // overlaps 10m; the 10m row has the lower ID
+    QVERIFY2(query.exec("INSERT INTO bands (name, start_freq, end_freq, enabled, sat_designator) "
+                        "VALUES ('10m-sat', 29.300, 29.510, 1, 'A')"),
+             qPrintable(lastErrorString(query)));
+    QVERIFY2(query.exec("UPDATE modes SET dxcc = 'PHONE' WHERE name = 'RTTY'"),
+             qPrintable(lastErrorString(query)));
+
+    // the cache does not see the changes until it is invalidated
+    QVERIFY(BandPlan::freq2Band(27.1).name.isEmpty());
+    QCOMPARE(BandPlan::modeToDXCCModeGroup(QStringLiteral("RTTY")), QStringLiteral("DIGITAL"));
+
+    BandPlan::invalidateCache();
+
+    QCOMPARE(BandPlan::freq2Band(27.1).name, QStringLiteral("11m"));
+    QCOMPARE(BandPlan::freq2Band(29.4).name, QStringLiteral("10m"));
+    QCOMPARE(BandPlan::freq2Band(29.7).name, QStringLiteral("10m"));
+    QCOMPARE(BandPlan::bandName2Band(QStringLiteral("11m")).end, 27.405);
+    QCOMPARE(BandPlan::modeToDXCCModeGroup(QStringLiteral("RTTY")), QStringLiteral("PHONE"));
+
+    bool disabledListed = false;
+    const QList<Band> enabledBands = BandPlan::bandsList(false, true);
+    for ( const Band &band : enabledBands )
+        disabledListed |= ( band.name == QLatin1String("11m") );
+    QVERIFY(!disabledListed);
+    QCOMPARE(BandPlan::bandsList(false, false).size(), enabledBands.size() + 1);
+
+    // restore the original state for the other tests
+    QVERIFY(query.exec("DELETE FROM bands WHERE name IN ('11m', '10m-sat')"));
+    QVERIFY(query.exec("UPDATE modes SET dxcc = 'DIGITAL' WHERE name = 'RTTY'"));
+    BandPlan::invalidateCache();
+
+    QVERIFY(BandPlan::freq2Band(27.1).name.isEmpty());
+}
+
 QTEST_MAIN(BandPlanTest)
 
 #include "tst_bandplan.moc"
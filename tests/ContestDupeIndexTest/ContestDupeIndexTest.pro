@@ -0,0 +1,13 @@
+QT += testlib core sql
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_contestdupeindex
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_contestdupeindex.cpp \
+    ../../data/ContestDupeIndex.cpp
+
+HEADERS += \
+    ../../data/ContestDupeIndex.h
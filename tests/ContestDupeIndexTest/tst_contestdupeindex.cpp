@@ -0,0 +1,191 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlField>
+#include <QSqlError>
+
+#include "data/ContestDupeIndex.h"
+
+namespace {
+const QString CONTEST_ID = QStringLiteral("CQ-WW-CW");
+const QDateTime DUPE_START(QDate(2024, 11, 23), QTime(0, 0), QTimeZone::utc());
+
+QSqlRecord contactRecord(int id, const QString &callsign, const QString &band, const QString &mode,
+                         const QString &contestID, const QDateTime &startTime)
+{
+    QSqlRecord record;
+    const QStringList names = {"id", "callsign", "band", "mode", "contest_id", "start_time"};
+    const QVariantList values = {id, callsign, band, mode, contestID, startTime};
+
+    for ( int i = 0; i < names.size(); ++i )
+    {
+        QSqlField field(names.at(i));
+        field.setValue(values.at(i));
+        record.append(field);
+    }
+    return record;
+}
+}
+
+class ContestDupeIndexTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void load();
+    void count_data();
+    void count();
+    void addRemoveContact();
+    void updateContact();
+    void isLoadedFor();
+
+private:
+    ContestDupeIndex index;
+};
+
+void ContestDupeIndexTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(":memory:");
+    QVERIFY(db.open());
+
+    QSqlQuery query;
+    QVERIFY2(query.exec("CREATE TABLE modes (id INTEGER PRIMARY KEY, name TEXT UNIQUE NOT NULL, dxcc TEXT NOT NULL)"),
+             qPrintable(query.lastError().text()));
+    QVERIFY2(query.exec("INSERT INTO modes (name, dxcc) VALUES "
+                        "('CW', 'CW'), ('SSB', 'PHONE'), ('FT8', 'DIGITAL'), ('RTTY', 'DIGITAL')"),
+             qPrintable(query.lastError().text()));
+    QVERIFY2(query.exec("CREATE TABLE contacts (id INTEGER PRIMARY KEY, callsign TEXT, band TEXT, mode TEXT,"
+                        "contest_id TEXT, start_time TEXT)"),
+             qPrintable(query.lastError().text()));
+
+    const QList<QSqlRecord> contacts = {
+        contactRecord(1, "OK1ABC", "20m", "CW", CONTEST_ID, DUPE_START.addSecs(3600)),
+        contactRecord(2, "OK1ABC", "40m", "CW", CONTEST_ID, DUPE_START.addSecs(7200)),
+        contactRecord(3, "OK1ABC", "40m", "RTTY", CONTEST_ID, DUPE_START.addSecs(7300)),
+        contactRecord(4, "DL1XYZ", "20m", "SSB", CONTEST_ID, DUPE_START.addSecs(100)),
+        contactRecord(5, "DL1XYZ", "20m", "CW", CONTEST_ID, DUPE_START.addSecs(-100)),  // before the dupe date
+        contactRecord(6, "DL1XYZ", "15m", "CW", "OTHER", DUPE_START.addSecs(100)),       // another contest
+        contactRecord(7, "W1AW", "10m", "OLIVIA", CONTEST_ID, DUPE_START.addSecs(100)),  // mode is not in modes
+    };
+
+    QVERIFY(query.prepare("INSERT INTO contacts (id, callsign, band, mode, contest_id, start_time) "
+                          "VALUES (:id, :callsign, :band, :mode, :contest_id, :start_time)"));
+
+    for ( const QSqlRecord &record : contacts )
+    {
+        for ( int i = 0; i < record.count(); ++i )
+            query.bindValue(":" + record.fieldName(i), record.value(i));
+        QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+    }
+
+    QVERIFY(index.load(CONTEST_ID, DUPE_START));
+}
+
+void ContestDupeIndexTest::cleanupTestCase()
+{
+    index.clear();
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
+}
+
+void ContestDupeIndexTest::load()
+{
+    QVERIFY(index.isLoaded());
+    QCOMPARE(index.modeGroup("RTTY"), QStringLiteral("DIGITAL"));
+    QCOMPARE(index.modeGroup("OLIVIA"), QString());
+}
+
+void ContestDupeIndexTest::count_data()
+{
+    QTest::addColumn<QString>("callsign");
+    QTest::addColumn<QString>("band");
+    QTest::addColumn<QString>("modeGroup");
+    QTest::addColumn<qulonglong>("allBands");
+    QTest::addColumn<qulonglong>("eachBand");
+    QTest::addColumn<qulonglong>("eachBandMode");
+
+    QTest::newRow("multiBand") << "OK1ABC" << "40m" << "CW" << 3ULL << 2ULL << 1ULL;
+    QTest::newRow("digital") << "OK1ABC" << "40m" << "DIGITAL" << 3ULL << 2ULL << 1ULL;
+    QTest::newRow("newBand") << "OK1ABC" << "80m" << "CW" << 3ULL << 0ULL << 0ULL;
+    QTest::newRow("dateAndContestFilter") << "DL1XYZ" << "20m" << "CW" << 1ULL << 1ULL << 0ULL;
+    QTest::newRow("otherContest") << "DL1XYZ" << "15m" << "CW" << 1ULL << 0ULL << 0ULL;
+    QTest::newRow("unknownMode") << "W1AW" << "10m" << "DIGITAL" << 0ULL << 0ULL << 0ULL;
+    QTest::newRow("caseSensitive") << "ok1abc" << "20m" << "CW" << 0ULL << 0ULL << 0ULL;
+}
+
+void ContestDupeIndexTest::count()
+{
+    QFETCH(QString, callsign);
+    QFETCH(QString, band);
+    QFETCH(QString, modeGroup);
+    QFETCH(qulonglong, allBands);
+    QFETCH(qulonglong, eachBand);
+    QFETCH(qulonglong, eachBandMode);
+
+    QCOMPARE(index.count(callsign), allBands);
+    QCOMPARE(index.count(callsign, band), eachBand);
+    QCOMPARE(index.count(callsign, band, modeGroup), eachBandMode);
+}
+
+void ContestDupeIndexTest::addRemoveContact()
+{
+    const QSqlRecord record = contactRecord(100, "SP9ABC", "20m", "FT8", CONTEST_ID, DUPE_START.addSecs(60));
+
+    index.addContact(record);
+    QCOMPARE(index.count("SP9ABC"), 1ULL);
+    QCOMPARE(index.count("SP9ABC", "20m", "DIGITAL"), 1ULL);
+
+    // not a QSO of the active contest
+    index.addContact(contactRecord(101, "SP9ABC", "20m", "FT8", "OTHER", DUPE_START.addSecs(60)));
+    index.addContact(contactRecord(102, "SP9ABC", "20m", "FT8", CONTEST_ID, DUPE_START.addSecs(-60)));
+    QCOMPARE(index.count("SP9ABC"), 1ULL);
+
+    index.removeContact(record);
+    QCOMPARE(index.count("SP9ABC"), 0ULL);
+    QCOMPARE(index.count("SP9ABC", "20m", "DIGITAL"), 0ULL);
+
+    // removing an unknown QSO does not underflow
+    index.removeContact(record);
+    QCOMPARE(index.count("SP9ABC"), 0ULL);
+}
+
+void ContestDupeIndexTest::updateContact()
+{
+    const QSqlRecord oldRecord = contactRecord(4, "DL1XYZ", "20m", "SSB", CONTEST_ID, DUPE_START.addSecs(100));
+    const QSqlRecord newRecord = contactRecord(4, "DL1XYZ", "15m", "SSB", CONTEST_ID, DUPE_START.addSecs(100));
+
+    index.updateContact(oldRecord, newRecord);
+    QCOMPARE(index.count("DL1XYZ"), 1ULL);
+    QCOMPARE(index.count("DL1XYZ", "20m"), 0ULL);
+    QCOMPARE(index.count("DL1XYZ", "15m", "PHONE"), 1ULL);
+
+    index.updateContact(newRecord, oldRecord);
+    QCOMPARE(index.count("DL1XYZ", "20m", "PHONE"), 1ULL);
+    QCOMPARE(index.count("DL1XYZ", "15m"), 0ULL);
+}
+
+void ContestDupeIndexTest::isLoadedFor()
+{
+    QVERIFY(index.isLoadedFor(CONTEST_ID, DUPE_START));
+    QVERIFY(!index.isLoadedFor("OTHER", DUPE_START));
+    QVERIFY(!index.isLoadedFor(CONTEST_ID, DUPE_START.addDays(1)));
+
+    ContestDupeIndex other;
+    QVERIFY(other.load("OTHER", DUPE_START));
+    QCOMPARE(other.count("DL1XYZ", "15m", "CW"), 1ULL);
+    QCOMPARE(other.count("OK1ABC"), 0ULL);
+}
+
+QTEST_APPLESS_MAIN(ContestDupeIndexTest)
+
+#include "tst_contestdupeindex.moc"
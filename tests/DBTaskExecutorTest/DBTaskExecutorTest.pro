@@ -0,0 +1,18 @@
+QT += testlib core sql
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_dbtaskexecutor
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_dbtaskexecutor.cpp \
+    test_stubs.cpp \
+    ../../core/DBTaskExecutor.cpp
+
+HEADERS += \
+    ../../core/DBTaskExecutor.h \
+    ../../core/LogDatabase.h
+
+unix: LIBS += -lsqlite3
+win32: LIBS += -lsqlite3
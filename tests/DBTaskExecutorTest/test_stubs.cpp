@@ -0,0 +1,32 @@
+// Stubs for the application parts used by DBTaskExecutor
+// The read-only connections open the database file created by the test
+
+#include <QThread>
+#include <QSqlDatabase>
+#include "core/LogDatabase.h"
+
+QString testDatabaseFile;
+
+LogDatabase::LogDatabase()
+{
+}
+
+QString LogDatabase::dbFilename()
+{
+    return testDatabaseFile;
+}
+
+QSqlDatabase LogDatabase::readOnlyConnection()
+{
+    const QString connectionName = QString("readonly_%1")
+                                   .arg(reinterpret_cast<quintptr>(QThread::currentThread()));
+
+    if ( QSqlDatabase::contains(connectionName) )
+        return QSqlDatabase::database(connectionName);
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    db.setDatabaseName(dbFilename());
+    db.setConnectOptions("QSQLITE_OPEN_READONLY");
+    db.open();
+    return db;
+}
@@ -0,0 +1,218 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+
+#include "core/DBTaskExecutor.h"
+
+extern QString testDatabaseFile;
+
+// a statement running for minutes unless it is interrupted
+static const QString SLOW_STATEMENT = QStringLiteral("WITH RECURSIVE cnt(x) AS "
+                                                     "(SELECT 1 UNION ALL SELECT x + 1 FROM cnt WHERE x < 1000000000) "
+                                                     "SELECT COUNT(*) FROM cnt");
+
+class DBTaskExecutorTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void submit_bindValues_returnsRows();
+    void submit_invalidStatement_returnsError();
+    void submit_differentKeys_bothFinish();
+    void submit_sameKey_cancelsOlder();
+    void cancel_runningStatement_isInterrupted();
+    void submitCallback_calledInContextThread();
+    void stop_cancelsRequests();
+
+private:
+    QTemporaryDir *tempDir = nullptr;
+
+    const int ROW_COUNT = 1000;
+};
+
+void DBTaskExecutorTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    tempDir = new QTemporaryDir();
+    QVERIFY(tempDir->isValid());
+
+    testDatabaseFile = tempDir->filePath("qlog.db");
+
+    // the writer - the executor reads over its own connections
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(testDatabaseFile);
+    QVERIFY(db.open());
+
+    QSqlQuery query;
+    QVERIFY(query.exec("PRAGMA journal_mode = WAL"));
+    QVERIFY(query.exec("CREATE TABLE contacts (id INTEGER PRIMARY KEY, callsign TEXT, band TEXT)"));
+
+    QVERIFY(db.transaction());
+    QVERIFY(query.prepare("INSERT INTO contacts (callsign, band) VALUES (?, ?)"));
+
+    for ( int i = 0; i < ROW_COUNT; i++ )
+    {
+        query.addBindValue(QString("OK%1AA").arg(i));
+        query.addBindValue(( i % 2 ) ? "20m" : "40m");
+        QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+    }
+
+    QVERIFY(db.commit());
+}
+
+void DBTaskExecutorTest::cleanupTestCase()
+{
+    DBTaskExecutor::instance()->stop();
+
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
+
+    delete tempDir;
+    tempDir = nullptr;
+}
+
+void DBTaskExecutorTest::submit_bindValues_returnsRows()
+{
+    QFuture<DBQueryResult> future = DBTaskExecutor::instance()->submit("rows",
+                                                                       "SELECT band, COUNT(1) AS cnt FROM contacts "
+                                                                       "WHERE id > ? GROUP BY band ORDER BY band",
+                                                                       QVariantList() << ROW_COUNT / 2);
+    future.waitForFinished();
+
+    QVERIFY(!future.isCanceled());
+
+    const DBQueryResult result = future.result();
+    QVERIFY2(result.ok, qPrintable(result.error));
+    QCOMPARE(result.columns, QStringList() << "band" << "cnt");
+    QCOMPARE(result.rows.size(), 2);
+    QCOMPARE(result.rows.at(0).at(0).toString(), QString("20m"));
+    QCOMPARE(result.rows.at(0).at(1).toInt(), ROW_COUNT / 4);
+    QCOMPARE(result.rows.at(1).at(0).toString(), QString("40m"));
+    QCOMPARE(result.rows.at(1).at(1).toInt(), ROW_COUNT / 4);
+}
+
+void DBTaskExecutorTest::submit_invalidStatement_returnsError()
+{
+    QFuture<DBQueryResult> future = DBTaskExecutor::instance()->submit("error", "SELECT * FROM nonexistent");
+    future.waitForFinished();
+
+    QVERIFY(!future.isCanceled());
+    QVERIFY(!future.result().ok);
+    QVERIFY(!future.result().error.isEmpty());
+}
+
+void DBTaskExecutorTest::submit_differentKeys_bothFinish()
+{
+    QFuture<DBQueryResult> first = DBTaskExecutor::instance()->submit("first", "SELECT COUNT(1) FROM contacts");
+    QFuture<DBQueryResult> second = DBTaskExecutor::instance()->submit("second", "SELECT MAX(id) FROM contacts");
+
+    first.waitForFinished();
+    second.waitForFinished();
+
+    QVERIFY(!first.isCanceled());
+    QVERIFY(!second.isCanceled());
+    QCOMPARE(first.result().rows.at(0).at(0).toInt(), ROW_COUNT);
+    QCOMPARE(second.result().rows.at(0).at(0).toInt(), ROW_COUNT);
+}
+
+void DBTaskExecutorTest::submit_sameKey_cancelsOlder()
+{
+    QFuture<DBQueryResult> older = DBTaskExecutor::instance()->submit("widget", SLOW_STATEMENT);
+    QFuture<DBQueryResult> newer = DBTaskExecutor::instance()->submit("widget", "SELECT COUNT(1) FROM contacts");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    older.waitForFinished();
+    newer.waitForFinished();
+
+    QVERIFY(timer.elapsed() < 10000);
+    QVERIFY(older.isCanceled());
+    QVERIFY(!newer.isCanceled());
+    QVERIFY(newer.result().ok);
+    QCOMPARE(newer.result().rows.at(0).at(0).toInt(), ROW_COUNT);
+}
+
+void DBTaskExecutorTest::cancel_runningStatement_isInterrupted()
+{
+    QFuture<DBQueryResult> future = DBTaskExecutor::instance()->submit("slow", SLOW_STATEMENT);
+
+    // the statement is running now
+    QThread::msleep(200);
+    QVERIFY(!future.isFinished());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    DBTaskExecutor::instance()->cancel("slow");
+    future.waitForFinished();
+
+    QVERIFY(timer.elapsed() < 10000);
+    QVERIFY(future.isCanceled());
+
+    // the connection of the interrupted worker is usable again
+    QFuture<DBQueryResult> next = DBTaskExecutor::instance()->submit("slow", "SELECT COUNT(1) FROM contacts");
+    next.waitForFinished();
+    QVERIFY(next.result().ok);
+    QCOMPARE(next.result().rows.at(0).at(0).toInt(), ROW_COUNT);
+}
+
+void DBTaskExecutorTest::submitCallback_calledInContextThread()
+{
+    QObject context;
+    int callbackCount = 0;
+    int count = -1;
+    bool mainThread = false;
+
+    DBTaskExecutor::instance()->submit("callback", SLOW_STATEMENT, QVariantList(),
+                                       &context, [&callbackCount](const DBQueryResult &)
+    {
+        callbackCount++;
+    });
+
+    DBTaskExecutor::instance()->submit("callback", "SELECT COUNT(1) FROM contacts", QVariantList(),
+                                       &context, [&callbackCount, &count, &mainThread](const DBQueryResult &result)
+    {
+        callbackCount++;
+        count = result.rows.value(0).value(0).toInt();
+        mainThread = ( QThread::currentThread() == QCoreApplication::instance()->thread() );
+    });
+
+    QTRY_COMPARE(count, ROW_COUNT);
+
+    // the canceled request does not call its callback
+    QTest::qWait(100);
+    QCOMPARE(callbackCount, 1);
+    QVERIFY(mainThread);
+}
+
+void DBTaskExecutorTest::stop_cancelsRequests()
+{
+    QFuture<DBQueryResult> running = DBTaskExecutor::instance()->submit("stop", SLOW_STATEMENT);
+
+    QThread::msleep(100);
+
+    DBTaskExecutor::instance()->stop();
+
+    QVERIFY(running.isFinished());
+    QVERIFY(running.isCanceled());
+
+    // a stopped executor cancels new requests immediately
+    QFuture<DBQueryResult> late = DBTaskExecutor::instance()->submit("stop", "SELECT 1");
+    QVERIFY(late.isFinished());
+    QVERIFY(late.isCanceled());
+}
+
+QTEST_GUILESS_MAIN(DBTaskExecutorTest)
+
+#include "tst_dbtaskexecutor.moc"
@@ -0,0 +1,13 @@
+QT += testlib core sql
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_dxcccreditindex
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_dxcccreditindex.cpp \
+    ../../data/DXCCCreditIndex.cpp
+
+HEADERS += \
+    ../../data/DXCCCreditIndex.h
@@ -0,0 +1,279 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+
+#include "data/DXCCCreditIndex.h"
+
+Q_DECLARE_METATYPE(DXCCCreditIndex::CallMatch)
+
+namespace {
+const QDateTime BASE_TIME(QDate(2024, 5, 1), QTime(12, 0), QTimeZone::utc());
+}
+
+class DXCCCreditIndexTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void load();
+    void select_data();
+    void select();
+    void setCreditGranted();
+
+private:
+    static QList<qulonglong> referenceMatches(const DXCCCreditIndex::Credit &credit,
+                                              DXCCCreditIndex::CallMatch callMatch,
+                                              bool matchMode);
+    QList<qulonglong> indexMatches(const DXCCCreditIndex::Credit &credit,
+                                   DXCCCreditIndex::CallMatch callMatch,
+                                   bool matchMode) const;
+    DXCCCreditIndex index;
+};
+
+void DXCCCreditIndexTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(":memory:");
+    QVERIFY(db.open());
+
+    QSqlQuery query;
+    QVERIFY2(query.exec("CREATE TABLE modes (name TEXT, dxcc TEXT)"),
+             qPrintable(query.lastError().text()));
+    QVERIFY2(query.exec("INSERT INTO modes VALUES ('CW', 'CW'), ('SSB', 'PHONE'), ('FT8', 'DIGITAL'), ('RTTY', 'DIGITAL')"),
+             qPrintable(query.lastError().text()));
+    QVERIFY2(query.exec("CREATE TABLE contacts (id INTEGER PRIMARY KEY, callsign TEXT, band TEXT, mode TEXT,"
+                        "start_time TEXT, prop_mode TEXT, credit_granted TEXT, dxcc INTEGER, my_dxcc INTEGER)"),
+             qPrintable(query.lastError().text()));
+
+    QVERIFY(query.prepare("INSERT INTO contacts (id, callsign, band, mode, start_time, prop_mode, credit_granted, dxcc, my_dxcc) "
+                          "VALUES (:id, :callsign, :band, :mode, :start_time, :prop_mode, :credit_granted, :dxcc, :my_dxcc)"));
+
+    const struct {
+        int id;
+        const char *callsign;
+        const char *band;
+        const char *mode;
+        int offsetHours;
+        const char *propMode;
+        int dxcc;
+        int myDxcc;
+    } contacts[] = {
+        {1, "W1AW", "20m", "CW", 0, nullptr, 291, 503},
+        {2, "W1AW", "20M", "FT8", 1, nullptr, 291, 503},
+        {3, "W1AW/4", "40m", "SSB", 20, "", 291, 503},
+        {4, "K1ABC", "20m", "RTTY", -30, nullptr, 291, 0},
+        {5, "K1ABC", "2m", "FT8", 2, "SAT", 291, 503},
+        {6, "OK1ABC", "20m", "CW", 49, nullptr, 503, 291},
+        {7, "ok1abc", "20m", "CW", 3, nullptr, 0, 503},
+        {8, "JA1XYZ", "15m", "SSB", -47, nullptr, 339, 503},
+    };
+
+    for ( const auto &contact : contacts )
+    {
+        query.bindValue(":id", contact.id);
+        query.bindValue(":callsign", contact.callsign);
+        query.bindValue(":band", contact.band);
+        query.bindValue(":mode", contact.mode);
+        query.bindValue(":start_time", BASE_TIME.addSecs(contact.offsetHours * 3600));
+        query.bindValue(":prop_mode", ( contact.propMode ) ? QVariant(contact.propMode) : QVariant());
+        query.bindValue(":credit_granted", "DXCC");
+        query.bindValue(":dxcc", ( contact.dxcc ) ? QVariant(contact.dxcc) : QVariant());
+        query.bindValue(":my_dxcc", ( contact.myDxcc ) ? QVariant(contact.myDxcc) : QVariant());
+        QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+    }
+
+    QVERIFY(index.load());
+}
+
+void DXCCCreditIndexTest::cleanupTestCase()
+{
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
+}
+
+QList<qulonglong> DXCCCreditIndexTest::referenceMatches(const DXCCCreditIndex::Credit &credit,
+                                                        DXCCCreditIndex::CallMatch callMatch,
+                                                        bool matchMode)
+{
+    // the former credit import statement
+    QStringList where = {"ABS(JULIANDAY(date(start_time)) - JULIANDAY(date(:qso_date))) <= 1"};
+
+    if ( !credit.band.isEmpty() )
+        where << "upper(band) = upper(:band)";
+
+    if ( !credit.propMode.isEmpty() )
+        where << "upper(prop_mode) = upper(:prop_mode)";
+    else
+        where << "(prop_mode IS NULL OR upper(prop_mode) <> 'SAT')";
+
+    if ( !credit.dxcc.isEmpty() )
+        where << "dxcc = :dxcc";
+
+    if ( !credit.awardEntity.isEmpty() )
+        where << "my_dxcc = :award_entity";
+
+    if ( callMatch == DXCCCreditIndex::EXACT_CALL_MATCH )
+        where << "callsign = upper(:call)";
+    else if ( callMatch == DXCCCreditIndex::PREFIX_CALL_MATCH )
+        where << "upper(callsign) LIKE upper(:call_prefix) ESCAPE '\\'";
+
+    if ( matchMode )
+    {
+        if ( !credit.dxccModeGroup.isEmpty() )
+        {
+            QString modeCondition = "(SELECT dxcc FROM modes WHERE upper(name) = upper(contacts.mode) LIMIT 1) = :dxcc_mode_group";
+            if ( !credit.mode.isEmpty() )
+                modeCondition = "(" + modeCondition + " OR upper(mode) = upper(:mode))";
+            where << modeCondition;
+        }
+        else if ( !credit.mode.isEmpty() )
+            where << "upper(mode) = upper(:mode)";
+    }
+
+    QSqlQuery query;
+    query.prepare(QString("SELECT id FROM contacts WHERE %1 ORDER BY start_time, id").arg(where.join(" AND ")));
+    query.bindValue(":qso_date", credit.qsoDate.toString(Qt::ISODate));
+
+    if ( !credit.band.isEmpty() ) query.bindValue(":band", credit.band);
+    if ( !credit.propMode.isEmpty() ) query.bindValue(":prop_mode", credit.propMode);
+    if ( !credit.dxcc.isEmpty() ) query.bindValue(":dxcc", credit.dxcc);
+    if ( !credit.awardEntity.isEmpty() ) query.bindValue(":award_entity", credit.awardEntity);
+
+    if ( callMatch == DXCCCreditIndex::EXACT_CALL_MATCH )
+        query.bindValue(":call", credit.call);
+    else if ( callMatch == DXCCCreditIndex::PREFIX_CALL_MATCH )
+        query.bindValue(":call_prefix", credit.call + "%");
+
+    if ( matchMode )
+    {
+        if ( !credit.dxccModeGroup.isEmpty() ) query.bindValue(":dxcc_mode_group", credit.dxccModeGroup);
+        if ( !credit.mode.isEmpty() ) query.bindValue(":mode", credit.mode);
+    }
+
+    QList<qulonglong> ret;
+
+    if ( !query.exec() )
+    {
+        qWarning() << query.lastError();
+        return ret;
+    }
+
+    while ( query.next() )
+        ret << query.value(0).toULongLong();
+
+    return ret;
+}
+
+QList<qulonglong> DXCCCreditIndexTest::indexMatches(const DXCCCreditIndex::Credit &credit,
+                                                    DXCCCreditIndex::CallMatch callMatch,
+                                                    bool matchMode) const
+{
+    QList<qulonglong> ret;
+    const QList<int> positions = index.select(credit, callMatch, matchMode);
+
+    for ( int pos : positions )
+        ret << index.contact(pos).id;
+
+    return ret;
+}
+
+void DXCCCreditIndexTest::load()
+{
+    QVERIFY(index.isLoaded());
+    QCOMPARE(index.size(), 8);
+}
+
+void DXCCCreditIndexTest::select_data()
+{
+    QTest::addColumn<QString>("call");
+    QTest::addColumn<QString>("band");
+    QTest::addColumn<QString>("propMode");
+    QTest::addColumn<QString>("dxcc");
+    QTest::addColumn<QString>("awardEntity");
+    QTest::addColumn<QString>("mode");
+    QTest::addColumn<QString>("modeGroup");
+    QTest::addColumn<int>("offsetDays");
+    QTest::addColumn<DXCCCreditIndex::CallMatch>("callMatch");
+    QTest::addColumn<bool>("matchMode");
+
+    QTest::newRow("exact call") << "W1AW" << "20m" << "" << "291" << "" << "" << "" << 0 << DXCCCreditIndex::EXACT_CALL_MATCH << false;
+    QTest::newRow("exact call lowercase") << "w1aw" << "20M" << "" << "291" << "" << "" << "" << 0 << DXCCCreditIndex::EXACT_CALL_MATCH << false;
+    QTest::newRow("exact call mode") << "W1AW" << "20m" << "" << "291" << "" << "CW" << "" << 0 << DXCCCreditIndex::EXACT_CALL_MATCH << true;
+    QTest::newRow("exact call mode group") << "W1AW" << "20m" << "" << "291" << "" << "" << "DIGITAL" << 0 << DXCCCreditIndex::EXACT_CALL_MATCH << true;
+    QTest::newRow("mode or mode group") << "W1AW" << "20m" << "" << "291" << "" << "CW" << "DIGITAL" << 0 << DXCCCreditIndex::EXACT_CALL_MATCH << true;
+    QTest::newRow("exact call no dxcc") << "W1AW" << "20m" << "" << "" << "" << "" << "" << 0 << DXCCCreditIndex::EXACT_CALL_MATCH << false;
+    QTest::newRow("stored lowercase call") << "OK1ABC" << "20m" << "" << "" << "" << "" << "" << 0 << DXCCCreditIndex::EXACT_CALL_MATCH << false;
+    QTest::newRow("prefix call") << "W1AW" << "40m" << "" << "291" << "" << "" << "" << 1 << DXCCCreditIndex::PREFIX_CALL_MATCH << false;
+    QTest::newRow("prefix call no dxcc") << "ok1" << "20m" << "" << "" << "" << "" << "" << 1 << DXCCCreditIndex::PREFIX_CALL_MATCH << false;
+    QTest::newRow("day before") << "" << "20m" << "" << "291" << "" << "" << "" << -1 << DXCCCreditIndex::NO_CALL_MATCH << false;
+    QTest::newRow("day after") << "" << "20m" << "" << "503" << "" << "" << "" << 1 << DXCCCreditIndex::NO_CALL_MATCH << false;
+    QTest::newRow("two days after") << "" << "20m" << "" << "291" << "" << "" << "" << 2 << DXCCCreditIndex::NO_CALL_MATCH << false;
+    QTest::newRow("two days before") << "" << "15m" << "" << "339" << "" << "" << "" << -2 << DXCCCreditIndex::NO_CALL_MATCH << false;
+    QTest::newRow("dxcc without band") << "" << "" << "" << "291" << "" << "" << "" << 0 << DXCCCreditIndex::NO_CALL_MATCH << false;
+    QTest::newRow("satellite excluded") << "" << "2m" << "" << "291" << "" << "" << "" << 0 << DXCCCreditIndex::NO_CALL_MATCH << false;
+    QTest::newRow("satellite credit") << "" << "2m" << "sat" << "291" << "" << "" << "" << 0 << DXCCCreditIndex::NO_CALL_MATCH << false;
+    QTest::newRow("award entity") << "" << "20m" << "" << "291" << "503" << "" << "" << 0 << DXCCCreditIndex::NO_CALL_MATCH << false;
+    QTest::newRow("other award entity") << "" << "20m" << "" << "291" << "291" << "" << "" << 0 << DXCCCreditIndex::NO_CALL_MATCH << false;
+    QTest::newRow("unknown dxcc") << "" << "20m" << "" << "1" << "" << "" << "" << 0 << DXCCCreditIndex::NO_CALL_MATCH << false;
+    QTest::newRow("mode without match") << "K1ABC" << "20m" << "" << "291" << "" << "SSB" << "PHONE" << -1 << DXCCCreditIndex::EXACT_CALL_MATCH << true;
+}
+
+void DXCCCreditIndexTest::select()
+{
+    QFETCH(QString, call);
+    QFETCH(QString, band);
+    QFETCH(QString, propMode);
+    QFETCH(QString, dxcc);
+    QFETCH(QString, awardEntity);
+    QFETCH(QString, mode);
+    QFETCH(QString, modeGroup);
+    QFETCH(int, offsetDays);
+    QFETCH(DXCCCreditIndex::CallMatch, callMatch);
+    QFETCH(bool, matchMode);
+
+    DXCCCreditIndex::Credit credit;
+    credit.qsoDate = BASE_TIME.date().addDays(offsetDays);
+    credit.call = call;
+    credit.band = band;
+    credit.propMode = propMode;
+    credit.dxcc = dxcc;
+    credit.awardEntity = awardEntity;
+    credit.mode = mode;
+    credit.dxccModeGroup = modeGroup;
+
+    QCOMPARE(indexMatches(credit, callMatch, matchMode),
+             referenceMatches(credit, callMatch, matchMode));
+}
+
+void DXCCCreditIndexTest::setCreditGranted()
+{
+    DXCCCreditIndex::Credit credit;
+    credit.qsoDate = BASE_TIME.date();
+    credit.call = "W1AW";
+    credit.band = "20m";
+    credit.dxcc = "291";
+
+    const QList<int> positions = index.select(credit, DXCCCreditIndex::EXACT_CALL_MATCH, false);
+    QCOMPARE(positions.size(), 2);
+
+    index.setCreditGranted(positions.first(), "DXCC,DXCC_BAND");
+    QCOMPARE(index.contact(positions.first()).creditGranted, QString("DXCC,DXCC_BAND"));
+    QCOMPARE(index.contact(positions.last()).creditGranted, QString("DXCC"));
+
+    index.clear();
+    QVERIFY(!index.isLoaded());
+    QVERIFY(index.select(credit, DXCCCreditIndex::EXACT_CALL_MATCH, false).isEmpty());
+}
+
+QTEST_APPLESS_MAIN(DXCCCreditIndexTest)
+
+#include "tst_dxcccreditindex.moc"
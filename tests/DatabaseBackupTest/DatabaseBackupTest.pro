@@ -0,0 +1,28 @@
+QT += testlib core sql widgets
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_databasebackup
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_databasebackup.cpp \
+    test_stubs.cpp \
+    ../../core/DatabaseBackup.cpp \
+    ../../core/FileCompressor.cpp
+
+HEADERS += \
+    ../../core/DatabaseBackup.h \
+    ../../core/FileCompressor.h \
+    ../../core/OrderedWorkQueue.h
+
+# zlib
+!isEmpty(ZLIBINCLUDEPATH) {
+    INCLUDEPATH += $$ZLIBINCLUDEPATH
+}
+!isEmpty(ZLIBLIBPATH) {
+    LIBS += -L$$ZLIBLIBPATH
+}
+
+unix: LIBS += -lsqlite3 -lz
+win32: LIBS += -lsqlite3 -lzlib
@@ -0,0 +1,42 @@
+// Stubs for the application parts used by DatabaseBackup
+// The tests call only the static backup functions
+
+#include <QDir>
+#include "core/LogDatabase.h"
+#include "core/LogParam.h"
+#include "core/Migration.h"
+
+QDir LogDatabase::dbDirectory()
+{
+    return QDir::temp();
+}
+
+QString LogDatabase::dbFilename()
+{
+    return dbDirectory().filePath("qlog.db");
+}
+
+bool LogParam::setLastBackupDate(const QDate)
+{
+    return true;
+}
+
+QDate LogParam::getLastBackupDate()
+{
+    return QDate();
+}
+
+QString LogParam::getBackupFormat()
+{
+    return QStringLiteral("database");
+}
+
+bool LogParam::getBackupCompressed()
+{
+    return true;
+}
+
+bool DBSchemaMigration::backupAllQSOsToADX(bool)
+{
+    return true;
+}
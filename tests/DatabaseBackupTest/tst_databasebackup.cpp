@@ -0,0 +1,304 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+
+#include "core/DatabaseBackup.h"
+#include "core/FileCompressor.h"
+
+class DatabaseBackupTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void backupDatabase_uncompressed_copiesAllRows();
+    void backupDatabase_compressed_copiesAllRows();
+    void backupDatabase_writerDuringBackup_copiesSnapshot();
+    void backupDatabase_abort_keepsPreviousBackup();
+    void backupDatabase_missingSource_returnsFalse();
+    void removeOldBackups_keepsNewest();
+    void backupFileName_containsDate();
+
+private:
+    static qlonglong countRows(const QString &fileName);
+    static QString integrityCheck(const QString &fileName);
+
+    QTemporaryDir *tempDir = nullptr;
+    QString sourceFile;
+
+    const int ROW_COUNT = 20000;
+};
+
+void DatabaseBackupTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    tempDir = new QTemporaryDir();
+    QVERIFY(tempDir->isValid());
+
+    sourceFile = tempDir->filePath("qlog.db");
+
+    // the main connection of the test - the same setup as the application uses
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(sourceFile);
+    QVERIFY(db.open());
+
+    QSqlQuery query;
+    QVERIFY(query.exec("PRAGMA journal_mode = WAL"));
+    QVERIFY(query.exec("CREATE TABLE contacts (id INTEGER PRIMARY KEY, callsign TEXT, comment TEXT)"));
+
+    QVERIFY(db.transaction());
+    QVERIFY(query.prepare("INSERT INTO contacts (callsign, comment) VALUES (?, ?)"));
+
+    for ( int i = 0; i < ROW_COUNT; i++ )
+    {
+        query.addBindValue(QString("OK%1AA").arg(i));
+        query.addBindValue(QString("comment %1 ").arg(i).repeated(5));
+        QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+    }
+
+    QVERIFY(db.commit());
+}
+
+void DatabaseBackupTest::cleanupTestCase()
+{
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
+
+    delete tempDir;
+    tempDir = nullptr;
+}
+
+qlonglong DatabaseBackupTest::countRows(const QString &fileName)
+{
+    qlonglong count = -1;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "backup_check");
+        db.setDatabaseName(fileName);
+        db.setConnectOptions("QSQLITE_OPEN_READONLY");
+
+        if ( db.open() )
+        {
+            QSqlQuery query(db);
+            if ( query.exec("SELECT COUNT(*) FROM contacts") && query.first() )
+                count = query.value(0).toLongLong();
+        }
+    }
+    QSqlDatabase::removeDatabase("backup_check");
+    return count;
+}
+
+QString DatabaseBackupTest::integrityCheck(const QString &fileName)
+{
+    QString result;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "backup_integrity");
+        db.setDatabaseName(fileName);
+
+        if ( db.open() )
+        {
+            QSqlQuery query(db);
+            if ( query.exec("PRAGMA integrity_check") && query.first() )
+                result = query.value(0).toString();
+        }
+    }
+    QSqlDatabase::removeDatabase("backup_integrity");
+    return result;
+}
+
+void DatabaseBackupTest::backupDatabase_uncompressed_copiesAllRows()
+{
+    const QString destFile = tempDir->filePath("qlog_backup_20240101.db");
+
+    // small slices - the backup runs in many steps
+    QVERIFY(DatabaseBackup::backupDatabase(sourceFile, destFile, false, 16));
+
+    QVERIFY(QFile::exists(destFile));
+    QVERIFY(!QFile::exists(destFile + ".part"));
+    QCOMPARE(integrityCheck(destFile), QString("ok"));
+    QCOMPARE(countRows(destFile), static_cast<qlonglong>(ROW_COUNT));
+}
+
+void DatabaseBackupTest::backupDatabase_compressed_copiesAllRows()
+{
+    const QString destFile = tempDir->filePath("qlog_backup_20240102.db.gz");
+    const QString decompressedFile = tempDir->filePath("decompressed.db");
+
+    QVERIFY(DatabaseBackup::backupDatabase(sourceFile, destFile, true));
+
+    QVERIFY(QFile::exists(destFile));
+    QVERIFY(!QFile::exists(destFile + ".part"));
+    QVERIFY(!QFile::exists(destFile + ".tmp"));
+    QVERIFY(GzipReadDevice::isGzipFile(destFile));
+    QVERIFY(QFileInfo(destFile).size() < QFileInfo(sourceFile).size());
+
+    QVERIFY(FileCompressor::gunzipFile(destFile, decompressedFile));
+    QCOMPARE(integrityCheck(decompressedFile), QString("ok"));
+    QCOMPARE(countRows(decompressedFile), static_cast<qlonglong>(ROW_COUNT));
+}
+
+void DatabaseBackupTest::backupDatabase_writerDuringBackup_copiesSnapshot()
+{
+    const QString destFile = tempDir->filePath("qlog_backup_20240103.db");
+
+    QAtomicInt writerStarted(0);
+    QAtomicInt writerStop(0);
+    int inserted = 0;
+
+    // the writer uses its own connection as the application does with the main one
+    QThread *writerThread = QThread::create([this, &writerStarted, &writerStop, &inserted]()
+    {
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "backup_writer");
+            db.setDatabaseName(sourceFile);
+
+            if ( db.open() )
+            {
+                QSqlQuery query(db);
+                query.exec("PRAGMA busy_timeout = 5000");
+                writerStarted.storeRelease(1);
+
+                while ( !writerStop.loadAcquire() )
+                {
+                    if ( query.exec("INSERT INTO contacts (callsign, comment) VALUES ('OK1WR', 'writer')") )
+                        inserted++;
+                    QThread::msleep(1);
+                }
+            }
+            writerStarted.storeRelease(1);
+        }
+        QSqlDatabase::removeDatabase("backup_writer");
+    });
+
+    writerThread->start();
+
+    while ( !writerStarted.loadAcquire() )
+        QThread::msleep(1);
+
+    const bool result = DatabaseBackup::backupDatabase(sourceFile, destFile, false, 4);
+
+    writerStop.storeRelease(1);
+    writerThread->wait();
+    delete writerThread;
+
+    QVERIFY(result);
+    QVERIFY(inserted > 0);
+    QCOMPARE(integrityCheck(destFile), QString("ok"));
+
+    // the backup is one consistent snapshot between the original rows and all written rows
+    const qlonglong count = countRows(destFile);
+    QVERIFY(count >= ROW_COUNT);
+    QVERIFY(count <= countRows(sourceFile));
+
+    QSqlQuery query;
+    QVERIFY(query.exec("DELETE FROM contacts WHERE callsign = 'OK1WR'"));
+}
+
+void DatabaseBackupTest::backupDatabase_abort_keepsPreviousBackup()
+{
+    const QString destFile = tempDir->filePath("qlog_backup_20240104.db");
+
+    QVERIFY(DatabaseBackup::backupDatabase(sourceFile, destFile, false));
+    const QByteArray previousBackup = [&destFile]()
+    {
+        QFile file(destFile);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }();
+    QVERIFY(!previousBackup.isEmpty());
+
+    QAtomicInt abort(1);
+
+    QVERIFY(!DatabaseBackup::backupDatabase(sourceFile, destFile, false, 1, &abort));
+    QVERIFY(!DatabaseBackup::backupDatabase(sourceFile, destFile, true, 1, &abort));
+
+    QVERIFY(!QFile::exists(destFile + ".part"));
+    QVERIFY(!QFile::exists(destFile + ".tmp"));
+
+    QFile file(destFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), previousBackup);
+}
+
+void DatabaseBackupTest::backupDatabase_missingSource_returnsFalse()
+{
+    const QString destFile = tempDir->filePath("qlog_backup_20240105.db");
+
+    QVERIFY(!DatabaseBackup::backupDatabase(tempDir->filePath("nonexistent.db"), destFile, false));
+    QVERIFY(!QFile::exists(destFile));
+    QVERIFY(!QFile::exists(destFile + ".part"));
+}
+
+void DatabaseBackupTest::removeOldBackups_keepsNewest()
+{
+    QTemporaryDir backupDir;
+    QVERIFY(backupDir.isValid());
+
+    const QStringList backups = {
+        "qlog_backup_20230101120000.adx",
+        "qlog_backup_20230201.adx",
+        "qlog_backup_20230301.adx",
+        "qlog_backup_20240101.db.gz",
+        "qlog_backup_20240108.db.gz",
+        "qlog_backup_20240115.db",
+        "qlog_backup_20240122.db.gz",
+        "qlog_backup_20240129.db.gz",
+        "qlog_backup_20240205.db.gz"
+    };
+    const QStringList premigration = {
+        "qlog_backup_20230115_premigration_v30.db.gz",
+        "qlog_backup_20230615_premigration_v33.db",
+        "qlog_backup_20240110_premigration_v38.db.gz",
+        "qlog_backup_20240205_premigration_v41.db.gz"
+    };
+    const QStringList others = {
+        "qlog.db",
+        "qlog_backup_notes.txt",
+        "qlog_backup_2024.db.gz"
+    };
+    const QStringList unfinished = {
+        "qlog_backup_20240212.db.gz.part",
+        "qlog_backup_20240212.db.gz.tmp",
+        "qlog_backup_20240212_premigration_v42.db.gz.part"
+    };
+
+    for ( const QString &name : backups + premigration + others + unfinished )
+    {
+        QFile file(backupDir.filePath(name));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("x");
+    }
+
+    DatabaseBackup::removeOldBackups(QDir(backupDir.path()), 5);
+
+    for ( int i = 0; i < backups.size(); i++ )
+        QCOMPARE(QFile::exists(backupDir.filePath(backups.at(i))), i >= backups.size() - 5);
+
+    // the pre-migration backups do not count into the periodic ones
+    for ( int i = 0; i < premigration.size(); i++ )
+        QCOMPARE(QFile::exists(backupDir.filePath(premigration.at(i))),
+                 i >= premigration.size() - DatabaseBackup::PREMIGRATION_BACKUP_COUNT);
+
+    for ( const QString &name : others )
+        QVERIFY(QFile::exists(backupDir.filePath(name)));
+
+    for ( const QString &name : unfinished )
+        QVERIFY(!QFile::exists(backupDir.filePath(name)));
+}
+
+void DatabaseBackupTest::backupFileName_containsDate()
+{
+    QCOMPARE(DatabaseBackup::backupFileName(QDate(2024, 3, 9), true), QString("qlog_backup_20240309.db.gz"));
+    QCOMPARE(DatabaseBackup::backupFileName(QDate(2024, 3, 9), false), QString("qlog_backup_20240309.db"));
+    QCOMPARE(DatabaseBackup::backupFileName(QDate(2024, 3, 9), true, 40), QString("qlog_backup_20240309_premigration_v40.db.gz"));
+}
+
+QTEST_APPLESS_MAIN(DatabaseBackupTest)
+
+#include "tst_databasebackup.moc"
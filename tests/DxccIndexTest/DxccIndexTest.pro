@@ -0,0 +1,22 @@
+QT += testlib core sql
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_dxccindex
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_dxccindex.cpp \
+    ../../data/Callsign.cpp \
+    ../../data/DxccAD1CIndex.cpp \
+    ../../data/DxccClublogIndex.cpp \
+    ../../data/DxccPrefixTrie.cpp \
+    ../../data/DxccSnapshot.cpp
+
+HEADERS += \
+    ../../data/Callsign.h \
+    ../../data/Dxcc.h \
+    ../../data/DxccAD1CIndex.h \
+    ../../data/DxccClublogIndex.h \
+    ../../data/DxccPrefixTrie.h \
+    ../../data/DxccSnapshot.h
@@ -0,0 +1,866 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QRandomGenerator>
+#include <QElapsedTimer>
+
+#include "data/Callsign.h"
+#include "data/DxccPrefixTrie.h"
+#include "data/DxccAD1CIndex.h"
+#include "data/DxccClublogIndex.h"
+#include "data/DxccSnapshot.h"
+
+namespace {
+QString lastErrorString(const QSqlQuery &query)
+{
+    return query.lastError().isValid() ? query.lastError().text() : QString();
+}
+
+// The same statement as Data::queryDXCC - used as the reference implementation
+const char *AD1C_REFERENCE_SQL =
+        "SELECT "
+        "    dxcc_entities_ad1c.id, "
+        "    dxcc_entities_ad1c.prefix, "
+        "    CASE "
+        "        WHEN (dxcc_prefixes_ad1c.cqz != 0) "
+        "        THEN dxcc_prefixes_ad1c.cqz "
+        "        ELSE dxcc_entities_ad1c.cqz "
+        "    END AS cqz, "
+        "    CASE "
+        "        WHEN (dxcc_prefixes_ad1c.ituz != 0) "
+        "        THEN dxcc_prefixes_ad1c.ituz "
+        "        ELSE dxcc_entities_ad1c.ituz "
+        "    END AS ituz , "
+        "    dxcc_prefixes_ad1c.exact "
+        "FROM dxcc_prefixes_ad1c "
+        "INNER JOIN dxcc_entities_ad1c ON (dxcc_prefixes_ad1c.dxcc = dxcc_entities_ad1c.id) "
+        "WHERE (dxcc_prefixes_ad1c.prefix = :callsign and dxcc_prefixes_ad1c.exact = true) "
+        "    OR (dxcc_prefixes_ad1c.exact = false and :callsign LIKE dxcc_prefixes_ad1c.prefix || '%') "
+        "ORDER BY dxcc_prefixes_ad1c.exact DESC, dxcc_prefixes_ad1c.prefix DESC "
+        "LIMIT 1 ";
+
+// The same statement as Data::queryDXCCClublog
+const char *CLUBLOG_REFERENCE_SQL =
+        "SELECT e.id, "
+        "      e.name, "
+        "      e.prefix, "
+        "      e.cont, "
+        "      COALESCE(z.cqz, "
+        "               CASE  WHEN (p.cqz != 0) THEN p.cqz ELSE e.cqz END) AS cqz, "
+        "      CASE WHEN z.cqz IS NOT NULL THEN NULL "
+        "           WHEN (p.ituz != 0) THEN p.ituz "
+        "           ELSE e.ituz END AS ituz, "
+        "      e.lat, "
+        "      e.lon, "
+        "      p.exact "
+        " FROM dxcc_prefixes_clublog p"
+        "   INNER JOIN dxcc_entities_clublog e ON (p.dxcc = e.id) "
+        "   LEFT JOIN dxcc_zone_exceptions_clublog z ON ( z.call = :exactcall AND :dxccdate BETWEEN COALESCE(z.start, '0001-01-01 00:00:00') "
+        "                                                                                    AND COALESCE(z.end, '9999-12-31 23:59:59')) "
+        " WHERE ((p.prefix = :exactcall and p.exact = 1) "
+        "     OR (p.exact = 0 and :modifiedcall LIKE p.prefix || '%')) "
+        "    AND :dxccdate BETWEEN COALESCE(p.start, '0001-01-01 00:00:00') "
+        "                          AND COALESCE(p.end, '9999-12-31 23:59:59') "
+        " ORDER BY p.exact DESC, p.prefix DESC LIMIT 1";
+
+// Clublog stores the times as ISO strings with an offset
+QString clublogTime(const QDateTime &dateTime)
+{
+    return dateTime.toUTC().toString(QStringLiteral("yyyy-MM-ddThh:mm:ss+00:00"));
+}
+
+QVariant clublogTime(const char *dateTime)
+{
+    return ( dateTime ) ? QVariant(QString::fromLatin1(dateTime)) : QVariant();
+}
+
+bool createClublogTables(const QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+
+    return query.exec("CREATE TABLE dxcc_entities_clublog ("
+                      "id INTEGER PRIMARY KEY, name TEXT NOT NULL, prefix TEXT, deleted INTEGER NOT NULL,"
+                      "cont TEXT, cqz INTEGER, ituz INTEGER, lat REAL, lon REAL, start TEXT, \"end\" TEXT)")
+        && query.exec("CREATE TABLE dxcc_prefixes_clublog ("
+                      "prefix TEXT NOT NULL, exact INTEGER NOT NULL, dxcc INTEGER NOT NULL,"
+                      "cqz INTEGER, ituz INTEGER, cont TEXT, lat REAL, lon REAL, start TEXT, \"end\" TEXT)")
+        && query.exec("CREATE INDEX dxcc_prefixes_clublog_idx on dxcc_prefixes_clublog (prefix, exact)")
+        && query.exec("CREATE TABLE dxcc_zone_exceptions_clublog ("
+                      "record INTEGER PRIMARY KEY, call TEXT NOT NULL, cqz INTEGER NOT NULL, start TEXT, \"end\" TEXT)");
+}
+}
+
+class DxccIndexTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void trie_longestFirst();
+    void trie_firstSlotWins();
+    void trie_unsupportedCharacters();
+    void ad1c_lookup_data();
+    void ad1c_lookup();
+    void ad1c_matchesSQL();
+    void ad1c_entity();
+    void ad1c_benchmark();
+    void clublog_lookup_data();
+    void clublog_lookup();
+    void clublog_matchesSQL();
+    void clublog_parseTime();
+    void clublog_benchmark();
+    void snapshot_lookup();
+    void snapshot_concurrentReaders();
+    void snapshot_outlivesReload();
+    void snapshot_batch();
+
+private:
+    DxccAD1CIndex ad1cIndex;
+    DxccClublogIndex clublogIndex;
+};
+
+void DxccIndexTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(":memory:");
+    QVERIFY(db.open());
+
+    QSqlQuery query;
+    QVERIFY2(query.exec("CREATE TABLE dxcc_entities_ad1c ("
+                        "id INTEGER PRIMARY KEY, name TEXT NOT NULL, prefix TEXT, cont TEXT,"
+                        "cqz INTEGER, ituz INTEGER, lat REAL, lon REAL, tz REAL)"),
+             qPrintable(lastErrorString(query)));
+    QVERIFY2(query.exec("CREATE TABLE dxcc_prefixes_ad1c ("
+                        "prefix TEXT NOT NULL, exact INTEGER NOT NULL, dxcc INTEGER NOT NULL,"
+                        "cqz INTEGER, ituz INTEGER, cont TEXT, lat REAL, lon REAL)"),
+             qPrintable(lastErrorString(query)));
+    QVERIFY2(query.exec("CREATE INDEX dxcc_prefixes_ad1c_idx ON dxcc_prefixes_ad1c (prefix, exact)"),
+             qPrintable(lastErrorString(query)));
+
+    struct EntityRow { int id; const char *name; const char *prefix; const char *cont; int cqz; int ituz; };
+    const EntityRow entities[] = {
+        {503, "Czech Republic", "OK", "EU", 15, 28},
+        {230, "Fed. Rep. of Germany", "DL", "EU", 14, 28},
+        {291, "United States", "K", "NA", 5, 8},
+        {105, "Guantanamo Bay", "KG4", "NA", 8, 11},
+        {6,   "Alaska", "KL", "NA", 1, 1},
+        {110, "Hawaii", "KH6", "OC", 31, 61},
+        {339, "Japan", "JA", "AS", 25, 45},
+        {150, "Australia", "VK", "OC", 30, 59},
+    };
+
+    QSqlQuery insertEntity;
+    QVERIFY(insertEntity.prepare("INSERT INTO dxcc_entities_ad1c (id, name, prefix, cont, cqz, ituz, lat, lon, tz) "
+                                 "VALUES (?, ?, ?, ?, ?, ?, 0, 0, 0)"));
+    for ( const EntityRow &row : entities )
+    {
+        insertEntity.bindValue(0, row.id);
+        insertEntity.bindValue(1, QString::fromLatin1(row.name));
+        insertEntity.bindValue(2, QString::fromLatin1(row.prefix));
+        insertEntity.bindValue(3, QString::fromLatin1(row.cont));
+        insertEntity.bindValue(4, row.cqz);
+        insertEntity.bindValue(5, row.ituz);
+        QVERIFY2(insertEntity.exec(), qPrintable(lastErrorString(insertEntity)));
+    }
+
+    struct PrefixRow { const char *prefix; int exact; int dxcc; int cqz; int ituz; };
+    const PrefixRow prefixes[] = {
+        {"OK", 0, 503, 0, 0},
+        {"OL", 0, 503, 0, 0},
+        {"DL", 0, 230, 0, 0},
+        {"DA", 0, 230, 0, 0},
+        {"K", 0, 291, 0, 0},
+        {"W", 0, 291, 0, 0},
+        {"N", 0, 291, 0, 0},
+        {"K6", 0, 291, 3, 6},
+        {"KG4", 0, 105, 0, 0},
+        {"KL", 0, 6, 0, 0},
+        {"KL7", 0, 6, 0, 0},
+        {"KH6", 0, 110, 0, 0},
+        {"JA", 0, 339, 0, 0},
+        {"JA1", 0, 339, 0, 0},
+        {"VK", 0, 150, 0, 0},
+        {"VK6", 0, 150, 29, 58},
+        {"KL7ABC", 1, 291, 4, 7},     // exact record overrides the KL7 prefix
+        {"OK1ABC/P", 1, 230, 0, 0},   // exact record with a suffix
+        {"XX", 0, 999, 0, 0},         // entity does not exist
+    };
+
+    QSqlQuery insertPrefix;
+    QVERIFY(insertPrefix.prepare("INSERT INTO dxcc_prefixes_ad1c (prefix, exact, dxcc, cqz, ituz) "
+                                 "VALUES (?, ?, ?, ?, ?)"));
+    for ( const PrefixRow &row : prefixes )
+    {
+        insertPrefix.bindValue(0, QString::fromLatin1(row.prefix));
+        insertPrefix.bindValue(1, row.exact);
+        insertPrefix.bindValue(2, row.dxcc);
+        insertPrefix.bindValue(3, row.cqz);
+        insertPrefix.bindValue(4, row.ituz);
+        QVERIFY2(insertPrefix.exec(), qPrintable(lastErrorString(insertPrefix)));
+    }
+
+    QVERIFY(ad1cIndex.load());
+    QVERIFY(!ad1cIndex.isEmpty());
+
+    QVERIFY2(createClublogTables(db), "Cannot create Clublog tables");
+
+    struct ClublogEntityRow { int id; const char *name; const char *prefix; int deleted; int cqz; int ituz; };
+    const ClublogEntityRow clublogEntities[] = {
+        {218, "Czechoslovakia", "OK", 1, 15, 28},
+        {503, "Czech Republic", "OK", 0, 15, 28},
+        {504, "Slovak Republic", "OM", 0, 15, 28},
+        {230, "Fed. Rep. of Germany", "DL", 0, 14, 28},
+        {291, "United States", "K", 0, 5, 8},
+        {6,   "Alaska", "KL", 0, 1, 1},
+    };
+
+    QSqlQuery insertClublogEntity;
+    QVERIFY(insertClublogEntity.prepare("INSERT INTO dxcc_entities_clublog (id, name, prefix, deleted, cont, cqz, ituz, lat, lon) "
+                                        "VALUES (?, ?, ?, ?, 'EU', ?, ?, 0, 0)"));
+    for ( const ClublogEntityRow &row : clublogEntities )
+    {
+        insertClublogEntity.bindValue(0, row.id);
+        insertClublogEntity.bindValue(1, QString::fromLatin1(row.name));
+        insertClublogEntity.bindValue(2, QString::fromLatin1(row.prefix));
+        insertClublogEntity.bindValue(3, row.deleted);
+        insertClublogEntity.bindValue(4, row.cqz);
+        insertClublogEntity.bindValue(5, row.ituz);
+        QVERIFY2(insertClublogEntity.exec(), qPrintable(lastErrorString(insertClublogEntity)));
+    }
+
+    struct ClublogPrefixRow { const char *prefix; int exact; int dxcc; int cqz; const char *start; const char *end; };
+    const ClublogPrefixRow clublogPrefixes[] = {
+        {"OK", 0, 218, 0, nullptr, "1992-12-31T23:59:59+00:00"},
+        {"OK", 0, 503, 0, "1993-01-01T00:00:00+00:00", nullptr},
+        {"OM", 0, 218, 0, nullptr, "1992-12-31T23:59:59+00:00"},
+        {"OM", 0, 504, 0, "1993-01-01T00:00:00+00:00", nullptr},
+        {"DL", 0, 230, 0, nullptr, nullptr},
+        {"K", 0, 291, 0, nullptr, nullptr},
+        {"W", 0, 291, 0, nullptr, nullptr},
+        {"K6", 0, 291, 3, nullptr, nullptr},
+        {"KL", 0, 6, 0, nullptr, nullptr},
+        {"KL7", 0, 6, 0, nullptr, nullptr},
+        {"KL7XYZ", 1, 291, 4, "2000-01-01T00:00:00+00:00", "2000-12-31T23:59:59+00:00"},
+        {"XX", 0, 999, 0, nullptr, nullptr},   // entity does not exist
+    };
+
+    QSqlQuery insertClublogPrefix;
+    QVERIFY(insertClublogPrefix.prepare("INSERT INTO dxcc_prefixes_clublog (prefix, exact, dxcc, cqz, start, \"end\") "
+                                        "VALUES (?, ?, ?, ?, ?, ?)"));
+    for ( const ClublogPrefixRow &row : clublogPrefixes )
+    {
+        insertClublogPrefix.bindValue(0, QString::fromLatin1(row.prefix));
+        insertClublogPrefix.bindValue(1, row.exact);
+        insertClublogPrefix.bindValue(2, row.dxcc);
+        insertClublogPrefix.bindValue(3, row.cqz);
+        insertClublogPrefix.bindValue(4, clublogTime(row.start));
+        insertClublogPrefix.bindValue(5, clublogTime(row.end));
+        QVERIFY2(insertClublogPrefix.exec(), qPrintable(lastErrorString(insertClublogPrefix)));
+    }
+
+    QVERIFY(query.exec("INSERT INTO dxcc_zone_exceptions_clublog (record, call, cqz, start, \"end\") VALUES "
+                       "(1, 'W1AW', 4, '2010-01-01T00:00:00+00:00', '2010-12-31T23:59:59+00:00'),"
+                       "(2, 'K1ABC', 3, NULL, NULL)"));
+
+    QVERIFY(clublogIndex.load());
+    QVERIFY(!clublogIndex.isEmpty());
+}
+
+void DxccIndexTest::cleanupTestCase()
+{
+    ad1cIndex.clear();
+    clublogIndex.clear();
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
+}
+
+void DxccIndexTest::trie_longestFirst()
+{
+    DxccPrefixTrie trie;
+    QVERIFY(trie.insert(QStringLiteral("K"), 0));
+    QVERIFY(trie.insert(QStringLiteral("KG4"), 1));
+    QVERIFY(trie.insert(QStringLiteral("KG"), 2));
+
+    const DxccPrefixTrie::MatchList result = trie.matches(QStringLiteral("KG4ABC"));
+    QCOMPARE(result.size(), 3);
+    QCOMPARE(result.at(0), 1);
+    QCOMPARE(result.at(1), 2);
+    QCOMPARE(result.at(2), 0);
+
+    QCOMPARE(trie.matches(QStringLiteral("W1AW")).size(), 0);
+    QCOMPARE(trie.find(QStringLiteral("KG")), 2);
+    QCOMPARE(trie.find(QStringLiteral("KG5")), -1);
+    QCOMPARE(trie.size(), 3);
+}
+
+void DxccIndexTest::trie_firstSlotWins()
+{
+    DxccPrefixTrie trie;
+    QVERIFY(trie.insert(QStringLiteral("OK"), 7));
+    QVERIFY(!trie.insert(QStringLiteral("OK"), 8));
+    QCOMPARE(trie.find(QStringLiteral("OK")), 7);
+    QCOMPARE(trie.size(), 1);
+}
+
+void DxccIndexTest::trie_unsupportedCharacters()
+{
+    DxccPrefixTrie trie;
+    QVERIFY(!trie.insert(QStringLiteral("O-K"), 1));
+    QVERIFY(trie.insert(QStringLiteral("ok"), 1)); // the alphabet is case-insensitive as the SQL LIKE
+    QCOMPARE(trie.matches(QStringLiteral("OK1ABC")).size(), 1);
+    QCOMPARE(trie.matches(QStringLiteral("OK-1")).size(), 1);
+    QCOMPARE(trie.matches(QString()).size(), 0);
+}
+
+void DxccIndexTest::ad1c_lookup_data()
+{
+    QTest::addColumn<QString>("callsign");
+    QTest::addColumn<int>("dxcc");
+    QTest::addColumn<int>("cqz");
+    QTest::addColumn<int>("ituz");
+    QTest::addColumn<QString>("prefix");
+
+    QTest::newRow("simple") << "OK1ABC" << 503 << 15 << 28 << "OK";
+    QTest::newRow("longerPrefix") << "K6ABC" << 291 << 3 << 6 << "K";
+    QTest::newRow("hostPrefix") << "DL/OK1ABC" << 230 << 14 << 28 << "DL";
+    QTest::newRow("suffixPrefix") << "OK1ABC/KH6" << 110 << 31 << 61 << "KH6";
+    QTest::newRow("suffixArea") << "VK2ABC/6" << 150 << 29 << 58 << "VK";
+    QTest::newRow("specialSuffix") << "OK1XYZ/P" << 503 << 15 << 28 << "OK";
+    QTest::newRow("exactWithSuffix") << "OK1ABC/P" << 230 << 14 << 28 << "DL";
+    QTest::newRow("exact") << "KL7ABC" << 291 << 4 << 7 << "K";
+    QTest::newRow("nonExactKL7") << "KL7ABD" << 6 << 1 << 1 << "KL";
+    QTest::newRow("guantanamo") << "KG4AB" << 105 << 8 << 11 << "KG4";
+    QTest::newRow("kg4USA") << "KG4ABC" << 291 << 5 << 8 << "KG4";
+    QTest::newRow("unknown") << "ZZ9ZZ" << 0 << 0 << 0 << "";
+    QTest::newRow("missingEntity") << "XX1AA" << 0 << 0 << 0 << "";
+}
+
+void DxccIndexTest::ad1c_lookup()
+{
+    QFETCH(QString, callsign);
+    QFETCH(int, dxcc);
+    QFETCH(int, cqz);
+    QFETCH(int, ituz);
+    QFETCH(QString, prefix);
+
+    const Callsign parsed(callsign);
+    const QString lookupPrefix = parsed.isValid() ? parsed.getDXCCLookupPrefix() : callsign;
+    const DxccEntity entity = ad1cIndex.lookup(lookupPrefix, parsed.getBase());
+
+    QCOMPARE(entity.dxcc, dxcc);
+    QCOMPARE(entity.cqz, cqz);
+    QCOMPARE(entity.ituz, ituz);
+    QCOMPARE(entity.prefix, prefix);
+}
+
+void DxccIndexTest::ad1c_matchesSQL()
+{
+    const QStringList callsigns = {
+        "OK1ABC", "OL9A", "DA0HQ", "K1ABC", "W6XYZ", "N0CALL", "K6AA", "KG4AA", "KG4ABC",
+        "KL7ABC", "KL7ABD", "KL0A", "KH6AB", "JA1XYZ", "JA3AAA", "VK6ABC", "VK3ZZ",
+        "DL/OK1ABC", "OK1ABC/P", "OK1XYZ/P", "VK2ABC/6", "OK1ABC/KH6", "XX1AA", "ZZ9ZZ"
+    };
+
+    QSqlQuery query;
+    QVERIFY(query.prepare(QString::fromLatin1(AD1C_REFERENCE_SQL)));
+
+    for ( const QString &callsign : callsigns )
+    {
+        const Callsign parsed(callsign);
+        const QString lookupPrefix = parsed.isValid() ? parsed.getDXCCLookupPrefix() : callsign;
+
+        query.bindValue(":callsign", lookupPrefix);
+        QVERIFY2(query.exec(), qPrintable(lastErrorString(query)));
+
+        const DxccEntity entity = ad1cIndex.lookup(lookupPrefix, parsed.getBase());
+
+        if ( !query.next() )
+        {
+            QCOMPARE(entity.dxcc, 0);
+            continue;
+        }
+
+        // KG4 exception is resolved in code, not in SQL
+        if ( query.value(1).toString() == "KG4" && !query.value(4).toBool() && parsed.getBase().size() != 5 )
+        {
+            QCOMPARE(entity.dxcc, 291);
+            continue;
+        }
+
+        QCOMPARE(entity.dxcc, query.value(0).toInt());
+        QCOMPARE(entity.cqz, query.value(2).toInt());
+        QCOMPARE(entity.ituz, query.value(3).toInt());
+    }
+}
+
+void DxccIndexTest::ad1c_entity()
+{
+    const DxccEntity entity = ad1cIndex.entity(339);
+    QCOMPARE(entity.dxcc, 339);
+    QCOMPARE(entity.country, QStringLiteral("Japan"));
+    QCOMPARE(entity.cont, QStringLiteral("AS"));
+
+    QCOMPARE(ad1cIndex.entity(1).dxcc, 0);
+}
+
+void DxccIndexTest::ad1c_benchmark()
+{
+    const Callsign parsed(QStringLiteral("JA1XYZ/KH6"));
+    const QString lookupPrefix = parsed.getDXCCLookupPrefix();
+    const QString base = parsed.getBase();
+
+    QBENCHMARK
+    {
+        ad1cIndex.lookup(lookupPrefix, base);
+    }
+}
+
+void DxccIndexTest::clublog_lookup_data()
+{
+    QTest::addColumn<QString>("callsign");
+    QTest::addColumn<QDateTime>("date");
+    QTest::addColumn<bool>("found");
+    QTest::addColumn<int>("dxcc");
+    QTest::addColumn<int>("cqz");
+    QTest::addColumn<int>("ituz");
+    QTest::addColumn<bool>("exact");
+
+    auto date = [](int year, int month, int day)
+    {
+        return QDateTime(QDate(year, month, day), QTime(12, 0), QTimeZone::utc());
+    };
+
+    QTest::newRow("deletedEntity") << "OK1ABC" << date(1990, 5, 1) << true << 218 << 15 << 28 << false;
+    QTest::newRow("currentEntity") << "OK1ABC" << date(2000, 5, 1) << true << 503 << 15 << 28 << false;
+    QTest::newRow("lastSecond") << "OM3ABC" << QDateTime(QDate(1992, 12, 31), QTime(23, 59, 59), QTimeZone::utc())
+                                << true << 218 << 15 << 28 << false;
+    QTest::newRow("firstSecond") << "OM3ABC" << QDateTime(QDate(1993, 1, 1), QTime(0, 0), QTimeZone::utc())
+                                 << true << 504 << 15 << 28 << false;
+    QTest::newRow("prefixCQZ") << "K6AAA" << date(2020, 1, 1) << true << 291 << 3 << 8 << false;
+    QTest::newRow("exactValid") << "KL7XYZ" << date(2000, 6, 1) << true << 291 << 4 << 8 << true;
+    QTest::newRow("exactExpired") << "KL7XYZ" << date(2005, 6, 1) << true << 6 << 1 << 1 << false;
+    QTest::newRow("zoneException") << "W1AW" << date(2010, 6, 1) << true << 291 << 4 << 0 << false;
+    QTest::newRow("zoneExpired") << "W1AW" << date(2011, 6, 1) << true << 291 << 5 << 8 << false;
+    QTest::newRow("zoneUnbounded") << "K1ABC" << date(1970, 1, 1) << true << 291 << 3 << 0 << false;
+    QTest::newRow("hostPrefix") << "DL/W1AW" << date(2010, 6, 1) << true << 230 << 14 << 28 << false;
+    QTest::newRow("unknown") << "ZZ9ZZ" << date(2020, 1, 1) << false << 0 << 0 << 0 << false;
+    QTest::newRow("missingEntity") << "XX1AA" << date(2020, 1, 1) << false << 0 << 0 << 0 << false;
+    QTest::newRow("invalidDate") << "OK1ABC" << QDateTime() << false << 0 << 0 << 0 << false;
+}
+
+void DxccIndexTest::clublog_lookup()
+{
+    QFETCH(QString, callsign);
+    QFETCH(QDateTime, date);
+    QFETCH(bool, found);
+    QFETCH(int, dxcc);
+    QFETCH(int, cqz);
+    QFETCH(int, ituz);
+    QFETCH(bool, exact);
+
+    const Callsign parsed(callsign);
+    const QString lookupPrefix = parsed.isValid() ? parsed.getDXCCLookupPrefix() : callsign;
+    DxccEntity entity;
+    bool isExactMatch = false;
+
+    QCOMPARE(clublogIndex.lookup(lookupPrefix, callsign, date, entity, &isExactMatch), found);
+
+    if ( !found )
+        return;
+
+    QCOMPARE(entity.dxcc, dxcc);
+    QCOMPARE(entity.cqz, cqz);
+    QCOMPARE(entity.ituz, ituz);
+    QCOMPARE(isExactMatch, exact);
+}
+
+void DxccIndexTest::clublog_matchesSQL()
+{
+    const QStringList callsigns = {
+        "OK1ABC", "OM3ABC", "DL1ABC", "K6AAA", "KL7XYZ", "KL7ABC", "W1AW", "K1ABC",
+        "DL/W1AW", "OK1ABC/P", "ZZ9ZZ", "XX1AA"
+    };
+    const QList<QDateTime> dates = {
+        QDateTime(QDate(1980, 1, 1), QTime(10, 0), QTimeZone::utc()),
+        QDateTime(QDate(1992, 12, 31), QTime(23, 59, 59), QTimeZone::utc()),
+        QDateTime(QDate(1993, 1, 1), QTime(0, 0, 1), QTimeZone::utc()),
+        QDateTime(QDate(2000, 7, 1), QTime(8, 30), QTimeZone::utc()),
+        QDateTime(QDate(2010, 3, 15), QTime(18, 0), QTimeZone::utc()),
+        QDateTime(QDate(2024, 11, 2), QTime(1, 2, 3), QTimeZone::utc())
+    };
+
+    QSqlQuery query;
+    QVERIFY(query.prepare(QString::fromLatin1(CLUBLOG_REFERENCE_SQL)));
+
+    for ( const QString &callsign : callsigns )
+    {
+        const Callsign parsed(callsign);
+        const QString lookupPrefix = parsed.isValid() ? parsed.getDXCCLookupPrefix() : callsign;
+
+        for ( const QDateTime &date : dates )
+        {
+            query.bindValue(":modifiedcall", lookupPrefix);
+            query.bindValue(":exactcall", callsign);
+            query.bindValue(":dxccdate", clublogTime(date));
+            QVERIFY2(query.exec(), qPrintable(lastErrorString(query)));
+
+            DxccEntity entity;
+            bool isExactMatch = false;
+            const bool found = clublogIndex.lookup(lookupPrefix, callsign, date, entity, &isExactMatch);
+
+            QCOMPARE(found, query.next());
+
+            if ( !found )
+                continue;
+
+            QCOMPARE(entity.dxcc, query.value(0).toInt());
+            QCOMPARE(entity.cqz, query.value(4).toInt());
+            QCOMPARE(entity.ituz, query.value(5).toInt());
+            QCOMPARE(isExactMatch, query.value(8).toBool());
+        }
+    }
+}
+
+void DxccIndexTest::clublog_parseTime()
+{
+    const qint64 expected = QDateTime(QDate(1993, 1, 1), QTime(0, 0), QTimeZone::utc()).toMSecsSinceEpoch();
+
+    QCOMPARE(DxccClublogIndex::parseTime(QStringLiteral("1993-01-01T00:00:00+00:00"), -1), expected);
+    QCOMPARE(DxccClublogIndex::parseTime(QStringLiteral("1993-01-01T00:00:00"), -1), expected);
+    QCOMPARE(DxccClublogIndex::parseTime(QStringLiteral("1993-01-01 00:00:00"), -1), expected);
+    QCOMPARE(DxccClublogIndex::parseTime(QStringLiteral("1993-01-01T01:00:00+01:00"), -1), expected);
+    QCOMPARE(DxccClublogIndex::parseTime(QString(), -1), qint64(-1));
+    QCOMPARE(DxccClublogIndex::parseTime(QStringLiteral("garbage"), -2), qint64(-2));
+}
+
+void DxccIndexTest::clublog_benchmark()
+{
+    if ( qEnvironmentVariableIsEmpty("QLOG_RUN_DXCC_INDEX_BENCHMARK") )
+        QSKIP("Set QLOG_RUN_DXCC_INDEX_BENCHMARK=1 to run the Clublog index benchmark");
+
+    const QString connectionName = QStringLiteral("clublogBenchmark");
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        db.setDatabaseName(":memory:");
+        QVERIFY(db.open());
+        QVERIFY2(createClublogTables(db), "Cannot create Clublog tables");
+
+        QRandomGenerator random(20241102);
+        const QDateTime firstDate(QDate(1985, 1, 1), QTime(0, 0), QTimeZone::utc());
+        const qint64 rangeSecs = firstDate.secsTo(QDateTime(QDate(2025, 1, 1), QTime(0, 0), QTimeZone::utc()));
+        const int entityCount = 400;
+
+        QVERIFY(db.transaction());
+
+        QSqlQuery insertEntity(db);
+        QVERIFY(insertEntity.prepare("INSERT INTO dxcc_entities_clublog (id, name, prefix, deleted, cont, cqz, ituz, lat, lon) "
+                                     "VALUES (?, ?, ?, 0, 'EU', ?, ?, 0, 0)"));
+        for ( int id = 1; id <= entityCount; ++id )
+        {
+            insertEntity.bindValue(0, id);
+            insertEntity.bindValue(1, QString("Entity %1").arg(id));
+            insertEntity.bindValue(2, QString("E%1").arg(id));
+            insertEntity.bindValue(3, 1 + id % 40);
+            insertEntity.bindValue(4, 1 + id % 90);
+            QVERIFY2(insertEntity.exec(), qPrintable(lastErrorString(insertEntity)));
+        }
+
+        QSqlQuery insertPrefix(db);
+        QVERIFY(insertPrefix.prepare("INSERT INTO dxcc_prefixes_clublog (prefix, exact, dxcc, cqz, start, \"end\") "
+                                     "VALUES (?, ?, ?, ?, ?, ?)"));
+
+        // every record is split into consecutive non-overlapping intervals over 40 years
+        auto insertRecord = [&](const QString &prefix, int exact) -> bool
+        {
+            const int intervalCount = 1 + random.bounded(3);
+            QDateTime start;
+
+            for ( int i = 0; i < intervalCount; ++i )
+            {
+                const QDateTime end = ( i == intervalCount - 1 ) ? QDateTime()
+                                                                 : firstDate.addSecs(rangeSecs * (i + 1) / intervalCount);
+                insertPrefix.bindValue(0, prefix);
+                insertPrefix.bindValue(1, exact);
+                insertPrefix.bindValue(2, 1 + static_cast<int>(random.bounded(entityCount)));
+                insertPrefix.bindValue(3, ( random.bounded(4) == 0 ) ? 1 + static_cast<int>(random.bounded(40)) : 0);
+                insertPrefix.bindValue(4, start.isValid() ? QVariant(clublogTime(start)) : QVariant());
+                insertPrefix.bindValue(5, end.isValid() ? QVariant(clublogTime(end.addSecs(-1))) : QVariant());
+                if ( !insertPrefix.exec() )
+                    return false;
+                start = end;
+            }
+            return true;
+        };
+
+        QStringList basePrefixes;
+
+        for ( char first = 'A'; first <= 'Z'; ++first )
+        {
+            for ( char second = 'A'; second <= 'Z'; ++second )
+            {
+                if ( random.bounded(2) )
+                    continue;
+
+                const QString prefix = QString(QChar(first)) + QChar(second);
+                basePrefixes << prefix;
+                QVERIFY(insertRecord(prefix, 0));
+
+                for ( int digit = 0; digit <= 9; ++digit )
+                {
+                    if ( random.bounded(5) == 0 )
+                        QVERIFY(insertRecord(prefix + QString::number(digit), 0));
+                }
+            }
+        }
+
+        auto randomCallsign = [&]() -> QString
+        {
+            QString callsign = basePrefixes.at(random.bounded(basePrefixes.size()))
+                               + QString::number(random.bounded(10));
+            const int suffixLength = 2 + random.bounded(2);
+
+            for ( int i = 0; i < suffixLength; ++i )
+                callsign.append(QChar('A' + random.bounded(26)));
+            return callsign;
+        };
+
+        QStringList specialCalls;
+
+        for ( int i = 0; i < 2000; ++i )
+        {
+            const QString callsign = randomCallsign();
+
+            if ( specialCalls.contains(callsign) )
+                continue;
+
+            specialCalls << callsign;
+            QVERIFY(insertRecord(callsign, 1));
+        }
+
+        QSqlQuery insertZone(db);
+        QVERIFY(insertZone.prepare("INSERT INTO dxcc_zone_exceptions_clublog (call, cqz, start, \"end\") "
+                                   "VALUES (?, ?, ?, ?)"));
+        // every second exact call has a one-year zone exception
+        for ( int i = 0; i < specialCalls.size(); i += 2 )
+        {
+            const QDateTime start = firstDate.addSecs(random.bounded(static_cast<quint32>(rangeSecs)));
+            insertZone.bindValue(0, specialCalls.at(i));
+            insertZone.bindValue(1, 1 + static_cast<int>(random.bounded(40)));
+            insertZone.bindValue(2, clublogTime(start));
+            insertZone.bindValue(3, clublogTime(start.addDays(365)));
+            QVERIFY2(insertZone.exec(), qPrintable(lastErrorString(insertZone)));
+        }
+
+        QVERIFY(db.commit());
+
+        struct Probe { QString callsign; QDateTime date; };
+        QVector<Probe> probes;
+        probes.reserve(100000);
+
+        for ( int i = 0; i < 100000; ++i )
+        {
+            const QString callsign = ( i % 10 == 0 ) ? specialCalls.at(random.bounded(specialCalls.size()))
+                                                     : randomCallsign();
+            probes.append({callsign, firstDate.addSecs(random.bounded(static_cast<quint32>(rangeSecs)))});
+        }
+
+        DxccClublogIndex index;
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY(index.load(db));
+        const qint64 loadMs = timer.elapsed();
+
+        QVector<DxccEntity> indexResults(probes.size());
+        QVector<bool> indexFound(probes.size());
+
+        timer.restart();
+        for ( int i = 0; i < probes.size(); ++i )
+            indexFound[i] = index.lookup(probes.at(i).callsign, probes.at(i).callsign, probes.at(i).date, indexResults[i]);
+        const qint64 indexNs = timer.nsecsElapsed();
+
+        QSqlQuery query(db);
+        QVERIFY(query.prepare(QString::fromLatin1(CLUBLOG_REFERENCE_SQL)));
+
+        int mismatches = 0;
+
+        timer.restart();
+        for ( int i = 0; i < probes.size(); ++i )
+        {
+            query.bindValue(":modifiedcall", probes.at(i).callsign);
+            query.bindValue(":exactcall", probes.at(i).callsign);
+            query.bindValue(":dxccdate", clublogTime(probes.at(i).date));
+            QVERIFY2(query.exec(), qPrintable(lastErrorString(query)));
+
+            const bool found = query.next();
+
+            if ( found != indexFound.at(i)
+                 || ( found && ( query.value(0).toInt() != indexResults.at(i).dxcc
+                                 || query.value(4).toInt() != indexResults.at(i).cqz ) ) )
+                mismatches++;
+        }
+        const qint64 sqlNs = timer.nsecsElapsed();
+
+        qInfo().noquote() << QString("Clublog lookups: %1 callsigns, %2 exact calls, index load %3 ms")
+                             .arg(probes.size()).arg(specialCalls.size()).arg(loadMs);
+        qInfo().noquote() << QString("  SQL:   %1 ms (%2 us/lookup)")
+                             .arg(sqlNs / 1000000).arg(double(sqlNs) / probes.size() / 1000.0, 0, 'f', 2);
+        qInfo().noquote() << QString("  index: %1 ms (%2 us/lookup), speedup %3x")
+                             .arg(indexNs / 1000000).arg(double(indexNs) / probes.size() / 1000.0, 0, 'f', 2)
+                             .arg(double(sqlNs) / qMax<qint64>(1, indexNs), 0, 'f', 1);
+
+        QCOMPARE(mismatches, 0);
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+void DxccIndexTest::snapshot_lookup()
+{
+    const DxccSnapshot::Ptr snapshot = DxccSnapshot::create();
+    QVERIFY(snapshot);
+    QVERIFY(snapshot->hasAD1C());
+    QVERIFY(snapshot->hasClublog());
+
+    QCOMPARE(snapshot->lookupAD1C(QStringLiteral("KG4ABC")).dxcc, 291);
+    QCOMPARE(snapshot->lookupAD1C(QString()).country, QString());
+
+    const QDateTime date(QDate(2000, 6, 1), QTime(12, 0), QTimeZone::utc());
+
+    // exact call - ITUZ is taken from AD1C only if the entity and CQZ match
+    DxccEntity entity = snapshot->lookupClublog(QStringLiteral("KL7XYZ"), date);
+    QCOMPARE(entity.dxcc, 291);
+    QCOMPARE(entity.cqz, 4);
+    QCOMPARE(entity.ituz, 8);
+
+    // zone exception - the CQZ differs from AD1C, ITUZ stays unknown
+    entity = snapshot->lookupClublog(QStringLiteral("W1AW"),
+                                     QDateTime(QDate(2010, 6, 1), QTime(12, 0), QTimeZone::utc()));
+    QCOMPARE(entity.dxcc, 291);
+    QCOMPARE(entity.cqz, 4);
+    QCOMPARE(entity.ituz, 0);
+
+    // historical entity
+    entity = snapshot->lookupClublog(QStringLiteral("OK1ABC"),
+                                     QDateTime(QDate(1990, 1, 1), QTime(12, 0), QTimeZone::utc()));
+    QCOMPARE(entity.dxcc, 218);
+    QCOMPARE(entity.ituz, 28);
+
+    // not in Clublog - AD1C result is returned
+    entity = snapshot->lookupClublog(QStringLiteral("JA1XYZ"), date);
+    QCOMPARE(entity.dxcc, 339);
+    QCOMPARE(entity.ituz, 45);
+
+    QCOMPARE(snapshot->entityClublog(504).country, QStringLiteral("Slovak Republic"));
+    QCOMPARE(snapshot->entityAD1C(150).country, QStringLiteral("Australia"));
+}
+
+void DxccIndexTest::snapshot_concurrentReaders()
+{
+    const DxccSnapshot::Ptr snapshot = DxccSnapshot::create();
+    const QStringList callsigns = {
+        "OK1ABC", "OM3ABC", "DL1ABC", "K6AAA", "KL7XYZ", "KG4ABC", "W1AW", "JA1XYZ",
+        "VK2ABC/6", "OK1ABC/KH6", "DL/W1AW", "ZZ9ZZ"
+    };
+    const QDateTime date(QDate(2010, 6, 1), QTime(12, 0), QTimeZone::utc());
+
+    QVector<int> expected;
+    for ( const QString &callsign : callsigns )
+        expected << snapshot->lookupClublog(callsign, date).dxcc
+                 << snapshot->lookupAD1C(callsign).dxcc;
+
+    QAtomicInt mismatches(0);
+    QList<QThread *> threads;
+
+    for ( int i = 0; i < 4; ++i )
+    {
+        threads << QThread::create([&]()
+        {
+            for ( int round = 0; round < 2000; ++round )
+            {
+                for ( int j = 0; j < callsigns.size(); ++j )
+                {
+                    if ( snapshot->lookupClublog(callsigns.at(j), date).dxcc != expected.at(2 * j)
+                         || snapshot->lookupAD1C(callsigns.at(j)).dxcc != expected.at(2 * j + 1) )
+                        mismatches.ref();
+                }
+            }
+        });
+        threads.last()->start();
+    }
+
+    for ( QThread *thread : threads )
+    {
+        QVERIFY(thread->wait(60000));
+        delete thread;
+    }
+
+    QCOMPARE(mismatches.loadRelaxed(), 0);
+}
+
+void DxccIndexTest::snapshot_outlivesReload()
+{
+    const DxccSnapshot::Ptr oldSnapshot = DxccSnapshot::create();
+
+    QSqlQuery query;
+    QVERIFY(query.exec("UPDATE dxcc_prefixes_ad1c SET dxcc = 230 WHERE prefix = 'JA'"));
+
+    const DxccSnapshot::Ptr newSnapshot = DxccSnapshot::create();
+
+    QVERIFY(query.exec("UPDATE dxcc_prefixes_ad1c SET dxcc = 339 WHERE prefix = 'JA'"));
+
+    // the reader holding the old snapshot is not affected by the reload
+    QCOMPARE(oldSnapshot->lookupAD1C(QStringLiteral("JA3AAA")).dxcc, 339);
+    QCOMPARE(newSnapshot->lookupAD1C(QStringLiteral("JA3AAA")).dxcc, 230);
+}
+
+void DxccIndexTest::snapshot_batch()
+{
+    const DxccSnapshot::Ptr snapshot = DxccSnapshot::create();
+    const QList<QString> callsigns = {
+        "OK1ABC", "JA1XYZ", "OK1ABC", QString(), "W1AW", "KG4ABC", "JA1XYZ", "OK1ABC"
+    };
+
+    const QList<DxccEntity> ad1c = snapshot->lookupAD1C(callsigns);
+    QCOMPARE(ad1c.size(), callsigns.size());
+
+    for ( int i = 0; i < callsigns.size(); ++i )
+    {
+        if ( callsigns.at(i).isEmpty() )
+            continue;
+        QCOMPARE(ad1c.at(i).dxcc, snapshot->lookupAD1C(callsigns.at(i)).dxcc);
+    }
+
+    QList<QDateTime> dates;
+    for ( int i = 0; i < callsigns.size(); ++i )
+        dates << QDateTime(QDate(1988 + i * 4, 6, 1), QTime(12, 0), QTimeZone::utc());
+
+    // the same callsign resolves differently for the different dates
+    const QList<DxccEntity> clublog = snapshot->lookupClublog(callsigns, dates);
+    QCOMPARE(clublog.size(), callsigns.size());
+    QCOMPARE(clublog.at(0).dxcc, 218);
+    QCOMPARE(clublog.at(2).dxcc, 503);
+
+    for ( int i = 0; i < callsigns.size(); ++i )
+    {
+        if ( callsigns.at(i).isEmpty() )
+            continue;
+
+        const DxccEntity &single = snapshot->lookupClublog(callsigns.at(i), dates.at(i));
+        QCOMPARE(clublog.at(i).dxcc, single.dxcc);
+        QCOMPARE(clublog.at(i).cqz, single.cqz);
+        QCOMPARE(clublog.at(i).ituz, single.ituz);
+    }
+
+    QVERIFY(snapshot->lookupClublog(callsigns, dates.mid(1)).isEmpty());
+}
+
+QTEST_APPLESS_MAIN(DxccIndexTest)
+
+#include "tst_dxccindex.moc"
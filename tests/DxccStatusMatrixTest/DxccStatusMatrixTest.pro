@@ -0,0 +1,14 @@
+QT += testlib core sql
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_dxccstatusmatrix
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_dxccstatusmatrix.cpp \
+    ../../data/DxccStatusMatrix.cpp
+
+HEADERS += \
+    ../../data/Dxcc.h \
+    ../../data/DxccStatusMatrix.h
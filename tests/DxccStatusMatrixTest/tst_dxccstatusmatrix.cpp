@@ -0,0 +1,301 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlField>
+#include <QSqlError>
+
+#include "data/DxccStatusMatrix.h"
+
+namespace {
+QString lastErrorString(const QSqlQuery &query)
+{
+    return query.lastError().isValid() ? query.lastError().text() : QString();
+}
+
+QSqlRecord contactRecord(int id, int myDxcc, int dxcc, const QString &band, const QString &mode,
+                         const QString &paper = "N", const QString &lotw = "N", const QString &eqsl = "N")
+{
+    QSqlRecord record;
+    const QStringList names = {"id", "my_dxcc", "dxcc", "band", "mode", "qsl_rcvd", "lotw_qsl_rcvd", "eqsl_qsl_rcvd"};
+    const QVariantList values = {id, myDxcc, dxcc, band, mode, paper, lotw, eqsl};
+
+    for ( int i = 0; i < names.size(); ++i )
+    {
+        QSqlField field(names.at(i));
+        field.setValue(values.at(i));
+        record.append(field);
+    }
+    return record;
+}
+}
+
+class DxccStatusMatrixTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void status_data();
+    void status();
+    void matchesSQL();
+    void addRemoveContact();
+    void updateContact();
+    void reloadEntities();
+    void modeGroup();
+
+private:
+    bool insertContact(const QSqlRecord &record);
+    DxccStatus referenceStatus(int dxcc, int myDxcc, const QString &band,
+                               const QString &modeGroup, int confirmedBy);
+
+    DxccStatusMatrix matrix;
+};
+
+void DxccStatusMatrixTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(":memory:");
+    QVERIFY(db.open());
+
+    QSqlQuery query;
+    QVERIFY2(query.exec("CREATE TABLE modes (id INTEGER PRIMARY KEY, name TEXT UNIQUE NOT NULL, dxcc TEXT NOT NULL)"),
+             qPrintable(lastErrorString(query)));
+    QVERIFY2(query.exec("INSERT INTO modes (name, dxcc) VALUES "
+                        "('CW', 'CW'), ('SSB', 'PHONE'), ('FM', 'PHONE'), ('FT8', 'DIGITAL'), ('RTTY', 'DIGITAL')"),
+             qPrintable(lastErrorString(query)));
+    QVERIFY2(query.exec("CREATE TABLE contacts (id INTEGER PRIMARY KEY, my_dxcc INTEGER, dxcc INTEGER,"
+                        "band TEXT, mode TEXT, qsl_rcvd TEXT, lotw_qsl_rcvd TEXT, eqsl_qsl_rcvd TEXT)"),
+             qPrintable(lastErrorString(query)));
+
+    const QList<QSqlRecord> contacts = {
+        contactRecord(1, 503, 230, "20m", "CW", "N", "Y", "N"),
+        contactRecord(2, 503, 230, "20m", "SSB"),
+        contactRecord(3, 503, 230, "40m", "FT8", "Y", "N", "N"),
+        contactRecord(4, 230, 230, "10m", "RTTY", "N", "N", "Y"),
+        contactRecord(5, 503, 291, "20m", "FT8"),
+        contactRecord(6, 503, 291, "20m", "FT8", "N", "N", "Y"),
+        contactRecord(7, 230, 291, "40m", "CW"),
+        contactRecord(8, 503, 339, "15m", "OLIVIA"),   // mode is not in the modes table
+        contactRecord(9, 503, 339, "20m", "SSB", "Y", "Y", "Y"),
+    };
+
+    for ( const QSqlRecord &record : contacts )
+        QVERIFY(insertContact(record));
+
+    QVERIFY(matrix.load());
+    QVERIFY(matrix.isLoaded());
+}
+
+void DxccStatusMatrixTest::cleanupTestCase()
+{
+    matrix.clear();
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
+}
+
+bool DxccStatusMatrixTest::insertContact(const QSqlRecord &record)
+{
+    QSqlQuery query;
+
+    if ( !query.prepare("INSERT INTO contacts (id, my_dxcc, dxcc, band, mode, qsl_rcvd, lotw_qsl_rcvd, eqsl_qsl_rcvd) "
+                        "VALUES (:id, :my_dxcc, :dxcc, :band, :mode, :qsl_rcvd, :lotw_qsl_rcvd, :eqsl_qsl_rcvd)") )
+        return false;
+
+    for ( int i = 0; i < record.count(); ++i )
+        query.bindValue(":" + record.fieldName(i), record.value(i));
+
+    return query.exec();
+}
+
+// The same statement as the former Data::dxccStatus - used as the reference implementation
+DxccStatus DxccStatusMatrixTest::referenceStatus(int dxcc, int myDxcc, const QString &band,
+                                                 const QString &modeGroup, int confirmedBy)
+{
+    QStringList dxccConfirmedByCond(QLatin1String("0=1"));
+
+    if ( confirmedBy & DxccStatusMatrix::CONFIRMED_BY_LOTW )
+        dxccConfirmedByCond << QLatin1String("all_dxcc_qsos.lotw_qsl_rcvd = 'Y'");
+
+    if ( confirmedBy & DxccStatusMatrix::CONFIRMED_BY_PAPER )
+        dxccConfirmedByCond << QLatin1String("all_dxcc_qsos.qsl_rcvd = 'Y'");
+
+    if ( confirmedBy & DxccStatusMatrix::CONFIRMED_BY_EQSL )
+        dxccConfirmedByCond << QLatin1String("all_dxcc_qsos.eqsl_qsl_rcvd = 'Y'");
+
+    QSqlQuery query;
+    const QString sqlStatement = QString("WITH all_dxcc_qsos AS (SELECT DISTINCT contacts.mode, contacts.band, "
+                                         "                       contacts.qsl_rcvd, contacts.lotw_qsl_rcvd, contacts.eqsl_qsl_rcvd "
+                                         "                       FROM contacts "
+                                         "                       WHERE dxcc = :dxcc %1) "
+                                         "  SELECT (SELECT 1 FROM all_dxcc_qsos LIMIT 1) as entity,"
+                                         "         (SELECT 1 FROM all_dxcc_qsos WHERE band = :band LIMIT 1) as band, "
+                                         "         (SELECT 1 FROM all_dxcc_qsos INNER JOIN modes ON (modes.name = all_dxcc_qsos.mode) "
+                                         "          WHERE modes.dxcc = :mode LIMIT 1) as mode, "
+                                         "         (SELECT 1 FROM all_dxcc_qsos INNER JOIN modes ON (modes.name = all_dxcc_qsos.mode) "
+                                         "          WHERE modes.dxcc = :mode AND all_dxcc_qsos.band = :band LIMIT 1) as slot, "
+                                         "         (SELECT 1 FROM all_dxcc_qsos INNER JOIN modes ON (modes.name = all_dxcc_qsos.mode) "
+                                         "          WHERE modes.dxcc = :mode AND all_dxcc_qsos.band = :band "
+                                         "                AND (%2) LIMIT 1) as confirmed")
+                                 .arg(( myDxcc != 0 ) ? QString(" AND my_dxcc = %1").arg(myDxcc) : QString(),
+                                      dxccConfirmedByCond.join(" OR "));
+
+    if ( !query.prepare(sqlStatement) )
+        return DxccStatus::UnknownStatus;
+
+    query.bindValue(":dxcc", dxcc);
+    query.bindValue(":band", band);
+    query.bindValue(":mode", modeGroup);
+
+    if ( !query.exec() || !query.next() )
+        return DxccStatus::UnknownStatus;
+
+    if ( query.value(0).isNull() )
+        return DxccStatus::NewEntity;
+
+    if ( query.value(1).isNull() )
+        return ( query.value(2).isNull() ) ? DxccStatus::NewBandMode : DxccStatus::NewBand;
+
+    if ( query.value(2).isNull() )
+        return DxccStatus::NewMode;
+
+    if ( query.value(3).isNull() )
+        return DxccStatus::NewSlot;
+
+    return ( query.value(4).isNull() ) ? DxccStatus::Worked : DxccStatus::Confirmed;
+}
+
+void DxccStatusMatrixTest::status_data()
+{
+    QTest::addColumn<int>("dxcc");
+    QTest::addColumn<int>("myDxcc");
+    QTest::addColumn<QString>("band");
+    QTest::addColumn<QString>("modeGroup");
+    QTest::addColumn<int>("confirmedBy");
+    QTest::addColumn<int>("expected");
+
+    const int all = DxccStatusMatrix::CONFIRMED_BY_LOTW
+                    | DxccStatusMatrix::CONFIRMED_BY_PAPER
+                    | DxccStatusMatrix::CONFIRMED_BY_EQSL;
+
+    QTest::newRow("newEntity") << 1 << 0 << "20m" << "CW" << all << int(DxccStatus::NewEntity);
+    QTest::newRow("newEntityForMyDxcc") << 339 << 230 << "20m" << "PHONE" << all << int(DxccStatus::NewEntity);
+    QTest::newRow("newBandMode") << 291 << 503 << "10m" << "PHONE" << all << int(DxccStatus::NewBandMode);
+    QTest::newRow("newBand") << 230 << 503 << "15m" << "CW" << all << int(DxccStatus::NewBand);
+    QTest::newRow("newMode") << 291 << 503 << "20m" << "CW" << all << int(DxccStatus::NewMode);
+    QTest::newRow("newSlot") << 230 << 503 << "40m" << "CW" << all << int(DxccStatus::NewSlot);
+    QTest::newRow("workedOnly") << 230 << 503 << "20m" << "PHONE" << all << int(DxccStatus::Worked);
+    QTest::newRow("confirmedLotw") << 230 << 503 << "20m" << "CW" << int(DxccStatusMatrix::CONFIRMED_BY_LOTW) << int(DxccStatus::Confirmed);
+    QTest::newRow("lotwDisabled") << 230 << 503 << "20m" << "CW" << int(DxccStatusMatrix::CONFIRMED_BY_PAPER) << int(DxccStatus::Worked);
+    QTest::newRow("confirmedEqsl") << 291 << 503 << "20m" << "DIGITAL" << int(DxccStatusMatrix::CONFIRMED_BY_EQSL) << int(DxccStatus::Confirmed);
+    QTest::newRow("nothingEnabled") << 339 << 503 << "20m" << "PHONE" << 0 << int(DxccStatus::Worked);
+    QTest::newRow("allMyDxcc") << 230 << 0 << "10m" << "DIGITAL" << all << int(DxccStatus::Confirmed);
+    QTest::newRow("otherMyDxcc") << 230 << 503 << "10m" << "DIGITAL" << all << int(DxccStatus::NewBand);
+    QTest::newRow("unknownModeBand") << 339 << 503 << "15m" << "DIGITAL" << all << int(DxccStatus::NewMode);
+}
+
+void DxccStatusMatrixTest::status()
+{
+    QFETCH(int, dxcc);
+    QFETCH(int, myDxcc);
+    QFETCH(QString, band);
+    QFETCH(QString, modeGroup);
+    QFETCH(int, confirmedBy);
+    QFETCH(int, expected);
+
+    QCOMPARE(int(matrix.status(dxcc, myDxcc, band, modeGroup, confirmedBy)), expected);
+    QCOMPARE(int(referenceStatus(dxcc, myDxcc, band, modeGroup, confirmedBy)), expected);
+}
+
+void DxccStatusMatrixTest::matchesSQL()
+{
+    const QList<int> entities = {1, 230, 291, 339};
+    const QList<int> myEntities = {0, 230, 503};
+    const QStringList bands = {"10m", "15m", "20m", "40m", "80m"};
+    const QStringList modeGroups = {"CW", "PHONE", "DIGITAL"};
+
+    for ( int dxcc : entities )
+        for ( int myDxcc : myEntities )
+            for ( const QString &band : bands )
+                for ( const QString &modeGroup : modeGroups )
+                    for ( int confirmedBy = 0; confirmedBy < 8; ++confirmedBy )
+                    {
+                        const DxccStatus expected = referenceStatus(dxcc, myDxcc, band, modeGroup, confirmedBy);
+                        const DxccStatus actual = matrix.status(dxcc, myDxcc, band, modeGroup, confirmedBy);
+
+                        if ( expected != actual )
+                            QFAIL(qPrintable(QString("%1 %2 %3 %4 %5: expected %6, got %7")
+                                             .arg(dxcc).arg(myDxcc).arg(band, modeGroup).arg(confirmedBy)
+                                             .arg(int(expected)).arg(int(actual))));
+                    }
+}
+
+void DxccStatusMatrixTest::addRemoveContact()
+{
+    const QSqlRecord record = contactRecord(100, 503, 150, "6m", "FM", "Y");
+
+    QCOMPARE(matrix.status(150, 503, "6m", "PHONE", DxccStatusMatrix::CONFIRMED_BY_PAPER), DxccStatus::NewEntity);
+
+    matrix.addContact(record);
+    QCOMPARE(matrix.status(150, 503, "6m", "PHONE", DxccStatusMatrix::CONFIRMED_BY_PAPER), DxccStatus::Confirmed);
+    QCOMPARE(matrix.status(150, 0, "6m", "CW", DxccStatusMatrix::CONFIRMED_BY_PAPER), DxccStatus::NewMode);
+
+    matrix.addContact(record);
+    matrix.removeContact(record);
+    QCOMPARE(matrix.status(150, 503, "6m", "PHONE", DxccStatusMatrix::CONFIRMED_BY_PAPER), DxccStatus::Confirmed);
+
+    matrix.removeContact(record);
+    QCOMPARE(matrix.status(150, 503, "6m", "PHONE", DxccStatusMatrix::CONFIRMED_BY_PAPER), DxccStatus::NewEntity);
+    QCOMPARE(matrix.status(150, 0, "6m", "PHONE", DxccStatusMatrix::CONFIRMED_BY_PAPER), DxccStatus::NewEntity);
+}
+
+void DxccStatusMatrixTest::updateContact()
+{
+    const QSqlRecord oldRecord = contactRecord(2, 503, 230, "20m", "SSB");
+    const QSqlRecord newRecord = contactRecord(2, 503, 230, "20m", "SSB", "N", "Y", "N");
+
+    QCOMPARE(matrix.status(230, 503, "20m", "PHONE", DxccStatusMatrix::CONFIRMED_BY_LOTW), DxccStatus::Worked);
+
+    matrix.updateContact(oldRecord, newRecord);
+    QCOMPARE(matrix.status(230, 503, "20m", "PHONE", DxccStatusMatrix::CONFIRMED_BY_LOTW), DxccStatus::Confirmed);
+
+    matrix.updateContact(newRecord, oldRecord);
+    QCOMPARE(matrix.status(230, 503, "20m", "PHONE", DxccStatusMatrix::CONFIRMED_BY_LOTW), DxccStatus::Worked);
+}
+
+void DxccStatusMatrixTest::reloadEntities()
+{
+    QVERIFY(insertContact(contactRecord(200, 503, 291, "80m", "CW", "Y")));
+
+    // the matrix does not see direct DB changes until the entity is reloaded
+    QCOMPARE(matrix.status(291, 503, "80m", "CW", DxccStatusMatrix::CONFIRMED_BY_PAPER), DxccStatus::NewBandMode);
+    QVERIFY(matrix.reloadEntities({291}));
+    QCOMPARE(matrix.status(291, 503, "80m", "CW", DxccStatusMatrix::CONFIRMED_BY_PAPER), DxccStatus::Confirmed);
+    QCOMPARE(matrix.status(291, 0, "80m", "CW", DxccStatusMatrix::CONFIRMED_BY_PAPER), DxccStatus::Confirmed);
+
+    QSqlQuery query;
+    QVERIFY(query.exec("DELETE FROM contacts WHERE id = 200"));
+    QVERIFY(matrix.reloadEntities({291}));
+    QCOMPARE(matrix.status(291, 503, "80m", "CW", DxccStatusMatrix::CONFIRMED_BY_PAPER), DxccStatus::NewBandMode);
+
+    // other entities are not affected
+    QCOMPARE(matrix.status(230, 503, "20m", "CW", DxccStatusMatrix::CONFIRMED_BY_LOTW), DxccStatus::Confirmed);
+}
+
+void DxccStatusMatrixTest::modeGroup()
+{
+    QCOMPARE(matrix.modeGroup("FT8"), QStringLiteral("DIGITAL"));
+    QCOMPARE(matrix.modeGroup("SSB"), QStringLiteral("PHONE"));
+    QCOMPARE(matrix.modeGroup("OLIVIA"), QString());
+}
+
+QTEST_APPLESS_MAIN(DxccStatusMatrixTest)
+
+#include "tst_dxccstatusmatrix.moc"
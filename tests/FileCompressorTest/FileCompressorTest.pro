@@ -10,7 +10,8 @@ SOURCES += \
     ../../core/FileCompressor.cpp
 
 HEADERS += \
-    ../../core/FileCompressor.h
+    ../../core/FileCompressor.h \
+    ../../core/OrderedWorkQueue.h
 
 # zlib
 !isEmpty(ZLIBINCLUDEPATH) {
@@ -2,6 +2,8 @@
 #include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QFile>
+#include <QBuffer>
+#include <QTextStream>
 #include <QRandomGenerator>
 
 #include "core/FileCompressor.h"
@@ -30,13 +32,31 @@ private slots:
     void gzipFile_progressCallback_isCalled();
     void gzipFile_progressCallbackCancel_stopsCompression();
 
+    // Parallel compression tests
+    void gzipFileParallel_mixedData_compressesAndDecompresses();
+    void gzipFileParallel_blockBoundaries_compressesAndDecompresses_data();
+    void gzipFileParallel_blockBoundaries_compressesAndDecompresses();
+    void gzipFileParallel_progressCallback_isCalledPerBlock();
+    void gzipFileParallel_progressCallbackCancel_removesDest();
+
+    // Streaming device tests
+    void gzipDevice_textStream_readsAllLines();
+    void gzipDevice_concatenatedMembers_readsAll();
+    void gzipDevice_truncatedData_reportsError();
+    void gzipDevice_compressedPosition_reachesSize();
+    void gzipDevice_isGzipFile_detectsMagic();
+
     // Benchmarks
     void gzip_benchmark_compression();
     void gzip_benchmark_decompression();
+    void gzipFile_benchmark_oneWorker();
+    void gzipFile_benchmark_allWorkers();
 
 private:
     QByteArray generateRandomData(int size);
     QByteArray generateCompressibleData(int size);
+    QByteArray readFile(const QString &fileName);
+    void writeFile(const QString &fileName, const QByteArray &data);
 
     QTemporaryDir *tempDir = nullptr;
 };
@@ -72,6 +92,21 @@ QByteArray FileCompressorTest::generateCompressibleData(int size)
     return data.left(size);
 }
 
+QByteArray FileCompressorTest::readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+void FileCompressorTest::writeFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(data), static_cast<qint64>(data.size()));
+}
+
 // ============================================================================
 // In-memory tests
 // ============================================================================
@@ -287,6 +322,229 @@ void FileCompressorTest::gzipFile_progressCallbackCancel_stopsCompression()
     QVERIFY(!QFile::exists(compressedFile));
 }
 
+// ============================================================================
+// Streaming device tests
+// ============================================================================
+
+void FileCompressorTest::gzipDevice_textStream_readsAllLines()
+{
+    QString compressedFile = tempDir->filePath("stream_lines.adi.gz");
+
+    QByteArray original;
+    for (int i = 0; i < 50000; ++i)
+        original.append("<CALL:5>OK1AA <QSO_DATE:8>20240101 <EOR>\n");
+
+    {
+        QFile file(compressedFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(FileCompressor::gzip(original));
+    }
+
+    GzipReadDevice device(compressedFile);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QVERIFY(device.isSequential());
+
+    QTextStream in(&device);
+    int lines = 0;
+    QString line;
+    while (in.readLineInto(&line))
+    {
+        QCOMPARE(line, QString("<CALL:5>OK1AA <QSO_DATE:8>20240101 <EOR>"));
+        ++lines;
+    }
+
+    QCOMPARE(lines, 50000);
+    QVERIFY(device.atEnd());
+}
+
+void FileCompressorTest::gzipDevice_concatenatedMembers_readsAll()
+{
+    QByteArray first = generateCompressibleData(300 * 1024);
+    QByteArray second = generateRandomData(100 * 1024);
+    QByteArray compressed = FileCompressor::gzip(first) + FileCompressor::gzip(second);
+
+    QBuffer buffer(&compressed);
+    GzipReadDevice device(&buffer);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+
+    QCOMPARE(device.readAll(), first + second);
+}
+
+void FileCompressorTest::gzipDevice_truncatedData_reportsError()
+{
+    QByteArray original = generateRandomData(64 * 1024);
+    QByteArray truncated = FileCompressor::gzip(original);
+    truncated.chop(truncated.size() / 2);
+
+    QBuffer buffer(&truncated);
+    GzipReadDevice device(&buffer);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+
+    QByteArray result = device.readAll();
+    QVERIFY(result.size() < original.size());
+    QVERIFY(original.startsWith(result));
+    QCOMPARE(device.read(1024), QByteArray());
+    QCOMPARE(device.errorString(), QString("Compressed input is truncated"));
+}
+
+void FileCompressorTest::gzipDevice_compressedPosition_reachesSize()
+{
+    QByteArray original = generateRandomData(512 * 1024);
+    QByteArray compressed = FileCompressor::gzip(original);
+
+    QBuffer buffer(&compressed);
+    GzipReadDevice device(&buffer);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QCOMPARE(device.compressedSize(), static_cast<qint64>(compressed.size()));
+    QCOMPARE(device.compressedPosition(), 0LL);
+
+    qint64 lastPosition = 0;
+    qint64 total = 0;
+    char block[4096];
+    qint64 bytesRead;
+
+    while ((bytesRead = device.read(block, sizeof(block))) > 0)
+    {
+        total += bytesRead;
+        QVERIFY(device.compressedPosition() >= lastPosition);
+        QVERIFY(device.compressedPosition() <= device.compressedSize());
+        lastPosition = device.compressedPosition();
+    }
+
+    QCOMPARE(total, static_cast<qint64>(original.size()));
+    QCOMPARE(device.compressedPosition(), device.compressedSize());
+}
+
+void FileCompressorTest::gzipDevice_isGzipFile_detectsMagic()
+{
+    QString compressedFile = tempDir->filePath("magic.adx.gz");
+    QString plainFile = tempDir->filePath("magic.adx");
+
+    {
+        QFile file(compressedFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(FileCompressor::gzip("<?xml version=\"1.0\"?>"));
+    }
+    {
+        QFile file(plainFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("<?xml version=\"1.0\"?>");
+    }
+
+    QVERIFY(GzipReadDevice::isGzipFile(compressedFile));
+    QVERIFY(!GzipReadDevice::isGzipFile(plainFile));
+    QVERIFY(!GzipReadDevice::isGzipFile(tempDir->filePath("nonexistent.adi.gz")));
+}
+
+// ============================================================================
+// Parallel compression tests
+// ============================================================================
+
+void FileCompressorTest::gzipFileParallel_mixedData_compressesAndDecompresses()
+{
+    QString sourceFile = tempDir->filePath("parallel_source.bin");
+    QString compressedFile = tempDir->filePath("parallel_compressed.gz");
+    QString decompressedFile = tempDir->filePath("parallel_decompressed.bin");
+
+    // random and repeated parts - the dictionary priming is used across the blocks
+    QByteArray original = generateRandomData(700 * 1024)
+                          + generateCompressibleData(3 * 1024 * 1024)
+                          + generateRandomData(12345);
+    writeFile(sourceFile, original);
+
+    QVERIFY(FileCompressor::gzipFileParallel(sourceFile, compressedFile, nullptr, 4));
+
+    // one standard gzip member - readable by all decompressors
+    QCOMPARE(FileCompressor::gunzip(readFile(compressedFile)), original);
+
+    QVERIFY(FileCompressor::gunzipFile(compressedFile, decompressedFile));
+    QCOMPARE(readFile(decompressedFile), original);
+
+    GzipReadDevice device(compressedFile);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QCOMPARE(device.readAll(), original);
+}
+
+void FileCompressorTest::gzipFileParallel_blockBoundaries_compressesAndDecompresses_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("empty") << 0 << 2;
+    QTest::newRow("one byte") << 1 << 2;
+    QTest::newRow("one block") << 128 * 1024 << 2;
+    QTest::newRow("exact blocks") << 8 * 128 * 1024 << 3;
+    QTest::newRow("block plus one") << 8 * 128 * 1024 + 1 << 3;
+    QTest::newRow("single thread") << 5 * 128 * 1024 + 77 << 1;
+}
+
+void FileCompressorTest::gzipFileParallel_blockBoundaries_compressesAndDecompresses()
+{
+    QFETCH(int, size);
+    QFETCH(int, threads);
+
+    QString sourceFile = tempDir->filePath("boundary_source.bin");
+    QString compressedFile = tempDir->filePath("boundary_compressed.gz");
+
+    QByteArray original = generateCompressibleData(size);
+    writeFile(sourceFile, original);
+
+    QVERIFY(FileCompressor::gzipFileParallel(sourceFile, compressedFile, nullptr, threads));
+
+    QBuffer buffer;
+    buffer.setData(readFile(compressedFile));
+    GzipReadDevice device(&buffer);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QCOMPARE(device.readAll(), original);
+    QVERIFY(device.atEnd());
+}
+
+void FileCompressorTest::gzipFileParallel_progressCallback_isCalledPerBlock()
+{
+    QString sourceFile = tempDir->filePath("parallel_progress_source.bin");
+    QString compressedFile = tempDir->filePath("parallel_progress_compressed.gz");
+
+    // 10.5 blocks
+    QByteArray original = generateCompressibleData(10 * 128 * 1024 + 64 * 1024);
+    writeFile(sourceFile, original);
+
+    int callCount = 0;
+    qint64 lastProcessed = 0;
+    bool progressValid = true;
+
+    auto progressCallback = [&](qint64 processed, qint64 total) -> bool {
+        ++callCount;
+        if (processed <= lastProcessed || total != original.size())
+            progressValid = false;
+        lastProcessed = processed;
+        return true;
+    };
+
+    QVERIFY(FileCompressor::gzipFileParallel(sourceFile, compressedFile, progressCallback, 4));
+    QCOMPARE(callCount, 11);
+    QVERIFY(progressValid);
+    QCOMPARE(lastProcessed, static_cast<qint64>(original.size()));
+}
+
+void FileCompressorTest::gzipFileParallel_progressCallbackCancel_removesDest()
+{
+    QString sourceFile = tempDir->filePath("parallel_cancel_source.bin");
+    QString compressedFile = tempDir->filePath("parallel_cancel_compressed.gz");
+
+    writeFile(sourceFile, generateRandomData(4 * 1024 * 1024));
+
+    int callCount = 0;
+
+    auto progressCallback = [&](qint64, qint64) -> bool {
+        ++callCount;
+        return callCount < 3;
+    };
+
+    QVERIFY(!FileCompressor::gzipFileParallel(sourceFile, compressedFile, progressCallback, 4));
+    QCOMPARE(callCount, 3);
+    QVERIFY(!QFile::exists(compressedFile));
+}
+
 // ============================================================================
 // Benchmarks
 // ============================================================================
@@ -316,6 +574,30 @@ void FileCompressorTest::gzip_benchmark_decompression()
     QCOMPARE(decompressed, data);
 }
 
+void FileCompressorTest::gzipFile_benchmark_oneWorker()
+{
+    QString sourceFile = tempDir->filePath("benchmark_source.bin");
+    QString compressedFile = tempDir->filePath("benchmark_one_worker.gz");
+
+    writeFile(sourceFile, generateRandomData(4 * 1024 * 1024) + generateCompressibleData(12 * 1024 * 1024));
+
+    QBENCHMARK {
+        QVERIFY(FileCompressor::gzipFileParallel(sourceFile, compressedFile, nullptr, 1));
+    }
+}
+
+void FileCompressorTest::gzipFile_benchmark_allWorkers()
+{
+    QString sourceFile = tempDir->filePath("benchmark_source.bin");
+    QString compressedFile = tempDir->filePath("benchmark_all_workers.gz");
+
+    writeFile(sourceFile, generateRandomData(4 * 1024 * 1024) + generateCompressibleData(12 * 1024 * 1024));
+
+    QBENCHMARK {
+        QVERIFY(FileCompressor::gzipFile(sourceFile, compressedFile));
+    }
+}
+
 int main(int argc, char **argv)
 {
     QCoreApplication app(argc, argv);
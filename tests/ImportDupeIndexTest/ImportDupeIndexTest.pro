@@ -0,0 +1,13 @@
+QT += testlib core sql
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_importdupeindex
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_importdupeindex.cpp \
+    ../../data/ImportDupeIndex.cpp
+
+HEADERS += \
+    ../../data/ImportDupeIndex.h
@@ -0,0 +1,180 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+
+#include "data/ImportDupeIndex.h"
+
+namespace {
+const QDateTime BASE_TIME(QDate(2024, 5, 1), QTime(12, 0), QTimeZone::utc());
+}
+
+class ImportDupeIndexTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void load();
+    void findDuplicate_data();
+    void findDuplicate();
+    void addContact();
+
+private:
+    static qulonglong referenceDuplicate(const QString &callsign, const QString &band,
+                                         const QString &mode, const QVariant &satName,
+                                         const QDateTime &startTime);
+    ImportDupeIndex index;
+};
+
+void ImportDupeIndexTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(":memory:");
+    QVERIFY(db.open());
+
+    QSqlQuery query;
+    QVERIFY2(query.exec("CREATE TABLE contacts (id INTEGER PRIMARY KEY, callsign TEXT, band TEXT, mode TEXT,"
+                        "sat_name TEXT, start_time TEXT)"),
+             qPrintable(query.lastError().text()));
+
+    QVERIFY(query.prepare("INSERT INTO contacts (id, callsign, band, mode, sat_name, start_time) "
+                          "VALUES (:id, :callsign, :band, :mode, :sat_name, :start_time)"));
+
+    const struct {
+        int id;
+        const char *callsign;
+        const char *band;
+        const char *mode;
+        const char *satName;
+        int offsetSecs;
+    } contacts[] = {
+        {1, "OK1ABC", "20m", "CW", nullptr, 0},
+        {2, "OK1ABC", "20m", "CW", nullptr, 7200},
+        {3, "OK1ABC", "40M", "ssb", nullptr, 0},
+        {4, "DL1XYZ", "2m", "FM", "AO-91", 0},
+        {5, "DL1XYZ", "2m", "FM", "", 3600},
+    };
+
+    for ( const auto &contact : contacts )
+    {
+        query.bindValue(":id", contact.id);
+        query.bindValue(":callsign", contact.callsign);
+        query.bindValue(":band", contact.band);
+        query.bindValue(":mode", contact.mode);
+        query.bindValue(":sat_name", ( contact.satName ) ? QVariant(contact.satName) : QVariant());
+        query.bindValue(":start_time", BASE_TIME.addSecs(contact.offsetSecs));
+        QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+    }
+
+    QVERIFY(index.load());
+}
+
+void ImportDupeIndexTest::cleanupTestCase()
+{
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
+}
+
+qulonglong ImportDupeIndexTest::referenceDuplicate(const QString &callsign, const QString &band,
+                                                   const QString &mode, const QVariant &satName,
+                                                   const QDateTime &startTime)
+{
+    // the former import statement
+    QSqlQuery query;
+    query.prepare("SELECT id FROM contacts "
+                  "WHERE callsign=upper(:callsign) "
+                  "AND upper(mode)=upper(:mode) "
+                  "AND upper(band)=upper(:band) "
+                  "AND COALESCE(sat_name, '') = COALESCE(:sat_name, '') "
+                  "AND ABS(JULIANDAY(start_time)-JULIANDAY(datetime(:startdate)))*24*60<30");
+    query.bindValue(":callsign", callsign);
+    query.bindValue(":mode", mode);
+    query.bindValue(":band", band);
+    query.bindValue(":startdate", startTime.toTimeZone(QTimeZone::utc()).toString("yyyy-MM-dd hh:mm:ss"));
+    query.bindValue(":sat_name", satName);
+
+    if ( !query.exec() || !query.next() )
+        return 0;
+
+    return query.value(0).toULongLong();
+}
+
+void ImportDupeIndexTest::load()
+{
+    QVERIFY(index.isLoaded());
+    QCOMPARE(index.size(), 5);
+}
+
+void ImportDupeIndexTest::findDuplicate_data()
+{
+    QTest::addColumn<QString>("callsign");
+    QTest::addColumn<QString>("band");
+    QTest::addColumn<QString>("mode");
+    QTest::addColumn<QVariant>("satName");
+    QTest::addColumn<int>("offsetSecs");
+
+    QTest::newRow("exact") << "OK1ABC" << "20m" << "CW" << QVariant() << 0;
+    QTest::newRow("lowercase input") << "ok1abc" << "20M" << "cw" << QVariant() << 0;
+    QTest::newRow("inside window before") << "OK1ABC" << "20m" << "CW" << QVariant() << -29 * 60;
+    QTest::newRow("inside window after") << "OK1ABC" << "20m" << "CW" << QVariant() << 29 * 60 + 59;
+    QTest::newRow("just outside window") << "OK1ABC" << "20m" << "CW" << QVariant() << 30 * 60 + 1;
+    QTest::newRow("outside window") << "OK1ABC" << "20m" << "CW" << QVariant() << -31 * 60;
+    QTest::newRow("second QSO") << "OK1ABC" << "20m" << "CW" << QVariant() << 7200 + 60;
+    QTest::newRow("between QSOs") << "OK1ABC" << "20m" << "CW" << QVariant() << 3600;
+    QTest::newRow("stored mixed case") << "OK1ABC" << "40m" << "SSB" << QVariant() << 10;
+    QTest::newRow("other band") << "OK1ABC" << "15m" << "CW" << QVariant() << 0;
+    QTest::newRow("other mode") << "OK1ABC" << "20m" << "SSB" << QVariant() << 0;
+    QTest::newRow("satellite") << "DL1XYZ" << "2m" << "FM" << QVariant("AO-91") << 60;
+    QTest::newRow("other satellite") << "DL1XYZ" << "2m" << "FM" << QVariant("SO-50") << 60;
+    QTest::newRow("no satellite null") << "DL1XYZ" << "2m" << "FM" << QVariant() << 3600;
+    QTest::newRow("no satellite empty") << "DL1XYZ" << "2m" << "FM" << QVariant("") << 3600;
+    QTest::newRow("unknown callsign") << "W1AW" << "20m" << "CW" << QVariant() << 0;
+}
+
+void ImportDupeIndexTest::findDuplicate()
+{
+    QFETCH(QString, callsign);
+    QFETCH(QString, band);
+    QFETCH(QString, mode);
+    QFETCH(QVariant, satName);
+    QFETCH(int, offsetSecs);
+
+    const QDateTime startTime = BASE_TIME.addSecs(offsetSecs);
+
+    QCOMPARE(index.findDuplicate(callsign, band, mode, satName.toString(), startTime),
+             referenceDuplicate(callsign, band, mode, satName, startTime));
+}
+
+void ImportDupeIndexTest::addContact()
+{
+    ImportDupeIndex localIndex;
+    QVERIFY(localIndex.load());
+
+    const QDateTime startTime = BASE_TIME.addDays(1);
+
+    QCOMPARE(localIndex.findDuplicate("SP1AAA", "20m", "FT8", QString(), startTime), 0ULL);
+
+    localIndex.addContact(100, "SP1AAA", "20m", "FT8", QString(), startTime);
+    localIndex.addContact(101, "SP1AAA", "20m", "FT8", QString(), startTime.addSecs(-7200));
+
+    QCOMPARE(localIndex.size(), 7);
+    QCOMPARE(localIndex.findDuplicate("sp1aaa", "20M", "ft8", QString(), startTime.addSecs(600)), 100ULL);
+    QCOMPARE(localIndex.findDuplicate("SP1AAA", "20m", "FT8", QString(), startTime.addSecs(-7000)), 101ULL);
+    QCOMPARE(localIndex.findDuplicate("SP1AAA", "20m", "FT8", QString(), startTime.addSecs(-3600)), 0ULL);
+
+    localIndex.clear();
+    QVERIFY(!localIndex.isLoaded());
+    QCOMPARE(localIndex.findDuplicate("SP1AAA", "20m", "FT8", QString(), startTime), 0ULL);
+}
+
+QTEST_APPLESS_MAIN(ImportDupeIndexTest)
+
+#include "tst_importdupeindex.moc"
@@ -0,0 +1,27 @@
+QT += testlib core sql xml
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_jsonformat
+
+DEFINES += VERSION=\\\"test\\\"
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_jsonformat.cpp \
+    ../AdxFormatTest/test_stubs.cpp \
+    ../../core/LogLocale.cpp \
+    ../../data/Accents.cpp \
+    ../../logformat/JsonFormat.cpp \
+    ../../logformat/AdxFormat.cpp \
+    ../../logformat/AdiFormat.cpp \
+    ../../logformat/AdiTokenizer.cpp
+
+HEADERS += \
+    ../../core/LogLocale.h \
+    ../../data/Data.h \
+    ../../logformat/JsonFormat.h \
+    ../../logformat/AdxFormat.h \
+    ../../logformat/AdiFormat.h \
+    ../../logformat/AdiTokenizer.h \
+    ../../logformat/LogFormat.h
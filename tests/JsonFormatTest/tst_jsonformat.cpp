@@ -0,0 +1,195 @@
+#include <QtTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSqlField>
+#include <QSqlRecord>
+
+#include "logformat/JsonFormat.h"
+
+// discards the output, only counts the written bytes
+class CountingDevice : public QIODevice
+{
+public:
+    qint64 written = 0;
+
+protected:
+    qint64 readData(char *, qint64) override { return -1; }
+    qint64 writeData(const char *, qint64 len) override
+    {
+        written += len;
+        return len;
+    }
+};
+
+class JsonFormatTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void emptyExportIsValidDocument();
+    void exportMatchesJsonDocumentOutput();
+    void millionRecordsStayUnderMemoryCeiling();
+
+private:
+    static void appendField(QSqlRecord &record,
+                            const QString &name,
+                            const QVariant &value);
+    static QSqlRecord sampleRecord(const QString &callsign, const QString &notes);
+    static qint64 residentSetKiB();
+};
+
+void JsonFormatTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+}
+
+void JsonFormatTest::appendField(QSqlRecord &record,
+                                 const QString &name,
+                                 const QVariant &value)
+{
+    QSqlField field(name, value.type());
+    field.setValue(value);
+    record.append(field);
+}
+
+QSqlRecord JsonFormatTest::sampleRecord(const QString &callsign, const QString &notes)
+{
+    QSqlRecord record;
+    appendField(record, QStringLiteral("callsign"), callsign);
+    appendField(record, QStringLiteral("band"), QStringLiteral("20M"));
+    appendField(record, QStringLiteral("mode"), QStringLiteral("SSB"));
+    appendField(record, QStringLiteral("freq"), 14.205);
+    appendField(record, QStringLiteral("rst_sent"), QStringLiteral("59"));
+    appendField(record, QStringLiteral("rst_rcvd"), QStringLiteral("57"));
+    appendField(record, QStringLiteral("name"), QStringLiteral("Pavel"));
+    appendField(record, QStringLiteral("name_intl"), QString::fromUtf8("Pavel \xc5\xbd\xc3\xa1k"));
+    appendField(record, QStringLiteral("notes"), notes);
+    appendField(record,
+                QStringLiteral("start_time"),
+                QDateTime(QDate(2026, 5, 28), QTime(12, 34, 56), Qt::UTC));
+    return record;
+}
+
+qint64 JsonFormatTest::residentSetKiB()
+{
+    QFile status(QStringLiteral("/proc/self/status"));
+    if ( !status.open(QIODevice::ReadOnly | QIODevice::Text) )
+        return -1;
+
+    const QList<QByteArray> lines = status.readAll().split('\n');
+    for ( const QByteArray &line : lines )
+    {
+        if ( line.startsWith("VmRSS:") )
+            return line.mid(6).trimmed().split(' ').first().toLongLong();
+    }
+
+    return -1;
+}
+
+void JsonFormatTest::emptyExportIsValidDocument()
+{
+    QByteArray output;
+    QBuffer buffer(&output);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QTextStream stream(&buffer);
+    JsonFormat format(stream);
+
+    format.exportStart();
+    format.exportEnd();
+    stream.flush();
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(output, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QVERIFY(doc.object().value(QStringLiteral("records")).toArray().isEmpty());
+    QCOMPARE(output, doc.toJson(QJsonDocument::Indented));
+}
+
+void JsonFormatTest::exportMatchesJsonDocumentOutput()
+{
+    QMap<QString, QString> applTags;
+    applTags.insert(QStringLiteral("APP_QLOG_NOTE"), QStringLiteral("tab\there \"quoted\" back\\slash"));
+
+    QByteArray output;
+    QBuffer buffer(&output);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QTextStream stream(&buffer);
+    JsonFormat format(stream);
+
+    format.exportStart();
+    format.exportContact(sampleRecord(QStringLiteral("OK1AA"), QStringLiteral("Line1\nLine2")));
+    format.exportContact(sampleRecord(QStringLiteral("DL1AB"), QString(QChar(0x01)) + QStringLiteral("ctrl")),
+                         &applTags);
+    format.exportContact(sampleRecord(QStringLiteral("JA1XYZ"), QString()));
+    format.exportEnd();
+    stream.flush();
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(output, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    const QJsonObject header = doc.object().value(QStringLiteral("header")).toObject();
+    QCOMPARE(header.value(QStringLiteral("adif_ver")).toString(), QStringLiteral("3.1.7"));
+    QCOMPARE(header.value(QStringLiteral("programid")).toString(), QStringLiteral("QLog"));
+    QCOMPARE(header.value(QStringLiteral("programversion")).toString(), QStringLiteral("test"));
+
+    const QJsonArray records = doc.object().value(QStringLiteral("records")).toArray();
+    QCOMPARE(records.size(), 3);
+    QCOMPARE(records.at(0).toObject().value(QStringLiteral("call")).toString(), QStringLiteral("OK1AA"));
+    QCOMPARE(records.at(0).toObject().value(QStringLiteral("notes")).toString(), QStringLiteral("Line1\nLine2"));
+    QCOMPARE(records.at(0).toObject().value(QStringLiteral("name_intl")).toString(),
+             QString::fromUtf8("Pavel \xc5\xbd\xc3\xa1k"));
+    QCOMPARE(records.at(1).toObject().value(QStringLiteral("APP_QLOG_NOTE")).toString(),
+             applTags.value(QStringLiteral("APP_QLOG_NOTE")));
+    QCOMPARE(records.at(1).toObject().value(QStringLiteral("notes")).toString(),
+             QString(QChar(0x01)) + QStringLiteral("ctrl"));
+    QVERIFY(!records.at(2).toObject().contains(QStringLiteral("notes")));
+
+    // the streamed output has the same layout as the former whole-document output
+    QCOMPARE(output, doc.toJson(QJsonDocument::Indented));
+}
+
+void JsonFormatTest::millionRecordsStayUnderMemoryCeiling()
+{
+    const qint64 baseline = residentSetKiB();
+
+    if ( baseline < 0 )
+        QSKIP("The resident set size is not available on this platform.");
+
+    const int recordCount = 1000000;
+    const qint64 ceilingKiB = 32 * 1024;
+    const QSqlRecord record = sampleRecord(QStringLiteral("OK1AA"), QStringLiteral("Streaming export"));
+
+    CountingDevice device;
+    QVERIFY(device.open(QIODevice::WriteOnly));
+    QTextStream stream(&device);
+    JsonFormat format(stream);
+
+    qint64 peak = baseline;
+
+    format.exportStart();
+
+    for ( int i = 0; i < recordCount; ++i )
+    {
+        format.exportContact(record);
+
+        if ( i % 50000 == 0 )
+            peak = qMax(peak, residentSetKiB());
+    }
+
+    format.exportEnd();
+    stream.flush();
+
+    peak = qMax(peak, residentSetKiB());
+
+    QVERIFY(device.written > recordCount * 100LL);
+    QVERIFY2(peak - baseline < ceilingKiB,
+             qPrintable(QStringLiteral("RSS grew by %1 KiB").arg(peak - baseline)));
+}
+
+QTEST_APPLESS_MAIN(JsonFormatTest)
+
+#include "tst_jsonformat.moc"
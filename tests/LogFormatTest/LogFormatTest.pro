@@ -0,0 +1,70 @@
+QT += testlib core sql xml network widgets
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_logformat
+
+DEFINES += VERSION=\\\"test\\\"
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_logformat.cpp \
+    test_stubs.cpp \
+    ../../core/FileCompressor.cpp \
+    ../../core/LogLocale.cpp \
+    ../../core/SQLBulkLoad.cpp \
+    ../../core/SQLTuning.cpp \
+    ../../data/Accents.cpp \
+    ../../data/BandPlan.cpp \
+    ../../data/Callsign.cpp \
+    ../../data/DXCCCreditIndex.cpp \
+    ../../data/DxccAD1CIndex.cpp \
+    ../../data/DxccClublogIndex.cpp \
+    ../../data/DxccPrefixTrie.cpp \
+    ../../data/DxccSnapshot.cpp \
+    ../../data/Gridsquare.cpp \
+    ../../data/ImportDupeIndex.cpp \
+    ../../logformat/AdiFormat.cpp \
+    ../../logformat/AdiTokenizer.cpp \
+    ../../logformat/AdxFormat.cpp \
+    ../../logformat/CSVFormat.cpp \
+    ../../logformat/CabrilloFormat.cpp \
+    ../../logformat/JsonFormat.cpp \
+    ../../logformat/LogFormat.cpp \
+    ../../logformat/PotaAdiFormat.cpp
+
+HEADERS += \
+    ../../core/FileCompressor.h \
+    ../../core/LogDatabase.h \
+    ../../core/LogLocale.h \
+    ../../core/OrderedWorkQueue.h \
+    ../../core/SQLBulkLoad.h \
+    ../../core/SQLTuning.h \
+    ../../data/BandPlan.h \
+    ../../data/Callsign.h \
+    ../../data/DXCCCreditIndex.h \
+    ../../data/Data.h \
+    ../../data/DxccSnapshot.h \
+    ../../data/Gridsquare.h \
+    ../../data/ImportDupeIndex.h \
+    ../../logformat/AdiFormat.h \
+    ../../logformat/AdiTokenizer.h \
+    ../../logformat/AdxFormat.h \
+    ../../logformat/CSVFormat.h \
+    ../../logformat/CabrilloFormat.h \
+    ../../logformat/JsonFormat.h \
+    ../../logformat/LogFormat.h \
+    ../../logformat/PotaAdiFormat.h
+
+RESOURCES += \
+    ../../res/res.qrc
+
+# zlib
+!isEmpty(ZLIBINCLUDEPATH) {
+    INCLUDEPATH += $$ZLIBINCLUDEPATH
+}
+!isEmpty(ZLIBLIBPATH) {
+    LIBS += -L$$ZLIBLIBPATH
+}
+unix: LIBS += -lz
+win32: LIBS += -lzlib
@@ -0,0 +1,155 @@
+// Stubs for the application parts used by LogFormat
+// The read-only connections open the database file created by the test
+
+#include <QAtomicInt>
+#include <QSqlDatabase>
+#include "core/LogDatabase.h"
+#include "core/QSOFilterManager.h"
+#include "data/Data.h"
+#include "data/StationProfile.h"
+#include "service/lotw/Lotw.h"
+
+QString testDatabaseFile;
+QList<QPair<QSqlRecord, QSqlRecord>> testDXCCStatusUpdates;
+bool testReadOnlyConnectionFails = false;
+QAtomicInt testReadOnlyConnections;
+
+LogDatabase::LogDatabase()
+{
+}
+
+QString LogDatabase::dbFilename()
+{
+    return testDatabaseFile;
+}
+
+QSqlDatabase LogDatabase::readOnlyConnection()
+{
+    testReadOnlyConnections.ref();
+
+    // a failed connection makes the worker return its chunks to the writer
+    if ( testReadOnlyConnectionFails )
+        return QSqlDatabase();
+
+    // the test threads are not reused - every thread gets its own connection
+    static QAtomicInt connectionCounter;
+    thread_local const QString connectionName = QString("readonly_%1").arg(connectionCounter.fetchAndAddOrdered(1));
+
+    if ( QSqlDatabase::contains(connectionName) )
+        return QSqlDatabase::database(connectionName);
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    db.setDatabaseName(dbFilename());
+    db.setConnectOptions("QSQLITE_OPEN_READONLY");
+    db.open();
+    return db;
+}
+
+QString QSOFilterManager::getWhereClause(const QString &, const QString &)
+{
+    return QStringLiteral("1 = 1");
+}
+
+QString StationProfile::getContactInnerJoin() const
+{
+    return QStringLiteral("1 = 1");
+}
+
+const QString LotwDXCCCreditDownloader::dxccModeGroupFromLotw(const QString &lotwModeGroup)
+{
+    return LotwBase::lotwGroupNameToDxcc(lotwModeGroup);
+}
+
+Data::Data(QObject *parent) :
+    QObject(parent)
+{
+}
+
+Data::~Data() = default;
+
+QPair<QString, QString> Data::legacyMode(const QString &)
+{
+    return {};
+}
+
+QString Data::statusToText(const DxccStatus &)
+{
+    return QStringLiteral("status");
+}
+
+DxccStatus Data::dxccStatus(int, const QString &, const QString &)
+{
+    return DxccStatus::Confirmed;
+}
+
+DxccEntity Data::lookupDxccIDAD1C(const int)
+{
+    return DxccEntity();
+}
+
+DxccEntity Data::lookupDxccIDClublog(const int)
+{
+    return DxccEntity();
+}
+
+QList<DxccEntity> Data::lookupDxccBatch(const QList<QString> &callsigns)
+{
+    QList<DxccEntity> entities;
+
+    for ( int i = 0; i < callsigns.size(); i++ )
+        entities << DxccEntity();
+
+    return entities;
+}
+
+QList<DxccEntity> Data::lookupDxccClublogBatch(const QList<QString> &callsigns, const QList<QDateTime> &)
+{
+    return lookupDxccBatch(callsigns);
+}
+
+SOTAEntity Data::lookupSOTA(const QString &)
+{
+    return SOTAEntity();
+}
+
+DxccSnapshot::Ptr Data::dxccSnapshot() const
+{
+    return DxccSnapshot::Ptr();
+}
+
+void Data::updateDXCCStatusCacheContact(const QSqlRecord &oldRecord, const QSqlRecord &newRecord)
+{
+    testDXCCStatusUpdates << qMakePair(oldRecord, newRecord);
+}
+
+void Data::invalidateDXCCStatusCache(const QSqlRecord &)
+{
+}
+
+void Data::invalidateSetOfDXCCStatusCache(const QSet<uint> &)
+{
+}
+
+void Data::updateDXCCStatusCache(const QSqlRecord &)
+{
+}
+
+void Data::clearDXCCStatusCache()
+{
+}
+
+void Data::updateDupeIndexWhenQSOAdded(const QSqlRecord &)
+{
+}
+
+void Data::updateDupeIndexWhenQSODeleted(const QSqlRecord &)
+{
+}
+
+void Data::updateDupeIndexWhenQSOUpdated(const QSqlRecord &)
+{
+}
+
+void Data::clearDupeIndex()
+{
+}
@@ -0,0 +1,557 @@
+#include <QtTest>
+#include <functional>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSqlRecord>
+
+#include "core/Migration.h"
+#include "logformat/AdiFormat.h"
+#include "logformat/LogFormat.h"
+
+extern QString testDatabaseFile;
+extern QList<QPair<QSqlRecord, QSqlRecord>> testDXCCStatusUpdates;
+extern bool testReadOnlyConnectionFails;
+extern QAtomicInt testReadOnlyConnections;
+
+// feeds the downloaded QSLs to runQSLImport
+class QSLFeed : public LogFormat
+{
+public:
+    QSLFeed(QTextStream &stream, const QList<QVariantMap> &qsls) :
+        LogFormat(stream),
+        qsls(qsls) {}
+
+    bool importNext(QSqlRecord &record) override
+    {
+        if ( qsls.isEmpty() )
+            return false;
+
+        const QVariantMap qsl = qsls.takeFirst();
+
+        for ( auto it = qsl.constBegin(); it != qsl.constEnd(); ++it )
+            record.setValue(it.key(), it.value());
+
+        return true;
+    }
+
+private:
+    QList<QVariantMap> qsls;
+};
+
+// The expected results are the results of the per-record QSqlTableModel
+// matching that runQSLImport used before the set-based merge.
+class LogFormatTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+
+    void qslImport_lotwExactMode_confirmsContact();
+    void qslImport_lotwModeGroup_fallsBack();
+    void qslImport_lotwMultipleMatches_rejected();
+    void qslImport_lotwExactTime_selectsContact();
+    void qslImport_eqslTimeWindow_is3600s();
+    void qslImport_sameContactTwice_seesFirstUpdate();
+    void qslImport_dxccStatusCache_updatedPerChange();
+    void qslImport_moreChunks_matchesAll();
+
+    void export_parallel_matchesSerial();
+    void export_failedChunks_formattedByWriter();
+    void export_parallel_emitsProgress();
+
+private:
+    QScopedPointer<QTemporaryDir> tempDir;
+
+    static bool executeSqlFile(int version);
+    static qulonglong insertContact(const QString &callsign,
+                                    const QString &mode,
+                                    const QDateTime &startTime,
+                                    const QString &stationCallsign = QStringLiteral("OK1TEST"));
+    static QVariantMap lotwQSL(const QString &callsign,
+                               const QString &mode,
+                               const QDateTime &startTime);
+    static QVariantMap eqslQSL(const QString &callsign,
+                               const QString &mode,
+                               const QDateTime &startTime);
+    static bool runQSLImport(LogFormat::QSLFrom fromService,
+                             const QList<QVariantMap> &qsls,
+                             QSLMergeStat &stats);
+    static QVariant contactValue(qulonglong id, const QString &column);
+    bool insertExportContacts(int contactCount) const;
+    static QString exportAdi(bool parallel,
+                             const std::function<void(LogFormat &)> &setupFilter,
+                             long &count,
+                             QList<int> *progress = nullptr);
+
+    const QDateTime qsoTime = QDateTime(QDate(2024, 3, 10), QTime(10, 0), Qt::UTC);
+};
+
+void LogFormatTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+    Q_INIT_RESOURCE(res);
+
+    tempDir.reset(new QTemporaryDir);
+    QVERIFY(tempDir->isValid());
+
+    testDatabaseFile = tempDir->filePath(QStringLiteral("qlog.db"));
+
+    QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"));
+    db.setDatabaseName(testDatabaseFile);
+    db.setConnectOptions("QSQLITE_ENABLE_REGEXP");
+    QVERIFY2(db.open(), qPrintable(db.lastError().text()));
+
+    QSqlQuery query;
+    QVERIFY(query.exec("PRAGMA journal_mode = WAL"));
+
+    for ( int version = 1; version <= DBSchemaMigration::latestVersion; ++version )
+        QVERIFY2(executeSqlFile(version), qPrintable(QString("Migration %1 failed").arg(version)));
+}
+
+void LogFormatTest::cleanupTestCase()
+{
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        if ( db.isValid() )
+            db.close();
+    }
+    QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
+}
+
+void LogFormatTest::init()
+{
+    QSqlQuery query;
+    QVERIFY(query.exec("DELETE FROM contacts"));
+
+    testDXCCStatusUpdates.clear();
+    testReadOnlyConnectionFails = false;
+    testReadOnlyConnections = 0;
+}
+
+bool LogFormatTest::executeSqlFile(int version)
+{
+    const QString resourceName = QStringLiteral(":/res/sql/migration_%1.sql")
+                                     .arg(version, 3, 10, QChar('0'));
+    QFile sqlFile(resourceName);
+    if ( !sqlFile.open(QIODevice::ReadOnly | QIODevice::Text) )
+        return false;
+
+    // the same statement split as DBSchemaMigration::runSqlFile
+    const QStringList statements = QTextStream(&sqlFile).readAll().split('\n').join(QStringLiteral(" ")).split(';');
+
+    QSqlDatabase db = QSqlDatabase::database();
+    QSqlQuery query(db);
+
+    if ( !db.transaction() )
+        return false;
+
+    for ( const QString &statement : statements )
+    {
+        const QString trimmed = statement.trimmed();
+        if ( trimmed.isEmpty() )
+            continue;
+
+        if ( !query.exec(trimmed) )
+        {
+            qWarning() << "SQL execution failed for version" << version
+                       << ":" << trimmed << query.lastError();
+            db.rollback();
+            return false;
+        }
+    }
+
+    return db.commit();
+}
+
+qulonglong LogFormatTest::insertContact(const QString &callsign,
+                                        const QString &mode,
+                                        const QDateTime &startTime,
+                                        const QString &stationCallsign)
+{
+    QSqlQuery query;
+
+    if ( !query.prepare("INSERT INTO contacts (callsign, band, mode, start_time, station_callsign, dxcc, my_dxcc) "
+                        "VALUES (:callsign, '20m', :mode, :start_time, :station_callsign, 291, 503)") )
+    {
+        qWarning() << query.lastError();
+        return 0;
+    }
+
+    query.bindValue(":callsign", callsign);
+    query.bindValue(":mode", mode);
+    query.bindValue(":start_time", startTime);
+    query.bindValue(":station_callsign", stationCallsign);
+
+    if ( !query.exec() )
+    {
+        qWarning() << query.lastError();
+        return 0;
+    }
+
+    return query.lastInsertId().toULongLong();
+}
+
+QVariantMap LogFormatTest::lotwQSL(const QString &callsign,
+                                   const QString &mode,
+                                   const QDateTime &startTime)
+{
+    // LoTW sends the band in upper case and lotw_qsl_rcvd in qsl_rcvd
+    return QVariantMap{{"callsign", callsign},
+                       {"band", "20M"},
+                       {"mode", mode},
+                       {"start_time", startTime},
+                       {"station_callsign", "OK1TEST"},
+                       {"qsl_rcvd", "Y"},
+                       {"qsl_rdate", "2024-04-01"}};
+}
+
+QVariantMap LogFormatTest::eqslQSL(const QString &callsign,
+                                   const QString &mode,
+                                   const QDateTime &startTime)
+{
+    return QVariantMap{{"callsign", callsign},
+                       {"band", "20M"},
+                       {"mode", mode},
+                       {"start_time", startTime},
+                       {"qsl_sent", "Y"}};
+}
+
+bool LogFormatTest::runQSLImport(LogFormat::QSLFrom fromService,
+                                 const QList<QVariantMap> &qsls,
+                                 QSLMergeStat &stats)
+{
+    QString input;
+    QTextStream stream(&input);
+    QSLFeed feed(stream, qsls);
+    bool finished = false;
+
+    QObject::connect(&feed, &LogFormat::QSLMergeFinished, [&stats, &finished](const QSLMergeStat &result)
+    {
+        stats = result;
+        finished = true;
+    });
+
+    feed.runQSLImport(fromService);
+
+    return finished;
+}
+
+QVariant LogFormatTest::contactValue(qulonglong id, const QString &column)
+{
+    QSqlQuery query;
+
+    if ( !query.exec(QString("SELECT %1 FROM contacts WHERE id = %2").arg(column).arg(id))
+         || !query.next() )
+        return QVariant();
+
+    return query.value(0);
+}
+
+bool LogFormatTest::insertExportContacts(int contactCount) const
+{
+    QSqlDatabase db = QSqlDatabase::database();
+
+    if ( !db.transaction() )
+        return false;
+
+    // unique start times - the serial export orders by start_time only
+    for ( int i = 0; i < contactCount; i++ )
+    {
+        if ( insertContact(QString("K%1ABC").arg(i),
+                           ( i % 3 ) ? "CW" : "SSB",
+                           qsoTime.addSecs(i * 60),
+                           ( i % 2 ) ? "OK2XYZ" : "OK1TEST") == 0 )
+        {
+            db.rollback();
+            return false;
+        }
+    }
+
+    return db.commit();
+}
+
+QString LogFormatTest::exportAdi(bool parallel,
+                                 const std::function<void(LogFormat &)> &setupFilter,
+                                 long &count,
+                                 QList<int> *progress)
+{
+    // the parallel export runs only for the log file of LogDatabase
+    const QString databaseFile = testDatabaseFile;
+
+    if ( !parallel )
+        testDatabaseFile.clear();
+
+    QString output;
+    QTextStream stream(&output);
+    AdiFormat format(stream);
+
+    if ( setupFilter )
+        setupFilter(format);
+
+    QSignalSpy progressSpy(&format, &LogFormat::exportProgress);
+
+    count = format.runExport();
+    stream.flush();
+
+    testDatabaseFile = databaseFile;
+
+    if ( progress )
+    {
+        for ( int i = 0; i < progressSpy.size(); i++ )
+            progress->append(progressSpy.at(i).at(0).toInt());
+    }
+
+    // the header contains the creation time
+    return output.mid(output.indexOf("<EOH>"));
+}
+
+void LogFormatTest::qslImport_lotwExactMode_confirmsContact()
+{
+    const qulonglong contact = insertContact("K1ABC", "CW", qsoTime);
+    // the same QSO logged by another station callsign is not a candidate
+    const qulonglong otherStation = insertContact("K1ABC", "CW", qsoTime, "OK2XYZ");
+
+    QSLMergeStat stats;
+    QVERIFY(runQSLImport(LogFormat::LOTW, {lotwQSL("K1ABC", "CW", qsoTime.addSecs(300))}, stats));
+
+    QCOMPARE(stats.qsosDownloaded, 1);
+    QCOMPARE(stats.newQSLs.size(), 1);
+    QCOMPARE(stats.unmatchedQSLs.size(), 0);
+    QCOMPARE(stats.errorQSLs.size(), 0);
+    QCOMPARE(contactValue(contact, "lotw_qsl_rcvd").toString(), QString("Y"));
+    QCOMPARE(contactValue(contact, "lotw_qslrdate").toString(), QString("2024-04-01"));
+    QCOMPARE(contactValue(otherStation, "lotw_qsl_rcvd").toString(), QString("N"));
+}
+
+void LogFormatTest::qslImport_lotwModeGroup_fallsBack()
+{
+    const qulonglong groupName = insertContact("K1ABC", "SSB", qsoTime);
+    const qulonglong groupMode = insertContact("K2ABC", "SSB", qsoTime);
+    const qulonglong otherGroup = insertContact("K3ABC", "CW", qsoTime);
+
+    QSLMergeStat stats;
+    // a LoTW mode group name, a mode of the same DXCC group and a mode of another group
+    QVERIFY(runQSLImport(LogFormat::LOTW,
+                         {lotwQSL("K1ABC", "PHONE", qsoTime),
+                          lotwQSL("K2ABC", "AM", qsoTime),
+                          lotwQSL("K3ABC", "RTTY", qsoTime)},
+                         stats));
+
+    QCOMPARE(stats.newQSLs.size(), 2);
+    QCOMPARE(stats.unmatchedQSLs.size(), 1);
+    QVERIFY(stats.unmatchedQSLs.first().contains("K3ABC"));
+    QVERIFY(stats.unmatchedQSLs.first().contains("Reason: no match"));
+    QCOMPARE(contactValue(groupName, "lotw_qsl_rcvd").toString(), QString("Y"));
+    QCOMPARE(contactValue(groupMode, "lotw_qsl_rcvd").toString(), QString("Y"));
+    QCOMPARE(contactValue(otherGroup, "lotw_qsl_rcvd").toString(), QString("N"));
+}
+
+void LogFormatTest::qslImport_lotwMultipleMatches_rejected()
+{
+    const qulonglong first = insertContact("K1ABC", "CW", qsoTime);
+    const qulonglong second = insertContact("K1ABC", "CW", qsoTime.addSecs(1200));
+
+    QSLMergeStat stats;
+    // both contacts are in the 30 minutes window and none has the exact time
+    QVERIFY(runQSLImport(LogFormat::LOTW, {lotwQSL("K1ABC", "CW", qsoTime.addSecs(600))}, stats));
+
+    QCOMPARE(stats.newQSLs.size(), 0);
+    QCOMPARE(stats.unmatchedQSLs.size(), 1);
+    QVERIFY(stats.unmatchedQSLs.first().contains("Reason: multiple matches"));
+    QCOMPARE(contactValue(first, "lotw_qsl_rcvd").toString(), QString("N"));
+    QCOMPARE(contactValue(second, "lotw_qsl_rcvd").toString(), QString("N"));
+}
+
+void LogFormatTest::qslImport_lotwExactTime_selectsContact()
+{
+    const qulonglong first = insertContact("K1ABC", "CW", qsoTime);
+    const qulonglong second = insertContact("K1ABC", "CW", qsoTime.addSecs(1200));
+
+    QSLMergeStat stats;
+    QVERIFY(runQSLImport(LogFormat::LOTW, {lotwQSL("K1ABC", "CW", qsoTime.addSecs(1200))}, stats));
+
+    QCOMPARE(stats.newQSLs.size(), 1);
+    QCOMPARE(stats.unmatchedQSLs.size(), 0);
+    QCOMPARE(contactValue(first, "lotw_qsl_rcvd").toString(), QString("N"));
+    QCOMPARE(contactValue(second, "lotw_qsl_rcvd").toString(), QString("Y"));
+}
+
+void LogFormatTest::qslImport_eqslTimeWindow_is3600s()
+{
+    const qulonglong inWindow = insertContact("K1ABC", "CW", qsoTime);
+    const qulonglong outOfWindow = insertContact("K2ABC", "CW", qsoTime);
+
+    QSLMergeStat stats;
+    QVERIFY(runQSLImport(LogFormat::EQSL,
+                         {eqslQSL("K1ABC", "CW", qsoTime.addSecs(3600)),
+                          eqslQSL("K2ABC", "CW", qsoTime.addSecs(3601))},
+                         stats));
+
+    QCOMPARE(stats.newQSLs.size(), 1);
+    QCOMPARE(stats.unmatchedQSLs.size(), 1);
+    QVERIFY(stats.unmatchedQSLs.first().contains("K2ABC"));
+    QCOMPARE(contactValue(inWindow, "eqsl_qsl_rcvd").toString(), QString("Y"));
+    QCOMPARE(contactValue(outOfWindow, "eqsl_qsl_rcvd").toString(), QString("N"));
+}
+
+void LogFormatTest::qslImport_sameContactTwice_seesFirstUpdate()
+{
+    const qulonglong contact = insertContact("K1ABC", "CW", qsoTime);
+
+    QVariantMap withGrid = lotwQSL("K1ABC", "CW", qsoTime);
+    withGrid.insert("gridsquare", "FN42");
+
+    QSLMergeStat stats;
+    // the first QSL confirms the contact; the second one sees it confirmed
+    // and only fills the empty grid
+    QVERIFY(runQSLImport(LogFormat::LOTW, {lotwQSL("K1ABC", "CW", qsoTime), withGrid}, stats));
+
+    QCOMPARE(stats.qsosDownloaded, 2);
+    QCOMPARE(stats.newQSLs.size(), 1);
+    QCOMPARE(stats.updatedQSOs.size(), 1);
+    QVERIFY(stats.updatedQSOs.first().contains("FN42"));
+    QCOMPARE(contactValue(contact, "lotw_qsl_rcvd").toString(), QString("Y"));
+    QCOMPARE(contactValue(contact, "gridsquare").toString(), QString("FN42"));
+}
+
+void LogFormatTest::qslImport_dxccStatusCache_updatedPerChange()
+{
+    const qulonglong contact = insertContact("K1ABC", "CW", qsoTime);
+    insertContact("K2ABC", "CW", qsoTime);
+
+    QVariantMap withGrid = lotwQSL("K1ABC", "CW", qsoTime);
+    withGrid.insert("gridsquare", "FN42");
+
+    QSLMergeStat stats;
+    // K3ABC is not in the log
+    QVERIFY(runQSLImport(LogFormat::LOTW,
+                         {lotwQSL("K1ABC", "CW", qsoTime),
+                          lotwQSL("K3ABC", "CW", qsoTime),
+                          withGrid},
+                         stats));
+
+    // one update per stored change; each one starts from the previous one
+    QCOMPARE(testDXCCStatusUpdates.size(), 2);
+
+    const QSqlRecord &firstOld = testDXCCStatusUpdates.at(0).first;
+    const QSqlRecord &firstNew = testDXCCStatusUpdates.at(0).second;
+    const QSqlRecord &secondOld = testDXCCStatusUpdates.at(1).first;
+    const QSqlRecord &secondNew = testDXCCStatusUpdates.at(1).second;
+
+    QCOMPARE(firstOld.value("id").toULongLong(), contact);
+    QCOMPARE(firstOld.value("lotw_qsl_rcvd").toString(), QString("N"));
+    QCOMPARE(firstNew.value("lotw_qsl_rcvd").toString(), QString("Y"));
+    QCOMPARE(secondOld.value("lotw_qsl_rcvd").toString(), QString("Y"));
+    QVERIFY(secondOld.value("gridsquare").toString().isEmpty());
+    QCOMPARE(secondNew.value("gridsquare").toString(), QString("FN42"));
+}
+
+void LogFormatTest::qslImport_moreChunks_matchesAll()
+{
+    // more than two QSL_MERGE_CHUNK_SIZE chunks
+    const int qslCount = 2500;
+    QList<QVariantMap> qsls;
+
+    QSqlDatabase::database().transaction();
+
+    for ( int i = 0; i < qslCount; i++ )
+    {
+        const QString callsign = QString("K%1ABC").arg(i);
+
+        QVERIFY(insertContact(callsign, "CW", qsoTime) != 0);
+        qsls << lotwQSL(callsign, "CW", qsoTime);
+    }
+
+    QVERIFY(QSqlDatabase::database().commit());
+
+    QSLMergeStat stats;
+    QVERIFY(runQSLImport(LogFormat::LOTW, qsls, stats));
+
+    QCOMPARE(stats.qsosDownloaded, qslCount);
+    QCOMPARE(stats.newQSLs.size(), qslCount);
+    QCOMPARE(stats.unmatchedQSLs.size(), 0);
+
+    QSqlQuery query;
+    QVERIFY(query.exec("SELECT COUNT(*) FROM contacts WHERE lotw_qsl_rcvd = 'Y'"));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), qslCount);
+}
+
+void LogFormatTest::export_parallel_matchesSerial()
+{
+    if ( QThread::idealThreadCount() < 2 )
+        QSKIP("The parallel export needs at least one worker thread");
+
+    QVERIFY(insertExportContacts(10000));
+
+    // the filters leave more than one EXPORT_CHUNK_SIZE chunk
+    auto setupFilter = [](LogFormat &format)
+    {
+        format.setFilterDateRange(QDate(2024, 3, 10), QDate(2024, 3, 14));
+        format.setFilterMyCallsign("ok2xyz");
+        format.setExportedFields({"callsign", "start_time", "band", "mode", "station_callsign"});
+    };
+
+    long serialCount = 0;
+    const QString serial = exportAdi(false, setupFilter, serialCount);
+
+    QCOMPARE(int(testReadOnlyConnections), 0);
+
+    long parallelCount = 0;
+    const QString parallel = exportAdi(true, setupFilter, parallelCount);
+
+    QVERIFY(int(testReadOnlyConnections) > 0);
+    QVERIFY(serialCount > 2000);
+    QVERIFY(serialCount < 5000);
+    QCOMPARE(parallelCount, serialCount);
+    QVERIFY(!serial.contains("OK1TEST"));
+    QVERIFY(!serial.contains("<GRIDSQUARE", Qt::CaseInsensitive));
+    QVERIFY(parallel == serial);
+}
+
+void LogFormatTest::export_failedChunks_formattedByWriter()
+{
+    if ( QThread::idealThreadCount() < 2 )
+        QSKIP("The parallel export needs at least one worker thread");
+
+    QVERIFY(insertExportContacts(5000));
+
+    long serialCount = 0;
+    const QString serial = exportAdi(false, nullptr, serialCount);
+
+    // the workers get no connection and return every chunk to the writer
+    testReadOnlyConnectionFails = true;
+
+    long parallelCount = 0;
+    const QString parallel = exportAdi(true, nullptr, parallelCount);
+
+    QVERIFY(int(testReadOnlyConnections) > 0);
+    QCOMPARE(serialCount, 5000L);
+    QCOMPARE(parallelCount, serialCount);
+    QVERIFY(parallel == serial);
+}
+
+void LogFormatTest::export_parallel_emitsProgress()
+{
+    if ( QThread::idealThreadCount() < 2 )
+        QSKIP("The parallel export needs at least one worker thread");
+
+    QVERIFY(insertExportContacts(5000));
+
+    long count = 0;
+    QList<int> progress;
+    exportAdi(true, nullptr, count, &progress);
+
+    // one signal per 2000 records chunk and the final one of runExport
+    QCOMPARE(count, 5000L);
+    QCOMPARE(progress, QList<int>({40, 80, 100, 100}));
+}
+
+QTEST_GUILESS_MAIN(LogFormatTest)
+
+#include "tst_logformat.moc"
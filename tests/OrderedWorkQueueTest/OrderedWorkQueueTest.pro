@@ -1,12 +1,12 @@
 QT += testlib core
 CONFIG += console testcase c++11
 TEMPLATE = app
-TARGET = tst_quadkeycache
+TARGET = tst_orderedworkqueue
 
 INCLUDEPATH += $$PWD/../..
 
 SOURCES += \
-    tst_quadkeycache.cpp
+    tst_orderedworkqueue.cpp
 
 HEADERS += \
-    ../../core/QuadKeyCache.h
+    ../../core/OrderedWorkQueue.h
@@ -0,0 +1,135 @@
+#include <QtTest>
+#include <QThread>
+
+#include "core/OrderedWorkQueue.h"
+
+class OrderedWorkQueueTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void singleStageKeepsOrder();
+    void workersKeepParserOrder();
+    void emptyInputFinishes();
+
+private:
+    static QThread *startParser(OrderedWorkQueue<QList<int>> &queue, int batches, int batchSize);
+};
+
+void OrderedWorkQueueTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+}
+
+QThread *OrderedWorkQueueTest::startParser(OrderedWorkQueue<QList<int>> &queue, int batches, int batchSize)
+{
+    QThread *parser = QThread::create([&queue, batches, batchSize]()
+    {
+        int value = 0;
+
+        for ( int i = 0; i < batches; i++ )
+        {
+            QList<int> batch;
+
+            for ( int j = 0; j < batchSize; j++ )
+                batch << value++;
+
+            queue.pushInput(batch);
+        }
+        queue.finishInput();
+    });
+    parser->start();
+    return parser;
+}
+
+void OrderedWorkQueueTest::singleStageKeepsOrder()
+{
+    OrderedWorkQueue<QList<int>> queue(2);
+    QThread *parser = startParser(queue, 50, 10);
+
+    // the writer enriches the batches itself
+    QList<int> written;
+    QList<int> batch;
+    quint64 seq = 0;
+
+    while ( queue.takeInput(seq, batch) )
+    {
+        queue.pushResult(seq, batch);
+        QVERIFY(queue.takeResult(batch));
+        written << batch;
+    }
+
+    QVERIFY(!queue.takeResult(batch));
+    QVERIFY(parser->wait(5000));
+    delete parser;
+
+    QCOMPARE(written.size(), 500);
+    for ( int i = 0; i < written.size(); i++ )
+        QCOMPARE(written.at(i), i);
+}
+
+void OrderedWorkQueueTest::workersKeepParserOrder()
+{
+    OrderedWorkQueue<QList<int>> queue(8);
+    QThread *parser = startParser(queue, 200, 16);
+    QList<QThread *> workers;
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        QThread *worker = QThread::create([&queue, i]()
+        {
+            quint64 seq = 0;
+            QList<int> batch;
+
+            while ( queue.takeInput(seq, batch) )
+            {
+                // finish the batches out of order
+                if ( ( seq + i ) % 3 == 0 )
+                    QThread::usleep(200);
+
+                for ( int &value : batch )
+                    value *= 2;
+
+                queue.pushResult(seq, batch);
+            }
+        });
+        worker->start();
+        workers << worker;
+    }
+
+    QList<int> written;
+    QList<int> batch;
+
+    while ( queue.takeResult(batch) )
+        written << batch;
+
+    QVERIFY(parser->wait(5000));
+    delete parser;
+
+    for ( QThread *worker : workers )
+    {
+        QVERIFY(worker->wait(5000));
+        delete worker;
+    }
+
+    QCOMPARE(written.size(), 200 * 16);
+    for ( int i = 0; i < written.size(); i++ )
+        QCOMPARE(written.at(i), i * 2);
+}
+
+void OrderedWorkQueueTest::emptyInputFinishes()
+{
+    OrderedWorkQueue<QList<int>> queue(1);
+    queue.finishInput();
+
+    QList<int> batch;
+    quint64 seq = 0;
+
+    QVERIFY(!queue.takeInput(seq, batch));
+    QVERIFY(!queue.takeResult(batch));
+}
+
+QTEST_APPLESS_MAIN(OrderedWorkQueueTest)
+
+#include "tst_orderedworkqueue.moc"
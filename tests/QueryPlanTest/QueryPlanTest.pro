@@ -0,0 +1,19 @@
+QT += testlib sql core widgets network
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_queryplan
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_queryplan.cpp \
+    ../../data/ContestDupeIndex.cpp \
+    ../../data/DxccStatusMatrix.cpp
+
+RESOURCES += \
+    ../../res/res.qrc
+
+HEADERS += \
+    ../../core/Migration.h \
+    ../../data/ContestDupeIndex.h \
+    ../../data/DxccStatusMatrix.h
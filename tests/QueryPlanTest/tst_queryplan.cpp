@@ -0,0 +1,251 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QFile>
+#include <QTextStream>
+#include <QRegularExpression>
+
+#include "core/Migration.h"
+#include "data/DxccStatusMatrix.h"
+#include "data/ContestDupeIndex.h"
+#include "logformat/LogFormat.h"
+
+// Query plans of the hot contacts statements on the latest schema.
+// A lookup statement fails when SQLite scans the contacts table (also
+// through an index) or when it stops searching the index designed for it.
+// The statements come from the application code; NewContactWidget and
+// the logbook model cannot be linked here, their statements are copies.
+class QueryPlanTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void hotStatement_usesIndex_data();
+    void hotStatement_usesIndex();
+
+private:
+    QScopedPointer<QTemporaryDir> tempDir;
+
+    static bool executeSqlFile(int version);
+    static QStringList queryPlan(const QString &statement, QString *error);
+    static bool isScan(const QString &detail, const QString &alias);
+    static bool isIndexStep(const QString &detail, const QString &step, const QString &index);
+};
+
+void QueryPlanTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+    Q_INIT_RESOURCE(res);
+
+    tempDir.reset(new QTemporaryDir);
+    QVERIFY(tempDir->isValid());
+
+    QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"));
+    db.setDatabaseName(tempDir->filePath(QStringLiteral("query_plan_test.sqlite")));
+    db.setConnectOptions("QSQLITE_ENABLE_REGEXP");
+    QVERIFY2(db.open(), qPrintable(db.lastError().text()));
+
+    for ( int version = 1; version <= DBSchemaMigration::latestVersion; ++version )
+        QVERIFY2(executeSqlFile(version), qPrintable(QString("Migration %1 failed").arg(version)));
+
+    // created by LogFormat::runQSLImport
+    QSqlQuery query;
+    QVERIFY2(query.exec(LogFormat::qslImportTableStatement()), qPrintable(query.lastError().text()));
+}
+
+void QueryPlanTest::cleanupTestCase()
+{
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        if ( db.isValid() )
+            db.close();
+    }
+    QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
+}
+
+bool QueryPlanTest::executeSqlFile(int version)
+{
+    const QString resourceName = QStringLiteral(":/res/sql/migration_%1.sql")
+                                     .arg(version, 3, 10, QChar('0'));
+    QFile sqlFile(resourceName);
+    if ( !sqlFile.open(QIODevice::ReadOnly | QIODevice::Text) )
+        return false;
+
+    // the same statement split as DBSchemaMigration::runSqlFile
+    const QStringList statements = QTextStream(&sqlFile).readAll().split('\n').join(QStringLiteral(" ")).split(';');
+
+    QSqlDatabase db = QSqlDatabase::database();
+    QSqlQuery query(db);
+
+    if ( !db.transaction() )
+        return false;
+
+    for ( const QString &statement : statements )
+    {
+        const QString trimmed = statement.trimmed();
+        if ( trimmed.isEmpty() )
+            continue;
+
+        if ( !query.exec(trimmed) )
+        {
+            qWarning() << "SQL execution failed for version" << version
+                       << ":" << trimmed << query.lastError();
+            db.rollback();
+            return false;
+        }
+    }
+
+    return db.commit();
+}
+
+QStringList QueryPlanTest::queryPlan(const QString &statement, QString *error)
+{
+    QSqlQuery query;
+    QStringList plan;
+
+    if ( !query.prepare(QStringLiteral("EXPLAIN QUERY PLAN ") + statement) )
+    {
+        *error = query.lastError().text();
+        return plan;
+    }
+
+    // the plan does not depend on the values - all parameters are NULL
+    const int parameterCount = statement.count(QRegularExpression(":[A-Za-z_]\\w*|\\?"));
+
+    for ( int i = 0; i < parameterCount; i++ )
+        query.bindValue(i, QVariant());
+
+    if ( !query.exec() )
+    {
+        *error = query.lastError().text();
+        return plan;
+    }
+
+    // id, parent, notused, detail
+    while ( query.next() )
+        plan << query.value(3).toString();
+
+    return plan;
+}
+
+bool QueryPlanTest::isScan(const QString &detail, const QString &alias)
+{
+    // older SQLite versions print "SCAN TABLE contacts AS c"
+    const QRegularExpression scanRegex(QString("^SCAN (TABLE )?(contacts AS )?%1( |$)").arg(alias));
+
+    return scanRegex.match(detail).hasMatch();
+}
+
+bool QueryPlanTest::isIndexStep(const QString &detail, const QString &step, const QString &index)
+{
+    // e.g. "SEARCH c USING COVERING INDEX contacts_dxcc_status_idx (dxcc=?)"
+    const QRegularExpression stepRegex(QString("^%1 .* USING (COVERING )?INDEX %2( |$)").arg(step, index));
+
+    return stepRegex.match(detail).hasMatch();
+}
+
+void QueryPlanTest::hotStatement_usesIndex_data()
+{
+    QTest::addColumn<QString>("statement");
+    QTest::addColumn<QString>("alias");
+    QTest::addColumn<QString>("expectedStep");
+    QTest::addColumn<QString>("expectedIndex");
+
+    // NewContactWidget - the previous QSO of the callsign (copy)
+    QTest::newRow("prevQSOExactMatch")
+            << "SELECT callsign, name_intl, qth_intl, gridsquare, notes_intl, email, web , darc_dok "
+               "FROM contacts "
+               "WHERE callsign = :exactCallsign "
+               "      AND gridsquare LIKE :grid "
+               "ORDER BY start_time DESC "
+               "LIMIT 1 "
+            << "contacts" << "SEARCH" << "contacts_callsign_start_time_idx";
+
+    // the contacts row is read by its rowid
+    QTest::newRow("prevQSOBaseCallMatch")
+            << "SELECT callsign, name_intl, qth_intl, gridsquare, notes_intl, email, web , darc_dok "
+               "FROM contacts c "
+               "  INNER JOIN contacts_autovalue a ON c.id = a.contactid "
+               "WHERE a.base_callsign = :partialCallsign "
+               "ORDER BY start_time DESC "
+               "LIMIT 1"
+            << "c" << "SEARCH" << "contacts_autovalue_call_idx";
+
+    // NewContactWidget - the dupe check of the QSOs from external applications (copy)
+    QTest::newRow("externalDupeCheck")
+            << "SELECT id FROM contacts "
+               "WHERE strftime('%Y-%m-%d %H:%M:%S', start_time) = strftime('%Y-%m-%d %H:%M:%S', :starttime) "
+               "      AND callsign = :callsign "
+               "      AND (CAST(ROUND(freq * 1000000.0) AS INTEGER) = :freq_hz OR band = :band) "
+               "      AND +mode = :mode "
+               "LIMIT 1"
+            << "contacts" << "SEARCH" << "contacts_callsign_start_time_idx";
+
+    // DxccStatusMatrix - the status of one DXCC entity
+    QTest::newRow("dxccStatus")
+            << DxccStatusMatrix::aggregateStatement(true)
+            << "c" << "SEARCH" << "contacts_dxcc_status_idx";
+
+    // ContestDupeIndex - Data::countDupe
+    QTest::newRow("contestDupe")
+            << ContestDupeIndex::selectStatement()
+            << "c" << "SEARCH" << "contacts_contest_id_idx";
+
+    // LogFormat::runQSLImport
+    QTest::newRow("qslImportMatchLoTW")
+            << LogFormat::qslImportMatchStatement(LogFormat::LOTW)
+            << "c" << "SEARCH" << "contacts_callsign_start_time_idx";
+
+    QTest::newRow("qslImportMatchEQSL")
+            << LogFormat::qslImportMatchStatement(LogFormat::EQSL)
+            << "c" << "SEARCH" << "contacts_callsign_start_time_idx";
+
+    // LogbookWidget - the sorted logbook and the callsign filter (the statements of LogbookModel)
+    // the whole logbook is read in the index order, without sorting
+    QTest::newRow("logbookSorted")
+            << "SELECT * FROM contacts ORDER BY start_time DESC"
+            << "contacts" << "SCAN" << "contacts_start_time_idx";
+
+    QTest::newRow("logbookCallsignFilter")
+            << "SELECT * FROM contacts WHERE callsign = :callsign ORDER BY start_time DESC"
+            << "contacts" << "SEARCH" << "contacts_callsign_start_time_idx";
+}
+
+void QueryPlanTest::hotStatement_usesIndex()
+{
+    QFETCH(QString, statement);
+    QFETCH(QString, alias);
+    QFETCH(QString, expectedStep);
+    QFETCH(QString, expectedIndex);
+
+    QString error;
+    const QStringList plan = queryPlan(statement, &error);
+
+    QVERIFY2(error.isEmpty(), qPrintable(error));
+    QVERIFY(!plan.isEmpty());
+
+    const QString planText = plan.join(QLatin1String("\n"));
+    bool indexStepFound = false;
+
+    for ( const QString &detail : plan )
+    {
+        // a lookup must not scan contacts - not even through an index
+        if ( expectedStep != QLatin1String("SCAN") )
+            QVERIFY2(!isScan(detail, alias),
+                     qPrintable(QString("Scan of contacts:\n%1").arg(planText)));
+
+        if ( isIndexStep(detail, expectedStep, expectedIndex) )
+            indexStepFound = true;
+    }
+
+    QVERIFY2(indexStepFound,
+             qPrintable(QString("No %1 using %2:\n%3").arg(expectedStep, expectedIndex, planText)));
+}
+
+QTEST_APPLESS_MAIN(QueryPlanTest)
+
+#include "tst_queryplan.moc"
@@ -0,0 +1,13 @@
+QT += testlib core sql
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_refstringtable
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_refstringtable.cpp \
+    ../../data/RefStringTable.cpp
+
+HEADERS += \
+    ../../data/RefStringTable.h
@@ -0,0 +1,185 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+
+#include "data/RefStringTable.h"
+
+static QStringList keys(const RefStringTable::Ptr &table)
+{
+    QStringList ret;
+
+    for ( int i = 0; i < table->size(); ++i )
+        ret << table->key(i);
+
+    return ret;
+}
+
+class RefStringTableTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void sortedKeys();
+    void values();
+    void membership_data();
+    void membership();
+    void prefixRange_data();
+    void prefixRange();
+    void emptyTable();
+    void matchesMap();
+
+private:
+    RefStringTable::Ptr sota;
+    RefStringTable::Ptr iota;
+};
+
+void RefStringTableTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(":memory:");
+    QVERIFY(db.open());
+
+    QSqlQuery query;
+    QVERIFY2(query.exec("CREATE TABLE sota_summits (summit_code TEXT)"), qPrintable(query.lastError().text()));
+    QVERIFY2(query.exec("INSERT INTO sota_summits VALUES "
+                        "('OK/US-001'), ('G/LD-001'), ('OK/JC-001'), ('OK/US-010'), ('OK/JC-001'), "
+                        "('DL/AM-001'), ('OK/US-002'), ('OE/TI-001')"),
+             qPrintable(query.lastError().text()));
+    QVERIFY2(query.exec("CREATE TABLE iota (iotaid TEXT, islandname TEXT)"), qPrintable(query.lastError().text()));
+    QVERIFY2(query.exec("INSERT INTO iota VALUES "
+                        "('EU-005', 'Great Britain'), ('AF-001', 'Agalega Islands'), ('EU-001', 'Åland Islands')"),
+             qPrintable(query.lastError().text()));
+
+    sota = RefStringTable::load("SELECT summit_code FROM sota_summits");
+    iota = RefStringTable::load("SELECT iotaid, islandname FROM iota");
+
+    QVERIFY(sota);
+    QVERIFY(iota);
+}
+
+void RefStringTableTest::cleanupTestCase()
+{
+    sota.reset();
+    iota.reset();
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(QSqlDatabase::defaultConnection);
+}
+
+void RefStringTableTest::sortedKeys()
+{
+    const QStringList expected = {"DL/AM-001", "G/LD-001", "OE/TI-001", "OK/JC-001",
+                                  "OK/US-001", "OK/US-002", "OK/US-010"};
+
+    QCOMPARE(sota->size(), expected.size());
+    QCOMPARE(keys(sota), expected);
+    QVERIFY(!sota->hasValues());
+    QCOMPARE(sota->value(0), QString());
+}
+
+void RefStringTableTest::values()
+{
+    QVERIFY(iota->hasValues());
+    QCOMPARE(keys(iota), QStringList({"AF-001", "EU-001", "EU-005"}));
+    QCOMPARE(iota->value(0), QStringLiteral("Agalega Islands"));
+    QCOMPARE(iota->value(1), QStringLiteral("Åland Islands"));
+    QCOMPARE(iota->value(2), QStringLiteral("Great Britain"));
+    QCOMPARE(iota->key(-1), QString());
+    QCOMPARE(iota->value(iota->size()), QString());
+}
+
+void RefStringTableTest::membership_data()
+{
+    QTest::addColumn<QString>("key");
+    QTest::addColumn<bool>("expected");
+
+    QTest::newRow("first") << "DL/AM-001" << true;
+    QTest::newRow("last") << "OK/US-010" << true;
+    QTest::newRow("middle") << "OK/JC-001" << true;
+    QTest::newRow("prefixOnly") << "OK/US" << false;
+    QTest::newRow("longer") << "OK/US-0010" << false;
+    QTest::newRow("lowercase") << "ok/us-001" << false;
+    QTest::newRow("beforeFirst") << "A" << false;
+    QTest::newRow("afterLast") << "ZZZ" << false;
+    QTest::newRow("empty") << "" << false;
+}
+
+void RefStringTableTest::membership()
+{
+    QFETCH(QString, key);
+    QFETCH(bool, expected);
+
+    QCOMPARE(sota->contains(key), expected);
+
+    if ( expected )
+        QCOMPARE(sota->key(sota->indexOf(key)), key);
+}
+
+void RefStringTableTest::prefixRange_data()
+{
+    QTest::addColumn<QString>("prefix");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("association") << "OK/" << QStringList{"OK/JC-001", "OK/US-001", "OK/US-002", "OK/US-010"};
+    QTest::newRow("region") << "OK/US-00" << QStringList{"OK/US-001", "OK/US-002"};
+    QTest::newRow("exact") << "G/LD-001" << QStringList{"G/LD-001"};
+    QTest::newRow("first") << "D" << QStringList{"DL/AM-001"};
+    QTest::newRow("none") << "SP/" << QStringList();
+    QTest::newRow("beforeFirst") << "A" << QStringList();
+    QTest::newRow("afterLast") << "Z" << QStringList();
+    QTest::newRow("all") << "" << keys(sota);
+}
+
+void RefStringTableTest::prefixRange()
+{
+    QFETCH(QString, prefix);
+    QFETCH(QStringList, expected);
+
+    const QPair<int, int> range = sota->prefixRange(prefix);
+    QStringList rangeKeys;
+
+    for ( int i = range.first; i < range.second; ++i )
+        rangeKeys << sota->key(i);
+
+    QCOMPARE(rangeKeys, expected);
+}
+
+void RefStringTableTest::emptyTable()
+{
+    const RefStringTable::Ptr empty = RefStringTable::load("SELECT summit_code FROM sota_summits WHERE 0 = 1");
+
+    QVERIFY(empty->isEmpty());
+    QCOMPARE(empty->size(), 0);
+    QCOMPARE(empty->key(0), QString());
+    QVERIFY(!empty->contains("OK/US-001"));
+    QCOMPARE(empty->prefixRange("OK"), qMakePair(0, 0));
+
+    // an invalid statement returns a null pointer, so the caller does not
+    // keep an empty table and can try again
+    const RefStringTable::Ptr invalid = RefStringTable::load("SELECT nothing FROM missing_table");
+    QVERIFY(!invalid);
+}
+
+void RefStringTableTest::matchesMap()
+{
+    // the table must return the same keys as the former QMap based lists
+    QMap<QString, QString> map;
+    QSqlQuery query("SELECT summit_code FROM sota_summits");
+
+    while ( query.next() )
+        map.insert(query.value(0).toString(), QString());
+
+    QCOMPARE(keys(sota), map.keys());
+}
+
+QTEST_APPLESS_MAIN(RefStringTableTest)
+
+#include "tst_refstringtable.moc"
@@ -0,0 +1,15 @@
+QT += testlib core sql
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_sqlbulkload
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_sqlbulkload.cpp \
+    ../../core/SQLBulkLoad.cpp \
+    ../../core/SQLTuning.cpp
+
+HEADERS += \
+    ../../core/SQLBulkLoad.h \
+    ../../core/SQLTuning.h
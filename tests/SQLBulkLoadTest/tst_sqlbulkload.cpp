@@ -0,0 +1,195 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+
+#include "core/SQLBulkLoad.h"
+
+class SQLBulkLoadTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+
+    void pragmasAreRestored();
+    void autovalueMatchesTrigger();
+    void rollbackKeepsTrigger();
+
+private:
+    static bool triggerExists(const QString &name);
+    static QList<QPair<qulonglong, QVariant>> autovalues();
+    static qulonglong insertContact(QSqlQuery &insert, const QString &callsign);
+
+    const QStringList callsigns = {"OK1ABC", "OK1ABC/P", "DL/OK1XYZ", "VP2E/K1ABC", "XX", "2E0ABC/M"};
+};
+
+void SQLBulkLoadTest::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(":memory:");
+    db.setConnectOptions("QSQLITE_ENABLE_REGEXP");
+    QVERIFY(db.open());
+
+    QSqlQuery query;
+    QVERIFY(query.exec("CREATE TABLE contacts (id INTEGER PRIMARY KEY, callsign TEXT)"));
+    QVERIFY(query.exec("CREATE TABLE contacts_autovalue (contactid INTEGER PRIMARY KEY, base_callsign TEXT)"));
+
+    // the same trigger as DBSchemaMigration::createTriggers creates
+    QVERIFY2(query.exec("CREATE TRIGGER insert_contacts_autovalue "
+                        "AFTER INSERT ON contacts "
+                        "FOR EACH ROW "
+                        "BEGIN "
+                        "  INSERT OR REPLACE INTO contacts_autovalue (contactid, base_callsign) "
+                        "  VALUES (NEW.id, (WITH tokenizedCallsign(word, csv) AS ( SELECT '', NEW.callsign||'/' "
+                        "                                                UNION ALL "
+                        "                                                SELECT substr(csv, 0, instr(csv, '/')), substr(csv, instr(csv, '/') + 1) "
+                        "                                                FROM tokenizedCallsign "
+                        "                                                WHERE csv != '' ) "
+                        "                   SELECT word FROM tokenizedCallsign "
+                        "                   WHERE word != '' and word REGEXP '^([A-Z][0-9]|[A-Z]{1,2}|[0-9][A-Z])([0-9]|[0-9]+)([A-Z]+)$' LIMIT 1)); "
+                        "END;"),
+             qPrintable(query.lastError().text()));
+}
+
+void SQLBulkLoadTest::cleanupTestCase()
+{
+    QSqlDatabase::database().close();
+}
+
+void SQLBulkLoadTest::init()
+{
+    QSqlQuery query;
+    QVERIFY(query.exec("DELETE FROM contacts"));
+    QVERIFY(query.exec("DELETE FROM contacts_autovalue"));
+}
+
+bool SQLBulkLoadTest::triggerExists(const QString &name)
+{
+    QSqlQuery query;
+    query.prepare("SELECT 1 FROM sqlite_master WHERE type = 'trigger' AND name = :name");
+    query.bindValue(":name", name);
+    return query.exec() && query.next();
+}
+
+QList<QPair<qulonglong, QVariant>> SQLBulkLoadTest::autovalues()
+{
+    QList<QPair<qulonglong, QVariant>> ret;
+    QSqlQuery query("SELECT contactid, base_callsign FROM contacts_autovalue ORDER BY contactid");
+
+    while ( query.next() )
+        ret << qMakePair(query.value(0).toULongLong(), query.value(1));
+
+    return ret;
+}
+
+qulonglong SQLBulkLoadTest::insertContact(QSqlQuery &insert, const QString &callsign)
+{
+    insert.bindValue(0, callsign);
+    if ( !insert.exec() )
+        return 0;
+    return insert.lastInsertId().toULongLong();
+}
+
+void SQLBulkLoadTest::pragmasAreRestored()
+{
+    QSqlQuery query;
+
+    QVERIFY(query.exec("PRAGMA cache_size") && query.next());
+    const int cacheSize = query.value(0).toInt();
+    QVERIFY(query.exec("PRAGMA temp_store") && query.next());
+    const int tempStore = query.value(0).toInt();
+
+    {
+        SQLBulkLoad bulkLoad(QSqlDatabase::database(), 32 * 1024);
+
+        QVERIFY(query.exec("PRAGMA cache_size") && query.next());
+        QCOMPARE(query.value(0).toInt(), -32 * 1024);
+        QVERIFY(query.exec("PRAGMA temp_store") && query.next());
+        QCOMPARE(query.value(0).toInt(), 2);
+    }
+
+    QVERIFY(query.exec("PRAGMA cache_size") && query.next());
+    QCOMPARE(query.value(0).toInt(), cacheSize);
+    QVERIFY(query.exec("PRAGMA temp_store") && query.next());
+    QCOMPARE(query.value(0).toInt(), tempStore);
+}
+
+void SQLBulkLoadTest::autovalueMatchesTrigger()
+{
+    QSqlQuery insert;
+    QVERIFY(insert.prepare("INSERT INTO contacts (callsign) VALUES (?)"));
+
+    // per-row trigger
+    for ( const QString &callsign : callsigns )
+        QVERIFY(insertContact(insert, callsign) != 0);
+
+    QList<QPair<qulonglong, QVariant>> expected = autovalues();
+    QCOMPARE(expected.size(), callsigns.size());
+
+    // bulk load - the trigger is suspended, the values are filled at the end
+    {
+        SQLBulkLoad bulkLoad;
+
+        QVERIFY(QSqlDatabase::database().transaction());
+        QVERIFY(bulkLoad.suspendContactTriggers());
+        QVERIFY(!triggerExists("insert_contacts_autovalue"));
+
+        QVariantList column;
+        for ( const QString &callsign : callsigns )
+            column << callsign;
+
+        insert.bindValue(0, column);
+        QVERIFY2(insert.execBatch(), qPrintable(insert.lastError().text()));
+
+        const qulonglong lastId = insert.lastInsertId().toULongLong();
+        bulkLoad.addInsertedContacts(lastId - callsigns.size() + 1, lastId);
+
+        // nothing was written by the suspended trigger
+        QCOMPARE(autovalues().size(), callsigns.size());
+
+        QVERIFY(bulkLoad.finishContacts());
+        QVERIFY(QSqlDatabase::database().commit());
+    }
+
+    QVERIFY(triggerExists("insert_contacts_autovalue"));
+
+    const QList<QPair<qulonglong, QVariant>> values = autovalues();
+    QCOMPARE(values.size(), callsigns.size() * 2);
+
+    for ( int i = 0; i < callsigns.size(); i++ )
+    {
+        QCOMPARE(values.at(i + callsigns.size()).first, values.at(i).first + callsigns.size());
+        QCOMPARE(values.at(i + callsigns.size()).second, expected.at(i).second);
+    }
+
+    // the resumed trigger works again
+    const qulonglong id = insertContact(insert, "OK1ABC/P");
+    QVERIFY(id != 0);
+    QCOMPARE(autovalues().last().first, id);
+    QCOMPARE(autovalues().last().second.toString(), QString("OK1ABC"));
+}
+
+void SQLBulkLoadTest::rollbackKeepsTrigger()
+{
+    {
+        SQLBulkLoad bulkLoad;
+
+        QVERIFY(QSqlDatabase::database().transaction());
+        QVERIFY(bulkLoad.suspendContactTriggers());
+        QVERIFY(!triggerExists("insert_contacts_autovalue"));
+        QVERIFY(QSqlDatabase::database().rollback());
+        QVERIFY(triggerExists("insert_contacts_autovalue"));
+    }
+
+    // the destructor does not create it twice
+    QVERIFY(triggerExists("insert_contacts_autovalue"));
+}
+
+QTEST_APPLESS_MAIN(SQLBulkLoadTest)
+
+#include "tst_sqlbulkload.moc"
@@ -0,0 +1,17 @@
+QT += testlib core sql
+CONFIG += console testcase c++11
+TEMPLATE = app
+TARGET = tst_sqltuningbenchmark
+
+INCLUDEPATH += $$PWD/../..
+
+SOURCES += \
+    tst_sqltuningbenchmark.cpp \
+    ../../core/SQLTuning.cpp
+
+HEADERS += \
+    ../../core/Migration.h \
+    ../../core/SQLTuning.h
+
+RESOURCES += \
+    ../../res/res.qrc
@@ -0,0 +1,469 @@
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimeZone>
+
+#include "core/Migration.h"
+#include "core/SQLTuning.h"
+
+// Measures the main database workloads under every tuning profile and
+// under the SQLite defaults (the baseline) on a file database in WAL mode
+// (the in-memory database ignores synchronous and mmap_size):
+//   import         - contacts inserted by execBatch in one transaction (ADIF import, LOV)
+//   log_qso        - contacts inserted one by one, a commit per QSO (interactive logging)
+//   logbook_select - the sorted logbook and callsign filtered views
+//   dupe_check     - the duplicate QSO statement
+// Set QLOG_RUN_SQL_TUNING_BENCHMARK=1 to run it; the results are printed by qInfo.
+class SQLTuningBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+    void benchmarkProfiles_data();
+    void benchmarkProfiles();
+
+private:
+    static bool benchmarkEnabled();
+    static bool executeSqlFile(int version, QString *error);
+    static bool openDatabase(const QString &fileName, QString *error);
+    static void closeDatabase();
+    static bool applyProfile(int profile);
+    static QString profileName(int profile);
+    static QString sampleCallsign(int index);
+    static QString sampleBand(int index);
+    static QString sampleMode(int index);
+    static QString sampleStartTime(int index);
+    static qint64 measureImport(int count, QString *error);
+    static qint64 measureLogQSO(int firstIndex, int count, QString *error);
+    static qint64 measureLogbookSelect(int *rows, QString *error);
+    static qint64 measureDupeCheck(int count, int *hits, QString *error);
+
+    // the connection keeps the SQLite defaults
+    static const int SQLITE_DEFAULT = -1;
+    static const int CHUNK_SIZE = 500;
+    static const int CALLSIGN_COUNT = 20000;
+};
+
+void SQLTuningBenchmark::initTestCase()
+{
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+    Q_INIT_RESOURCE(res);
+}
+
+void SQLTuningBenchmark::cleanup()
+{
+    closeDatabase();
+}
+
+void SQLTuningBenchmark::benchmarkProfiles_data()
+{
+    QTest::addColumn<int>("profile");
+    QTest::addColumn<int>("recordCount");
+
+    QTest::newRow("sqlite_default 100k") << static_cast<int>(SQLITE_DEFAULT) << 100000;
+    QTest::newRow("interactive 100k") << static_cast<int>(SQLTuning::INTERACTIVE) << 100000;
+    QTest::newRow("bulk_load 100k") << static_cast<int>(SQLTuning::BULK_LOAD) << 100000;
+    QTest::newRow("low_memory 100k") << static_cast<int>(SQLTuning::LOW_MEMORY) << 100000;
+}
+
+void SQLTuningBenchmark::benchmarkProfiles()
+{
+    if ( !benchmarkEnabled() )
+        QSKIP("Set QLOG_RUN_SQL_TUNING_BENCHMARK=1 to run the SQL tuning benchmark.");
+
+    QFETCH(int, profile);
+    QFETCH(int, recordCount);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("qlog.db"));
+
+    QString error;
+    QVERIFY2(openDatabase(fileName, &error), qPrintable(error));
+
+    for ( int version = 1; version <= DBSchemaMigration::latestVersion; ++version )
+        QVERIFY2(executeSqlFile(version, &error), qPrintable(error));
+
+    QVERIFY(applyProfile(profile));
+
+    const SQLTuning::Settings current = SQLTuning::currentSettings();
+
+    // the profile must be really active on the connection
+    if ( profile != SQLITE_DEFAULT )
+    {
+        const SQLTuning::Settings expected = SQLTuning::profileSettings(static_cast<SQLTuning::Profile>(profile));
+        QCOMPARE(current.synchronous, expected.synchronous);
+        QCOMPARE(current.cacheSizeKiB, expected.cacheSizeKiB);
+        QCOMPARE(current.mmapSize, expected.mmapSize);
+        QCOMPARE(current.tempStore, expected.tempStore);
+        QCOMPARE(current.walAutocheckpoint, expected.walAutocheckpoint);
+    }
+
+    const qint64 importMs = measureImport(recordCount, &error);
+    QVERIFY2(importMs >= 0, qPrintable(error));
+
+    // a new connection - the reads start with an empty page cache
+    closeDatabase();
+    QVERIFY2(openDatabase(fileName, &error), qPrintable(error));
+    QVERIFY(applyProfile(profile));
+
+    int selectedRows = 0;
+    const qint64 selectMs = measureLogbookSelect(&selectedRows, &error);
+    QVERIFY2(selectMs >= 0, qPrintable(error));
+    QVERIFY(selectedRows >= recordCount);
+
+    int dupeHits = 0;
+    const qint64 dupeMs = measureDupeCheck(10000, &dupeHits, &error);
+    QVERIFY2(dupeMs >= 0, qPrintable(error));
+    QCOMPARE(dupeHits, 10000);
+
+    const int logCount = 1000;
+    const qint64 logQSOMs = measureLogQSO(recordCount, logCount, &error);
+    QVERIFY2(logQSOMs >= 0, qPrintable(error));
+
+    QSqlQuery countQuery(QStringLiteral("SELECT COUNT(*) FROM contacts"));
+    QVERIFY(countQuery.next());
+    QCOMPARE(countQuery.value(0).toInt(), recordCount + logCount);
+
+    const QString report =
+        QStringLiteral("SQL tuning benchmark: profile=%1, records=%2, "
+                       "import_ms=%3, import_rows_per_s=%4, "
+                       "log_qso_ms=%5, log_qso_per_s=%6, "
+                       "logbook_select_ms=%7, dupe_check_ms=%8, dupe_checks_per_s=%9, db_kB=%10, "
+                       "synchronous=%11, cache_size_KiB=%12, mmap_size=%13")
+            .arg(profileName(profile))
+            .arg(recordCount)
+            .arg(importMs)
+            .arg(recordCount * 1000LL / qMax<qint64>(1, importMs))
+            .arg(logQSOMs)
+            .arg(logCount * 1000LL / qMax<qint64>(1, logQSOMs))
+            .arg(selectMs)
+            .arg(dupeMs)
+            .arg(10000 * 1000LL / qMax<qint64>(1, dupeMs))
+            .arg(QFileInfo(fileName).size() / 1024)
+            .arg(current.synchronous)
+            .arg(current.cacheSizeKiB)
+            .arg(current.mmapSize);
+
+    qInfo().noquote() << report;
+}
+
+bool SQLTuningBenchmark::benchmarkEnabled()
+{
+    return qEnvironmentVariableIntValue("QLOG_RUN_SQL_TUNING_BENCHMARK") != 0;
+}
+
+bool SQLTuningBenchmark::applyProfile(int profile)
+{
+    if ( profile == SQLITE_DEFAULT )
+        return true;
+
+    return SQLTuning::apply(static_cast<SQLTuning::Profile>(profile));
+}
+
+QString SQLTuningBenchmark::profileName(int profile)
+{
+    if ( profile == SQLITE_DEFAULT )
+        return QStringLiteral("sqlite_default");
+
+    return SQLTuning::profileName(static_cast<SQLTuning::Profile>(profile));
+}
+
+bool SQLTuningBenchmark::executeSqlFile(int version, QString *error)
+{
+    const QString resourceName = QStringLiteral(":/res/sql/migration_%1.sql")
+                                     .arg(version, 3, 10, QLatin1Char('0'));
+    QFile sqlFile(resourceName);
+    if ( !sqlFile.open(QIODevice::ReadOnly | QIODevice::Text) )
+    {
+        *error = QStringLiteral("Cannot open %1").arg(resourceName);
+        return false;
+    }
+
+    const QString sqlContent = QTextStream(&sqlFile).readAll();
+    const QStringList statements = sqlContent.split(QLatin1Char('\n'))
+                                       .join(QStringLiteral(" "))
+                                       .split(QLatin1Char(';'));
+
+    QSqlDatabase db = QSqlDatabase::database();
+    QSqlQuery query(db);
+
+    if ( !db.transaction() )
+    {
+        *error = db.lastError().text();
+        return false;
+    }
+
+    for ( const QString &statement : statements )
+    {
+        const QString trimmed = statement.trimmed();
+        if ( trimmed.isEmpty() )
+            continue;
+
+        if ( !query.exec(trimmed) )
+        {
+            *error = QStringLiteral("Migration %1 failed: %2\n%3")
+                         .arg(version, 3, 10, QLatin1Char('0'))
+                         .arg(query.lastError().text(), trimmed);
+            db.rollback();
+            return false;
+        }
+    }
+
+    return db.commit();
+}
+
+bool SQLTuningBenchmark::openDatabase(const QString &fileName, QString *error)
+{
+    QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"));
+    db.setDatabaseName(fileName);
+    db.setConnectOptions(QStringLiteral("QSQLITE_ENABLE_REGEXP"));
+
+    if ( !db.open() )
+    {
+        *error = db.lastError().text();
+        return false;
+    }
+
+    // the same connection setup as LogDatabase::openDatabase
+    QSqlQuery query;
+    if ( !query.exec(QStringLiteral("PRAGMA foreign_keys = ON"))
+         || !query.exec(QStringLiteral("PRAGMA journal_mode = WAL")) )
+    {
+        *error = query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+void SQLTuningBenchmark::closeDatabase()
+{
+    const QString connectionName = QString::fromLatin1(QSqlDatabase::defaultConnection);
+    if ( !QSqlDatabase::contains(connectionName) )
+        return;
+
+    {
+        QSqlDatabase db = QSqlDatabase::database();
+        if ( db.isValid() )
+            db.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+QString SQLTuningBenchmark::sampleCallsign(int index)
+{
+    static const char *prefixes[] = {"OK", "DL", "K", "JA", "PY", "VK", "G", "F", "SP", "UA"};
+    const int callIndex = index % CALLSIGN_COUNT;
+
+    return QString::fromLatin1(prefixes[callIndex % 10])
+           + QString::number(callIndex % 10)
+           + QString(QChar('A' + (callIndex / 10) % 26))
+           + QString(QChar('A' + (callIndex / 260) % 26))
+           + QString(QChar('A' + (callIndex / 6760) % 26));
+}
+
+QString SQLTuningBenchmark::sampleBand(int index)
+{
+    static const char *bands[] = {"160m", "80m", "40m", "30m", "20m", "17m", "15m", "12m", "10m", "6m"};
+    return QString::fromLatin1(bands[(index / 7) % 10]);
+}
+
+QString SQLTuningBenchmark::sampleMode(int index)
+{
+    static const char *modes[] = {"CW", "SSB", "FT8", "RTTY"};
+    return QString::fromLatin1(modes[(index / 3) % 4]);
+}
+
+QString SQLTuningBenchmark::sampleStartTime(int index)
+{
+    static const QDateTime base(QDate(2010, 1, 1), QTime(0, 0, 0), QTimeZone::utc());
+    return base.addSecs(index * 173LL).toString(QStringLiteral("yyyy-MM-dd hh:mm:ss"));
+}
+
+qint64 SQLTuningBenchmark::measureImport(int count, QString *error)
+{
+    QSqlQuery insert;
+    if ( !insert.prepare(QStringLiteral("INSERT INTO contacts "
+                                        "(start_time, end_time, callsign, rst_sent, rst_rcvd, freq, band, mode, "
+                                        " name, qth, gridsquare, dxcc, country, comment, station_callsign, my_dxcc) "
+                                        "VALUES (?, ?, ?, '599', '599', 14.025, ?, ?, "
+                                        " 'Name', 'QTH', 'JO70AA', 503, 'Czech Republic', ?, 'OK1QLOG', 503)")) )
+    {
+        *error = insert.lastError().text();
+        return -1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlDatabase::database().transaction();
+
+    for ( int i = 0; i < count; i += CHUNK_SIZE )
+    {
+        QVariantList startTimes, callsigns, bands, modes, comments;
+
+        for ( int j = i; j < qMin(count, i + CHUNK_SIZE); ++j )
+        {
+            startTimes << sampleStartTime(j);
+            callsigns << sampleCallsign(j);
+            bands << sampleBand(j);
+            modes << sampleMode(j);
+            comments << QStringLiteral("benchmark comment %1").arg(j);
+        }
+
+        insert.addBindValue(startTimes);
+        insert.addBindValue(startTimes);
+        insert.addBindValue(callsigns);
+        insert.addBindValue(bands);
+        insert.addBindValue(modes);
+        insert.addBindValue(comments);
+
+        if ( !insert.execBatch() )
+        {
+            *error = insert.lastError().text();
+            QSqlDatabase::database().rollback();
+            return -1;
+        }
+    }
+
+    if ( !QSqlDatabase::database().commit() )
+    {
+        *error = QSqlDatabase::database().lastError().text();
+        return -1;
+    }
+
+    return timer.elapsed();
+}
+
+qint64 SQLTuningBenchmark::measureLogQSO(int firstIndex, int count, QString *error)
+{
+    QSqlQuery insert;
+    if ( !insert.prepare(QStringLiteral("INSERT INTO contacts (start_time, end_time, callsign, band, mode) "
+                                        "VALUES (?, ?, ?, ?, ?)")) )
+    {
+        *error = insert.lastError().text();
+        return -1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // autocommit - every QSO is one transaction as in the New QSO widget
+    for ( int i = firstIndex; i < firstIndex + count; ++i )
+    {
+        insert.bindValue(0, sampleStartTime(i));
+        insert.bindValue(1, sampleStartTime(i));
+        insert.bindValue(2, sampleCallsign(i));
+        insert.bindValue(3, sampleBand(i));
+        insert.bindValue(4, sampleMode(i));
+
+        if ( !insert.exec() )
+        {
+            *error = insert.lastError().text();
+            return -1;
+        }
+    }
+
+    return timer.elapsed();
+}
+
+qint64 SQLTuningBenchmark::measureLogbookSelect(int *rows, QString *error)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    int count = 0;
+
+    // the whole logbook sorted as the logbook view does
+    QSqlQuery query;
+    query.setForwardOnly(true);
+    if ( !query.exec(QStringLiteral("SELECT * FROM contacts ORDER BY start_time DESC")) )
+    {
+        *error = query.lastError().text();
+        return -1;
+    }
+
+    while ( query.next() )
+        ++count;
+
+    // callsign filters of the logbook
+    QSqlQuery filterQuery;
+    filterQuery.setForwardOnly(true);
+    if ( !filterQuery.prepare(QStringLiteral("SELECT * FROM contacts WHERE callsign = ? ORDER BY start_time DESC")) )
+    {
+        *error = filterQuery.lastError().text();
+        return -1;
+    }
+
+    for ( int i = 0; i < 500; ++i )
+    {
+        filterQuery.bindValue(0, sampleCallsign(i * 37));
+
+        if ( !filterQuery.exec() )
+        {
+            *error = filterQuery.lastError().text();
+            return -1;
+        }
+
+        while ( filterQuery.next() )
+            ++count;
+    }
+
+    *rows = count;
+    return timer.elapsed();
+}
+
+qint64 SQLTuningBenchmark::measureDupeCheck(int count, int *hits, QString *error)
+{
+    QSqlQuery dupQuery;
+    if ( !dupQuery.prepare(QStringLiteral("SELECT * FROM contacts "
+                                          "WHERE callsign=upper(:callsign) "
+                                          "AND upper(mode)=upper(:mode) "
+                                          "AND upper(band)=upper(:band) "
+                                          "AND COALESCE(sat_name, '') = COALESCE(:sat_name, '') "
+                                          "AND ABS(JULIANDAY(start_time)-JULIANDAY(datetime(:startdate)))*24*60<30")) )
+    {
+        *error = dupQuery.lastError().text();
+        return -1;
+    }
+
+    int found = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    // every checked QSO is in the log
+    for ( int i = 0; i < count; ++i )
+    {
+        const int index = i * 7;
+
+        dupQuery.bindValue(QStringLiteral(":callsign"), sampleCallsign(index));
+        dupQuery.bindValue(QStringLiteral(":mode"), sampleMode(index));
+        dupQuery.bindValue(QStringLiteral(":band"), sampleBand(index));
+        dupQuery.bindValue(QStringLiteral(":sat_name"), QString());
+        dupQuery.bindValue(QStringLiteral(":startdate"), sampleStartTime(index));
+
+        if ( !dupQuery.exec() )
+        {
+            *error = dupQuery.lastError().text();
+            return -1;
+        }
+
+        if ( dupQuery.next() )
+            ++found;
+    }
+
+    *hits = found;
+    return timer.elapsed();
+}
+
+QTEST_APPLESS_MAIN(SQLTuningBenchmark)
+
+#include "tst_sqltuningbenchmark.moc"
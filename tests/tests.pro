@@ -5,17 +5,30 @@ SUBDIRS += CallsignTest \
            AdiImportBenchmark \
            AdxFormatTest \
            AdifRecoveryTest \
+           ContestDupeIndexTest \
            CredentialStoreTest \
            DataTest \
+           DBTaskExecutorTest \
+           DatabaseBackupTest \
+           DXCCCreditIndexTest \
+           DxccIndexTest \
+           DxccStatusMatrixTest \
            FileCompressorTest \
            GridsquareTest \
+           ImportDupeIndexTest \
+           JsonFormatTest \
+           LogFormatTest \
            BandPlanTest \
            BandmapGuideTest \
            AlertEvaluatorTest \
            DxServerStringTest \
            HostsPortStringTest \
            MigrationTest \
+           OrderedWorkQueueTest \
            PasswordCipherTest \
-           QuadKeyCacheTest \
+           QueryPlanTest \
+           RefStringTableTest \
+           SQLBulkLoadTest \
+           SQLTuningBenchmark \
            QTableQSOViewTest \
            RigctldManagerTest
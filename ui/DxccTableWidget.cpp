@@ -2,17 +2,19 @@
 #include <QTableView>
 #include <QVBoxLayout>
 #include <QDate>
-#include <QSqlError>
-#include <QSqlQuery>
 #include "models/DxccTableModel.h"
 #include "DxccTableWidget.h"
 #include "core/debug.h"
 #include "data/StationProfile.h"
 #include "data/BandPlan.h"
+#include "core/DBTaskExecutor.h"
 
 MODULE_IDENTIFICATION("qlog.ui.dxcctablewidget");
 
-DxccTableWidget::DxccTableWidget(QWidget *parent) : QTableView(parent)
+DxccTableWidget::DxccTableWidget(QWidget *parent) :
+    QTableView(parent),
+    // the widget is used several times - every instance has its own request
+    taskKey(QString("dxcc_table_%1").arg(reinterpret_cast<quintptr>(this)))
 {
     FCT_IDENTIFICATION;
 
@@ -23,12 +25,19 @@ DxccTableWidget::DxccTableWidget(QWidget *parent) : QTableView(parent)
     this->verticalHeader()->setVisible(false);
 }
 
+DxccTableWidget::~DxccTableWidget()
+{
+    FCT_IDENTIFICATION;
+
+    DBTaskExecutor::instance()->cancel(taskKey);
+}
+
 void DxccTableWidget::clear()
 {
     FCT_IDENTIFICATION;
 
+    DBTaskExecutor::instance()->cancel(taskKey);
     dxccTableModel->clear();
-    dxccTableModel->setQuery(QString());
     setHidden(true);
 }
 
@@ -77,27 +86,32 @@ void DxccTableWidget::updateDxTable(const QString &condition,
                            "        LEFT OUTER JOIN dxcc_summary c ON c.dxcc = m.dxcc "
                            " ORDER BY m.dxcc").arg(stmt_band_part1.join(","),
                                                    filter,
-                                                   condition.arg(conditionValue.toString()),
+                                                   condition,
                                                    stmt_band_part2.join(","));
 
     qCDebug(runtime) << stmt;
 
-    dxccTableModel->setQuery(stmt);
+    // the table is filled when the result arrives - a newer call cancels this one
+    DBTaskExecutor::instance()->submit(taskKey, stmt, QVariantList() << conditionValue,
+                                       this, [this, dxccBands, highlightedBand](const DBQueryResult &result)
+    {
+        dxccTableModel->setResult(result);
 
-    // get default Brush from Mode column - Mode Column has always the default color
-    const QVariant &defaultBrush = dxccTableModel->headerData(0, Qt::Horizontal, Qt::BackgroundRole);
+        // get default Brush from Mode column - Mode Column has always the default color
+        const QVariant &defaultBrush = dxccTableModel->headerData(0, Qt::Horizontal, Qt::BackgroundRole);
 
-    dxccTableModel->setHeaderData(0, Qt::Horizontal, tr("Mode"));
+        dxccTableModel->setHeaderData(0, Qt::Horizontal, tr("Mode"));
 
-    for ( int i = 0; i < dxccBands.size(); i++ )
-    {
-        dxccTableModel->setHeaderData(i+1, Qt::Horizontal, ( highlightedBand == dxccBands.at(i) ) ? QBrush(Qt::darkGray)
-                                                                                               : defaultBrush, Qt::BackgroundRole);
-        dxccTableModel->setHeaderData(i+1, Qt::Horizontal, dxccBands.at(i).name);
-    }
+        for ( int i = 0; i < dxccBands.size(); i++ )
+        {
+            dxccTableModel->setHeaderData(i+1, Qt::Horizontal, ( highlightedBand == dxccBands.at(i) ) ? QBrush(Qt::darkGray)
+                                                                                                   : defaultBrush, Qt::BackgroundRole);
+            dxccTableModel->setHeaderData(i+1, Qt::Horizontal, dxccBands.at(i).name);
+        }
 
-    horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
-    show();
+        horizontalHeader()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+        show();
+    });
 }
 
 void DxccTableWidget::setDxCallsign(const QString &dxCallsign, const Band &band)
@@ -107,7 +121,7 @@ void DxccTableWidget::setDxCallsign(const QString &dxCallsign, const Band &band)
     qCDebug(function_parameters) << dxCallsign;
 
     if (!dxCallsign.isEmpty())
-        updateDxTable("c.callsign = '%1'", dxCallsign.toUpper(), band);
+        updateDxTable("c.callsign = ?", dxCallsign.toUpper(), band);
     else
         clear();
 
@@ -120,7 +134,7 @@ void DxccTableWidget::setDxcc(int dxcc, const Band &highlightedBand)
     qCDebug(function_parameters) << dxcc;
 
     if ( dxcc )
-        updateDxTable("c.dxcc = %1", dxcc, highlightedBand);
+        updateDxTable("c.dxcc = ?", dxcc, highlightedBand);
     else
         clear();
 }
@@ -12,6 +12,7 @@ class DxccTableWidget : public QTableView
     Q_OBJECT
 public:
     explicit DxccTableWidget(QWidget *parent = nullptr);
+    ~DxccTableWidget();
 
 public slots:
     void clear();
@@ -24,6 +25,7 @@ private:
                        const Band &highlightedBand);
 
     DxccTableModel* dxccTableModel;
+    const QString taskKey;
 };
 
 #endif // QLOG_UI_DXCCTABLEWIDGET_H
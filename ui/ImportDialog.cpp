@@ -7,6 +7,7 @@
 #include "logformat/LogFormat.h"
 #include "core/debug.h"
 #include "core/LogParam.h"
+#include "core/FileCompressor.h"
 #include "data/StationProfile.h"
 #include "data/RigProfile.h"
 
@@ -110,7 +111,8 @@ void ImportDialog::browse()
 
     QString filename = QFileDialog::getOpenFileName(this, tr("Select File"),
                                                     lastPath,
-                                                    ui->typeSelect->currentText().toUpper() + "(*." + ui->typeSelect->currentText().toLower() + ")",
+                                                    ui->typeSelect->currentText().toUpper() + "(*." + ui->typeSelect->currentText().toLower()
+                                                    + " *." + ui->typeSelect->currentText().toLower() + ".gz)",
                                                     nullptr,
 #if defined(Q_OS_LINUX) && !(defined(QLOG_FLATPAK) && defined(Q_PROCESSOR_ARM_64))
                                                     // Do not use the Native Dialog under Linux because the dialog is case-sensitive.
@@ -346,9 +348,28 @@ void ImportDialog::runImport()
     }
 
     QFile file(ui->fileEdit->text());
-    file.open(QFile::ReadOnly | QFile::Text);
-    QTextStream in(&file);
+    GzipReadDevice gzipDevice(&file);
+    QIODevice *input = &file;
 
+    if ( GzipReadDevice::isGzipFile(file.fileName()) )
+    {
+        // the compressed file is decompressed while it is being imported
+        if ( !file.open(QFile::ReadOnly) || !gzipDevice.open(QIODevice::ReadOnly) )
+        {
+            QMessageBox::warning(nullptr, QMessageBox::tr("QLog Warning"),
+                                 QMessageBox::tr("Cannot open the compressed file") + "\n" + gzipDevice.errorString());
+            return;
+        }
+        input = &gzipDevice;
+    }
+    else
+    {
+        file.open(QFile::ReadOnly | QFile::Text);
+    }
+
+    QTextStream in(input);
+
+    // the progress of a compressed input follows the compressed bytes
     size = file.size();
 
     QMap<QString, QString> defaults;
@@ -34,6 +34,7 @@
 #include "service/GenericCallbook.h"
 #include "core/QSOFilterManager.h"
 #include "core/LogParam.h"
+#include "core/DBTaskExecutor.h"
 
 MODULE_IDENTIFICATION("qlog.ui.logbookwidget");
 
@@ -1148,8 +1149,8 @@ void LogbookWidget::reselectModel()
     // it is not possible to use mode->rowCount here because model contains only
     // the first 5000 records (or more) and rowCount has a value 5000 here. Therefore, it is needed
     // to run a QSL stateme with Count. Run it only in case when QTableview does not contain all
-    // records from model
-    int qsoCount = 0;
+    // records from model. The count runs in the background - it takes seconds on a large log
+    // and a newer filter cancels it
     if ( model->canFetchMore() )
     {
         QString countRecordsStmt(QLatin1String("SELECT COUNT(1) FROM contacts"));
@@ -1157,14 +1158,20 @@ void LogbookWidget::reselectModel()
         if ( !model->filter().isEmpty() )
             countRecordsStmt.append(QString(" WHERE %1").arg(model->filter()));
 
-        QSqlQuery query(countRecordsStmt);
+        ui->filteredQSOsLabel->setText(tr("Count: ..."));
 
-        qsoCount = query.first() ? query.value(0).toInt() : 0;
+        DBTaskExecutor::instance()->submit(QLatin1String("logbook_count"), countRecordsStmt, QVariantList(),
+                                           this, [this](const DBQueryResult &result)
+        {
+            const int qsoCount = ( result.ok && !result.rows.isEmpty() ) ? result.rows.first().value(0).toInt() : 0;
+            ui->filteredQSOsLabel->setText(tr("Count: %n", "", qsoCount));
+        });
     }
     else
-        qsoCount = model->rowCount();
-
-    ui->filteredQSOsLabel->setText(tr("Count: %n", "", qsoCount));
+    {
+        DBTaskExecutor::instance()->cancel(QLatin1String("logbook_count"));
+        ui->filteredQSOsLabel->setText(tr("Count: %n", "", model->rowCount()));
+    }
 }
 
 void LogbookWidget::updateTable()
@@ -383,6 +383,9 @@ MainWindow::MainWindow(QWidget* parent) :
     connect(ui->rotatorWidget, &RotatorWidget::rotProfileChanged, this, &MainWindow::rotConnect);
 
     connect(ui->logbookWidget, &LogbookWidget::deletedEntities, Data::instance(), &Data::invalidateSetOfDXCCStatusCache); // must be the first delete signal
+    connect(ui->logbookWidget, &LogbookWidget::contactUpdated, Data::instance(), &Data::updateDXCCStatusCache); // must be the first update signal
+    connect(ui->logbookWidget, &LogbookWidget::contactUpdated, Data::instance(), &Data::updateDupeIndexWhenQSOUpdated);
+    connect(ui->logbookWidget, &LogbookWidget::contactDeleted, Data::instance(), &Data::updateDupeIndexWhenQSODeleted);
     connect(ui->logbookWidget, &LogbookWidget::logbookUpdated, stats, &StatisticsWidget::refreshWidget);
     connect(ui->logbookWidget, &LogbookWidget::contactUpdated, &networknotification, &NetworkNotification::QSOUpdated);
     connect(ui->logbookWidget, &LogbookWidget::clublogContactUpdated, clublogRT, &ClubLogUploader::updateQSOImmediately);
@@ -398,6 +401,7 @@ MainWindow::MainWindow(QWidget* parent) :
     connect(ui->logbookWidget, &LogbookWidget::sendDXSpotContactReq, ui->dxWidget, &DxWidget::prepareQSOSpot);
 
     connect(ui->newContactWidget, &NewContactWidget::contactAdded, Data::instance(), &Data::invalidateDXCCStatusCache); // must be the first delete signal
+    connect(ui->newContactWidget, &NewContactWidget::contactAdded, Data::instance(), &Data::updateDupeIndexWhenQSOAdded);
     connect(ui->newContactWidget, &NewContactWidget::contactAdded, ui->logbookWidget, &LogbookWidget::updateTable);
     connect(ui->newContactWidget, &NewContactWidget::contactAdded, ui->logbookWidget, &LogbookWidget::setDefaultSort);
     connect(ui->newContactWidget, &NewContactWidget::contactAdded, &networknotification, &NetworkNotification::QSOInserted);
@@ -2251,6 +2255,10 @@ void MainWindow::showSettings()
     const int result = sw.exec();
     equipmentProfileSelectionSuspended = false;
 
+    // the bands and modes tables are saved on every field change,
+    // also when the dialog is canceled
+    BandPlan::invalidateCache();
+
     const RigProfile &rigProfile = RigProfilesManager::instance()->getCurProfile1();
     const bool waitForRigBand = result == QDialog::Accepted
                                 && ui->actionConnectRig->isChecked()
@@ -2278,6 +2286,7 @@ void MainWindow::showSettings()
             ui->newContactWidget->reportTXBand();
 
         Data::instance()->clearDXCCStatusCache();
+        Data::instance()->clearDupeIndex();
         rigConnect();
         if ( !waitForRigBand && rotatorConnectPending )
         {
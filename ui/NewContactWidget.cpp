@@ -25,6 +25,7 @@
 #include "data/AntProfile.h"
 #include "data/CWKeyProfile.h"
 #include "data/Data.h"
+#include "models/RefStringTableModel.h"
 #include "data/Callsign.h"
 #include "core/PropConditions.h"
 #include "core/MembershipQE.h"
@@ -190,19 +191,22 @@ NewContactWidget::NewContactWidget(QWidget *parent) :
     /***************/
     /* Completers  */
     /***************/
-    wwffCompleter = new QCompleter(Data::instance()->wwffIDList(), this);
+    wwffCompleter = new QCompleter(new RefStringTableModel([]() { return Data::instance()->wwffTable(); },
+                                                           uiDynamic->wwffEdit, Qt::MatchStartsWith, this), this);
     wwffCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     wwffCompleter->setFilterMode(Qt::MatchStartsWith);
     wwffCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     uiDynamic->wwffEdit->setCompleter(nullptr);
 
-    potaCompleter = new MultiselectCompleter(Data::instance()->potaIDList(), this);
+    potaCompleter = new MultiselectCompleter(new RefStringTableModel([]() { return Data::instance()->potaTable(); },
+                                                                     uiDynamic->potaEdit, Qt::MatchStartsWith, this), this);
     potaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     potaCompleter->setFilterMode(Qt::MatchStartsWith);
     potaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     uiDynamic->potaEdit->setCompleter(nullptr);
 
-    sotaCompleter = new QCompleter(Data::instance()->sotaIDList(), this);
+    sotaCompleter = new QCompleter(new RefStringTableModel([]() { return Data::instance()->sotaTable(); },
+                                                           uiDynamic->sotaEdit, Qt::MatchStartsWith, this), this);
     sotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     sotaCompleter->setFilterMode(Qt::MatchStartsWith);
     sotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
@@ -302,6 +306,7 @@ NewContactWidget::NewContactWidget(QWidget *parent) :
 
     // SQL query returns two QSOs. The first one is the last QSO with Base Callsign
     // and the second one is the last QSO for the Callsign from a portable QTH.
+    // tests/QueryPlanTest keeps a copy of both statements - keep it in sync.
     isPrevQSOExactMatchQuery = prevQSOExactMatchQuery.prepare(QLatin1String("SELECT "
                                                                             "    callsign, "
                                                                             "    name_intl, "
@@ -2154,12 +2159,14 @@ void NewContactWidget::saveExternalContact(QSqlRecord record)
     //
     // In the future, however, this should be handled by merging the records.
 
+    // +mode - the search must go through the callsign index, the mode index is not selective;
+    // tests/QueryPlanTest keeps a copy of the statement - keep it in sync
     QSqlQuery checkQuery;
     if ( !checkQuery.prepare(QLatin1String("SELECT id FROM contacts "
                                      "WHERE strftime('%Y-%m-%d %H:%M:%S', start_time) = strftime('%Y-%m-%d %H:%M:%S', :starttime) "
                                      "      AND callsign = :callsign "
                                      "      AND (CAST(ROUND(freq * 1000000.0) AS INTEGER) = :freq_hz OR band = :band) "
-                                     "      AND mode = :mode "
+                                     "      AND +mode = :mode "
                                      "LIMIT 1")) )
     {
         qWarning() << "Cannot prepared select statement for the External Dupe Check";
@@ -4510,7 +4517,8 @@ NewContactDynamicWidgets::NewContactDynamicWidgets(bool allocateWidgets,
         dokEdit->setToolTip(QCoreApplication::translate("NewContactWidget", "the contacted station's DARC DOK (District Location Code) (ex. A01)", nullptr));
 
         //iotaEdit->setMaximumSize(QSize(200, 16777215));
-        QCompleter *iotaCompleter = new QCompleter(Data::instance()->iotaIDList(), iotaEdit);
+        QCompleter *iotaCompleter = new QCompleter(new RefStringTableModel([]() { return Data::instance()->iotaTable(); },
+                                                                           iotaEdit, Qt::MatchContains, iotaEdit), iotaEdit);
         iotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
         iotaCompleter->setFilterMode(Qt::MatchContains);
         iotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
@@ -11,6 +11,7 @@
 #include "ui_QSODetailDialog.h"
 #include "core/debug.h"
 #include "data/Data.h"
+#include "models/RefStringTableModel.h"
 #include "PaperQSLDialog.h"
 #include "service/eqsl/Eqsl.h"
 #include "models/SqlListModel.h"
@@ -126,56 +127,64 @@ QSODetailDialog::QSODetailDialog(const QSqlRecord &qso,
     modeController->applyCurrentMode();
 
     /* IOTA Completer */
-    iotaCompleter.reset(new QCompleter(Data::instance()->iotaIDList(), this));
+    iotaCompleter.reset(new QCompleter(new RefStringTableModel([]() { return Data::instance()->iotaTable(); },
+                                                               ui->iotaEdit, Qt::MatchContains, this), this));
     iotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     iotaCompleter->setFilterMode(Qt::MatchContains);
     iotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->iotaEdit->setCompleter(iotaCompleter.data());
 
     /* SOTA Completer */
-    sotaCompleter.reset(new QCompleter(Data::instance()->sotaIDList(), this));
+    sotaCompleter.reset(new QCompleter(new RefStringTableModel([]() { return Data::instance()->sotaTable(); },
+                                                               ui->sotaEdit, Qt::MatchStartsWith, this), this));
     sotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     sotaCompleter->setFilterMode(Qt::MatchStartsWith);
     sotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->sotaEdit->setCompleter(nullptr);
 
     /* POTA Completer */
-    potaCompleter.reset(new MultiselectCompleter(Data::instance()->potaIDList(), this));
+    potaCompleter.reset(new MultiselectCompleter(new RefStringTableModel([]() { return Data::instance()->potaTable(); },
+                                                                         ui->potaEdit, Qt::MatchStartsWith, this), this));
     potaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     potaCompleter->setFilterMode(Qt::MatchStartsWith);
     potaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->potaEdit->setCompleter(nullptr);
 
     /* WWFF Completer */
-    wwffCompleter.reset(new QCompleter(Data::instance()->wwffIDList(), this));
+    wwffCompleter.reset(new QCompleter(new RefStringTableModel([]() { return Data::instance()->wwffTable(); },
+                                                               ui->wwffEdit, Qt::MatchStartsWith, this), this));
     wwffCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     wwffCompleter->setFilterMode(Qt::MatchStartsWith);
     wwffCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->wwffEdit->setCompleter(nullptr);
 
     /* MyIOTA Completer */
-    myIotaCompleter.reset(new QCompleter(Data::instance()->iotaIDList(), this));
+    myIotaCompleter.reset(new QCompleter(new RefStringTableModel([]() { return Data::instance()->iotaTable(); },
+                                                                 ui->myIOTAEdit, Qt::MatchContains, this), this));
     myIotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     myIotaCompleter->setFilterMode(Qt::MatchContains);
     myIotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->myIOTAEdit->setCompleter(myIotaCompleter.data());
 
     /* MySOTA Completer */
-    mySotaCompleter.reset(new QCompleter(Data::instance()->sotaIDList(), this));
+    mySotaCompleter.reset(new QCompleter(new RefStringTableModel([]() { return Data::instance()->sotaTable(); },
+                                                                 ui->mySOTAEdit, Qt::MatchStartsWith, this), this));
     mySotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     mySotaCompleter->setFilterMode(Qt::MatchStartsWith);
     mySotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->mySOTAEdit->setCompleter(nullptr);
 
     /* MyPOTA Completer */
-    myPotaCompleter.reset(new QCompleter(Data::instance()->potaIDList(), this));
+    myPotaCompleter.reset(new QCompleter(new RefStringTableModel([]() { return Data::instance()->potaTable(); },
+                                                                 ui->myPOTAEdit, Qt::MatchStartsWith, this), this));
     myPotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     myPotaCompleter->setFilterMode(Qt::MatchStartsWith);
     myPotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->myPOTAEdit->setCompleter(nullptr);
 
     /* MyWWFF Completer */
-    myWWFFCompleter.reset(new QCompleter(Data::instance()->wwffIDList(), this));
+    myWWFFCompleter.reset(new QCompleter(new RefStringTableModel([]() { return Data::instance()->wwffTable(); },
+                                                                 ui->myWWFFEdit, Qt::MatchStartsWith, this), this));
     myWWFFCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     myWWFFCompleter->setFilterMode(Qt::MatchStartsWith);
     myWWFFCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
@@ -34,6 +34,7 @@
 #include "data/RigProfile.h"
 #include "data/AntProfile.h"
 #include "data/Data.h"
+#include "models/RefStringTableModel.h"
 #include "data/Gridsquare.h"
 #include "core/FldigiUDPReceiver.h"
 #include "core/WsjtxUDPReceiver.h"
@@ -571,25 +572,29 @@ SettingsDialog::SettingsDialog(MainWindow *parent) :
     for ( QLineEdit *edit : hostsPortEdits )
         edit->setValidator(new QRegularExpressionValidator(hostsPortRe, edit));
 
-    iotaCompleter = new QCompleter(Data::instance()->iotaIDList(), ui->stationIOTAEdit);
+    iotaCompleter = new QCompleter(new RefStringTableModel([]() { return Data::instance()->iotaTable(); },
+                                                           ui->stationIOTAEdit, Qt::MatchContains, ui->stationIOTAEdit), ui->stationIOTAEdit);
     iotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     iotaCompleter->setFilterMode(Qt::MatchContains);
     iotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->stationIOTAEdit->setCompleter(iotaCompleter);
 
-    sotaCompleter = new QCompleter(Data::instance()->sotaIDList(), this);
+    sotaCompleter = new QCompleter(new RefStringTableModel([]() { return Data::instance()->sotaTable(); },
+                                                           ui->stationSOTAEdit, Qt::MatchStartsWith, this), this);
     sotaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     sotaCompleter->setFilterMode(Qt::MatchStartsWith);
     sotaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->stationSOTAEdit->setCompleter(nullptr);
 
-    wwffCompleter = new QCompleter(Data::instance()->wwffIDList(), this);
+    wwffCompleter = new QCompleter(new RefStringTableModel([]() { return Data::instance()->wwffTable(); },
+                                                           ui->stationWWFFEdit, Qt::MatchStartsWith, this), this);
     wwffCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     wwffCompleter->setFilterMode(Qt::MatchStartsWith);
     wwffCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
     ui->stationWWFFEdit->setCompleter(nullptr);
 
-    potaCompleter = new MultiselectCompleter(Data::instance()->potaIDList(), this);
+    potaCompleter = new MultiselectCompleter(new RefStringTableModel([]() { return Data::instance()->potaTable(); },
+                                                                     ui->stationPOTAEdit, Qt::MatchStartsWith, this), this);
     potaCompleter->setCaseSensitivity(Qt::CaseInsensitive);
     potaCompleter->setFilterMode(Qt::MatchStartsWith);
     potaCompleter->setModelSorting(QCompleter::CaseSensitivelySortedModel);
@@ -17,9 +17,12 @@
 #include "models/SqlListModel.h"
 #include "data/Gridsquare.h"
 #include "core/QSOFilterManager.h"
+#include "core/DBTaskExecutor.h"
 
 MODULE_IDENTIFICATION("qlog.ui.statisticswidget");
 
+const QString StatisticsWidget::BAR_GRAPH_TASK = QStringLiteral("statistics_bar_graph");
+
 void StatisticsWidget::mainStatChanged(int idx)
 {
      FCT_IDENTIFICATION;
@@ -52,6 +55,9 @@ void StatisticsWidget::refreshGraph()
      if ( !isVisible() )
          return;
 
+     // a running bar graph query must not overwrite a newer graph
+     DBTaskExecutor::instance()->cancel(BAR_GRAPH_TASK);
+
      QStringList genericFilter;
 
      genericFilter << " 1 = 1 "; //just initialization - use only in case of empty Options
@@ -202,12 +208,10 @@ void StatisticsWidget::refreshGraph()
 
          qCDebug(runtime) << stmt;
 
-         QSqlQuery query(stmt);
-
-         drawBarGraphs(ui->statTypeMainCombo->currentText()
-                       + " "
-                       + ui->statTypeSecCombo->currentText(),
-                       query);
+         refreshBarGraph(ui->statTypeMainCombo->currentText()
+                         + " "
+                         + ui->statTypeSecCombo->currentText(),
+                         stmt);
      }
      /************/
      /* Percents */
@@ -264,12 +268,10 @@ void StatisticsWidget::refreshGraph()
 
          qCDebug(runtime) << stmt;
 
-         QSqlQuery query(stmt);
-
-         drawBarGraphs(ui->statTypeMainCombo->currentText()
-                       + " "
-                       + ui->statTypeSecCombo->currentText(),
-                       query);
+         refreshBarGraph(ui->statTypeMainCombo->currentText()
+                         + " "
+                         + ui->statTypeSecCombo->currentText(),
+                         stmt);
 
      }
      /*************/
@@ -307,12 +309,10 @@ void StatisticsWidget::refreshGraph()
 
          qCDebug(runtime) << stmt;
 
-         QSqlQuery query(stmt);
-
-         drawBarGraphs(ui->statTypeMainCombo->currentText()
-                       + " "
-                       + ui->statTypeSecCombo->currentText(),
-                       query);
+         refreshBarGraph(ui->statTypeMainCombo->currentText()
+                         + " "
+                         + ui->statTypeSecCombo->currentText(),
+                         stmt);
      }
      /***************/
      /* Show on Map */
@@ -471,11 +471,26 @@ bool StatisticsWidget::event(QEvent *event)
     return QWidget::event(event);  // Propagate the event further
 }
 
-void StatisticsWidget::drawBarGraphs(const QString &title, QSqlQuery &query)
+void StatisticsWidget::refreshBarGraph(const QString &title, const QString &stmt)
 {
     FCT_IDENTIFICATION;
 
-    if ( query.lastQuery().isEmpty() ) return;
+    if ( stmt.isEmpty() ) return;
+
+    // the statistics of a large log take seconds - they run in the background
+    DBTaskExecutor::instance()->submit(BAR_GRAPH_TASK, stmt, QVariantList(),
+                                       this, [this, title](const DBQueryResult &result)
+    {
+        if ( !result.ok )
+            qCWarning(runtime) << "Statistics query failed" << result.error;
+
+        drawBarGraphs(title, result.rows);
+    });
+}
+
+void StatisticsWidget::drawBarGraphs(const QString &title, const QList<QVariantList> &rows)
+{
+    FCT_IDENTIFICATION;
 
     QChart *chart = ui->graphView->chart();
 
@@ -488,10 +503,10 @@ void StatisticsWidget::drawBarGraphs(const QString &title, QSqlQuery &query)
     QBarSeries* series = new QBarSeries(chart);
     QValueAxis *axisY = new QValueAxis(chart);
 
-    while ( query.next() )
+    for ( const QVariantList &row : rows )
     {
-        axisX->append(query.value(0).toString());
-        *set << query.value(1).toInt();
+        axisX->append(row.value(0).toString());
+        *set << row.value(1).toInt();
     }
 
     series->append(set);
@@ -40,7 +40,8 @@ protected:
 
 private:
 
-    void drawBarGraphs(const QString &title, QSqlQuery &query);
+    void refreshBarGraph(const QString &title, const QString &stmt);
+    void drawBarGraphs(const QString &title, const QList<QVariantList> &rows);
     void drawPieGraph(const QString &title, QPieSeries* series);
     void drawMyLocationsOnMap(QSqlQuery &);
     void drawPointsOnMap(QSqlQuery&);
@@ -61,6 +62,8 @@ private:
     QString mapRenderKey;
 
 
+    static const QString BAR_GRAPH_TASK;
+
     // default statistics interval [in days]
     const int DEFAULT_STAT_RANGE = -1;
 
@@ -6,6 +6,11 @@ MultiselectCompleter::MultiselectCompleter(const QStringList& items, QObject* pa
 {
 }
 
+MultiselectCompleter::MultiselectCompleter(QAbstractItemModel *model, QObject *parent)
+    : QCompleter(model, parent)
+{
+}
+
 QString MultiselectCompleter::pathFromIndex( const QModelIndex& index ) const
 {
     QString path = QCompleter::pathFromIndex(index);
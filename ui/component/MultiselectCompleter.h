@@ -10,6 +10,8 @@ class MultiselectCompleter : public QCompleter
 public:
     explicit MultiselectCompleter(const QStringList &items,
                                   QObject *parent = nullptr);
+    explicit MultiselectCompleter(QAbstractItemModel *model,
+                                  QObject *parent = nullptr);
     ~MultiselectCompleter() {};
 
 public: